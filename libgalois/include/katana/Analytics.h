@@ -1,6 +1,7 @@
 #ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_H_
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_H_
 
+#include "katana/analytics/GraphProfile.h"
 #include "katana/analytics/betweenness_centrality/betweenness_centrality.h"
 #include "katana/analytics/bfs/bfs.h"
 #include "katana/analytics/connected_components/connected_components.h"
@@ -23,6 +23,7 @@
 #include "katana/FixedSizeRing.h"
 #include "katana/Mem.h"
 #include "katana/PaddedLock.h"
+#include "katana/Trace.h"
 #include "katana/WLCompileCheck.h"
 #include "katana/WorkListHelpers.h"
 #include "katana/config.h"
@@ -113,6 +114,9 @@ private:
     if (r)
       return r;
 
+    // Refill from the chunks of other threads; only refills that find a
+    // chunk are traced
+    TraceScope scope("refill", "worklist");
     for (int i = id + 1; i < (int)Q.size(); ++i) {
       r = popChunkByID(i);
       if (r)
@@ -125,6 +129,7 @@ private:
         return r;
     }
 
+    scope.Dismiss();
     return 0;
   }
 
@@ -26,10 +26,12 @@
 #include "katana/OperatorReferenceTypes.h"
 #include "katana/PaddedLock.h"
 #include "katana/PerThreadStorage.h"
+#include "katana/PerfCounters.h"
 #include "katana/Statistics.h"
 #include "katana/TerminationDetection.h"
 #include "katana/ThreadPool.h"
 #include "katana/Timer.h"
+#include "katana/Trace.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
 
@@ -411,6 +413,8 @@ public:
 
   void operator()(void) {
     ThreadContext& ctx = *workers.getLocal();
+    TraceScope scope(loopname, "do_all");
+    PerfCounterScope thread_counters;
     totalTime.start();
 
     while (true) {
@@ -427,7 +431,15 @@ public:
       KATANA_LOG_DEBUG_ASSERT(!ctx.hasWork());
 
       stealTime.start();
-      bool stole = trySteal(ctx);
+      bool stole;
+      {
+        // Idle threads retry often, so only successful steals are traced
+        TraceScope steal_scope(loopname, "steal");
+        stole = trySteal(ctx);
+        if (!stole) {
+          steal_scope.Dismiss();
+        }
+      }
       stealTime.stop();
 
       if (stole) {
@@ -472,7 +484,11 @@ struct ChooseDoAllImpl {
 
     GetThreadPool().run(
         activeThreads, [&exec]() { exec.initThread(); },
-        [&barrier]() { barrier.Wait(); }, std::ref(exec));
+        [&barrier]() {
+          TraceScope scope("barrier", "barrier");
+          barrier.Wait();
+        },
+        std::ref(exec));
   }
 };
 
@@ -480,46 +496,46 @@ template <>
 struct ChooseDoAllImpl<false> {
   template <typename R, typename F, typename ArgsT>
   static void call(const R& range, F func, const ArgsT& argsTuple) {
-    on_each_gen(
-        [&](const unsigned int, const unsigned int) {
-          static constexpr bool NEED_STATS =
-              katana::internal::NeedStats<ArgsT>::value;
-          static constexpr bool MORE_STATS =
-              NEED_STATS && has_trait<more_stats_tag, ArgsT>();
+    // do_all_gen times the loop and reports its counters and wakeups
+    RunOnEachThread([&](const unsigned int, const unsigned int) {
+      static constexpr bool NEED_STATS =
+          katana::internal::NeedStats<ArgsT>::value;
+      static constexpr bool MORE_STATS =
+          NEED_STATS && has_trait<more_stats_tag, ArgsT>();
 
-          const char* const loopname = katana::internal::getLoopName(argsTuple);
+      const char* const loopname = katana::internal::getLoopName(argsTuple);
 
-          PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
-          PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
-          PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
+      PerThreadTimer<MORE_STATS> totalTime(loopname, "Total");
+      PerThreadTimer<MORE_STATS> initTime(loopname, "Init");
+      PerThreadTimer<MORE_STATS> execTime(loopname, "Work");
 
-          totalTime.start();
-          initTime.start();
+      TraceScope scope(loopname, "do_all");
+      totalTime.start();
+      initTime.start();
 
-          auto begin = range.local_begin();
-          const auto end = range.local_end();
+      auto begin = range.local_begin();
+      const auto end = range.local_end();
 
-          initTime.stop();
+      initTime.stop();
 
-          execTime.start();
+      execTime.start();
 
-          size_t iter = 0;
+      size_t iter = 0;
 
-          while (begin != end) {
-            func(*begin++);
-            if (NEED_STATS) {
-              ++iter;
-            }
-          }
-          execTime.stop();
+      while (begin != end) {
+        func(*begin++);
+        if (NEED_STATS) {
+          ++iter;
+        }
+      }
+      execTime.stop();
 
-          totalTime.stop();
+      totalTime.stop();
 
-          if (NEED_STATS) {
-            katana::ReportStatSum(loopname, "Iterations", iter);
-          }
-        },
-        std::make_tuple());
+      if (NEED_STATS) {
+        katana::ReportStatSum(loopname, "Iterations", iter);
+      }
+    });
   }
 };
 
@@ -541,6 +557,8 @@ do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
 
   constexpr bool TIME_IT = has_trait<loopname_tag, ArgsT>();
   CondStatTimer<TIME_IT> timer(katana::internal::getLoopName(argsT));
+  CondPerfCounterRegion<TIME_IT> counters(
+      katana::internal::getLoopName(argsT));
 
   timer.start();
 
@@ -550,6 +568,10 @@ do_all_gen(const R& range, F&& func, const ArgsTuple& argsTuple) {
   internal::ChooseDoAllImpl<STEAL>::call(range, func_ref, argsT);
 
   timer.stop();
+  counters.Stop();
+  if (TIME_IT) {
+    internal::ReportWakeupStats(katana::internal::getLoopName(argsT));
+  }
 }
 
 }  // namespace katana
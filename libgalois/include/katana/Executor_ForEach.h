@@ -28,9 +28,11 @@
 #include "katana/Barrier.h"
 #include "katana/Chunk.h"
 #include "katana/Context.h"
+#include "katana/Executor_OnEach.h"
 #include "katana/LoopStatistics.h"
 #include "katana/Mem.h"
 #include "katana/OperatorReferenceTypes.h"
+#include "katana/PerfCounters.h"
 #include "katana/Range.h"
 #include "katana/Simple.h"
 #include "katana/TerminationDetection.h"
@@ -38,6 +40,7 @@
 #include "katana/ThreadTimer.h"
 #include "katana/Threads.h"
 #include "katana/Timer.h"
+#include "katana/Trace.h"
 #include "katana/Traits.h"
 #include "katana/UserContextAccess.h"
 #include "katana/config.h"
@@ -299,6 +302,8 @@ protected:
 
   template <bool couldAbort, bool isLeader>
   void go() {
+    TraceScope scope(loopname, "for_each");
+    PerfCounterScope thread_counters;
     execTime.start();
 
     // Thread-local data goes on the local stack to be NUMA friendly
@@ -346,6 +351,7 @@ protected:
       }
 
       term.InitializeThread();
+      TraceScope barrier_scope("barrier", "barrier");
       barrier.Wait();
     }
 
@@ -391,6 +397,7 @@ public:
 
   template <typename RangeTy>
   void initThread(const RangeTy& range) {
+    TraceScope scope(loopname, "push_initial");
     initTime.start();
 
     wl.push_initial(range);
@@ -457,7 +464,11 @@ for_each_impl(const RangeTy& range, FunctionTy&& fn, const ArgsTy& args) {
   W.init(range);
   GetThreadPool().run(
       activeThreads, [&W, &range]() { W.initThread(range); },
-      [&barrier] { barrier.Wait(); }, std::ref(W));
+      [&barrier] {
+        TraceScope scope("barrier", "barrier");
+        barrier.Wait();
+      },
+      std::ref(W));
 }
 
 // TODO: Need to decide whether user should provide num_run tag or
@@ -480,12 +491,17 @@ for_each_gen(const RangeTy& r, FunctionTy&& fn, const TupleTy& tpl) {
 
   constexpr bool TIME_IT = has_trait<loopname_tag, decltype(xtpl)>();
   CondStatTimer<TIME_IT> timer(katana::internal::getLoopName(xtpl));
+  CondPerfCounterRegion<TIME_IT> counters(katana::internal::getLoopName(xtpl));
 
   timer.start();
 
   for_each_impl(r, std::forward<FunctionTy>(fn), xtpl);
 
   timer.stop();
+  counters.Stop();
+  if (TIME_IT) {
+    internal::ReportWakeupStats(katana::internal::getLoopName(xtpl));
+  }
 }
 
 }  // end namespace katana
@@ -21,10 +21,13 @@
 #define KATANA_LIBGALOIS_KATANA_EXECUTORONEACH_H_
 
 #include "katana/OperatorReferenceTypes.h"
+#include "katana/PerfCounters.h"
+#include "katana/Statistics.h"
 #include "katana/ThreadPool.h"
 #include "katana/ThreadTimer.h"
 #include "katana/Threads.h"
 #include "katana/Timer.h"
+#include "katana/Trace.h"
 #include "katana/Traits.h"
 #include "katana/config.h"
 #include "katana/gIO.h"
@@ -33,6 +36,37 @@ namespace katana {
 
 namespace internal {
 
+/// Report under loopname how long the threads of the loop just run took to
+/// wake up: the number of Wakeups, of them ParkedWakeups, the sum of their
+/// latencies, WakeupLatencyNs, and StartDelayNs, the latency until the last
+/// thread started, summed over all runs of the loop. The stats are taken from
+/// the pool, so the wakeups of a run are reported at most once.
+inline void
+ReportWakeupStats(const char* loopname) {
+  ThreadPool::WakeupStats stats = GetThreadPool().takeLastWakeupStats();
+  if (!stats.wakeups) {
+    return;
+  }
+  ReportStatSum(loopname, "Wakeups", stats.wakeups);
+  ReportStatSum(loopname, "ParkedWakeups", stats.parked);
+  ReportStatSum(loopname, "WakeupLatencyNs", stats.totalLatencyNs);
+  ReportStatSum(loopname, "StartDelayNs", stats.maxLatencyNs);
+}
+
+/// Run fn(tid, num_threads) on every active thread, counting each thread's
+/// hardware events for the PerfCounterRegion of the calling loop. Reports
+/// nothing itself, so loops built on it, like on_each and do_all, open their
+/// region and report their statistics exactly once.
+template <typename FunctionTy>
+inline void
+RunOnEachThread(const FunctionTy& fn) {
+  const auto numT = getActiveThreads();
+  GetThreadPool().run(numT, [&] {
+    PerfCounterScope thread_counters;
+    fn(ThreadPool::getTID(), numT);
+  });
+}
+
 template <typename FunctionTy, typename ArgsTy>
 inline void
 on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
@@ -46,24 +80,26 @@ on_each_impl(FunctionTy&& fn, const ArgsTy& argsTuple) {
   const char* const loopname = katana::internal::getLoopName(argsTuple);
 
   CondStatTimer<NEEDS_STATS> timer(loopname);
+  CondPerfCounterRegion<NEEDS_STATS> counters(loopname);
 
   PerThreadTimer<MORE_STATS> execTime(loopname, "Execute");
 
-  const auto numT = getActiveThreads();
-
   OperatorReferenceType<decltype(std::forward<FunctionTy>(fn))> fn_ref = fn;
 
-  auto runFun = [&] {
+  timer.start();
+  RunOnEachThread([&](unsigned tid, unsigned numT) {
     execTime.start();
-
-    fn_ref(ThreadPool::getTID(), numT);
-
+    {
+      TraceScope scope(loopname, "on_each");
+      fn_ref(tid, numT);
+    }
     execTime.stop();
-  };
-
-  timer.start();
-  GetThreadPool().run(numT, runFun);
+  });
   timer.stop();
+  counters.Stop();
+  if (NEEDS_STATS) {
+    ReportWakeupStats(loopname);
+  }
 }
 
 }  // namespace internal
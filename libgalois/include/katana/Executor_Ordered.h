@@ -20,33 +20,376 @@
 #ifndef KATANA_LIBGALOIS_KATANA_EXECUTORORDERED_H_
 #define KATANA_LIBGALOIS_KATANA_EXECUTORORDERED_H_
 
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#include "katana/Context.h"
+#include "katana/Executor_DoAll.h"
+#include "katana/Executor_OnEach.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Range.h"
+#include "katana/Statistics.h"
+#include "katana/Threads.h"
+#include "katana/Traits.h"
+#include "katana/UserContextAccess.h"
 #include "katana/config.h"
 
 namespace katana {
 
-// TODO(ddn): Pull in and integrate in executors from exp
+namespace internal {
 
-template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc>
-void
-for_each_ordered_impl(
-    [[maybe_unused]] Iter beg, [[maybe_unused]] Iter end,
-    [[maybe_unused]] const Cmp& cmp, [[maybe_unused]] const NhFunc& nhFunc,
-    [[maybe_unused]] const OpFunc& opFunc,
-    [[maybe_unused]] const char* loopname) {
-  KATANA_DIE("not yet implemented");
-}
+/// Conflict detection context of one task in a window of an ordered loop.
+///
+/// While the neighborhoods of the tasks of a window are visited, each Lockable
+/// ends up marked by the task with the lowest id, i.e., the earliest task,
+/// that visits it. A task that finds the mark of an earlier task, or whose
+/// mark is stolen by one, is not ready: running it now could reorder it with
+/// respect to an earlier task.
+class KATANA_EXPORT OrderedContext : public SimpleRuntimeContext {
+  size_t id_{0};
+  std::atomic<bool> not_ready_{false};
+
+public:
+  OrderedContext() : SimpleRuntimeContext(true) {}
+  ~OrderedContext() override;
+
+  void Reset(size_t id) {
+    id_ = id;
+    not_ready_.store(false, std::memory_order_relaxed);
+  }
+
+  bool IsReady() const { return !not_ready_.load(std::memory_order_relaxed); }
+
+  void subAcquire(Lockable* lockable, katana::MethodFlag) override;
+};
+
+struct AlwaysStable {
+  template <typename T>
+  bool operator()(const T&) const {
+    return true;
+  }
+};
+
+/// Speculative ordered executor over a sliding window of the earliest
+/// pending tasks.
+///
+/// Each round takes up to window_size_ of the earliest pending tasks. The
+/// neighborhoods of the window are visited in parallel to find its sources,
+/// the tasks with no earlier task of the window in their neighborhood. Then
+/// the operator runs in parallel on the sources that pass the stability test.
+/// Their neighborhoods are disjoint from those of all earlier tasks, so running
+/// them together commits them in priority order. For stable source algorithms,
+/// tasks pushed by the operator never precede a source of the same round. The
+/// other tasks of the window and the tasks pushed by the operator go back to
+/// the pending set.
+///
+/// The pending set is a heap per thread, so no step of a round is serial in
+/// the size of the window. Each thread pops the earliest window_size_ tasks
+/// of its heap; the window is the earliest window_size_ of these candidates,
+/// found with a parallel sort, and the other candidates go back to the heaps
+/// they came from.
+///
+/// The earliest task of a window is always run, so every round makes progress.
+/// The window grows while most of it commits and shrinks when most of it is
+/// deferred.
+template <
+    typename T, typename Cmp, typename NhFunc, typename OpFunc,
+    typename StableTest>
+class OrderedExecutor {
+  constexpr static size_t kWindowPerThread = 8;
+  constexpr static size_t kMaxWindowSize = size_t{1} << 20;
+
+  /// Heap order: the earliest task, by cmp, is at the top. cmp may be either
+  /// strict or not.
+  struct HeapCmp {
+    const Cmp& cmp;
+    bool operator()(const T& a, const T& b) const {
+      return cmp(b, a) && !cmp(a, b);
+    }
+  };
+
+  struct ThreadLocalData {
+    UserContextAccess<T> facing;
+    /// This thread's part of the pending set, ordered by HeapCmp
+    std::vector<T> heap;
+    /// The earliest tasks of heap, earliest first, offered for the window
+    std::vector<T> candidates;
+    size_t iterations{0};
+    size_t commits{0};
+    size_t pushes{0};
+    size_t round_commits{0};
+  };
+
+  HeapCmp heap_cmp_;
+  const NhFunc& nh_func_;
+  const OpFunc& op_func_;
+  const StableTest& stable_test_;
+  const char* loopname_;
+
+  std::vector<T> window_;
+  std::vector<char> stable_;
+  std::deque<OrderedContext> contexts_;
+  PerThreadStorage<ThreadLocalData> thread_data_;
+  size_t window_size_{0};
+
+  /// Where the candidates of each thread begin in the concatenation of all
+  /// candidates, and the indices of that concatenation in window order
+  std::vector<size_t> candidate_offsets_;
+  std::vector<size_t> candidate_order_;
+
+  void PushHeap(std::vector<T>* heap, T&& item) const {
+    heap->emplace_back(std::move(item));
+    std::push_heap(heap->begin(), heap->end(), heap_cmp_);
+  }
+
+  const T& Candidate(size_t index) {
+    auto it = std::upper_bound(
+        candidate_offsets_.begin(), candidate_offsets_.end(), index);
+    size_t tid = std::distance(candidate_offsets_.begin(), it) - 1;
+    return thread_data_.getRemote(tid)
+        ->candidates[index - candidate_offsets_[tid]];
+  }
+
+  /// Spread the initial tasks over the heaps of the active threads
+  void Distribute(const std::vector<T>& initial) {
+    on_each_gen(
+        [&](unsigned tid, unsigned num_threads) {
+          ThreadLocalData& tld = *thread_data_.getLocal();
+          auto [begin, end] =
+              block_range(initial.begin(), initial.end(), tid, num_threads);
+          tld.heap.assign(begin, end);
+          std::make_heap(tld.heap.begin(), tld.heap.end(), heap_cmp_);
+        },
+        std::make_tuple());
+  }
+
+  /// Take the earliest window_size_ pending tasks, earliest first
+  void FillWindow() {
+    size_t num_threads = thread_data_.size();
+    on_each_gen(
+        [&](unsigned, unsigned) {
+          ThreadLocalData& tld = *thread_data_.getLocal();
+          tld.candidates.clear();
+          while (tld.candidates.size() < window_size_ && !tld.heap.empty()) {
+            std::pop_heap(tld.heap.begin(), tld.heap.end(), heap_cmp_);
+            tld.candidates.emplace_back(std::move(tld.heap.back()));
+            tld.heap.pop_back();
+          }
+        },
+        std::make_tuple());
+
+    candidate_offsets_.assign(num_threads + 1, 0);
+    for (unsigned t = 0; t < num_threads; ++t) {
+      candidate_offsets_[t + 1] =
+          candidate_offsets_[t] + thread_data_.getRemote(t)->candidates.size();
+    }
+    size_t num_candidates = candidate_offsets_.back();
+
+    // Ties are broken by index, so the candidates of each thread that make
+    // the window are a prefix of its candidates
+    candidate_order_.resize(num_candidates);
+    std::iota(candidate_order_.begin(), candidate_order_.end(), size_t{0});
+    auto earlier = [this](size_t a, size_t b) {
+      const T& x = Candidate(a);
+      const T& y = Candidate(b);
+      if (heap_cmp_(y, x)) {
+        return true;
+      }
+      return !heap_cmp_(x, y) && a < b;
+    };
+    ParallelSTL::sort(
+        candidate_order_.begin(), candidate_order_.end(), earlier);
+
+    size_t size = std::min(window_size_, num_candidates);
+    window_.resize(size);
+    do_all_gen(
+        iterate(size_t{0}, size),
+        [this](size_t i) { window_[i] = Candidate(candidate_order_[i]); },
+        std::make_tuple(no_stats()));
+
+    // Return the rest to their heaps
+    on_each_gen(
+        [&](unsigned tid, unsigned) {
+          ThreadLocalData& tld = *thread_data_.getLocal();
+          size_t begin = candidate_offsets_[tid];
+          size_t end = candidate_offsets_[tid + 1];
+          size_t num_taken = 0;
+          if (size > 0 && begin < end) {
+            // The number of this thread's candidates that are not after the
+            // last task of the window
+            size_t last = candidate_order_[size - 1];
+            size_t lo = 0;
+            size_t hi = end - begin;
+            while (lo < hi) {
+              size_t mid = lo + (hi - lo) / 2;
+              if (begin + mid == last || earlier(begin + mid, last)) {
+                lo = mid + 1;
+              } else {
+                hi = mid;
+              }
+            }
+            num_taken = lo;
+          }
+          for (size_t i = num_taken; i < tld.candidates.size(); ++i) {
+            PushHeap(&tld.heap, std::move(tld.candidates[i]));
+          }
+        },
+        std::make_tuple());
+
+    while (contexts_.size() < window_.size()) {
+      contexts_.emplace_back();
+    }
+    stable_.resize(window_.size());
+  }
+
+  /// Visit neighborhoods and mark the sources of the window
+  void MarkSources() {
+    do_all_gen(
+        iterate(size_t{0}, window_.size()),
+        [this](size_t i) {
+          OrderedContext& ctx = contexts_[i];
+          ctx.Reset(i);
+          setThreadContext(&ctx);
+          nh_func_(window_[i]);
+          setThreadContext(nullptr);
+          stable_[i] = i == 0 || stable_test_(window_[i]);
+        },
+        std::make_tuple(steal(), no_stats()));
+  }
+
+  /// Run the stable sources of the window, release the marks and put the
+  /// other tasks and the pushed ones in the heap of the running thread
+  void CommitSources() {
+    do_all_gen(
+        iterate(size_t{0}, window_.size()),
+        [this](size_t i) {
+          OrderedContext& ctx = contexts_[i];
+          ThreadLocalData& tld = *thread_data_.getLocal();
+          ++tld.iterations;
+          if (ctx.IsReady() && stable_[i]) {
+            op_func_(window_[i], tld.facing.data());
+            ++tld.round_commits;
+            auto& pb = tld.facing.getPushBuffer();
+            tld.pushes += pb.size();
+            for (T& item : pb) {
+              PushHeap(&tld.heap, std::move(item));
+            }
+            tld.facing.resetPushBuffer();
+            tld.facing.resetAlloc();
+          } else {
+            PushHeap(&tld.heap, std::move(window_[i]));
+          }
+          ctx.commitIteration();
+        },
+        std::make_tuple(steal(), no_stats()));
+  }
+
+  /// \returns the number of tasks committed in this round and, in
+  /// num_pending, the number of tasks left
+  size_t EndRound(size_t* num_pending) {
+    size_t committed = 0;
+    *num_pending = 0;
+    for (unsigned t = 0; t < thread_data_.size(); ++t) {
+      ThreadLocalData& tld = *thread_data_.getRemote(t);
+      committed += tld.round_commits;
+      tld.commits += tld.round_commits;
+      tld.round_commits = 0;
+      *num_pending += tld.heap.size();
+    }
+    return committed;
+  }
+
+  void AdaptWindow(size_t committed, size_t min_window_size) {
+    size_t size = window_.size();
+    if (size == window_size_ && committed * 4 >= size * 3) {
+      window_size_ = std::min(window_size_ * 2, kMaxWindowSize);
+    } else if (committed * 4 < size) {
+      window_size_ = std::max(window_size_ / 2, min_window_size);
+    }
+  }
+
+  void ReportStats(size_t rounds) {
+    if (!loopname_) {
+      return;
+    }
+    size_t iterations = 0;
+    size_t commits = 0;
+    size_t pushes = 0;
+    for (unsigned t = 0; t < thread_data_.size(); ++t) {
+      const ThreadLocalData& tld = *thread_data_.getRemote(t);
+      iterations += tld.iterations;
+      commits += tld.commits;
+      pushes += tld.pushes;
+    }
+    ReportStatSingle(loopname_, "Iterations", iterations);
+    ReportStatSingle(loopname_, "Commits", commits);
+    ReportStatSingle(loopname_, "Pushes", pushes);
+    ReportStatSingle(loopname_, "Conflicts", iterations - commits);
+    ReportStatSingle(loopname_, "Rounds", rounds);
+  }
+
+public:
+  OrderedExecutor(
+      const Cmp& cmp, const NhFunc& nh_func, const OpFunc& op_func,
+      const StableTest& stable_test, const char* loopname)
+      : heap_cmp_{cmp},
+        nh_func_(nh_func),
+        op_func_(op_func),
+        stable_test_(stable_test),
+        loopname_(loopname) {}
+
+  template <typename Iter>
+  void Run(Iter begin, Iter end) {
+    std::vector<T> initial(begin, end);
+    size_t num_pending = initial.size();
+    Distribute(initial);
+
+    size_t min_window_size = getActiveThreads();
+    window_size_ = min_window_size * kWindowPerThread;
+
+    size_t rounds = 0;
+    while (num_pending > 0) {
+      FillWindow();
+      MarkSources();
+      CommitSources();
+      AdaptWindow(EndRound(&num_pending), min_window_size);
+      ++rounds;
+    }
+
+    ReportStats(rounds);
+  }
+};
+
+}  // namespace internal
 
 template <
     typename Iter, typename Cmp, typename NhFunc, typename OpFunc,
     typename StableTest>
 void
 for_each_ordered_impl(
-    [[maybe_unused]] Iter beg, [[maybe_unused]] Iter end,
-    [[maybe_unused]] const Cmp& cmp, [[maybe_unused]] const NhFunc& nhFunc,
-    [[maybe_unused]] const OpFunc& opFunc,
-    [[maybe_unused]] const StableTest& stabilityTest,
-    [[maybe_unused]] const char* loopname) {
-  KATANA_DIE("not yet implemented");
+    Iter beg, Iter end, const Cmp& cmp, const NhFunc& nhFunc,
+    const OpFunc& opFunc, const StableTest& stabilityTest,
+    const char* loopname) {
+  using T = typename std::iterator_traits<Iter>::value_type;
+
+  internal::OrderedExecutor<T, Cmp, NhFunc, OpFunc, StableTest> executor(
+      cmp, nhFunc, opFunc, stabilityTest, loopname);
+  executor.Run(beg, end);
+}
+
+template <typename Iter, typename Cmp, typename NhFunc, typename OpFunc>
+void
+for_each_ordered_impl(
+    Iter beg, Iter end, const Cmp& cmp, const NhFunc& nhFunc,
+    const OpFunc& opFunc, const char* loopname) {
+  // Tasks of stable source algorithms stay sources once they are sources
+  for_each_ordered_impl(
+      beg, end, cmp, nhFunc, opFunc, internal::AlwaysStable{}, loopname);
 }
 
 }  // end namespace katana
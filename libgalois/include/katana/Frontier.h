@@ -0,0 +1,271 @@
+#ifndef KATANA_LIBGALOIS_KATANA_FRONTIER_H_
+#define KATANA_LIBGALOIS_KATANA_FRONTIER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "katana/DynamicBitset.h"
+#include "katana/Loops.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// The active nodes of a round of a bulk-synchronous graph algorithm.
+///
+/// A frontier is either sparse, an array of the IDs of its nodes, or dense, a
+/// bitmap over all of the nodes of the graph. Sparse frontiers are cheaper to
+/// iterate over while they are small and dense ones once their nodes cover a
+/// sizable fraction of the edges of the graph, so EdgeMap switches between
+/// them as a frontier grows and shrinks (Shun and Blelloch, "Ligra: A
+/// Lightweight Graph Processing Framework for Shared Memory", PPoPP 2013).
+class KATANA_EXPORT Frontier {
+public:
+  /// A frontier whose nodes account for more than 1/kDenseDivisor of the
+  /// edges (EdgeMap) or of the nodes (Filter) of the graph is made dense
+  static const uint32_t kDenseDivisor = 20;
+
+  /// An empty frontier of a graph with \param num_nodes nodes
+  explicit Frontier(uint32_t num_nodes = 0) : num_nodes_(num_nodes) {}
+
+  /// A sparse frontier of \param nodes, which must be distinct
+  static Frontier FromNodes(uint32_t num_nodes, std::vector<uint32_t> nodes);
+
+  /// A dense frontier of every node
+  static Frontier All(uint32_t num_nodes);
+
+  uint32_t num_nodes() const { return num_nodes_; }
+  /// The number of nodes in the frontier
+  uint64_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool is_dense() const { return is_dense_; }
+
+  /// The nodes of a sparse frontier, in no particular order
+  const std::vector<uint32_t>& nodes() const { return nodes_; }
+  /// The bitmap of a dense frontier
+  const DynamicBitset& bitmap() const { return bitmap_; }
+
+  /// Return whether \param node is in the frontier, which must be dense
+  bool Contains(uint32_t node) const { return bitmap_.test(node); }
+
+  /// Convert the frontier to its dense form; do not call in a parallel region
+  void ToDense();
+  /// Convert the frontier to its sparse form, with its nodes in ascending
+  /// order; do not call in a parallel region
+  void ToSparse();
+
+  /// Call fn(node) for every node of the frontier in parallel (VertexMap)
+  template <typename F>
+  void Map(const F& fn, const char* loopname = "VertexMap") const;
+
+  /// Return the frontier of the nodes of this one for which pred(node) is
+  /// true (VertexFilter). pred is called once for every node, in parallel.
+  template <typename P>
+  Frontier Filter(const P& pred, const char* loopname = "VertexFilter") const;
+
+private:
+  friend class FrontierBuilder;
+
+  uint32_t num_nodes_;
+  uint64_t size_{0};
+  bool is_dense_{false};
+  std::vector<uint32_t> nodes_;
+  DynamicBitset bitmap_;
+};
+
+/// Collects the nodes of the next frontier from a parallel loop.
+class KATANA_EXPORT FrontierBuilder {
+public:
+  /// Build a frontier of a graph with \param num_nodes nodes in its dense
+  /// form if \param dense and in its sparse form otherwise
+  FrontierBuilder(uint32_t num_nodes, bool dense);
+
+  FrontierBuilder(const FrontierBuilder&) = delete;
+  FrontierBuilder& operator=(const FrontierBuilder&) = delete;
+
+  /// Add \param node to the frontier. May be called concurrently, but a
+  /// sparse frontier must be given each node at most once.
+  void Add(uint32_t node) {
+    if (dense_) {
+      bitmap_.set(node);
+    } else {
+      nodes_.getLocal()->push_back(node);
+    }
+  }
+
+  /// Return the frontier of the added nodes; do not call in a parallel region
+  Frontier Finish();
+
+private:
+  uint32_t num_nodes_;
+  bool dense_;
+  DynamicBitset bitmap_;
+  PerThreadStorage<std::vector<uint32_t>> nodes_;
+};
+
+/// The direction in which EdgeMap traverses edges
+enum class EdgeMapDirection {
+  /// Push from sparse frontiers and pull into dense ones
+  kAuto = 0,
+  /// Always push along the out-edges of the frontier
+  kPush,
+  /// Always pull along the in-edges of every node
+  kPull,
+};
+
+struct EdgeMapOptions {
+  EdgeMapDirection direction{EdgeMapDirection::kAuto};
+  /// Whether the in-edges of every node are its out-edges, i.e., the graph is
+  /// symmetric. Directed graphs have no in-edges to pull along, so EdgeMap
+  /// pushes from every node of a dense frontier instead.
+  bool symmetric{false};
+  /// Make the frontier dense when its size plus out-degree exceeds the number
+  /// of edges divided by this
+  uint32_t dense_divisor{Frontier::kDenseDivisor};
+  /// The chunk size of the loops over the frontier
+  unsigned chunk_size{katana::chunk_size<>::value};
+  const char* loopname{"EdgeMap"};
+};
+
+namespace internal {
+
+/// Return the number of out-edges of the nodes of frontier
+template <typename Graph>
+uint64_t
+OutDegree(const Graph& graph, const Frontier& frontier) {
+  GAccumulator<uint64_t> out_degree;
+  auto add = [&](uint32_t node) { out_degree += graph.edges(node).size(); };
+  if (frontier.is_dense()) {
+    do_all(
+        iterate(uint32_t{0}, frontier.num_nodes()),
+        [&](uint32_t node) {
+          if (frontier.Contains(node)) {
+            add(node);
+          }
+        },
+        no_stats());
+  } else {
+    do_all(iterate(frontier.nodes()), add, no_stats());
+  }
+  return out_degree.reduce();
+}
+
+}  // namespace internal
+
+/// Call update(src, dst, edge) for the edges out of \param frontier whose
+/// destination satisfies cond(dst) and return the frontier of the
+/// destinations for which update returned true (EdgeMap).
+///
+/// update may be called concurrently for the same destination and, when the
+/// next frontier is sparse, must return true at most once for each of them,
+/// e.g., by claiming the destination with a compare-and-swap. When pulling,
+/// the in-edges of each destination are visited only while cond(dst) holds,
+/// so cond should become false once a destination needs no more updates, and
+/// edge is the reverse edge (dst, src). The frontier may be converted between
+/// its dense and sparse forms.
+template <typename Graph, typename Update, typename Cond>
+Frontier
+EdgeMap(
+    const Graph& graph, Frontier* frontier, const Update& update,
+    const Cond& cond, const EdgeMapOptions& options = {}) {
+  bool dense = false;
+  switch (options.direction) {
+  case EdgeMapDirection::kPush:
+    break;
+  case EdgeMapDirection::kPull:
+    dense = true;
+    break;
+  default:
+    dense = frontier->size() + internal::OutDegree(graph, *frontier) >
+            graph.num_edges() / options.dense_divisor;
+  }
+
+  uint32_t num_nodes = frontier->num_nodes();
+  FrontierBuilder next(num_nodes, dense);
+  auto push = [&](uint32_t src) {
+    for (auto edge : graph.edges(src)) {
+      uint32_t dst = *graph.GetEdgeDest(edge);
+      if (cond(dst) && update(src, dst, edge)) {
+        next.Add(dst);
+      }
+    }
+  };
+
+  if (!dense) {
+    frontier->ToSparse();
+    do_all(
+        iterate(frontier->nodes()), push, steal(),
+        katana::chunk_size<>(options.chunk_size), loopname(options.loopname));
+    return next.Finish();
+  }
+
+  frontier->ToDense();
+  if (options.symmetric) {
+    do_all(
+        iterate(uint32_t{0}, num_nodes),
+        [&](uint32_t dst) {
+          for (auto edge : graph.edges(dst)) {
+            if (!cond(dst)) {
+              return;
+            }
+            uint32_t src = *graph.GetEdgeDest(edge);
+            if (frontier->Contains(src) && update(src, dst, edge)) {
+              next.Add(dst);
+            }
+          }
+        },
+        steal(), katana::chunk_size<>(options.chunk_size),
+        loopname(options.loopname));
+  } else {
+    do_all(
+        iterate(uint32_t{0}, num_nodes),
+        [&](uint32_t src) {
+          if (frontier->Contains(src)) {
+            push(src);
+          }
+        },
+        steal(), katana::chunk_size<>(options.chunk_size),
+        loopname(options.loopname));
+  }
+  return next.Finish();
+}
+
+template <typename F>
+void
+Frontier::Map(const F& fn, const char* loopname) const {
+  if (is_dense_) {
+    do_all(
+        iterate(uint32_t{0}, num_nodes_),
+        [&](uint32_t node) {
+          if (bitmap_.test(node)) {
+            fn(node);
+          }
+        },
+        steal(), katana::loopname(loopname));
+  } else {
+    do_all(iterate(nodes_), fn, steal(), katana::loopname(loopname));
+  }
+}
+
+template <typename P>
+Frontier
+Frontier::Filter(const P& pred, const char* loopname) const {
+  FrontierBuilder next(num_nodes_, is_dense_);
+  Map(
+      [&](uint32_t node) {
+        if (pred(node)) {
+          next.Add(node);
+        }
+      },
+      loopname);
+  Frontier filtered = next.Finish();
+  if (filtered.is_dense() && filtered.size() <= num_nodes_ / kDenseDivisor) {
+    filtered.ToSparse();
+  }
+  return filtered;
+}
+
+}  // namespace katana
+
+#endif
@@ -42,6 +42,8 @@ struct KATANA_EXPORT MachineTopoInfo {
   unsigned maxCores;
   unsigned maxSockets;
   unsigned maxNumaNodes;
+  unsigned hostThreads;      // threads of the machine before cpuset and quota
+  unsigned cpuQuotaThreads;  // CPUs the cgroup CPU quota allows, 0 if no quota
 };
 
 struct KATANA_EXPORT HWTopoInfo {
@@ -52,8 +54,19 @@ struct KATANA_EXPORT HWTopoInfo {
 /**
  * getHWTopo determines the machine topology from the process information
  * exposed in /proc and /dev filesystems.
+ *
+ * The topology is the one effective for this process: only the CPUs in its
+ * cpuset are included and, if its cgroup (e.g., a container) has a CPU quota,
+ * only as many threads as the quota allows CPUs, so that a pool with
+ * maxThreads threads never oversubscribes its CPU time. CPUs whose NUMA node
+ * the process may not allocate memory on are attributed to the nearest node
+ * it may allocate on.
+ *
+ * The topology is computed once per process. If KATANA_HWTOPO_CACHE is set,
+ * the parse of /proc/cpuinfo and NUMA information is also cached in that
+ * file and reused by later processes until the machine reboots.
  */
-KATANA_EXPORT HWTopoInfo getHWTopo();
+KATANA_EXPORT const HWTopoInfo& getHWTopo();
 
 /**
  * parseCPUList parses cpuset information in "List format" as described in
@@ -61,6 +74,21 @@ KATANA_EXPORT HWTopoInfo getHWTopo();
  */
 KATANA_EXPORT std::vector<int> parseCPUList(const std::string& in);
 
+/**
+ * parseCgroupCPUMax parses the contents of a cgroup v2 cpu.max file, "$MAX
+ * $PERIOD", and returns the number of CPUs the quota allows, rounded up, or 0
+ * if there is no quota
+ */
+KATANA_EXPORT unsigned parseCgroupCPUMax(const std::string& in);
+
+/**
+ * parseCgroupCFSQuota parses the contents of the cgroup v1 cpu.cfs_quota_us
+ * and cpu.cfs_period_us files and returns the number of CPUs the quota
+ * allows, rounded up, or 0 if there is no quota
+ */
+KATANA_EXPORT unsigned parseCgroupCFSQuota(
+    const std::string& quota, const std::string& period);
+
 /**
  * bindThreadSelf binds a thread to an osContext as returned by getHWTopo.
  */
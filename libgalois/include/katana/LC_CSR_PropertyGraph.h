@@ -0,0 +1,270 @@
+#ifndef KATANA_LIBGALOIS_KATANA_LCCSRPROPERTYGRAPH_H_
+#define KATANA_LIBGALOIS_KATANA_LCCSRPROPERTYGRAPH_H_
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "katana/Details.h"
+#include "katana/Loops.h"
+#include "katana/MethodFlags.h"
+#include "katana/Properties.h"
+#include "katana/PropertyFileGraph.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Result.h"
+
+namespace katana {
+
+namespace internal {
+
+/// The type returned by LC_CSR_PropertyGraph::getData and getEdgeData for a
+/// tuple of properties: a reference to the value of a single property, or a
+/// tuple of references for any other number of properties.
+template <typename Props>
+struct CSRPropertyDataTypes;
+
+template <typename... Props>
+struct CSRPropertyDataTypes<std::tuple<Props...>> {
+  using reference = std::tuple<PropertyReferenceType<Props>...>;
+};
+
+template <typename Prop>
+struct CSRPropertyDataTypes<std::tuple<Prop>> {
+  using reference = PropertyReferenceType<Prop>;
+};
+
+}  // namespace internal
+
+/// An LC_CSR_Graph-compatible view of a PropertyFileGraph, for code written
+/// against the LC_CSR_Graph API (edge_begin, getEdgeDst, getData, getEdgeData,
+/// sortAllEdgesByDst, ...).
+///
+/// Nothing is copied: the topology is read from the arrow arrays of the
+/// PropertyFileGraph and node and edge data are references into the property
+/// arrays, as in PropertyGraph. The node data of LC_CSR_Graph becomes the
+/// tuple of properties NodeProps: with one property, getData(n) returns a
+/// reference to its value, and with several, a tuple of references, so that
+///
+///   auto [rank, degree] = graph.getData(n);
+///
+/// binds to the properties of n. Edge data works the same way with
+/// EdgeProps.
+///
+/// The view does not own the PropertyFileGraph, and it has no locks, so it
+/// behaves like an LC_CSR_Graph with no lockable and method flags are
+/// accepted but ignored.
+///
+/// \tparam NodeProps A tuple of property types (\ref Properties.h) for nodes
+/// \tparam EdgeProps A tuple of property types for edges
+template <typename NodeProps, typename EdgeProps>
+class LC_CSR_PropertyGraph {
+  using Graph = PropertyGraph<NodeProps, EdgeProps>;
+
+  Graph graph_;
+  PropertyViewType<UInt32Property> dests_;
+
+  LC_CSR_PropertyGraph(Graph graph, PropertyViewType<UInt32Property> dests)
+      : graph_(std::move(graph)), dests_(std::move(dests)) {}
+
+public:
+  template <bool>
+  struct with_no_lockable {
+    using type = LC_CSR_PropertyGraph;
+  };
+
+  template <bool>
+  struct with_numa_alloc {
+    using type = LC_CSR_PropertyGraph;
+  };
+
+  using GraphNode = GraphTopology::Node;
+  using node_properties = NodeProps;
+  using edge_properties = EdgeProps;
+  using node_data_reference =
+      typename internal::CSRPropertyDataTypes<NodeProps>::reference;
+  using edge_data_reference =
+      typename internal::CSRPropertyDataTypes<EdgeProps>::reference;
+  using edge_iterator = GraphTopology::edge_iterator;
+  using edges_iterator = StandardRange<NoDerefIterator<edge_iterator>>;
+  using iterator = GraphTopology::node_iterator;
+  using const_iterator = iterator;
+  using local_iterator = iterator;
+  using const_local_iterator = iterator;
+
+  /// Make a view of pfg with the named node and edge properties, which must
+  /// match NodeProps and EdgeProps.
+  static Result<LC_CSR_PropertyGraph> Make(
+      PropertyFileGraph* pfg, const std::vector<std::string>& node_properties,
+      const std::vector<std::string>& edge_properties) {
+    auto graph_result = Graph::Make(pfg, node_properties, edge_properties);
+    if (!graph_result) {
+      return graph_result.error();
+    }
+    auto dests_result = ConstructPropertyView<UInt32Property>(
+        pfg->topology().out_dests.get());
+    if (!dests_result) {
+      return dests_result.error();
+    }
+    return LC_CSR_PropertyGraph(
+        std::move(graph_result.value()), std::move(dests_result.value()));
+  }
+
+  /// Make a view of pfg with all of its properties.
+  static Result<LC_CSR_PropertyGraph> Make(PropertyFileGraph* pfg) {
+    return Make(
+        pfg, pfg->node_schema()->field_names(),
+        pfg->edge_schema()->field_names());
+  }
+
+  node_data_reference getData(GraphNode N, MethodFlag = MethodFlag::WRITE) {
+    return NodeData(N, static_cast<NodeProps*>(nullptr));
+  }
+
+  edge_data_reference getEdgeData(
+      edge_iterator ni, MethodFlag = MethodFlag::UNPROTECTED) {
+    return EdgeData(ni, static_cast<EdgeProps*>(nullptr));
+  }
+
+  GraphNode getEdgeDst(edge_iterator ni) const { return dests_[*ni]; }
+
+  size_t size() const { return graph_.size(); }
+  size_t sizeEdges() const { return graph_.num_edges(); }
+
+  uint64_t num_nodes() const { return graph_.num_nodes(); }
+  uint64_t num_edges() const { return graph_.num_edges(); }
+
+  iterator begin() const { return graph_.begin(); }
+  iterator end() const { return graph_.end(); }
+
+  edge_iterator edge_begin(GraphNode N, MethodFlag = MethodFlag::WRITE) const {
+    return graph_.edge_begin(N);
+  }
+
+  edge_iterator edge_end(GraphNode N, MethodFlag = MethodFlag::WRITE) const {
+    return graph_.edge_end(N);
+  }
+
+  auto getDegree(GraphNode N) const {
+    return std::distance(edge_begin(N), edge_end(N));
+  }
+
+  edges_iterator edges(GraphNode N, MethodFlag = MethodFlag::WRITE) const {
+    return internal::make_no_deref_range(edge_begin(N), edge_end(N));
+  }
+
+  edges_iterator out_edges(
+      GraphNode N, MethodFlag mflag = MethodFlag::WRITE) const {
+    return edges(N, mflag);
+  }
+
+  edge_iterator findEdge(GraphNode N1, GraphNode N2) const {
+    return std::find_if(edge_begin(N1), edge_end(N1), [=](edge_iterator e) {
+      return getEdgeDst(e) == N2;
+    });
+  }
+
+  edge_iterator findEdgeSortedByDst(GraphNode N1, GraphNode N2) const {
+    auto e = std::lower_bound(
+        edge_begin(N1), edge_end(N1), N2,
+        [=](edge_iterator e, GraphNode N) { return getEdgeDst(e) < N; });
+    return (e != edge_end(N1) && getEdgeDst(e) == N2) ? e : edge_end(N1);
+  }
+
+  /**
+   * Sorts outgoing edges of a node by getEdgeDst(e), moving their edge
+   * properties with them. The sort is stable.
+   */
+  void sortEdgesByDst(GraphNode N, MethodFlag = MethodFlag::WRITE) {
+    uint64_t begin = *edge_begin(N);
+    uint64_t end = *edge_end(N);
+    auto by_dest = [&](uint64_t a, uint64_t b) {
+      return dests_[a] < dests_[b];
+    };
+
+    std::vector<uint64_t> order(end - begin);
+    std::iota(order.begin(), order.end(), begin);
+    if (std::is_sorted(order.begin(), order.end(), by_dest)) {
+      return;
+    }
+    std::stable_sort(order.begin(), order.end(), by_dest);
+
+    Permute(begin, order, [&](uint64_t e) -> uint32_t& { return dests_[e]; });
+    PermuteEdgeData(begin, order, static_cast<EdgeProps*>(nullptr));
+  }
+
+  /**
+   * Sorts all outgoing edges of all nodes in parallel. Comparison is over
+   * getEdgeDst(e). Like SortAllEdgesByDest, this clears the GraphProfile
+   * stored with the graph.
+   */
+  void sortAllEdgesByDst(MethodFlag mflag = MethodFlag::WRITE) {
+    katana::do_all(
+        katana::iterate(size_t{0}, this->size()),
+        [=](GraphNode N) { this->sortEdgesByDst(N, mflag); },
+        katana::no_stats(), katana::steal());
+    graph_.GetPropertyFileGraph().set_graph_profile({});
+  }
+
+  /// Accessor for the typed view this view is built on.
+  Graph& GetPropertyGraph() { return graph_; }
+
+  /// Accessor for the underlying PropertyFileGraph.
+  const PropertyFileGraph& GetPropertyFileGraph() const {
+    return graph_.GetPropertyFileGraph();
+  }
+
+private:
+  template <typename... Props>
+  node_data_reference NodeData(GraphNode N, std::tuple<Props...>*) {
+    if constexpr (sizeof...(Props) == 1) {
+      return graph_.template GetData<Props...>(N);
+    } else {
+      return node_data_reference(graph_.template GetData<Props>(N)...);
+    }
+  }
+
+  template <typename... Props>
+  edge_data_reference EdgeData(edge_iterator ni, std::tuple<Props...>*) {
+    if constexpr (sizeof...(Props) == 1) {
+      return graph_.template GetEdgeData<Props...>(ni);
+    } else {
+      return edge_data_reference(graph_.template GetEdgeData<Props>(ni)...);
+    }
+  }
+
+  /// Move the value at order[i] to begin + i for each i, where value(e) is a
+  /// reference to the value of edge e.
+  template <typename ValueFn>
+  static void Permute(
+      uint64_t begin, const std::vector<uint64_t>& order,
+      const ValueFn& value) {
+    using Value = std::decay_t<decltype(value(begin))>;
+    std::vector<Value> values;
+    values.reserve(order.size());
+    for (uint64_t e : order) {
+      values.emplace_back(value(e));
+    }
+    for (size_t i = 0; i < values.size(); ++i) {
+      value(begin + i) = values[i];
+    }
+  }
+
+  template <typename... Props>
+  void PermuteEdgeData(
+      uint64_t begin, const std::vector<uint64_t>& order,
+      std::tuple<Props...>*) {
+    (Permute(
+         begin, order,
+         [&](uint64_t e) -> PropertyReferenceType<Props> {
+           return graph_.template GetEdgeData<Props>(edge_iterator(e));
+         }),
+     ...);
+  }
+};
+
+}  // namespace katana
+
+#endif
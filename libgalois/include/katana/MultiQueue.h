@@ -0,0 +1,326 @@
+#ifndef KATANA_LIBGALOIS_KATANA_MULTIQUEUE_H_
+#define KATANA_LIBGALOIS_KATANA_MULTIQUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include "katana/PaddedLock.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Statistics.h"
+#include "katana/ThreadPool.h"
+#include "katana/Threads.h"
+#include "katana/WLCompileCheck.h"
+#include "katana/WorkListHelpers.h"
+#include "katana/config.h"
+#include "katana/optional.h"
+
+namespace katana {
+
+/**
+ * Relaxed priority scheduling with a MultiQueue. Indexer is a
+ * default-constructable class whose instances conform to <code>R r =
+ * indexer(item)</code> where R is any trivially copyable type ordered by
+ * <code>operator&lt;</code>, e.g., a floating point distance.
+ *
+ * There are QueuesPerThread sequential heaps per active thread, each behind
+ * its own lock. A push goes to a random heap. A pop looks at the tops of two
+ * random heaps and takes the earlier one. Unlike \ref OrderedByIntegerMetric,
+ * there are no buckets to tune; the price is that a pop may return an item
+ * that is not the globally earliest one.
+ *
+ * On destruction, the worklist reports under "MultiQueue":
+ * - Pops and Pushes
+ * - EmptyPops: pops that found no work
+ * - LockRetries: push or pop attempts that found a heap locked
+ * - RankErrorSamples, RankErrorTotal and RankErrorMax: for a sample of pops,
+ *   the number of heaps whose top was strictly earlier than the popped item,
+ *   a lower bound on its rank error
+ *
+ * An example:
+ * \code
+ * struct Indexer {
+ *   float operator()(const Request& r) const { return r.dist; }
+ * };
+ *
+ * katana::for_each(
+ *     katana::iterate(items), Fn, katana::wl<katana::MultiQueue<Indexer>>());
+ * \endcode
+ *
+ * @tparam Indexer         Indexer class
+ * @tparam QueuesPerThread Number of heaps per active thread
+ * @tparam UseDescending   Pop the latest item instead of the earliest
+ */
+template <
+    class Indexer = DummyIndexer<int>, unsigned QueuesPerThread = 2,
+    bool UseDescending = false, typename T = int, typename Index = int,
+    bool Concurrent = true>
+class MultiQueue : private boost::noncopyable {
+  static_assert(QueuesPerThread > 0, "need at least one queue per thread");
+
+public:
+  template <typename _T>
+  using retype = MultiQueue<
+      Indexer, QueuesPerThread, UseDescending, _T,
+      std::decay_t<typename std::result_of<Indexer(_T)>::type>, Concurrent>;
+
+  template <bool _b>
+  using rethread =
+      MultiQueue<Indexer, QueuesPerThread, UseDescending, T, Index, _b>;
+
+  template <typename _indexer>
+  struct with_indexer {
+    typedef MultiQueue<
+        _indexer, QueuesPerThread, UseDescending, T, Index, Concurrent>
+        type;
+  };
+
+  template <unsigned _queues_per_thread>
+  struct with_queues_per_thread {
+    typedef MultiQueue<
+        Indexer, _queues_per_thread, UseDescending, T, Index, Concurrent>
+        type;
+  };
+
+  template <bool _use_descending>
+  struct with_descending {
+    typedef MultiQueue<
+        Indexer, QueuesPerThread, _use_descending, T, Index, Concurrent>
+        type;
+  };
+
+  typedef T value_type;
+  typedef Index index_type;
+
+  static_assert(
+      std::is_trivially_copyable_v<index_type>,
+      "MultiQueue priorities must be trivially copyable");
+
+private:
+  //! Sample the rank error of one in every kRankErrorPeriod pops of a thread
+  constexpr static unsigned kRankErrorPeriod = 64;
+
+  struct Entry {
+    index_type priority;
+    T item;
+  };
+
+  struct alignas(KATANA_CACHE_LINE_SIZE) Queue {
+    PaddedLock<Concurrent> lock;
+    std::vector<Entry> heap;
+    //! Copies of the top priority and size that can be read without the lock
+    std::atomic<index_type> top{};
+    std::atomic<size_t> size{0};
+  };
+
+  struct ThreadData {
+    uint64_t random_state{1};
+    size_t pushes{0};
+    size_t pops{0};
+    size_t empty_pops{0};
+    size_t lock_retries{0};
+    size_t rank_error_samples{0};
+    size_t rank_error_total{0};
+    size_t rank_error_max{0};
+
+    //! A random index in [0, n) from an xorshift generator
+    size_t Next(size_t n) {
+      random_state ^= random_state << 13;
+      random_state ^= random_state >> 7;
+      random_state ^= random_state << 17;
+      return random_state % n;
+    }
+  };
+
+  static bool Before(const index_type& a, const index_type& b) {
+    return UseDescending ? b < a : a < b;
+  }
+
+  struct HeapCmp {
+    bool operator()(const Entry& a, const Entry& b) const {
+      return Before(b.priority, a.priority);
+    }
+  };
+
+  size_t num_queues_;
+  std::unique_ptr<Queue[]> queues_;
+  PerThreadStorage<ThreadData> data_;
+  Indexer indexer_;
+
+  static void UpdateTop(Queue& q) {
+    if (!q.heap.empty()) {
+      q.top.store(q.heap.front().priority, std::memory_order_relaxed);
+    }
+    q.size.store(q.heap.size(), std::memory_order_release);
+  }
+
+  //! Pops from q, which must be locked and not empty, and unlocks it
+  T PopLocked(Queue& q, ThreadData& p) {
+    std::pop_heap(q.heap.begin(), q.heap.end(), HeapCmp());
+    Entry e = std::move(q.heap.back());
+    q.heap.pop_back();
+    UpdateTop(q);
+    q.lock.unlock();
+
+    if (++p.pops % kRankErrorPeriod == 0) {
+      SampleRankError(e.priority, p);
+    }
+    return std::move(e.item);
+  }
+
+  void SampleRankError(const index_type& priority, ThreadData& p) {
+    size_t error = 0;
+    for (size_t i = 0; i < num_queues_; ++i) {
+      Queue& q = queues_[i];
+      if (q.size.load(std::memory_order_acquire) &&
+          Before(q.top.load(std::memory_order_relaxed), priority)) {
+        ++error;
+      }
+    }
+    ++p.rank_error_samples;
+    p.rank_error_total += error;
+    p.rank_error_max = std::max(p.rank_error_max, error);
+  }
+
+  //! Pick the earlier of two random queues, up to num_queues_ times
+  katana::optional<value_type> RandomPop(ThreadData& p) {
+    for (size_t attempt = 0; attempt < num_queues_; ++attempt) {
+      Queue* a = &queues_[p.Next(num_queues_)];
+      Queue* b = &queues_[p.Next(num_queues_)];
+      bool has_a = a->size.load(std::memory_order_acquire) != 0;
+      bool has_b = b->size.load(std::memory_order_acquire) != 0;
+      if (!has_a && !has_b) {
+        continue;
+      }
+      Queue* q = a;
+      if (!has_a ||
+          (has_b && Before(
+                        b->top.load(std::memory_order_relaxed),
+                        a->top.load(std::memory_order_relaxed)))) {
+        q = b;
+      }
+      if (!q->lock.try_lock()) {
+        ++p.lock_retries;
+        continue;
+      }
+      if (q->heap.empty()) {
+        q->lock.unlock();
+        continue;
+      }
+      return PopLocked(*q, p);
+    }
+    return katana::optional<value_type>();
+  }
+
+  //! Look at every queue so that a pop only fails when there is no work
+  KATANA_ATTRIBUTE_NOINLINE
+  katana::optional<value_type> ScanPop(ThreadData& p) {
+    size_t start = p.Next(num_queues_);
+    for (size_t i = 0; i < num_queues_; ++i) {
+      Queue& q = queues_[(start + i) % num_queues_];
+      if (!q.size.load(std::memory_order_acquire)) {
+        continue;
+      }
+      q.lock.lock();
+      if (q.heap.empty()) {
+        q.lock.unlock();
+        continue;
+      }
+      return PopLocked(q, p);
+    }
+    ++p.empty_pops;
+    return katana::optional<value_type>();
+  }
+
+  void ReportStats() {
+    size_t pushes = 0;
+    size_t pops = 0;
+    size_t empty_pops = 0;
+    size_t lock_retries = 0;
+    size_t rank_error_samples = 0;
+    size_t rank_error_total = 0;
+    size_t rank_error_max = 0;
+    for (unsigned i = 0; i < data_.size(); ++i) {
+      const ThreadData& p = *data_.getRemote(i);
+      pushes += p.pushes;
+      pops += p.pops;
+      empty_pops += p.empty_pops;
+      lock_retries += p.lock_retries;
+      rank_error_samples += p.rank_error_samples;
+      rank_error_total += p.rank_error_total;
+      rank_error_max = std::max(rank_error_max, p.rank_error_max);
+    }
+    if (!pushes) {
+      return;
+    }
+    ReportStatSingle("MultiQueue", "Pushes", pushes);
+    ReportStatSingle("MultiQueue", "Pops", pops);
+    ReportStatSingle("MultiQueue", "EmptyPops", empty_pops);
+    ReportStatSingle("MultiQueue", "LockRetries", lock_retries);
+    ReportStatSingle("MultiQueue", "RankErrorSamples", rank_error_samples);
+    ReportStatSingle("MultiQueue", "RankErrorTotal", rank_error_total);
+    ReportStatSingle("MultiQueue", "RankErrorMax", rank_error_max);
+  }
+
+public:
+  MultiQueue(const Indexer& x = Indexer())
+      : num_queues_(
+            size_t{QueuesPerThread} * (Concurrent ? getActiveThreads() : 1)),
+        queues_(std::make_unique<Queue[]>(num_queues_)),
+        indexer_(x) {
+    for (unsigned i = 0; i < data_.size(); ++i) {
+      // Any odd seed works for xorshift
+      data_.getRemote(i)->random_state = 2 * i + 0x9E3779B97F4A7C15ULL;
+    }
+  }
+
+  ~MultiQueue() { ReportStats(); }
+
+  void push(const value_type& val) {
+    ThreadData& p = *data_.getLocal();
+    Entry e{indexer_(val), val};
+    for (;;) {
+      Queue& q = queues_[p.Next(num_queues_)];
+      if (!q.lock.try_lock()) {
+        ++p.lock_retries;
+        continue;
+      }
+      q.heap.emplace_back(std::move(e));
+      std::push_heap(q.heap.begin(), q.heap.end(), HeapCmp());
+      UpdateTop(q);
+      q.lock.unlock();
+      break;
+    }
+    ++p.pushes;
+  }
+
+  template <typename Iter>
+  void push(Iter b, Iter e) {
+    while (b != e)
+      push(*b++);
+  }
+
+  template <typename RangeTy>
+  void push_initial(const RangeTy& range) {
+    push(range.local_begin(), range.local_end());
+  }
+
+  katana::optional<value_type> pop() {
+    ThreadData& p = *data_.getLocal();
+    katana::optional<value_type> item = RandomPop(p);
+    if (item) {
+      return item;
+    }
+    return ScanPop(p);
+  }
+};
+KATANA_WLCOMPILECHECK(MultiQueue)
+
+}  // end namespace katana
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PARTITIONGRAPH_H_
+#define KATANA_LIBGALOIS_KATANA_PARTITIONGRAPH_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// How PartitionGraph assigns edges to partitions. The values are stored as
+/// the policy ID of the partitioned RDG, where zero means not partitioned.
+enum class PartitionPolicy : uint32_t {
+  /// An edge belongs to the partition that owns its source
+  kOutgoingEdgeCut = 1,
+  /// An edge belongs to the partition that owns its destination
+  kIncomingEdgeCut = 2,
+  /// Partitions form a rows x columns grid, and an edge belongs to the
+  /// partition in the row of the owner of its source and the column of the
+  /// owner of its destination
+  kCartesianVertexCut = 3,
+};
+
+/// Split \param pfg into \param num_partitions property graphs, one per host
+/// of a distributed computation.
+///
+/// Every node is owned (mastered) by one partition. Owners are assigned in
+/// contiguous ranges of node IDs that balance the number of edges, counting
+/// out-edges for outgoing edge-cuts and Cartesian vertex-cuts and in-edges for
+/// incoming edge-cuts. Each edge is assigned to a partition by \param policy.
+/// A partition holds its masters followed by mirrors, the nodes owned by other
+/// partitions that are endpoints of its edges, in increasing global ID order.
+///
+/// Each partition has the node and edge properties of its nodes and edges,
+/// its local_to_global_vector(), filled in partition metadata, and
+/// master_nodes() and mirror_nodes() with one array per partition:
+/// mirror_nodes()[h] is the global IDs of the mirrors owned by h and
+/// master_nodes()[h] is the global IDs of the masters mirrored on h.
+///
+/// The result can be written with PropertyFileGraph::WritePartitions.
+KATANA_EXPORT Result<std::vector<std::unique_ptr<PropertyFileGraph>>>
+PartitionGraph(
+    PropertyFileGraph* pfg, uint32_t num_partitions, PartitionPolicy policy);
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef KATANA_LIBGALOIS_KATANA_PERFCOUNTERS_H_
+#define KATANA_LIBGALOIS_KATANA_PERFCOUNTERS_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// Hardware events counted by PerfCounterScope
+enum class PerfEvent {
+  kCycles,
+  kInstructions,
+  kLLCMisses,
+  kDTLBMisses,
+  /// Last level cache misses served by the memory of another NUMA node
+  kRemoteDRAMAccesses,
+};
+
+constexpr int kNumPerfEvents = 5;
+
+/// Counts of hardware events, with a flag for each event that the processor
+/// and kernel support.
+struct KATANA_EXPORT PerfCounts {
+  std::array<uint64_t, kNumPerfEvents> values{};
+  std::array<bool, kNumPerfEvents> valid{};
+
+  uint64_t operator[](PerfEvent e) const {
+    return values[static_cast<int>(e)];
+  }
+  bool IsValid(PerfEvent e) const { return valid[static_cast<int>(e)]; }
+
+  PerfCounts& operator+=(const PerfCounts& other);
+  PerfCounts& operator-=(const PerfCounts& other);
+};
+
+/// Return true if hardware counters are enabled, i.e., if the environment
+/// variable KATANA_PERF_COUNTERS is set. Counters are read with the Linux
+/// perf_event_open system call, so they need no special build, but the
+/// kernel may refuse them, e.g., because of
+/// /proc/sys/kernel/perf_event_paranoid, in which case a warning is logged
+/// and nothing is counted.
+KATANA_EXPORT bool PerfCountersEnabled();
+
+/// Counts the hardware events of the calling thread, an active thread of a
+/// parallel loop, from construction to destruction. The parallel loops count
+/// each thread's part of the loop this way; the counts of all threads are
+/// read with PerfCounterRegion.
+class KATANA_EXPORT PerfCounterScope {
+public:
+  PerfCounterScope();
+  ~PerfCounterScope();
+
+  PerfCounterScope(const PerfCounterScope&) = delete;
+  PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+  PerfCounterScope(PerfCounterScope&&) = delete;
+  PerfCounterScope& operator=(PerfCounterScope&&) = delete;
+
+private:
+  bool enabled_;
+  std::array<uint64_t, kNumPerfEvents + 2> start_;
+};
+
+/// Reports through StatManager the hardware events counted by all threads in
+/// parallel loops between its construction and Stop, or its destruction.
+///
+/// The counts are reported under region as Cycles, Instructions, LLCMisses,
+/// DTLBMisses and RemoteDRAMAccesses, where available, together with IPC,
+/// the instructions per cycle. If Stop is given the number of edges processed,
+/// e.g., by a graph algorithm, the misses and cycles per edge are reported
+/// too, as LLCMissesPerEdge and so on. Named parallel loops report their
+/// counts this way under their loop name.
+///
+/// Ratios are of the totals over all regions with the same name, so a loop
+/// run once per round reports the IPC of all of its rounds.
+class KATANA_EXPORT PerfCounterRegion {
+public:
+  explicit PerfCounterRegion(const char* region);
+  ~PerfCounterRegion();
+
+  PerfCounterRegion(const PerfCounterRegion&) = delete;
+  PerfCounterRegion& operator=(const PerfCounterRegion&) = delete;
+  PerfCounterRegion(PerfCounterRegion&&) = delete;
+  PerfCounterRegion& operator=(PerfCounterRegion&&) = delete;
+
+  /// Stop counting and report the counts. num_edges, if non-zero, is the
+  /// number of edges processed in the region.
+  void Stop(uint64_t num_edges = 0);
+
+private:
+  std::string region_;
+  bool running_;
+  PerfCounts start_;
+};
+
+template <bool Enable>
+class CondPerfCounterRegion : public PerfCounterRegion {
+public:
+  explicit CondPerfCounterRegion(const char* region)
+      : PerfCounterRegion(region) {}
+};
+
+template <>
+class CondPerfCounterRegion<false> {
+public:
+  explicit CondPerfCounterRegion(const char*) {}
+
+  void Stop(uint64_t = 0) const {}
+};
+
+}  // namespace katana
+
+#endif
@@ -168,6 +168,25 @@ public:
       const std::vector<std::string>& node_properties,
       const std::vector<std::string>& edge_properties);
 
+  /// Make a property graph from the contiguous range of nodes [node_begin,
+  /// node_end) of an RDG. Only the parts of the topology and of the property
+  /// row groups that cover the range are read from storage.
+  ///
+  /// Nodes are renumbered to start from zero, so node n of the slice is node
+  /// node_begin + n of the RDG. Every out-edge of the slice is kept, including
+  /// those that leave it, so that slices loaded by different hosts together
+  /// cover every edge. The destinations outside the range become mirror nodes
+  /// of the slice, which follow its own nodes in increasing RDG ID order, like
+  /// the mirrors of PartitionGraph. Mirrors have no out-edges and null node
+  /// properties. local_to_global_vector() maps every node, mirrors included,
+  /// to its RDG node ID.
+  ///
+  /// \returns invalid_argument if the range is not within the graph
+  static Result<std::unique_ptr<PropertyFileGraph>> MakeSlice(
+      const std::string& rdg_name, uint64_t node_begin, uint64_t node_end,
+      const std::vector<std::string>& node_properties,
+      const std::vector<std::string>& edge_properties);
+
   /**
    * @return A copy of this with the same set of properties. The copy shares no
    *        state with this.
@@ -184,6 +203,38 @@ public:
       const std::vector<std::string>& node_properties,
       const std::vector<std::string>& edge_properties);
 
+  /// Make the subgraph induced by the nodes for which \param node_mask is
+  /// true, i.e., those nodes and the edges between them, with every node and
+  /// edge property.
+  ///
+  /// Nodes keep their relative order and are renumbered from zero, and edges
+  /// keep their order. The ID of each node in this graph is recorded in
+  /// local_to_global_vector() of the result; if this graph has a
+  /// local_to_global_vector() itself, the IDs it maps to are recorded
+  /// instead.
+  ///
+  /// \returns invalid_argument if node_mask does not have one entry per node
+  Result<std::unique_ptr<PropertyFileGraph>> InducedSubgraph(
+      const std::vector<bool>& node_mask) const;
+
+  /// Like InducedSubgraph(const std::vector<bool>&) but for the nodes in
+  /// \param node_list. The order of node_list and duplicate nodes in it are
+  /// ignored.
+  ///
+  /// \returns invalid_argument if a node is not in the graph
+  Result<std::unique_ptr<PropertyFileGraph>> InducedSubgraph(
+      const std::vector<GraphTopology::Node>& node_list) const;
+
+  /// Make a graph with every node of this but only the edges for which
+  /// \param edge_mask is true, with every node and edge property.
+  ///
+  /// Node IDs and the order of the remaining edges are unchanged. The result
+  /// has the same local_to_global_vector() as this.
+  ///
+  /// \returns invalid_argument if edge_mask does not have one entry per edge
+  Result<std::unique_ptr<PropertyFileGraph>> EdgeFilteredSubgraph(
+      const std::vector<bool>& edge_mask) const;
+
   const std::string& rdg_dir() const { return rdg_.rdg_dir().string(); }
 
   const tsuba::PartitionMetadata& partition_metadata() const {
@@ -193,7 +244,16 @@ public:
     rdg_.set_part_metadata(meta);
   }
 
-  const std::shared_ptr<arrow::ChunkedArray>& local_to_global_vector() {
+  /// The serialized katana::analytics::GraphProfile of the topology, which is
+  /// stored with the graph, or the empty string if there is none. Changing the
+  /// topology with SetTopology, SortAllEdgesByDest, SortNodesByDegree or
+  /// LC_CSR_PropertyGraph::sortAllEdgesByDst clears it.
+  const std::string& graph_profile() const { return rdg_.graph_profile(); }
+  void set_graph_profile(std::string graph_profile) {
+    rdg_.set_graph_profile(std::move(graph_profile));
+  }
+
+  const std::shared_ptr<arrow::ChunkedArray>& local_to_global_vector() const {
     return rdg_.local_to_global_vector();
   }
   void set_local_to_global_vector(std::shared_ptr<arrow::ChunkedArray>&& a) {
@@ -220,6 +280,13 @@ public:
   Result<void> Write(
       const std::string& rdg_name, const std::string& command_line);
 
+  /// Write \param partitions as the partitions of one RDG named \param
+  /// rdg_name so that partitions[i] is loaded by host i of partitions.size()
+  /// hosts. Partitions are usually made by PartitionGraph.
+  static Result<void> WritePartitions(
+      const std::vector<std::unique_ptr<PropertyFileGraph>>& partitions,
+      const std::string& rdg_name, const std::string& command_line);
+
   /// Write updates to the property graph
   ///
   /// Like \ref Write(const std::string&, const std::string&) but update
@@ -482,6 +549,21 @@ KATANA_EXPORT GraphTopology::Edge FindEdgeSortedByDest(
 /// descending order.
 KATANA_EXPORT Result<void> SortNodesByDegree(PropertyFileGraph* pfg);
 
+namespace internal {
+
+/// Give dst the topology \param topology, the rows \param node_rows of the
+/// node properties of \param src and the rows \param edge_rows of its edge
+/// properties, where null rows mean every row. The local_to_global_vector()
+/// of dst maps its nodes to the global IDs of the nodes of src they came from.
+/// Every property of dst is replaced and marked persistent; dst may be src.
+KATANA_EXPORT Result<void> SetTopologyAndTakeRows(
+    const PropertyFileGraph& src, const GraphTopology& topology,
+    const std::shared_ptr<arrow::UInt64Array>& node_rows,
+    const std::shared_ptr<arrow::UInt64Array>& edge_rows,
+    PropertyFileGraph* dst);
+
+}  // namespace internal
+
 }  // namespace katana
 
 #endif
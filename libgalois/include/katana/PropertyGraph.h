@@ -181,6 +181,7 @@ public:
    * @returns pointer to the underlying PropertyFileGraph.
    */
   const PropertyFileGraph& GetPropertyFileGraph() const { return *pfg_; }
+  PropertyFileGraph& GetPropertyFileGraph() { return *pfg_; }
 
   // Graph constructors
   static Result<PropertyGraph<NodeProps, EdgeProps>> Make(
@@ -0,0 +1,123 @@
+#ifndef KATANA_LIBGALOIS_KATANA_REORDERNODES_H_
+#define KATANA_LIBGALOIS_KATANA_REORDERNODES_H_
+
+#include <cstdint>
+#include <memory>
+
+#include <arrow/api.h>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// A plan for ReorderNodes, specifying the order to give nodes and any
+/// parameters associated with it.
+///
+/// Every order places nodes that are accessed together near each other so
+/// that their properties share cache lines and pages, but they differ in
+/// cost: degree grouping, breadth-first and reverse Cuthill-McKee orders are
+/// computed in parallel in a few passes over the edges, while Gorder and
+/// community orders are computed sequentially and are meant to be computed
+/// once and stored with the graph.
+class KATANA_EXPORT ReorderPlan {
+public:
+  enum Algorithm {
+    kDegreeGrouping = 0,
+    kBreadthFirst,
+    kReverseCuthillMcKee,
+    kGorder,
+    kCommunity,
+  };
+
+  static const uint32_t kDefaultGorderWindow = 5;
+
+private:
+  Algorithm algorithm_;
+  uint32_t window_;
+
+  ReorderPlan(Algorithm algorithm, uint32_t window)
+      : algorithm_(algorithm), window_(window) {}
+
+public:
+  ReorderPlan() : ReorderPlan{kDegreeGrouping, 0} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The number of most recently placed nodes Gorder scores candidates
+  /// against
+  uint32_t window() const { return window_; }
+
+  /// Group nodes by out-degree, in groups whose bounds double from the
+  /// average degree, with the group of the highest degrees first. Nodes keep
+  /// their relative order within a group, so the hot, high-degree nodes are
+  /// packed together without destroying the locality the graph already has.
+  static ReorderPlan DegreeGrouping() { return {kDegreeGrouping, 0}; }
+
+  /// Place nodes in the order a breadth-first search over out-edges visits
+  /// them, starting each connected component from its node of highest
+  /// degree.
+  static ReorderPlan BreadthFirst() { return {kBreadthFirst, 0}; }
+
+  /// Reverse Cuthill-McKee: a breadth-first order from a pseudo-peripheral
+  /// node of each component that visits the neighbors of each node in order
+  /// of increasing degree, reversed. It minimizes the bandwidth of the
+  /// adjacency matrix, which suits meshes and road networks. The search
+  /// follows out-edges, so the graph should be symmetric.
+  static ReorderPlan ReverseCuthillMcKee() {
+    return {kReverseCuthillMcKee, 0};
+  }
+
+  /// Greedily place next the node that shares the most in-neighbors with,
+  /// or has the most edges to or from, the last window placed nodes
+  /// (Wei et al., "Speedup Graph Processing by Graph Ordering", SIGMOD 2016).
+  static ReorderPlan Gorder(uint32_t window = kDefaultGorderWindow) {
+    return {kGorder, window};
+  }
+
+  /// Merge each node, in order of increasing degree, into the neighboring
+  /// community that most increases modularity and place nodes in the
+  /// depth-first order of the resulting hierarchy of communities, so that
+  /// every community, at every level, is contiguous (Arai et al., "Rabbit
+  /// Order", IPDPS 2016). Edges are treated as undirected.
+  static ReorderPlan Community() { return {kCommunity, 0}; }
+};
+
+/// Renumber the nodes of \param pfg in the order given by \param plan to
+/// improve the cache locality of algorithms that run on it.
+///
+/// The topology and every node and edge property are permuted. Each node
+/// keeps its edges in their original relative order, so edges sorted by
+/// destination before reordering need to be sorted again with
+/// SortAllEdgesByDest. Every property is marked persistent, as for
+/// subgraphs.
+///
+/// The returned array maps each new node ID to the node's ID before
+/// reordering. It is also recorded in local_to_global_vector(), so it is
+/// stored with the graph; if the graph already had a local_to_global_vector(),
+/// the IDs it mapped to are recorded instead. Node properties computed on the
+/// reordered graph can be put back in the original order with
+/// RestoreNodeOrder.
+///
+/// \returns invalid_argument if pfg is a partition of a distributed graph,
+/// whose nodes must stay ordered with masters first
+KATANA_EXPORT Result<std::shared_ptr<arrow::UInt64Array>> ReorderNodes(
+    PropertyFileGraph* pfg, ReorderPlan plan = {});
+
+/// Return the permutation that undoes \param new_to_old, a permutation
+/// returned by ReorderNodes, i.e., the new ID of each original node.
+KATANA_EXPORT Result<std::shared_ptr<arrow::UInt64Array>> InvertPermutation(
+    const std::shared_ptr<arrow::UInt64Array>& new_to_old);
+
+/// Return \param property, a node property of a graph reordered by
+/// ReorderNodes, in the order of the nodes before reordering. \param
+/// new_to_old is the permutation ReorderNodes returned.
+///
+/// \returns invalid_argument if property and new_to_old differ in length
+KATANA_EXPORT Result<std::shared_ptr<arrow::ChunkedArray>> RestoreNodeOrder(
+    const std::shared_ptr<arrow::ChunkedArray>& property,
+    const std::shared_ptr<arrow::UInt64Array>& new_to_old);
+
+}  // namespace katana
+
+#endif
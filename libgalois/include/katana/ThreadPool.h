@@ -22,10 +22,14 @@
 
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
+#include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "katana/CacheLineStorage.h"
@@ -54,6 +58,16 @@ namespace katana {
 class KATANA_EXPORT ThreadPool {
   friend class SharedMem;
 
+public:
+  //! How long the threads woken by a run took to start, i.e., from the
+  //! thread waking them up, in cascade, to their first instruction of work
+  struct WakeupStats {
+    uint64_t wakeups{0};         // threads woken
+    uint64_t parked{0};          // threads woken from parking
+    uint64_t totalLatencyNs{0};  // sum of the latencies of all threads
+    uint64_t maxLatencyNs{0};    // latency until the last thread started
+  };
+
 protected:
   struct shutdown_ty {};  //! type for shutting down thread
   struct fastmode_ty {
@@ -64,38 +78,35 @@ protected:
   };  //! type to switch to dedicated mode
 
   //! Per-thread mailboxes for notification
+  //!
+  //! A waiting thread spins for a while before parking, i.e., sleeping in the
+  //! kernel, on state, so that loops run in quick succession wake their
+  //! threads without system calls while a pool left idle burns little CPU.
   struct per_signal {
+    enum : uint32_t {
+      kIdle = 0,  // waiting, spinning
+      kReleased,  // woken up
+      kParked,    // waiting, asleep
+    };
+
+    // used to park where futexes are not available
     std::condition_variable cv;
     std::mutex m;
     unsigned wbegin, wend;
     std::atomic<int> done;
-    std::atomic<int> fastRelease;
+    std::atomic<uint32_t> state{kIdle};
     ThreadTopoInfo topo;
+    // the time of the last wakeup, and how long and whether from parking this
+    // thread took to wake up
+    std::chrono::steady_clock::time_point wakeupTime;
+    uint64_t latencyNs{0};
+    bool parked{false};
 
-    void wakeup(bool fastmode) {
-      if (fastmode) {
-        done = 0;
-        fastRelease = 1;
-      } else {
-        std::lock_guard<std::mutex> lg(m);
-        done = 0;
-        cv.notify_one();
-        // start.release();
-      }
-    }
-
-    void wait(bool fastmode) {
-      if (fastmode) {
-        while (!fastRelease.load(std::memory_order_relaxed)) {
-          asmPause();
-        }
-        fastRelease = 0;
-      } else {
-        std::unique_lock<std::mutex> lg(m);
-        cv.wait(lg, [=] { return !done; });
-        // start.acquire();
-      }
-    }
+    void wakeup();
+
+    //! wait for wakeup, spinning for up to spinBudgetNs, or forever in
+    //! fastmode, before parking
+    void wait(bool fastmode, uint64_t spinBudgetNs);
   };
 
   thread_local static per_signal my_box;
@@ -107,6 +118,8 @@ protected:
   unsigned masterFastmode;
   bool running;
   std::function<void(void)> work;
+  std::atomic<uint64_t> spinBudgetNs;
+  WakeupStats lastWakeupStats;
 
   //! destroy all threads
   void destroyCommon();
@@ -118,7 +131,7 @@ protected:
   void threadLoop(unsigned tid);
 
   //! spin up for run
-  void cascade(bool fastmode);
+  void cascade();
 
   //! spin down after run
   void decascade();
@@ -126,6 +139,9 @@ protected:
   //! execute work on num threads
   void runInternal(unsigned num);
 
+  //! set spinBudgetNs to how long waking up a parked thread takes
+  void calibrateSpinBudget();
+
   ThreadPool();
 
 public:
@@ -180,6 +196,17 @@ public:
   unsigned getMaxCores() const { return mi.maxCores; }
   unsigned getMaxSockets() const { return mi.maxSockets; }
   unsigned getMaxNumaNodes() const { return mi.maxNumaNodes; }
+  //! return how long the threads of the last run took to wake up and clear
+  //! them, so that the wakeups of a run are reported at most once even when
+  //! loops are built on other loops
+  WakeupStats takeLastWakeupStats() {
+    return std::exchange(lastWakeupStats, WakeupStats{});
+  }
+  //! return how long idle threads spin before parking
+  uint64_t getSpinBudgetNs() const { return spinBudgetNs; }
+  //! return the topology the pool was sized for, i.e., the cores, sockets and
+  //! NUMA nodes this process may use, and the CPU quota it runs under
+  const MachineTopoInfo& getMachineTopoInfo() const { return mi; }
 
   unsigned getLeaderForSocket(unsigned pid) const {
     for (unsigned i = 0; i < getMaxThreads(); ++i)
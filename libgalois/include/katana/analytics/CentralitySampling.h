@@ -0,0 +1,88 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_CENTRALITYSAMPLING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_CENTRALITYSAMPLING_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace katana::analytics {
+
+/// Small counter-based random number generator (splitmix64). Seeding is free,
+/// so parallel loops can give every sample its own generator seeded from the
+/// sample index and stay deterministic regardless of scheduling.
+class SplitMix64 {
+  uint64_t state_;
+
+public:
+  explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+  uint64_t operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  /// A uniform integer in [0, bound)
+  uint64_t Uniform(uint64_t bound) {
+    // Lemire's multiply-shift; the bias is below 2^-32 for any bound that
+    // fits in 32 bits.
+    return static_cast<uint64_t>(
+        (static_cast<unsigned __int128>((*this)()) * bound) >> 64);
+  }
+
+  /// A uniform real in [0, 1)
+  double UniformReal() { return ((*this)() >> 11) * 0x1.0p-53; }
+};
+
+/// Confidence radii for estimating many means at once from a growing sample,
+/// as in adaptive sampling for centrality (e.g., KADABRA [1]). Every sampled
+/// value must be in [0, 1]. The means are checked at a sequence of sample
+/// sizes; the check-th check spends delta / 2^(check + 1) of the failure
+/// probability, split evenly across the means, so all radii of all checks hold
+/// together with probability at least 1 - delta.
+///
+/// Each radius is the smaller of Hoeffding's bound and the empirical Bernstein
+/// bound of Maurer and Pontil [2]; the latter is much tighter for means near 0,
+/// which is where most centrality values are.
+///
+/// [1] M. Borassi and E. Natale, "KADABRA is an ADaptive Algorithm for
+/// Betweenness via Random Approximation," ESA 2016.
+/// [2] A. Maurer and M. Pontil, "Empirical Bernstein Bounds and Sample
+/// Variance Penalization," COLT 2009.
+class SampleMeanBound {
+  double delta_;
+  uint64_t num_means_;
+
+public:
+  SampleMeanBound(double delta, uint64_t num_means)
+      : delta_(delta), num_means_(std::max<uint64_t>(num_means, 1)) {}
+
+  /// The radius around sum / num_samples that contains the true mean, for the
+  /// check-th check.
+  double Radius(
+      uint32_t check, double sum, double sum_squares,
+      uint64_t num_samples) const {
+    if (num_samples < 2) {
+      return 1;
+    }
+    // Each of the two bounds gets half of this mean's share
+    double log_term = std::log(4.0 * num_means_ / delta_) +
+                      (check + 1) * std::log(2.0);
+    double n = num_samples;
+    double hoeffding = std::sqrt(log_term / (2 * n));
+
+    double mean = sum / n;
+    double variance =
+        std::max(0.0, (sum_squares - n * mean * mean) / (n - 1));
+    double two_sided_log_term = log_term + std::log(2.0);
+    double bernstein = std::sqrt(2 * variance * two_sided_log_term / n) +
+                       7 * two_sided_log_term / (3 * (n - 1));
+
+    return std::min({hoeffding, bernstein, 1.0});
+  }
+};
+
+}  // namespace katana::analytics
+
+#endif
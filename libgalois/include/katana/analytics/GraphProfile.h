@@ -0,0 +1,101 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHPROFILE_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHPROFILE_H_
+
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana::analytics {
+
+/// A summary of the topology of a graph from which the analytics choose an
+/// algorithm when given an automatic plan, e.g., BfsPlan::Automatic.
+///
+/// Computing a profile takes a few parallel passes over the edges, so Get
+/// stores the profile with the graph and reuses it until the topology
+/// changes. It is saved with the graph when the graph is written.
+struct KATANA_EXPORT GraphProfile {
+  uint64_t num_nodes{0};
+  uint64_t num_edges{0};
+  double average_degree{0};
+  /// The mean out-degree over the median out-degree of a random sample of
+  /// nodes with edges. Power-law graphs have a few nodes of very high degree
+  /// and so a skew well above 1.
+  double degree_skew{0};
+  /// A lower bound on the diameter of the graph, following out-edges, found
+  /// by repeated breadth-first search from the farthest node of the last
+  /// search
+  uint32_t estimated_diameter{0};
+  /// True if the edges of every node are sorted by destination
+  bool edges_sorted{false};
+
+  /// Compute the profile of pfg.
+  static Result<GraphProfile> Compute(const PropertyFileGraph& pfg);
+
+  /// Return the profile stored with pfg if it is of the current topology, or
+  /// compute it and store it with pfg otherwise.
+  static Result<GraphProfile> Get(PropertyFileGraph* pfg);
+
+  /// Return Get(pfg) for choosing an automatic plan, or log a warning and
+  /// return nullopt, upon which the caller should use its default plan, if
+  /// profiling fails.
+  static std::optional<GraphProfile> ForAutomaticPlan(PropertyFileGraph* pfg);
+
+  static Result<GraphProfile> FromJson(const std::string& json);
+  Result<std::string> ToJson() const;
+
+  /// Print the profile in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+};
+
+/// The thresholds with which automatic plans choose algorithms from a
+/// GraphProfile.
+///
+/// The defaults are reasonable for most machines. Better thresholds for a
+/// particular machine can be found by running scripts/calibrate_plans.py on
+/// it, which writes them to a JSON file; setting the environment variable
+/// KATANA_PLAN_CALIBRATION to the path of that file makes Get return them.
+/// Thresholds missing from the file keep their defaults. The script times
+/// only BFS and connected components; the other automatic plans reuse the
+/// thresholds fit on those.
+struct KATANA_EXPORT PlanCalibration {
+  /// Graphs whose degree skew is at least this, and whose average degree is
+  /// at least min_skewed_average_degree, are treated as power-law graphs by
+  /// BFS, connected components, PageRank and k-truss. The defaults are those
+  /// of the GAP benchmark suite.
+  double skew_threshold{1.3};
+  double min_skewed_average_degree{10};
+  /// Graphs with an estimated diameter of at least this are treated as
+  /// high-diameter graphs, e.g., road networks, for which bulk-synchronous
+  /// algorithms spend most of their time in barriers.
+  uint32_t high_diameter{64};
+  /// The edge tile size of tiled algorithms on power-law graphs
+  uint32_t edge_tile_size{512};
+  /// Connected components uses Afforest on graphs with at least this average
+  /// degree; sampling neighbors does not pay off on sparser graphs.
+  double afforest_min_average_degree{2};
+
+  bool IsPowerLaw(const GraphProfile& profile) const {
+    return profile.degree_skew >= skew_threshold &&
+           profile.average_degree >= min_skewed_average_degree;
+  }
+
+  bool IsHighDiameter(const GraphProfile& profile) const {
+    return profile.estimated_diameter >= high_diameter;
+  }
+
+  /// Read thresholds from a JSON file.
+  static Result<PlanCalibration> FromFile(const std::string& path);
+
+  /// The calibration of this machine: the file named by
+  /// KATANA_PLAN_CALIBRATION if it is set, or the defaults otherwise.
+  static const PlanCalibration& Get();
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -18,6 +18,7 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kAdaptiveSampling,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
@@ -25,9 +26,19 @@ public:
 
 private:
   Algorithm algorithm_;
+  double epsilon_;
+  double delta_;
+
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, double epsilon,
+      double delta)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        delta_(delta) {}
 
   BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+      : BetweennessCentralityPlan(architecture, algorithm, 0.01, 0.1) {}
 
 public:
   BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
@@ -51,11 +62,31 @@ public:
   }
 
   Algorithm algorithm() const { return algorithm_; }
+  double epsilon() const { return epsilon_; }
+  double delta() const { return delta_; }
 
   static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
 
   static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
 
+  /// Estimate betweenness centrality from random shortest paths between
+  /// random pairs of nodes [1], drawn in batches until, with probability at
+  /// least 1 - delta, every estimate is within epsilon * n * (n - 1) of the
+  /// exact value, i.e., within epsilon after normalizing by the number of
+  /// ordered pairs. Between batches the stopping rule of KADABRA [2] is
+  /// checked; the sample size never exceeds the bound of [1], which depends
+  /// on the vertex diameter rather than the size of the graph. The sources
+  /// argument is ignored.
+  ///
+  /// [1] M. Riondato and E. M. Kornaropoulos, "Fast Approximation of
+  /// Betweenness Centrality through Sampling," WSDM 2014.
+  /// [2] M. Borassi and E. Natale, "KADABRA is an ADaptive Algorithm for
+  /// Betweenness via Random Approximation," ESA 2016.
+  static BetweennessCentralityPlan AdaptiveSampling(
+      double epsilon = 0.01, double delta = 0.1) {
+    return {kCPU, kAdaptiveSampling, epsilon, delta};
+  }
+
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
     return BetweennessCentralityPlan(kCPU, algo);
   }
@@ -80,6 +111,8 @@ extern KATANA_EXPORT const BetweennessCentralitySources
  * @param sources Only process some sources, producing an approximate
  *          betweenness centrality. If this is a vector process those source
  *          nodes; if this is an int process that number of source nodes.
+ *          Use BetweennessCentralityPlan::AdaptiveSampling instead to get an
+ *          approximation with an error bound.
  * @param plan
  */
 KATANA_EXPORT Result<void> BetweennessCentrality(
@@ -22,18 +22,22 @@ public:
 private:
   Algorithm algorithm_;
   ptrdiff_t edge_tile_size_;
+  bool symmetric_;
 
   BfsPlan(
-      Architecture architecture, Algorithm algorithm, ptrdiff_t edge_tile_size)
+      Architecture architecture, Algorithm algorithm, ptrdiff_t edge_tile_size,
+      bool symmetric = false)
       : Plan(architecture),
         algorithm_(algorithm),
-        edge_tile_size_(edge_tile_size) {}
+        edge_tile_size_(edge_tile_size),
+        symmetric_(symmetric) {}
 
 public:
   BfsPlan() : BfsPlan{kCPU, kSynchronousTile, 256} {}
 
   Algorithm algorithm() const { return algorithm_; }
   ptrdiff_t edge_tile_size() const { return edge_tile_size_; }
+  bool symmetric() const { return symmetric_; }
 
   static BfsPlan AsynchronousTile(ptrdiff_t edge_tile_size = 256) {
     return {kCPU, kAsynchronousTile, edge_tile_size};
@@ -45,7 +49,11 @@ public:
     return {kCPU, kSynchronousTile, edge_tile_size};
   }
 
-  static BfsPlan Synchronous() { return {kCPU, kSynchronous, 0}; }
+  /// If symmetric, the graph must have the reverse of every edge, which lets
+  /// the levels with dense frontiers pull along in-edges instead of pushing.
+  static BfsPlan Synchronous(bool symmetric = false) {
+    return {kCPU, kSynchronous, 0, symmetric};
+  }
 
   static BfsPlan FromAlgorithm(Algorithm algo) {
     switch (algo) {
@@ -61,6 +69,11 @@ public:
       return {};
     }
   }
+
+  /// Choose an algorithm from the GraphProfile of pfg: the asynchronous
+  /// algorithms on high-diameter graphs, where a round per level is costly,
+  /// and the tiled algorithms on power-law graphs.
+  static BfsPlan Automatic(PropertyFileGraph* pfg);
 };
 
 /// The tag for the output property of BFS in PropertyGraphs.
@@ -0,0 +1,112 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_CLOSENESSCENTRALITY_CLOSENESSCENTRALITY_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_CLOSENESSCENTRALITY_CLOSENESSCENTRALITY_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for ClosenessCentrality, specifying the algorithm,
+/// the centrality measure and any parameters associated with them.
+class ClosenessCentralityPlan : public Plan {
+public:
+  /// Algorithm selectors for closeness centrality
+  enum Algorithm { kExact, kAdaptiveSampling };
+
+  /// Centrality measures. With d(u, v) the distance from u to v and n the
+  /// number of nodes:
+  ///
+  /// kHarmonic: the average of 1 / d(u, v) over all nodes u other than v,
+  /// where 1 / d(u, v) is 0 if v cannot be reached from u.
+  ///
+  /// kCloseness: closeness as generalized to disconnected graphs by Wasserman
+  /// and Faust, (r - 1) / (n - 1) * (r - 1) / s, where r is the number of
+  /// nodes that reach v, including v, and s is the sum of their distances to
+  /// v; 0 if no other node reaches v.
+  enum Measure { kHarmonic, kCloseness };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  Measure measure_;
+  double epsilon_;
+  double delta_;
+
+  ClosenessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, Measure measure,
+      double epsilon, double delta)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        measure_(measure),
+        epsilon_(epsilon),
+        delta_(delta) {}
+
+public:
+  ClosenessCentralityPlan()
+      : ClosenessCentralityPlan{kCPU, kExact, kHarmonic, 0.01, 0.1} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  Measure measure() const { return measure_; }
+  double epsilon() const { return epsilon_; }
+  double delta() const { return delta_; }
+
+  /// Search from every node. Sources are searched 64 at a time with the
+  /// bit-parallel multi-source BFS of Then et al. [1], so each batch shares
+  /// one pass over the edges.
+  ///
+  /// [1] M. Then, M. Kaufmann, F. Chirigati, T. Hoang-Vu, K. Pham, A. Kemper,
+  /// T. Neumann and H. T. Vo, "The More the Merrier: Efficient Multi-Source
+  /// Graph Traversal," PVLDB 8(4), 2014.
+  static ClosenessCentralityPlan Exact(Measure measure = kHarmonic) {
+    return {kCPU, kExact, measure, 0, 0};
+  }
+
+  /// Search from random sources, in the same batches as Exact, until, with
+  /// probability at least 1 - delta, every harmonic centrality estimate is
+  /// within epsilon of the exact value (Eppstein and Wang [1]). The number
+  /// of sources adapts to the variance of the estimates, as in
+  /// BetweennessCentralityPlan::AdaptiveSampling. Closeness is estimated from
+  /// the same sources but without an error bound. If the sample would need as
+  /// many sources as the graph has nodes, the result is exact.
+  ///
+  /// [1] D. Eppstein and J. Wang, "Fast Approximation of Centrality," SODA
+  /// 2001.
+  static ClosenessCentralityPlan AdaptiveSampling(
+      Measure measure = kHarmonic, double epsilon = 0.01, double delta = 0.1) {
+    return {kCPU, kAdaptiveSampling, measure, epsilon, delta};
+  }
+};
+
+/// Compute the closeness or harmonic centrality of every node of pfg, based on
+/// distances from other nodes to it.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. The created property has type double.
+KATANA_EXPORT Result<void> ClosenessCentrality(
+    PropertyFileGraph* pfg, const std::string& output_property_name,
+    ClosenessCentralityPlan plan = {});
+
+struct KATANA_EXPORT ClosenessCentralityStatistics {
+  /// The maximum centrality across all nodes.
+  double max_centrality;
+  /// The minimum centrality across all nodes.
+  double min_centrality;
+  /// The average centrality across all nodes.
+  double average_centrality;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<ClosenessCentralityStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -141,6 +141,11 @@ public:
         kCPU, kEdgeAfforest, edge_tile_size, neighbor_sample_size,
         component_sample_frequency};
   }
+
+  /// Choose an algorithm from the GraphProfile of pfg: Afforest, tiled on
+  /// power-law graphs, or Asynchronous on graphs too sparse for sampling
+  /// neighbors to pay off.
+  static ConnectedComponentsPlan Automatic(PropertyFileGraph* pfg);
 };
 
 /// Compute the Connected-components for pfg. The pfg is expected to be
@@ -0,0 +1,84 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_COREDECOMPOSITION_COREDECOMPOSITION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_COREDECOMPOSITION_COREDECOMPOSITION_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for core decomposition, specifying the algorithm
+/// and any parameters associated with it.
+class CoreDecompositionPlan : public Plan {
+public:
+  /// Algorithm selectors for core decomposition
+  enum Algorithm { kBucketed, kSerial };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t num_open_buckets_;
+
+  CoreDecompositionPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t num_open_buckets)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        num_open_buckets_(num_open_buckets) {}
+
+public:
+  CoreDecompositionPlan() : CoreDecompositionPlan{kCPU, kBucketed, 128} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  uint32_t num_open_buckets() const { return num_open_buckets_; }
+
+  /// Parallel peeling. Nodes are kept in buckets by current degree and all
+  /// nodes of the lowest non-empty bucket are removed in each round. Only
+  /// num_open_buckets buckets are materialized at a time; nodes of higher
+  /// degree wait in an overflow bucket until the window reaches them.
+  static CoreDecompositionPlan Bucketed(uint32_t num_open_buckets = 128) {
+    return {kCPU, kBucketed, num_open_buckets};
+  }
+
+  /// The serial O(|E|) algorithm of Batagelj and Zaversnik.
+  static CoreDecompositionPlan Serial() { return {kCPU, kSerial, 0}; }
+};
+
+/// Compute the core number of every node of pfg, i.e., the largest k such
+/// that the node belongs to the k-core. The pfg must be symmetric; self loops
+/// are ignored.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. The created property has type uint32_t.
+KATANA_EXPORT Result<void> CoreDecomposition(
+    PropertyFileGraph* pfg, const std::string& output_property_name,
+    CoreDecompositionPlan plan = {});
+
+KATANA_EXPORT Result<void> CoreDecompositionAssertValid(
+    PropertyFileGraph* pfg, const std::string& property_name);
+
+struct KATANA_EXPORT CoreDecompositionStatistics {
+  /// The largest core number, i.e., the degeneracy of the graph.
+  uint32_t degeneracy;
+  /// The number of nodes in the innermost core.
+  uint64_t num_nodes_in_max_core;
+  /// The number of distinct core numbers, i.e., non-empty shells.
+  uint64_t num_distinct_cores;
+  /// The average core number.
+  double average_core_number;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<CoreDecompositionStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
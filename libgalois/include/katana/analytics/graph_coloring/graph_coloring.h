@@ -0,0 +1,120 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHCOLORING_GRAPHCOLORING_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_GRAPHCOLORING_GRAPHCOLORING_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for GraphColoring, specifying the algorithm and any
+/// parameters associated with it.
+class GraphColoringPlan : public Plan {
+public:
+  /// Algorithm selectors for graph coloring
+  enum Algorithm {
+    kSpeculative,
+    kJonesPlassmann,
+    kLargestDegreeFirst,
+    kSmallestLast
+  };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t distance_;
+  bool balance_;
+
+  GraphColoringPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t distance,
+      bool balance)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        distance_(distance),
+        balance_(balance) {}
+
+public:
+  GraphColoringPlan() : GraphColoringPlan{kCPU, kSpeculative, 1, false} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// Nodes at most this many hops apart get different colors; 1 or 2.
+  uint32_t distance() const { return distance_; }
+  /// Whether color classes are rebalanced after coloring.
+  bool balance() const { return balance_; }
+
+  /// Gebremedhin and Manne: every uncolored node speculatively takes the
+  /// smallest color not used around it, then the lower id node of every
+  /// conflicting pair is uncolored again for the next round.
+  static GraphColoringPlan Speculative(
+      uint32_t distance = 1, bool balance = false) {
+    return {kCPU, kSpeculative, distance, balance};
+  }
+
+  /// Jones and Plassmann: every node takes the smallest free color once all
+  /// neighbors of larger random priority are colored. Never produces
+  /// conflicts.
+  static GraphColoringPlan JonesPlassmann(
+      uint32_t distance = 1, bool balance = false) {
+    return {kCPU, kJonesPlassmann, distance, balance};
+  }
+
+  /// Jones-Plassmann with nodes of larger degree colored first; random
+  /// priorities break ties.
+  static GraphColoringPlan LargestDegreeFirst(
+      uint32_t distance = 1, bool balance = false) {
+    return {kCPU, kLargestDegreeFirst, distance, balance};
+  }
+
+  /// Jones-Plassmann in smallest-last order, i.e., nodes are colored in the
+  /// reverse of the order in which they are removed by repeatedly removing a
+  /// node of minimum degree. Uses at most degeneracy + 1 colors at distance 1.
+  /// The ordering is computed serially.
+  static GraphColoringPlan SmallestLast(
+      uint32_t distance = 1, bool balance = false) {
+    return {kCPU, kSmallestLast, distance, balance};
+  }
+};
+
+/// Color the nodes of pfg so that no two nodes within plan.distance() hops
+/// have the same color. The pfg must be symmetric; self loops are ignored.
+/// If plan.balance() is set, nodes are then moved out of color classes larger
+/// than the average into smaller ones where that keeps the coloring valid,
+/// without adding colors, so that per-color parallel loops are better
+/// utilized.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. The created property has type uint32_t; colors
+/// are numbered from 0.
+KATANA_EXPORT Result<void> GraphColoring(
+    PropertyFileGraph* pfg, const std::string& output_property_name,
+    GraphColoringPlan plan = {});
+
+KATANA_EXPORT Result<void> GraphColoringAssertValid(
+    PropertyFileGraph* pfg, const std::string& property_name,
+    uint32_t distance = 1);
+
+struct KATANA_EXPORT GraphColoringStatistics {
+  /// The number of colors used.
+  uint32_t num_colors;
+  /// The number of nodes of the most common color.
+  uint64_t largest_color_class_size;
+  /// The number of nodes of the least common color.
+  uint64_t smallest_color_class_size;
+  /// The average number of nodes per color.
+  double average_color_class_size;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<GraphColoringStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,142 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_HYPERGRAPHPARTITION_HYPERGRAPHPARTITION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_HYPERGRAPHPARTITION_HYPERGRAPHPARTITION_H_
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for HypergraphPartition, specifying the algorithm
+/// and any parameters associated with it.
+///
+/// The only algorithm is BiPart [1], a deterministic multilevel partitioner:
+/// the hypergraph is coarsened by parallel matching of nodes that share a
+/// hyperedge, the coarsest hypergraph is bisected greedily, and the bisection
+/// is projected back level by level with parallel refinement at each level.
+/// k-way partitions are built by recursive bisection. Every step breaks ties
+/// by id, so the partition does not depend on the number of threads.
+///
+/// [1] S. Maleki, U. Agarwal, M. Burtscher and K. Pingali, "BiPart: A Parallel
+/// and Deterministic Hypergraph Partitioner," PPoPP 2021.
+class HypergraphPartitionPlan : public Plan {
+public:
+  /// Algorithm selectors for hypergraph partitioning
+  enum Algorithm { kBiPart };
+
+  /// The hyperedge each node prefers to be merged along during coarsening
+  enum MatchingPolicy {
+    kHigherDegree,
+    kLowerDegree,
+    kHigherWeight,
+    kLowerWeight,
+    kRandom
+  };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  MatchingPolicy matching_policy_;
+  uint32_t max_coarsening_levels_;
+  uint32_t refinement_iterations_;
+  double imbalance_tolerance_;
+
+  HypergraphPartitionPlan(
+      Architecture architecture, Algorithm algorithm,
+      MatchingPolicy matching_policy, uint32_t max_coarsening_levels,
+      uint32_t refinement_iterations, double imbalance_tolerance)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        matching_policy_(matching_policy),
+        max_coarsening_levels_(max_coarsening_levels),
+        refinement_iterations_(refinement_iterations),
+        imbalance_tolerance_(imbalance_tolerance) {}
+
+public:
+  HypergraphPartitionPlan()
+      : HypergraphPartitionPlan{kCPU, kBiPart, kHigherDegree, 25, 2, 0.05} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  MatchingPolicy matching_policy() const { return matching_policy_; }
+  uint32_t max_coarsening_levels() const { return max_coarsening_levels_; }
+  uint32_t refinement_iterations() const { return refinement_iterations_; }
+  double imbalance_tolerance() const { return imbalance_tolerance_; }
+
+  /// \param matching_policy the priority of hyperedges when matching:
+  ///     higher or lower number of pins, higher or lower total pin weight, or
+  ///     a hash of the hyperedge id
+  /// \param max_coarsening_levels the maximum number of times the hypergraph
+  ///     is coarsened before the initial bisection
+  /// \param refinement_iterations the number of refinement passes at each
+  ///     level of uncoarsening
+  /// \param imbalance_tolerance how much heavier than its share of the node
+  ///     weight a side of each bisection may be, e.g., 0.05 for 5%
+  static HypergraphPartitionPlan BiPart(
+      MatchingPolicy matching_policy = kHigherDegree,
+      uint32_t max_coarsening_levels = 25, uint32_t refinement_iterations = 2,
+      double imbalance_tolerance = 0.05) {
+    return {
+        kCPU,
+        kBiPart,
+        matching_policy,
+        max_coarsening_levels,
+        refinement_iterations,
+        imbalance_tolerance};
+  }
+};
+
+/// The partition of the nodes of pfg that are hyperedges.
+constexpr uint32_t kHyperedgePartition = std::numeric_limits<uint32_t>::max();
+
+/// Partition the hypergraph stored in pfg into num_partitions parts of about
+/// equal size, minimizing the number of hyperedges cut, i.e., with pins in more
+/// than one part.
+///
+/// pfg is read as a bipartite graph: the nodes for which the node property
+/// named hyperedge_property_name is non-zero are hyperedges, and the pins of
+/// a hyperedge are the other nodes adjacent to it by an edge in either
+/// direction. Edges between two hyperedges or two nodes are ignored. The
+/// property must have type uint8_t or bool.
+///
+/// The node property named output_property_name is created by this function
+/// and may not exist before the call. The created property has type uint32_t
+/// and holds the part, in [0, num_partitions), of each node, or
+/// kHyperedgePartition for hyperedges.
+KATANA_EXPORT Result<void> HypergraphPartition(
+    PropertyFileGraph* pfg, const std::string& hyperedge_property_name,
+    uint32_t num_partitions, const std::string& output_property_name,
+    HypergraphPartitionPlan plan = {});
+
+KATANA_EXPORT Result<void> HypergraphPartitionAssertValid(
+    PropertyFileGraph* pfg, const std::string& hyperedge_property_name,
+    uint32_t num_partitions, const std::string& property_name);
+
+struct KATANA_EXPORT HypergraphPartitionStatistics {
+  /// The number of hyperedges with pins in more than one part.
+  uint64_t num_cut_hyperedges;
+  /// The number of nodes, not counting hyperedges, in each part.
+  std::vector<uint64_t> part_sizes;
+
+  /// The size of the largest part over the average part size.
+  double Imbalance() const;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<HypergraphPartitionStatistics> Compute(
+      katana::PropertyFileGraph* pfg,
+      const std::string& hyperedge_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -48,6 +48,10 @@ public:
 
   /// The graph's edge lists are sorted; optimize based on this.
   static JaccardPlan Sorted() { return {kCPU, kSorted}; }
+
+  /// Choose Sorted or Unsorted from the GraphProfile of pfg, which records
+  /// whether the edges are sorted.
+  static JaccardPlan Automatic(PropertyFileGraph* pfg);
 };
 
 /// The tag for the output property of Jaccard in PropertyGraphs.
@@ -39,6 +39,11 @@ public:
 
   /// Compute k-1 core and then k-truss algorithm.
   static KTrussPlan BspCoreThenTruss() { return {kCPU, kBspCoreThenTruss}; }
+
+  /// Choose an algorithm from the GraphProfile of pfg: BspCoreThenTruss on
+  /// power-law graphs, where computing the core first removes most of the
+  /// low-degree nodes cheaply, and Bsp otherwise.
+  static KTrussPlan Automatic(PropertyFileGraph* pfg);
 };
 
 /// Compute the k-truss for pfg. The pfg is expected to be
@@ -0,0 +1,114 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_LABELPROPAGATION_LABELPROPAGATION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_LABELPROPAGATION_LABELPROPAGATION_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for LabelPropagation, specifying the algorithm and
+/// any parameters associated with it.
+class LabelPropagationPlan : public Plan {
+public:
+  /// Algorithm selectors for label propagation
+  enum Algorithm { kSynchronous, kAsynchronous };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t max_iterations_;
+
+  LabelPropagationPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t max_iterations)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        max_iterations_(max_iterations) {}
+
+public:
+  LabelPropagationPlan() : LabelPropagationPlan{kCPU, kAsynchronous, 100} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The maximum number of passes over the active nodes.
+  uint32_t max_iterations() const { return max_iterations_; }
+
+  /// Every active node computes its new label from the labels of the previous
+  /// iteration. Deterministic, but labels may oscillate, e.g., on bipartite
+  /// subgraphs, until max_iterations is reached.
+  static LabelPropagationPlan Synchronous(uint32_t max_iterations = 100) {
+    return {kCPU, kSynchronous, max_iterations};
+  }
+
+  /// Active nodes update their labels in place, so later nodes of an
+  /// iteration already see the new labels. Usually converges in fewer
+  /// iterations than Synchronous, but with seeds, labels can travel several
+  /// hops in one iteration and overtake closer seeds; Synchronous is usually
+  /// more accurate there.
+  static LabelPropagationPlan Asynchronous(uint32_t max_iterations = 100) {
+    return {kCPU, kAsynchronous, max_iterations};
+  }
+};
+
+/// Detect communities in pfg by label propagation [1]: every node repeatedly
+/// takes the label carried by the largest total edge weight among its
+/// neighbors, preferring its current label on ties and otherwise breaking
+/// them pseudo-randomly. Only nodes with a neighbor whose label changed in the
+/// last iteration are revisited, and propagation stops when no label changes
+/// or after plan.max_iterations() iterations. The pfg should be symmetric.
+///
+/// If edge_weight_property_name is empty, every edge has weight 1. Otherwise
+/// it names an edge property of a numeric type.
+///
+/// If seed_property_name is empty, every node starts in its own community.
+/// Otherwise it names a uint64_t node property; nodes where it is not null
+/// keep that label, the others start unlabeled, do not vote, and take the
+/// labels propagated from the seeds. Nodes no seed reaches get the label
+/// std::numeric_limits<uint64_t>::max().
+///
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. The created property has type uint64_t; without
+/// seeds, the label of a community is the id of one of the nodes in it.
+///
+/// [1] U. N. Raghavan, R. Albert and S. Kumara, "Near linear time algorithm to
+/// detect community structures in large-scale networks," Physical Review E 76,
+/// 036106, 2007.
+KATANA_EXPORT Result<void> LabelPropagation(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& seed_property_name,
+    const std::string& output_property_name, LabelPropagationPlan plan = {});
+
+/// Check that the labels in property_name are a fixed point of label
+/// propagation, which holds if LabelPropagation converged within
+/// max_iterations.
+KATANA_EXPORT Result<void> LabelPropagationAssertValid(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& seed_property_name, const std::string& property_name);
+
+struct KATANA_EXPORT LabelPropagationStatistics {
+  /// Total number of communities in the graph.
+  uint64_t total_communities;
+  /// Total number of communities with more than 1 node.
+  uint64_t total_non_trivial_communities;
+  /// The number of nodes present in the largest community.
+  uint64_t largest_community_size;
+  /// The ratio of nodes present in the largest community.
+  double ratio_largest_community;
+  /// The number of nodes no seed label reached.
+  uint64_t num_unlabeled_nodes;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<LabelPropagationStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
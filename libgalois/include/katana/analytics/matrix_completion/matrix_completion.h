@@ -0,0 +1,180 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MATRIXCOMPLETION_MATRIXCOMPLETION_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MATRIXCOMPLETION_MATRIXCOMPLETION_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for MatrixCompletion, specifying the algorithm and
+/// any parameters associated with it.
+///
+/// All algorithms minimize the squared error of the predicted ratings plus
+/// lambda times the squared norms of the latent vectors, and stop after
+/// max_rounds rounds or once a round changes the error by less than
+/// tolerance, relative to the error before the round.
+class MatrixCompletionPlan : public Plan {
+public:
+  /// Algorithm selectors for matrix completion
+  enum Algorithm { kSGDBlockedEdges, kSGDByItems, kALS };
+
+  /// How the SGD step size changes from round to round
+  enum StepFunction { kBold, kPurdue, kIntel, kBottou, kInverse };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t latent_vector_size_;
+  double lambda_;
+  double learning_rate_;
+  double decay_rate_;
+  StepFunction step_function_;
+  double tolerance_;
+  uint32_t max_rounds_;
+  uint32_t items_per_block_;
+  uint32_t users_per_block_;
+
+  MatrixCompletionPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint32_t latent_vector_size, double lambda, double learning_rate,
+      double decay_rate, StepFunction step_function, double tolerance,
+      uint32_t max_rounds, uint32_t items_per_block, uint32_t users_per_block)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        latent_vector_size_(latent_vector_size),
+        lambda_(lambda),
+        learning_rate_(learning_rate),
+        decay_rate_(decay_rate),
+        step_function_(step_function),
+        tolerance_(tolerance),
+        max_rounds_(max_rounds),
+        items_per_block_(items_per_block),
+        users_per_block_(users_per_block) {}
+
+public:
+  MatrixCompletionPlan()
+      : MatrixCompletionPlan{
+            kCPU, kSGDBlockedEdges, 20, 0.05, 0.012, 0.015, kBold, 0.01, 100,
+            350, 2048} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  /// The number of latent factors of each item and user
+  uint32_t latent_vector_size() const { return latent_vector_size_; }
+  /// The regularization parameter
+  double lambda() const { return lambda_; }
+  /// The initial SGD step size
+  double learning_rate() const { return learning_rate_; }
+  /// The decay of the SGD step size for kPurdue and kIntel
+  double decay_rate() const { return decay_rate_; }
+  StepFunction step_function() const { return step_function_; }
+  double tolerance() const { return tolerance_; }
+  uint32_t max_rounds() const { return max_rounds_; }
+  uint32_t items_per_block() const { return items_per_block_; }
+  uint32_t users_per_block() const { return users_per_block_; }
+
+  /// SGD over a 2D grid of blocks of items and users, scheduled by
+  /// Fixed2DGraphTiledExecutor so that no two threads update the same item or
+  /// user at the same time.
+  static MatrixCompletionPlan SGDBlockedEdges(
+      uint32_t latent_vector_size = 20, double lambda = 0.05,
+      double learning_rate = 0.012, StepFunction step_function = kBold,
+      double decay_rate = 0.015, uint32_t items_per_block = 350,
+      uint32_t users_per_block = 2048, double tolerance = 0.01,
+      uint32_t max_rounds = 100) {
+    return {
+        kCPU,
+        kSGDBlockedEdges,
+        latent_vector_size,
+        lambda,
+        learning_rate,
+        decay_rate,
+        step_function,
+        tolerance,
+        max_rounds,
+        items_per_block,
+        users_per_block};
+  }
+
+  /// SGD where each thread processes all ratings of an item in turn, locking
+  /// the user of each rating.
+  static MatrixCompletionPlan SGDByItems(
+      uint32_t latent_vector_size = 20, double lambda = 0.05,
+      double learning_rate = 0.012, StepFunction step_function = kBold,
+      double decay_rate = 0.015, double tolerance = 0.01,
+      uint32_t max_rounds = 100) {
+    return {
+        kCPU,
+        kSGDByItems,
+        latent_vector_size,
+        lambda,
+        learning_rate,
+        decay_rate,
+        step_function,
+        tolerance,
+        max_rounds,
+        0,
+        0};
+  }
+
+  /// Alternating least squares: each round solves for every user with the
+  /// items fixed, then for every item with the users fixed, each a
+  /// latent_vector_size square linear system.
+  static MatrixCompletionPlan ALS(
+      uint32_t latent_vector_size = 20, double lambda = 0.05,
+      double tolerance = 0.01, uint32_t max_rounds = 100) {
+    return {
+        kCPU, kALS, latent_vector_size, lambda, 0, 0, kBold, tolerance,
+        max_rounds, 0, 0};
+  }
+};
+
+/// Factor the sparse matrix of ratings stored in pfg into latent vectors of
+/// items and users, such that the rating of an item by a user is predicted by
+/// the dot product of their latent vectors.
+///
+/// Each edge of pfg is a rating: its source is the item and its destination
+/// the user. A bipartite pfg has items with out-edges and users with in-edges,
+/// but a node may be both, in which case it has both latent vectors. The edge
+/// property named rating_property_name must have an integer or floating point
+/// type.
+///
+/// The node properties named item_property_name and user_property_name are
+/// created by this function and may not exist before the call. They have type
+/// fixed_size_list<float>[latent_vector_size] and hold the latent vector of
+/// each node as an item and as a user respectively, or null if the node has no
+/// out-edges or no in-edges respectively.
+KATANA_EXPORT Result<void> MatrixCompletion(
+    PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name, MatrixCompletionPlan plan = {});
+
+KATANA_EXPORT Result<void> MatrixCompletionAssertValid(
+    PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name);
+
+struct KATANA_EXPORT MatrixCompletionStatistics {
+  /// The number of ratings.
+  uint64_t num_ratings;
+  /// The root mean square error of the predicted ratings.
+  double root_mean_square_error;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MatrixCompletionStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+      const std::string& item_property_name,
+      const std::string& user_property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_MINIMUMSPANNINGFOREST_MINIMUMSPANNINGFOREST_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for MinimumSpanningForest, specifying the algorithm
+/// and any parameters associated with it.
+class MinimumSpanningForestPlan : public Plan {
+public:
+  /// Algorithm selectors for minimum spanning forest
+  enum Algorithm { kBoruvka, kFilterKruskal };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint64_t kruskal_threshold_;
+
+  MinimumSpanningForestPlan(
+      Architecture architecture, Algorithm algorithm,
+      uint64_t kruskal_threshold)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        kruskal_threshold_(kruskal_threshold) {}
+
+public:
+  MinimumSpanningForestPlan()
+      : MinimumSpanningForestPlan{kCPU, kBoruvka, 100000} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  uint64_t kruskal_threshold() const { return kruskal_threshold_; }
+
+  /// Parallel Boruvka: every component picks its lightest outgoing edge, the
+  /// picked edges are merged with a lock-free union-find, and edges inside a
+  /// component are filtered out. Once kruskal_threshold edges or fewer remain,
+  /// the rest of the forest is found with FilterKruskal.
+  static MinimumSpanningForestPlan Boruvka(
+      uint64_t kruskal_threshold = 100000) {
+    return {kCPU, kBoruvka, kruskal_threshold};
+  }
+
+  /// Filter-Kruskal [1]: partition the edges around a pivot weight, solve the
+  /// lighter part recursively, drop heavier edges whose endpoints are already
+  /// connected, then solve the rest. Partitioning and filtering are parallel.
+  ///
+  /// [1] V. Osipov, P. Sanders and J. Singler, "The Filter-Kruskal Minimum
+  /// Spanning Tree Algorithm," ALENEX 2009.
+  static MinimumSpanningForestPlan FilterKruskal() {
+    return {kCPU, kFilterKruskal, 0};
+  }
+};
+
+/// Compute a minimum spanning forest of pfg, treating every edge as
+/// undirected, so the two copies of an edge in a symmetric graph are parallel
+/// edges of which at most one is picked. Ties between equal weights are broken
+/// by edge id, so every plan returns the same forest.
+/// The edge property named edge_weight_property_name must have an integer or
+/// floating point type.
+/// The edge property named output_property_name is created by this function
+/// and may not exist before the call. The created property has type uint8_t
+/// and is 1 for edges in the forest and 0 otherwise.
+KATANA_EXPORT Result<void> MinimumSpanningForest(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    MinimumSpanningForestPlan plan = {});
+
+KATANA_EXPORT Result<void> MinimumSpanningForestAssertValid(
+    PropertyFileGraph* pfg, const std::string& edge_weight_property_name,
+    const std::string& property_name);
+
+struct KATANA_EXPORT MinimumSpanningForestStatistics {
+  /// The number of edges in the forest.
+  uint64_t num_forest_edges;
+  /// The number of trees in the forest, i.e., of connected components.
+  uint64_t num_trees;
+  /// The sum of the weights of the forest edges.
+  double total_weight;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<MinimumSpanningForestStatistics> Compute(
+      katana::PropertyFileGraph* pfg,
+      const std::string& edge_weight_property_name,
+      const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
@@ -2,6 +2,8 @@
 #define KATANA_LIBGALOIS_KATANA_ANALYTICS_PAGERANK_PAGERANK_H_
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include "katana/Properties.h"
 #include "katana/PropertyFileGraph.h"
@@ -93,6 +95,15 @@ public:
       float alpha = 0.85) {
     return {kCPU, kPushSynchronous, tolerance, max_iterations, alpha};
   }
+
+  /// Choose an algorithm from the GraphProfile of pfg. If the partition
+  /// metadata of pfg says it is transposed, use a pull algorithm: PullResidual
+  /// on power-law graphs, where most nodes converge long before the few of
+  /// high degree, and PullTopological otherwise. Otherwise, use
+  /// PushAsynchronous.
+  static PagerankPlan Automatic(
+      PropertyFileGraph* pfg, float tolerance = 1.0e-3,
+      unsigned int max_iterations = 1000, float alpha = 0.85);
 };
 
 /// Compute the Page Rank of each node in the graph.
@@ -105,6 +116,86 @@ KATANA_EXPORT Result<void> Pagerank(
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyFileGraph* pfg, const std::string& property_name);
 
+/// A computational plan for personalized Page Rank, specifying the algorithm
+/// and any parameters associated with it.
+///
+/// Both algorithms push residuals forward along out-edges like
+/// PagerankPlan::PushAsynchronous, so the graph does not need to be
+/// transposed. A node is pushed once its residual exceeds tolerance times its
+/// out-degree (Andersen, Chung and Lang), which bounds the work of a seed set
+/// by O(1 / (tolerance * (1 - alpha))) independently of the size of the graph.
+class PersonalizedPagerankPlan : public Plan {
+public:
+  enum Algorithm {
+    kLocalPush,
+    kBatchedPush,
+  };
+
+  /// The largest number of seed sets in one batch of kBatchedPush.
+  constexpr static const uint32_t kMaxBatchSize = 64;
+
+private:
+  Algorithm algorithm_;
+  float tolerance_;
+  float alpha_;
+  uint32_t batch_size_;
+
+  PersonalizedPagerankPlan(
+      Architecture architecture, Algorithm algorithm, float tolerance,
+      float alpha, uint32_t batch_size)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        tolerance_(tolerance),
+        alpha_(alpha),
+        batch_size_(batch_size) {}
+
+public:
+  PersonalizedPagerankPlan()
+      : PersonalizedPagerankPlan(kCPU, kBatchedPush, 1.0e-6, 0.85, 16) {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  float tolerance() const { return tolerance_; }
+  float alpha() const { return alpha_; }
+  uint32_t batch_size() const { return batch_size_; }
+
+  /// Serial forward push for each seed set, with residuals and ranks kept in
+  /// hash tables, so only the nodes around the seeds are touched. Seed sets
+  /// are processed in parallel. Best for many small queries.
+  static PersonalizedPagerankPlan LocalPush(
+      float tolerance = 1.0e-6, float alpha = 0.85) {
+    return {kCPU, kLocalPush, tolerance, alpha, 1};
+  }
+
+  /// Asynchronous parallel push over up to batch_size seed sets at once. Each
+  /// node has a vector of batch_size residuals and ranks, and pushing a node
+  /// scans its edges once for all of the seed sets of the batch.
+  static PersonalizedPagerankPlan BatchedPush(
+      float tolerance = 1.0e-6, float alpha = 0.85, uint32_t batch_size = 16) {
+    return {kCPU, kBatchedPush, tolerance, alpha, batch_size};
+  }
+};
+
+/// Compute the personalized Page Rank of each node for each seed set, i.e.,
+/// the probability of ending at the node in a random walk that starts at a
+/// uniformly chosen node of the seed set and continues with probability alpha
+/// at each step. Walks that reach a node without out-edges are dropped, so
+/// the ranks of a seed set sum to at most 1.
+/// The properties named output_property_names, one per seed set, are created
+/// by this function and may not exist before the call. They have type float.
+KATANA_EXPORT Result<void> PersonalizedPagerank(
+    PropertyFileGraph* pfg, const std::vector<std::vector<uint32_t>>& seed_sets,
+    const std::vector<std::string>& output_property_names,
+    PersonalizedPagerankPlan plan = {});
+
+/// Like PersonalizedPagerank, but return the top_k highest ranked nodes and
+/// their ranks for each seed set, highest first, instead of creating
+/// properties. Nodes with rank 0 are never returned.
+KATANA_EXPORT Result<std::vector<std::vector<std::pair<uint32_t, float>>>>
+PersonalizedPagerankTopK(
+    PropertyFileGraph* pfg, const std::vector<std::vector<uint32_t>>& seed_sets,
+    uint32_t top_k,
+    PersonalizedPagerankPlan plan = PersonalizedPagerankPlan::LocalPush());
+
 struct KATANA_EXPORT PagerankStatistics {
   /// The maximum similarity excluding the comparison node.
   float max_rank;
@@ -25,6 +25,8 @@ public:
     kDijkstra,
     kTopo,
     kTopoTile,
+    kMultiQueue,
+    kOrdered,
     kAutomatic,
   };
 
@@ -101,6 +103,15 @@ public:
   static SsspPlan TopoTile(ptrdiff_t edge_tile_size = 512) {
     return {kCPU, kTopoTile, 0, edge_tile_size};
   }
+
+  /// Label-correcting SSSP scheduled by a relaxed MultiQueue. Requests are
+  /// ordered by their exact distance, so there is no delta to tune.
+  static SsspPlan MultiQueue() { return {kCPU, kMultiQueue, 0, 0}; }
+
+  /// Dijkstra's algorithm run in parallel by the ordered executor. Requests
+  /// commit in distance order, so each node is expanded about once, as in
+  /// Dijkstra().
+  static SsspPlan Ordered() { return {kCPU, kOrdered, 0, 0}; }
 };
 
 template <typename Weight>
@@ -0,0 +1,101 @@
+#ifndef KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+#define KATANA_LIBGALOIS_KATANA_ANALYTICS_STRONGLYCONNECTEDCOMPONENTS_STRONGLYCONNECTEDCOMPONENTS_H_
+
+#include <iostream>
+
+#include "katana/PropertyFileGraph.h"
+#include "katana/analytics/Plan.h"
+
+// API
+
+namespace katana::analytics {
+
+/// A computational plan to for StronglyConnectedComponents, specifying the
+/// algorithm and any parameters associated with it.
+class StronglyConnectedComponentsPlan : public Plan {
+public:
+  /// Algorithm selectors for strongly connected components
+  enum Algorithm { kSerial, kForwardBackward, kMultistep };
+
+  static const int kChunkSize;
+
+  // Don't allow people to directly construct these, so as to have only one
+  // consistent way to configure.
+private:
+  Algorithm algorithm_;
+  uint32_t serial_threshold_;
+
+  StronglyConnectedComponentsPlan(
+      Architecture architecture, Algorithm algorithm, uint32_t serial_threshold)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        serial_threshold_(serial_threshold) {}
+
+public:
+  StronglyConnectedComponentsPlan()
+      : StronglyConnectedComponentsPlan{kCPU, kMultistep, 100000} {}
+
+  Algorithm algorithm() const { return algorithm_; }
+  uint32_t serial_threshold() const { return serial_threshold_; }
+
+  /// Tarjan's algorithm, serial.
+  static StronglyConnectedComponentsPlan Serial() {
+    return {kCPU, kSerial, 0};
+  }
+
+  /// Trim nodes without in- or out-edges, find the component of a high
+  /// degree pivot with a parallel forward-backward search, then recursively
+  /// split the rest into forward, backward and remaining sets. Each set is a
+  /// separate task searched serially.
+  static StronglyConnectedComponentsPlan ForwardBackward() {
+    return {kCPU, kForwardBackward, 0};
+  }
+
+  /// Multistep [1]: trimming and a parallel forward-backward search for the
+  /// large component, then rounds of coloring, where each node takes the
+  /// largest node id that reaches it and each color's root collects its
+  /// component with a backward search. Once serial_threshold nodes or fewer
+  /// are left, the rest is finished with Tarjan's algorithm.
+  ///
+  /// [1] G. M. Slota, S. Rajamanickam and K. Madduri, "BFS and Coloring-Based
+  /// Parallel Algorithms for Strongly Connected Components and Related
+  /// Problems," 2014 IEEE 28th International Parallel and Distributed
+  /// Processing Symposium (IPDPS), 2014, pp. 550-559.
+  static StronglyConnectedComponentsPlan Multistep(
+      uint32_t serial_threshold = 100000) {
+    return {kCPU, kMultistep, serial_threshold};
+  }
+};
+
+/// Compute the strongly connected components of pfg, a directed graph. In-edges
+/// are built transiently, so pfg does not need to be transposed.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call. The created property has type uint64_t; all
+/// nodes of a component have the id of one of them as their component id.
+KATANA_EXPORT Result<void> StronglyConnectedComponents(
+    PropertyFileGraph* pfg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan = {});
+
+KATANA_EXPORT Result<void> StronglyConnectedComponentsAssertValid(
+    PropertyFileGraph* pfg, const std::string& property_name);
+
+struct KATANA_EXPORT StronglyConnectedComponentsStatistics {
+  /// Total number of strongly connected components in the graph.
+  uint64_t total_components;
+  /// Total number of components with more than 1 node.
+  uint64_t total_non_trivial_components;
+  /// The number of nodes present in the largest component.
+  uint64_t largest_component_size;
+  /// The ratio of nodes present in the largest component.
+  double ratio_largest_component;
+
+  /// Print the statistics in a human readable form.
+  void Print(std::ostream& os = std::cout) const;
+
+  static katana::Result<StronglyConnectedComponentsStatistics> Compute(
+      katana::PropertyFileGraph* pfg, const std::string& property_name);
+};
+
+}  // namespace katana::analytics
+
+#endif
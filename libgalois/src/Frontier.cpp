@@ -0,0 +1,88 @@
+#include "katana/Frontier.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "katana/Galois.h"
+
+katana::Frontier
+katana::Frontier::FromNodes(uint32_t num_nodes, std::vector<uint32_t> nodes) {
+  Frontier frontier(num_nodes);
+  frontier.size_ = nodes.size();
+  frontier.nodes_ = std::move(nodes);
+  return frontier;
+}
+
+katana::Frontier
+katana::Frontier::All(uint32_t num_nodes) {
+  Frontier frontier(num_nodes);
+  frontier.is_dense_ = true;
+  frontier.size_ = num_nodes;
+  frontier.bitmap_.resize(num_nodes);
+  auto& bits = frontier.bitmap_.get_vec();
+  katana::do_all(
+      katana::iterate(size_t{0}, bits.size()),
+      [&](size_t i) { bits[i] = ~uint64_t{0}; }, katana::no_stats());
+  // Clear the bits past the last node
+  if (uint32_t tail = num_nodes % DynamicBitset::bits_uint64; tail != 0) {
+    bits[bits.size() - 1] = (uint64_t{1} << tail) - 1;
+  }
+  return frontier;
+}
+
+void
+katana::Frontier::ToDense() {
+  if (is_dense_) {
+    return;
+  }
+  bitmap_.resize(num_nodes_);
+  katana::do_all(
+      katana::iterate(nodes_), [&](uint32_t node) { bitmap_.set(node); },
+      katana::no_stats());
+  nodes_ = std::vector<uint32_t>();
+  is_dense_ = true;
+}
+
+void
+katana::Frontier::ToSparse() {
+  if (!is_dense_) {
+    return;
+  }
+  nodes_ = bitmap_.getOffsets<uint32_t>();
+  bitmap_ = DynamicBitset();
+  is_dense_ = false;
+}
+
+katana::FrontierBuilder::FrontierBuilder(uint32_t num_nodes, bool dense)
+    : num_nodes_(num_nodes), dense_(dense) {
+  if (dense_) {
+    bitmap_.resize(num_nodes_);
+  }
+}
+
+katana::Frontier
+katana::FrontierBuilder::Finish() {
+  Frontier frontier(num_nodes_);
+  if (dense_) {
+    frontier.is_dense_ = true;
+    frontier.size_ = bitmap_.count();
+    frontier.bitmap_ = std::move(bitmap_);
+    return frontier;
+  }
+
+  // Concatenate the nodes each thread added
+  std::vector<uint64_t> offsets(nodes_.size() + 1);
+  for (unsigned i = 0; i < nodes_.size(); ++i) {
+    offsets[i + 1] = offsets[i] + nodes_.getRemote(i)->size();
+  }
+  frontier.size_ = offsets.back();
+  frontier.nodes_.resize(frontier.size_);
+  katana::on_each([&](unsigned tid, unsigned num_threads) {
+    for (unsigned i = tid; i < nodes_.size(); i += num_threads) {
+      const auto& local = *nodes_.getRemote(i);
+      std::copy(
+          local.begin(), local.end(), frontier.nodes_.begin() + offsets[i]);
+    }
+  });
+  return frontier;
+}
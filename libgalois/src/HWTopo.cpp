@@ -1,7 +1,24 @@
 #include "katana/HWTopo.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
 #include <stdexcept>
 
+namespace {
+
+/// The number of CPUs that a quota of quota microseconds every period
+/// microseconds allows, rounded up, or 0 if either is not positive
+unsigned
+quotaThreads(int64_t quota, int64_t period) {
+  if (quota <= 0 || period <= 0) {
+    return 0;
+  }
+  return std::max<int64_t>(1, (quota + period - 1) / period);
+}
+
+}  // namespace
+
 std::vector<int>
 katana::parseCPUList(const std::string& line) {
   std::vector<int> vals;
@@ -36,3 +53,33 @@ katana::parseCPUList(const std::string& line) {
 
   return vals;
 }
+
+unsigned
+katana::parseCgroupCPUMax(const std::string& in) {
+  std::istringstream fields(in);
+  std::string quota;
+  int64_t period = 0;
+  if (!(fields >> quota >> period) || quota == "max") {
+    return 0;
+  }
+  try {
+    return quotaThreads(std::stoll(quota), period);
+  } catch (const std::invalid_argument&) {
+    return 0;
+  } catch (const std::out_of_range&) {
+    return 0;
+  }
+}
+
+unsigned
+katana::parseCgroupCFSQuota(
+    const std::string& quota, const std::string& period) {
+  // An unlimited quota is -1
+  try {
+    return quotaThreads(std::stoll(quota), std::stoll(period));
+  } catch (const std::invalid_argument&) {
+    return 0;
+  } catch (const std::out_of_range&) {
+    return 0;
+  }
+}
@@ -22,14 +22,11 @@
 #include <sys/types.h>
 
 #include <algorithm>
-#include <memory>
-#include <mutex>
 
 #include <mach/mach_interface.h>
 #include <mach/thread_policy.h>
 
 #include "katana/HWTopo.h"
-#include "katana/SimpleLock.h"
 #include "katana/gIO.h"
 
 using namespace katana;
@@ -56,6 +53,8 @@ makeHWTopo() {
   mti.maxThreads = getIntValue("hw.logicalcpu_max");
   mti.maxCores = getIntValue("hw.physicalcpu_max");
   mti.maxNumaNodes = mti.maxSockets;
+  mti.hostThreads = mti.maxThreads;
+  mti.cpuQuotaThreads = 0;
 
   std::vector<ThreadTopoInfo> tti;
   tti.reserve(mti.maxThreads);
@@ -133,14 +132,8 @@ katana::bindThreadSelf(unsigned osContext) {
   return true;
 }
 
-HWTopoInfo
+const HWTopoInfo&
 katana::getHWTopo() {
-  static SimpleLock lock;
-  static std::unique_ptr<HWTopoInfo> data;
-
-  std::lock_guard<SimpleLock> guard(lock);
-  if (!data) {
-    data = std::make_unique<HWTopoInfo>(makeHWTopo());
-  }
-  return *data;
+  static HWTopoInfo data = makeHWTopo();
+  return data;
 }
@@ -17,19 +17,24 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <unistd.h>
+
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cctype>
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <functional>
-#include <memory>
-#include <mutex>
 #include <set>
+#include <sstream>
+#include <string>
 
+#include "katana/Env.h"
 #include "katana/HWTopo.h"
-#include "katana/SimpleLock.h"
+#include "katana/Logging.h"
 #include "katana/gIO.h"
 
 #ifdef KATANA_USE_NUMA
@@ -66,29 +71,32 @@ operator<(const cpuinfo& lhs, const cpuinfo& rhs) {
   return lhs.proc < rhs.proc;
 }
 
-unsigned
-getNumaNode(cpuinfo& c) {
-  static bool warnOnce = false;
 #ifdef KATANA_USE_NUMA
-  static bool numaAvail = false;
-
-  if (!warnOnce) {
-    warnOnce = true;
-    numaAvail = numa_available() >= 0;
-    numaAvail = numaAvail && numa_num_configured_nodes() > 0;
-    if (!numaAvail)
+bool
+numaAvailable() {
+  static bool numaAvail = [] {
+    bool avail = numa_available() >= 0 && numa_num_configured_nodes() > 0;
+    if (!avail)
       katana::gWarn(
           "Numa support configured but not present at runtime.  "
           "Assuming numa topology matches socket topology.");
-  }
+    return avail;
+  }();
+  return numaAvail;
+}
+#endif
 
-  if (!numaAvail)
+unsigned
+getNumaNode(cpuinfo& c) {
+#ifdef KATANA_USE_NUMA
+  if (!numaAvailable())
     return c.physid;
   int i = numa_node_of_cpu(c.proc);
   if (i < 0)
     KATANA_SYS_DIE("failed finding numa node for ", c.proc);
   return i;
 #else
+  static bool warnOnce = false;
   if (!warnOnce) {
     warnOnce = true;
     katana::gWarn(
@@ -141,6 +149,88 @@ parseCPUInfo() {
   return vals;
 }
 
+//! The contents of the file at path, or empty if it cannot be read
+std::string
+readFile(const std::string& path) {
+  std::ifstream in(path);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+const char* const kTopoCacheMagic = "katana-hwtopo-1";
+
+//! Read the CPUs cached by writeTopoCache during the boot with ID boot
+bool
+readTopoCache(
+    const std::string& path, const std::string& boot,
+    std::vector<cpuinfo>* info) {
+  std::ifstream in(path);
+  std::string magic;
+  std::string cachedBoot;
+  if (!(in >> magic >> cachedBoot) || magic != kTopoCacheMagic ||
+      cachedBoot != boot)
+    return false;
+
+  std::vector<cpuinfo> vals;
+  cpuinfo c{};
+  while (in >> c.proc >> c.physid >> c.coreid >> c.numaNode)
+    vals.push_back(c);
+  if (!in.eof() || vals.empty())
+    return false;
+
+  *info = std::move(vals);
+  return true;
+}
+
+void
+writeTopoCache(
+    const std::string& path, const std::string& boot,
+    const std::vector<cpuinfo>& info) {
+  // Write to a temporary file and rename it so that concurrently starting
+  // processes never read a partial cache
+  std::string tmpPath = path + "." + std::to_string(getpid());
+  {
+    std::ofstream out(tmpPath);
+    out << kTopoCacheMagic << " " << boot << "\n";
+    for (auto& c : info)
+      out << c.proc << " " << c.physid << " " << c.coreid << " " << c.numaNode
+          << "\n";
+    if (!out) {
+      katana::gWarn("failed writing topology cache ", tmpPath);
+      unlink(tmpPath.c_str());
+      return;
+    }
+  }
+  if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+    katana::gWarn(
+        "failed writing topology cache ", path, " (", strerror(errno), ")");
+    unlink(tmpPath.c_str());
+  }
+}
+
+//! Parse /proc/cpuinfo or, if KATANA_HWTOPO_CACHE is set, reuse the parse of
+//! an earlier process since the last boot
+std::vector<cpuinfo>
+loadCPUInfo() {
+  std::string path;
+  if (!katana::GetEnv("KATANA_HWTOPO_CACHE", &path) || path.empty())
+    return parseCPUInfo();
+
+  // CPUs can only be replaced across reboots
+  std::string boot = readFile("/proc/sys/kernel/random/boot_id");
+  boot.erase(std::remove_if(boot.begin(), boot.end(), ::isspace), boot.end());
+  if (boot.empty())
+    return parseCPUInfo();
+
+  std::vector<cpuinfo> info;
+  if (readTopoCache(path, boot, &info))
+    return info;
+  info = parseCPUInfo();
+  writeTopoCache(path, boot, info);
+  return info;
+}
+
 unsigned
 countSockets(const std::vector<cpuinfo>& info) {
   std::set<unsigned> pkgs;
@@ -175,8 +265,10 @@ markSMT(std::vector<cpuinfo>& info) {
       info[i].smt = false;
 }
 
+//! Parse the list-format field prefix of /proc/self/status, e.g.,
+//! Cpus_allowed_list:
 std::vector<int>
-parseCPUSet() {
+parseStatusList(const std::string& prefix) {
   std::vector<int> vals;
 
   std::ifstream data("/proc/self/status");
@@ -186,7 +278,6 @@ parseCPUSet() {
   }
 
   std::string line;
-  std::string prefix("Cpus_allowed_list:");
   bool found = false;
   while (true) {
     std::getline(data, line);
@@ -209,6 +300,11 @@ parseCPUSet() {
   return katana::parseCPUList(line);
 }
 
+std::vector<int>
+parseCPUSet() {
+  return parseStatusList("Cpus_allowed_list:");
+}
+
 void
 markValid(std::vector<cpuinfo>& info) {
   auto v = parseCPUSet();
@@ -222,14 +318,153 @@ markValid(std::vector<cpuinfo>& info) {
   }
 }
 
+//! Attribute CPUs on NUMA nodes that the cpuset of the process does not let it
+//! allocate memory on to the nearest node that it does
+void
+markMemoryNodes(std::vector<cpuinfo>& info) {
+#ifdef KATANA_USE_NUMA
+  if (!numaAvailable())
+    return;
+  auto mems = parseStatusList("Mems_allowed_list:");
+  if (mems.empty())
+    return;
+  std::sort(mems.begin(), mems.end());
+  for (auto& c : info) {
+    int node = c.numaNode;
+    if (std::binary_search(mems.begin(), mems.end(), node))
+      continue;
+    c.numaNode = *std::min_element(mems.begin(), mems.end(), [=](int a, int b) {
+      return numa_distance(node, a) < numa_distance(node, b);
+    });
+  }
+#else
+  (void)info;
+#endif
+}
+
+std::vector<std::string>
+split(const std::string& s, char delim) {
+  std::vector<std::string> fields;
+  std::istringstream in(s);
+  std::string field;
+  while (std::getline(in, field, delim))
+    fields.push_back(field);
+  return fields;
+}
+
+bool
+hasCPUController(const std::string& controllers) {
+  auto c = split(controllers, ',');
+  return std::find(c.begin(), c.end(), "cpu") != c.end();
+}
+
+//! Find the directory of the cgroup of this process that CPU quotas apply
+//! to: in the cgroup v1 hierarchy with the cpu controller if there is one
+//! and otherwise in the v2 hierarchy. Set mountPoint to where the hierarchy
+//! is mounted.
+bool
+findCPUCgroup(bool* v2, std::string* mountPoint, std::string* dir) {
+  // Lines are "ID PARENT MAJOR:MINOR ROOT MOUNT_POINT OPTIONS... - TYPE
+  // SOURCE SUPER_OPTIONS"
+  std::ifstream mountInfo("/proc/self/mountinfo");
+  std::string line;
+  std::string root;
+  bool found = false;
+  while (std::getline(mountInfo, line)) {
+    auto fields = split(line, ' ');
+    auto sep = std::find(fields.begin(), fields.end(), "-");
+    if (fields.size() < 5 || fields.end() - sep < 4)
+      continue;
+    if (sep[1] == "cgroup" && hasCPUController(sep[3])) {
+      *v2 = false;
+      root = fields[3];
+      *mountPoint = fields[4];
+      found = true;
+      break;
+    }
+    if (sep[1] == "cgroup2" && !found) {
+      *v2 = true;
+      root = fields[3];
+      *mountPoint = fields[4];
+      found = true;
+    }
+  }
+  if (!found)
+    return false;
+
+  // Lines are "HIERARCHY_ID:CONTROLLERS:PATH"; the v2 hierarchy has ID 0 and
+  // no controllers
+  std::ifstream cgroups("/proc/self/cgroup");
+  std::string path;
+  found = false;
+  while (std::getline(cgroups, line)) {
+    auto first = line.find(':');
+    auto second = line.find(':', first + 1);
+    if (first == std::string::npos || second == std::string::npos)
+      continue;
+    auto controllers = line.substr(first + 1, second - first - 1);
+    if (*v2 ? line.compare(0, second + 1, "0::") == 0
+            : hasCPUController(controllers)) {
+      path = line.substr(second + 1);
+      found = true;
+      break;
+    }
+  }
+  if (!found)
+    return false;
+
+  // The hierarchy may be mounted from a cgroup below its root, e.g., in a
+  // container, in which case path is relative to the hierarchy root and not
+  // to the mount
+  if (root != "/") {
+    if (path.compare(0, root.size(), root) == 0)
+      path = path.substr(root.size());
+    else
+      path.clear();
+  }
+  if (path == "/")
+    path.clear();
+  *dir = *mountPoint + path;
+  return true;
+}
+
+//! The number of CPUs the cgroup CPU quota of this process allows, or 0 if
+//! there is no quota
+unsigned
+getCPUQuotaThreads() {
+  bool v2 = false;
+  std::string mountPoint;
+  std::string dir;
+  if (!findCPUCgroup(&v2, &mountPoint, &dir))
+    return 0;
+
+  // The quotas of ancestors also apply
+  unsigned threads = 0;
+  while (true) {
+    unsigned t =
+        v2 ? katana::parseCgroupCPUMax(readFile(dir + "/cpu.max"))
+           : katana::parseCgroupCFSQuota(
+                 readFile(dir + "/cpu.cfs_quota_us"),
+                 readFile(dir + "/cpu.cfs_period_us"));
+    if (t && (!threads || t < threads))
+      threads = t;
+    if (dir.size() <= mountPoint.size())
+      break;
+    dir = dir.substr(0, dir.find_last_of('/'));
+  }
+  return threads;
+}
+
 katana::HWTopoInfo
 makeHWTopo() {
   katana::MachineTopoInfo retMTI;
 
-  auto info = parseCPUInfo();
+  auto info = loadCPUInfo();
+  retMTI.hostThreads = info.size();
   std::sort(info.begin(), info.end());
   markSMT(info);
   markValid(info);
+  markMemoryNodes(info);
 
   info.erase(
       std::partition(
@@ -238,6 +473,14 @@ makeHWTopo() {
 
   std::sort(info.begin(), info.end());
   markSMT(info);
+
+  // Threads beyond the quota would only be descheduled, at their worst while
+  // spinning. Threads on separate cores, and on as few sockets as possible,
+  // come first.
+  retMTI.cpuQuotaThreads = getCPUQuotaThreads();
+  if (retMTI.cpuQuotaThreads && retMTI.cpuQuotaThreads < info.size())
+    info.resize(retMTI.cpuQuotaThreads);
+
   retMTI.maxSockets = countSockets(info);
   retMTI.maxThreads = info.size();
   retMTI.maxCores = countCores(info);
@@ -278,16 +521,10 @@ makeHWTopo() {
 
 }  // namespace
 
-katana::HWTopoInfo
+const katana::HWTopoInfo&
 katana::getHWTopo() {
-  static SimpleLock lock;
-  static std::unique_ptr<HWTopoInfo> data;
-
-  std::lock_guard<SimpleLock> guard(lock);
-  if (!data) {
-    data = std::make_unique<HWTopoInfo>(makeHWTopo());
-  }
-  return *data;
+  static HWTopoInfo data = makeHWTopo();
+  return data;
 }
 
 //! binds current thread to OS HW context "proc"
@@ -0,0 +1,28 @@
+#include "katana/Executor_Ordered.h"
+
+katana::internal::OrderedContext::~OrderedContext() = default;
+
+void
+katana::internal::OrderedContext::subAcquire(
+    katana::Lockable* lockable, katana::MethodFlag) {
+  if (tryLock(lockable)) {
+    addToNhood(lockable);
+  }
+
+  OrderedContext* other;
+  do {
+    other = static_cast<OrderedContext*>(getOwner(lockable));
+    if (other == this) {
+      return;
+    }
+    if (other && other->id_ < id_) {
+      // An earlier task of the window shares this neighborhood
+      not_ready_.store(true, std::memory_order_relaxed);
+      return;
+    }
+  } while (!stealByCAS(lockable, other));
+
+  if (other) {
+    other->not_ready_.store(true, std::memory_order_relaxed);
+  }
+}
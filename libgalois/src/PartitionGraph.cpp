@@ -0,0 +1,459 @@
+#include "katana/PartitionGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <arrow/compute/api.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Timer.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+/// Return the first node of each of num_partitions ranges of nodes, plus one
+/// past the last node, such that the ranges have about the same total weight.
+/// \param cumulative_weight(n) is the total weight of nodes [0, n].
+template <typename WeightFn>
+std::vector<uint64_t>
+BalancedRanges(
+    uint64_t num_nodes, uint32_t num_partitions, WeightFn cumulative_weight) {
+  std::vector<uint64_t> begins(num_partitions + 1, num_nodes);
+  begins[0] = 0;
+  if (num_nodes == 0) {
+    return begins;
+  }
+
+  uint64_t total = cumulative_weight(num_nodes - 1);
+  using Iter = boost::counting_iterator<uint64_t>;
+  for (uint32_t p = 1; p < num_partitions; ++p) {
+    uint64_t target = total / num_partitions * p +
+                      total % num_partitions * p / num_partitions;
+    begins[p] = *std::partition_point(
+        Iter(begins[p - 1]), Iter(num_nodes),
+        [&](uint64_t n) { return cumulative_weight(n) <= target; });
+  }
+  return begins;
+}
+
+/// The rows x columns grid of a Cartesian vertex-cut; rows is the largest
+/// factor of num_partitions that is at most its square root
+std::pair<uint32_t, uint32_t>
+CartesianGrid(uint32_t num_partitions) {
+  auto rows = static_cast<uint32_t>(std::sqrt(num_partitions));
+  while (num_partitions % rows != 0) {
+    --rows;
+  }
+  return std::make_pair(rows, num_partitions / rows);
+}
+
+std::shared_ptr<arrow::Table>
+TakeRows(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::shared_ptr<arrow::UInt64Array>& indices) {
+  auto take_res =
+      arrow::compute::Take(arrow::Datum(table), arrow::Datum(indices));
+  if (!take_res.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", take_res.status());
+    return nullptr;
+  }
+  return take_res.ValueOrDie().table();
+}
+
+template <typename T>
+std::shared_ptr<arrow::Array>
+MakeArray(const std::vector<T>& values) {
+  typename arrow::CTypeTraits<T>::BuilderType builder;
+  if (auto r = builder.AppendValues(values); !r.ok()) {
+    return nullptr;
+  }
+  std::shared_ptr<arrow::Array> array;
+  if (auto r = builder.Finish(&array); !r.ok()) {
+    return nullptr;
+  }
+  return array;
+}
+
+/// State shared by the construction of every partition
+struct Partitioner {
+  katana::PropertyFileGraph* pfg;
+  uint32_t num_partitions;
+  katana::PartitionPolicy policy;
+  std::pair<uint32_t, uint32_t> grid;
+
+  const uint64_t* out_indices;
+  const uint32_t* out_dests;
+
+  /// First node owned by each partition
+  std::vector<uint64_t> begins;
+  /// Owner of each node
+  std::vector<uint32_t> owner;
+
+  /// The edges of each partition found by each thread, indexed by thread and
+  /// then partition. Threads scan consecutive ranges of sources, so the edges
+  /// of a partition are in order of source when concatenated in thread order.
+  std::vector<std::vector<std::vector<Edge>>> found_edges;
+  /// The mirrors of each partition found by each thread, possibly repeated
+  std::vector<std::vector<std::vector<uint64_t>>> found_mirrors;
+
+  Edge edge_begin(Node n) const { return n > 0 ? out_indices[n - 1] : 0; }
+  Edge edge_end(Node n) const { return out_indices[n]; }
+
+  uint32_t EdgePartition(Node src, Node dst) const {
+    switch (policy) {
+    case katana::PartitionPolicy::kOutgoingEdgeCut:
+      return owner[src];
+    case katana::PartitionPolicy::kIncomingEdgeCut:
+      return owner[dst];
+    case katana::PartitionPolicy::kCartesianVertexCut:
+      return owner[src] / grid.second * grid.second +
+             owner[dst] % grid.second;
+    }
+    KATANA_LOG_FATAL("unknown partition policy");
+  }
+
+  katana::Result<void> AssignOwners();
+
+  /// Assign every edge to its partition and find the mirrors of every
+  /// partition in one parallel pass over the edges
+  void BucketEdges();
+
+  /// Make the partition of host \param p and record the global IDs of its
+  /// mirrors, grouped by owner, in \param mirrors
+  katana::Result<std::unique_ptr<katana::PropertyFileGraph>> MakePartition(
+      uint32_t p, std::vector<std::vector<uint64_t>>* mirrors);
+};
+
+katana::Result<void>
+Partitioner::AssignOwners() {
+  uint64_t num_nodes = pfg->num_nodes();
+
+  // Count one for each node so that graphs with few edges still spread their
+  // nodes over all partitions
+  if (policy == katana::PartitionPolicy::kIncomingEdgeCut) {
+    std::vector<std::atomic<uint64_t>> in_degree(num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, pfg->num_edges()),
+        [&](Edge e) {
+          katana::atomicAdd(in_degree[out_dests[e]], uint64_t{1});
+        },
+        katana::no_stats(), katana::loopname("PartitionInDegree"));
+
+    std::vector<uint64_t> cumulative(num_nodes);
+    katana::do_all(
+        katana::iterate(uint64_t{0}, num_nodes),
+        [&](uint64_t n) { cumulative[n] = in_degree[n].load() + 1; },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        cumulative.begin(), cumulative.end(), cumulative.begin());
+    begins = BalancedRanges(
+        num_nodes, num_partitions, [&](uint64_t n) { return cumulative[n]; });
+  } else {
+    begins = BalancedRanges(num_nodes, num_partitions, [&](uint64_t n) {
+      return out_indices[n] + n + 1;
+    });
+  }
+
+  owner.resize(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_partitions),
+      [&](uint32_t p) {
+        std::fill(
+            owner.begin() + begins[p], owner.begin() + begins[p + 1], p);
+      },
+      katana::no_stats());
+
+  return katana::ResultSuccess();
+}
+
+void
+Partitioner::BucketEdges() {
+  uint32_t num_threads = katana::getActiveThreads();
+  // Give each thread about the same number of edges
+  std::vector<uint64_t> thread_begins = BalancedRanges(
+      pfg->num_nodes(), num_threads,
+      [&](uint64_t n) { return out_indices[n] + n + 1; });
+
+  found_edges.assign(num_threads, {});
+  found_mirrors.assign(num_threads, {});
+  katana::on_each([&](unsigned tid, unsigned) {
+    auto& edges = found_edges[tid];
+    auto& mirrors = found_mirrors[tid];
+    edges.resize(num_partitions);
+    mirrors.resize(num_partitions);
+    for (Node src = thread_begins[tid]; src < thread_begins[tid + 1]; ++src) {
+      for (Edge e = edge_begin(src); e < edge_end(src); ++e) {
+        Node dst = out_dests[e];
+        uint32_t p = EdgePartition(src, dst);
+        edges[p].emplace_back(e);
+        // Sources repeat consecutively, so skip those just recorded
+        if (owner[src] != p &&
+            (mirrors[p].empty() || mirrors[p].back() != src)) {
+          mirrors[p].emplace_back(src);
+        }
+        if (owner[dst] != p) {
+          mirrors[p].emplace_back(dst);
+        }
+      }
+    }
+  });
+}
+
+katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
+Partitioner::MakePartition(
+    uint32_t p, std::vector<std::vector<uint64_t>>* mirrors) {
+  uint64_t num_nodes = pfg->num_nodes();
+  uint32_t num_threads = found_edges.size();
+
+  // Gather the edges and mirrors the threads found for this partition
+  std::vector<uint64_t> edge_offsets(num_threads + 1);
+  std::vector<uint64_t> mirror_offsets(num_threads + 1);
+  for (uint32_t t = 0; t < num_threads; ++t) {
+    edge_offsets[t + 1] = edge_offsets[t] + found_edges[t][p].size();
+    mirror_offsets[t + 1] = mirror_offsets[t] + found_mirrors[t][p].size();
+  }
+  std::vector<Edge> edge_ids(edge_offsets.back());
+  std::vector<uint64_t> mirror_nodes(mirror_offsets.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_threads),
+      [&](uint32_t t) {
+        std::copy(
+            found_edges[t][p].begin(), found_edges[t][p].end(),
+            edge_ids.begin() + edge_offsets[t]);
+        std::copy(
+            found_mirrors[t][p].begin(), found_mirrors[t][p].end(),
+            mirror_nodes.begin() + mirror_offsets[t]);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::sort(mirror_nodes.begin(), mirror_nodes.end());
+  mirror_nodes.erase(
+      std::unique(mirror_nodes.begin(), mirror_nodes.end()),
+      mirror_nodes.end());
+
+  // Masters come first, then mirrors in increasing global ID order
+  uint64_t num_owned = begins[p + 1] - begins[p];
+  uint64_t num_local = num_owned + mirror_nodes.size();
+  if (num_local > std::numeric_limits<Node>::max()) {
+    KATANA_LOG_DEBUG("partition {} has too many nodes: {}", p, num_local);
+    return katana::ErrorCode::InvalidArgument;
+  }
+  std::vector<uint64_t> local_to_global(num_local);
+  std::iota(
+      local_to_global.begin(), local_to_global.begin() + num_owned, begins[p]);
+  std::copy(
+      mirror_nodes.begin(), mirror_nodes.end(),
+      local_to_global.begin() + num_owned);
+  auto to_local = [&](Node n) -> Node {
+    if (owner[n] == p) {
+      return n - begins[p];
+    }
+    return num_owned +
+           (std::lower_bound(mirror_nodes.begin(), mirror_nodes.end(), n) -
+            mirror_nodes.begin());
+  };
+
+  // Mirrors are sorted, so those owned by each partition are contiguous
+  mirrors->assign(num_partitions, {});
+  for (uint32_t h = 0; h < num_partitions; ++h) {
+    if (h == p) {
+      continue;
+    }
+    auto first = std::lower_bound(
+        mirror_nodes.begin(), mirror_nodes.end(), begins[h]);
+    auto last =
+        std::lower_bound(first, mirror_nodes.end(), begins[h + 1]);
+    (*mirrors)[h].assign(first, last);
+  }
+
+  // The edges are in order of global source; put the edges of masters first
+  // to order them by local source
+  auto source = [&](Edge e) -> Node {
+    return std::upper_bound(out_indices, out_indices + num_nodes, e) -
+           out_indices;
+  };
+  auto masters_begin = std::partition_point(
+      edge_ids.begin(), edge_ids.end(),
+      [&](Edge e) { return source(e) < begins[p]; });
+  auto masters_end = std::partition_point(
+      masters_begin, edge_ids.end(),
+      [&](Edge e) { return source(e) < begins[p + 1]; });
+  std::rotate(edge_ids.begin(), masters_begin, masters_end);
+  uint64_t num_local_edges = edge_ids.size();
+
+  std::vector<Node> local_sources(num_local_edges);
+  std::vector<Node> local_dests(num_local_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_local_edges),
+      [&](uint64_t i) {
+        Edge e = edge_ids[i];
+        local_sources[i] = to_local(source(e));
+        local_dests[i] = to_local(out_dests[e]);
+      },
+      katana::no_stats(), katana::loopname("PartitionPlaceEdges"));
+
+  // Count the edges of each local node from the bounds of its run of edges
+  std::vector<uint64_t> local_indices(num_local);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_local_edges),
+      [&](uint64_t i) {
+        if (i + 1 == num_local_edges ||
+            local_sources[i] != local_sources[i + 1]) {
+          local_indices[local_sources[i]] = i + 1;
+        }
+      },
+      katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_local_edges),
+      [&](uint64_t i) {
+        if (i == 0 || local_sources[i] != local_sources[i - 1]) {
+          local_indices[local_sources[i]] -= i;
+        }
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      local_indices.begin(), local_indices.end(), local_indices.begin());
+
+  auto indices_array = MakeArray(local_indices);
+  auto dests_array = MakeArray(local_dests);
+  auto l2g_array = MakeArray(local_to_global);
+  auto edge_ids_array = MakeArray(edge_ids);
+  if (!indices_array || !dests_array || !l2g_array || !edge_ids_array) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto node_table = TakeRows(
+      pfg->node_table(),
+      std::static_pointer_cast<arrow::UInt64Array>(l2g_array));
+  auto edge_table = TakeRows(
+      pfg->edge_table(),
+      std::static_pointer_cast<arrow::UInt64Array>(edge_ids_array));
+  if (!node_table || !edge_table) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto part = std::make_unique<katana::PropertyFileGraph>();
+  if (auto res = part->SetTopology(katana::GraphTopology{
+          .out_indices =
+              std::static_pointer_cast<arrow::UInt64Array>(indices_array),
+          .out_dests =
+              std::static_pointer_cast<arrow::UInt32Array>(dests_array),
+      });
+      !res) {
+    return res.error();
+  }
+  if (auto res = part->AddNodeProperties(node_table); !res) {
+    return res.error();
+  }
+  if (auto res = part->AddEdgeProperties(edge_table); !res) {
+    return res.error();
+  }
+  part->MarkAllPropertiesPersistent();
+  part->set_local_to_global_vector(
+      std::make_shared<arrow::ChunkedArray>(l2g_array));
+
+  // Local nodes at or past num_nodes_with_edges have no outgoing edges
+  uint64_t num_nodes_with_edges = num_local;
+  while (num_nodes_with_edges > 0 &&
+         part->edges(num_nodes_with_edges - 1).empty()) {
+    --num_nodes_with_edges;
+  }
+
+  part->set_partition_metadata(tsuba::PartitionMetadata{
+      .policy_id_ = static_cast<uint32_t>(policy),
+      .transposed_ = false,
+      .is_outgoing_edge_cut_ =
+          policy == katana::PartitionPolicy::kOutgoingEdgeCut,
+      .is_incoming_edge_cut_ =
+          policy == katana::PartitionPolicy::kIncomingEdgeCut,
+      .num_global_nodes_ = num_nodes,
+      .num_edge_ids_ = pfg->num_edges(),
+      .num_edges_ = num_local_edges,
+      .num_nodes_ = static_cast<uint32_t>(num_local),
+      .num_owned_ = static_cast<uint32_t>(num_owned),
+      .num_nodes_with_edges_ = static_cast<uint32_t>(num_nodes_with_edges),
+      .cartesian_grid_ = grid,
+  });
+
+  return std::unique_ptr<katana::PropertyFileGraph>(std::move(part));
+}
+
+}  // namespace
+
+katana::Result<std::vector<std::unique_ptr<katana::PropertyFileGraph>>>
+katana::PartitionGraph(
+    PropertyFileGraph* pfg, uint32_t num_partitions, PartitionPolicy policy) {
+  if (num_partitions == 0) {
+    return ErrorCode::InvalidArgument;
+  }
+  switch (policy) {
+  case PartitionPolicy::kOutgoingEdgeCut:
+  case PartitionPolicy::kIncomingEdgeCut:
+  case PartitionPolicy::kCartesianVertexCut:
+    break;
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+
+  katana::StatTimer timer("PartitionGraph");
+  timer.start();
+
+  Partitioner partitioner{
+      .pfg = pfg,
+      .num_partitions = num_partitions,
+      .policy = policy,
+      .grid = policy == PartitionPolicy::kCartesianVertexCut
+                  ? CartesianGrid(num_partitions)
+                  : std::make_pair(uint32_t{0}, uint32_t{0}),
+      .out_indices = pfg->topology().out_indices->raw_values(),
+      .out_dests = pfg->topology().out_dests->raw_values(),
+      .begins = {},
+      .owner = {},
+      .found_edges = {},
+      .found_mirrors = {},
+  };
+
+  if (auto res = partitioner.AssignOwners(); !res) {
+    return res.error();
+  }
+  partitioner.BucketEdges();
+
+  std::vector<std::unique_ptr<PropertyFileGraph>> partitions;
+  std::vector<std::vector<std::vector<uint64_t>>> mirrors(num_partitions);
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    auto part_res = partitioner.MakePartition(p, &mirrors[p]);
+    if (!part_res) {
+      return part_res.error();
+    }
+    partitions.emplace_back(std::move(part_res.value()));
+  }
+
+  // The masters of p mirrored on h are exactly the mirrors of h owned by p
+  for (uint32_t p = 0; p < num_partitions; ++p) {
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> master_nodes;
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> mirror_nodes;
+    for (uint32_t h = 0; h < num_partitions; ++h) {
+      auto masters = MakeArray(mirrors[h][p]);
+      auto mirrors_of_h = MakeArray(mirrors[p][h]);
+      if (!masters || !mirrors_of_h) {
+        return ErrorCode::ArrowError;
+      }
+      master_nodes.emplace_back(std::make_shared<arrow::ChunkedArray>(masters));
+      mirror_nodes.emplace_back(
+          std::make_shared<arrow::ChunkedArray>(mirrors_of_h));
+    }
+    partitions[p]->set_master_nodes(std::move(master_nodes));
+    partitions[p]->set_mirror_nodes(std::move(mirror_nodes));
+  }
+
+  timer.stop();
+
+  return partitions;
+}
@@ -0,0 +1,340 @@
+#include "katana/PerfCounters.h"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "katana/CacheLineStorage.h"
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Statistics.h"
+#include "katana/ThreadPool.h"
+
+namespace {
+
+constexpr const char* kEventNames[katana::kNumPerfEvents] = {
+    "Cycles", "Instructions", "LLCMisses", "DTLBMisses",
+    "RemoteDRAMAccesses"};
+
+/// A raw reading of the counters of a thread: the time the counters were
+/// enabled and the time they were running, which differ when the kernel
+/// multiplexes counters, followed by the value of each event.
+using Reading = std::array<uint64_t, katana::kNumPerfEvents + 2>;
+
+/// The counters of one thread, opened as a group so that they are read
+/// together and scheduled on the processor together.
+class ThreadCounters {
+public:
+  ThreadCounters() { Open(); }
+
+  ~ThreadCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      close(fd);
+    }
+#endif
+  }
+
+  ThreadCounters(const ThreadCounters&) = delete;
+  ThreadCounters& operator=(const ThreadCounters&) = delete;
+  ThreadCounters(ThreadCounters&&) = delete;
+  ThreadCounters& operator=(ThreadCounters&&) = delete;
+
+  const std::array<bool, katana::kNumPerfEvents>& valid() const {
+    return valid_;
+  }
+
+  /// Read the counters, or return false if there are none.
+  bool Read(Reading* reading) const {
+#ifdef __linux__
+    if (fds_.empty()) {
+      return false;
+    }
+    // The group read format is the number of events, the enabled and running
+    // times and then the value of each event in the order they were opened
+    uint64_t buffer[3 + katana::kNumPerfEvents];
+    ssize_t size = (3 + events_.size()) * sizeof(uint64_t);
+    if (read(fds_.front(), buffer, size) != size) {
+      return false;
+    }
+    reading->fill(0);
+    (*reading)[0] = buffer[1];
+    (*reading)[1] = buffer[2];
+    for (size_t i = 0; i < events_.size(); ++i) {
+      (*reading)[2 + events_[i]] = buffer[3 + i];
+    }
+    return true;
+#else
+    (void)reading;
+    return false;
+#endif
+  }
+
+private:
+  void Open();
+
+  std::vector<int> fds_;
+  /// The event of each of fds_
+  std::vector<int> events_;
+  std::array<bool, katana::kNumPerfEvents> valid_{};
+};
+
+#ifdef __linux__
+
+constexpr uint64_t
+CacheReadMisses(uint64_t cache) {
+  return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+         (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+void
+ThreadCounters::Open() {
+  struct Config {
+    uint32_t type;
+    uint64_t config;
+  };
+  // In the order of PerfEvent. Read misses of the NODE cache are accesses
+  // that miss the local NUMA node.
+  const Config configs[katana::kNumPerfEvents] = {
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HW_CACHE, CacheReadMisses(PERF_COUNT_HW_CACHE_LL)},
+      {PERF_TYPE_HW_CACHE, CacheReadMisses(PERF_COUNT_HW_CACHE_DTLB)},
+      {PERF_TYPE_HW_CACHE, CacheReadMisses(PERF_COUNT_HW_CACHE_NODE)},
+  };
+
+  int error = 0;
+  for (int event = 0; event < katana::kNumPerfEvents; ++event) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = configs[event].type;
+    attr.config = configs[event].config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    int leader = fds_.empty() ? -1 : fds_.front();
+    // Count the calling thread on any CPU
+    int fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+    if (fd < 0) {
+      // Events the processor does not have are left out
+      error = errno;
+      continue;
+    }
+    fds_.emplace_back(fd);
+    events_.emplace_back(event);
+    valid_[event] = true;
+  }
+
+  if (fds_.empty()) {
+    KATANA_WARN_ONCE(
+        "KATANA_PERF_COUNTERS is set but perf_event_open failed: {}; see "
+        "/proc/sys/kernel/perf_event_paranoid",
+        std::strerror(error));
+  }
+}
+
+#else
+
+void
+ThreadCounters::Open() {
+  KATANA_WARN_ONCE(
+      "KATANA_PERF_COUNTERS is set but hardware counters need Linux");
+}
+
+#endif
+
+ThreadCounters&
+GetThreadCounters() {
+  thread_local ThreadCounters counters;
+  return counters;
+}
+
+class PerfState {
+public:
+  PerfState() : enabled_(katana::GetEnv("KATANA_PERF_COUNTERS")) {
+    if (enabled_) {
+      totals_.resize(katana::GetThreadPool().getMaxThreads());
+    }
+  }
+
+  bool enabled() const { return enabled_; }
+
+  /// The counts of thread tid in parallel loops so far
+  katana::PerfCounts& Total(unsigned tid) { return totals_[tid].get(); }
+
+  katana::PerfCounts SumTotals() {
+    katana::PerfCounts sum;
+    for (auto& total : totals_) {
+      sum += total.get();
+    }
+    return sum;
+  }
+
+  void Report(
+      const std::string& region, const katana::PerfCounts& counts,
+      uint64_t num_edges);
+
+private:
+  /// The totals of all regions with the same name
+  struct RegionTotal {
+    katana::PerfCounts counts;
+    /// The counts of the regions for which the number of edges is known
+    katana::PerfCounts edge_counts;
+    uint64_t num_edges{0};
+  };
+
+  bool enabled_;
+  std::vector<katana::CacheLineStorage<katana::PerfCounts>> totals_;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, RegionTotal> regions_;
+};
+
+PerfState&
+GetPerfState() {
+  static PerfState state;
+  return state;
+}
+
+double
+Ratio(uint64_t numerator, uint64_t denominator) {
+  return denominator ? static_cast<double>(numerator) / denominator : 0;
+}
+
+void
+PerfState::Report(
+    const std::string& region, const katana::PerfCounts& counts,
+    uint64_t num_edges) {
+  using katana::PerfEvent;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  RegionTotal& total = regions_[region];
+  RegionTotal before = total;
+  total.counts += counts;
+  if (num_edges) {
+    total.edge_counts += counts;
+    total.num_edges += num_edges;
+  }
+
+  for (int event = 0; event < katana::kNumPerfEvents; ++event) {
+    if (counts.valid[event]) {
+      katana::ReportStatSum(region, kEventNames[event], counts.values[event]);
+    }
+  }
+
+  // StatManager sums the values reported for a region, so report the change
+  // in each ratio of the totals; their sum is then the ratio of the totals.
+  if (counts.IsValid(PerfEvent::kCycles) &&
+      counts.IsValid(PerfEvent::kInstructions)) {
+    double ipc = Ratio(
+        total.counts[PerfEvent::kInstructions],
+        total.counts[PerfEvent::kCycles]);
+    double last_ipc = Ratio(
+        before.counts[PerfEvent::kInstructions],
+        before.counts[PerfEvent::kCycles]);
+    katana::ReportStatSum(region, "IPC", ipc - last_ipc);
+  }
+
+  if (!num_edges) {
+    return;
+  }
+  for (PerfEvent event :
+       {PerfEvent::kCycles, PerfEvent::kLLCMisses, PerfEvent::kDTLBMisses,
+        PerfEvent::kRemoteDRAMAccesses}) {
+    if (!counts.IsValid(event)) {
+      continue;
+    }
+    double per_edge = Ratio(total.edge_counts[event], total.num_edges);
+    double last_per_edge =
+        Ratio(before.edge_counts[event], before.num_edges);
+    katana::ReportStatSum(
+        region,
+        std::string(kEventNames[static_cast<int>(event)]) + "PerEdge",
+        per_edge - last_per_edge);
+  }
+}
+
+}  // namespace
+
+katana::PerfCounts&
+katana::PerfCounts::operator+=(const PerfCounts& other) {
+  for (int event = 0; event < kNumPerfEvents; ++event) {
+    values[event] += other.values[event];
+    valid[event] = valid[event] || other.valid[event];
+  }
+  return *this;
+}
+
+katana::PerfCounts&
+katana::PerfCounts::operator-=(const PerfCounts& other) {
+  for (int event = 0; event < kNumPerfEvents; ++event) {
+    values[event] -= other.values[event];
+  }
+  return *this;
+}
+
+bool
+katana::PerfCountersEnabled() {
+  return GetPerfState().enabled();
+}
+
+katana::PerfCounterScope::PerfCounterScope()
+    : enabled_(PerfCountersEnabled()), start_{} {
+  if (enabled_) {
+    enabled_ = GetThreadCounters().Read(&start_);
+  }
+}
+
+katana::PerfCounterScope::~PerfCounterScope() {
+  if (!enabled_) {
+    return;
+  }
+  const ThreadCounters& counters = GetThreadCounters();
+  Reading end;
+  if (!counters.Read(&end)) {
+    return;
+  }
+  uint64_t running = end[1] - start_[1];
+  if (running == 0) {
+    return;
+  }
+  // Scale up counts of events that were only counted part of the time
+  double scale = static_cast<double>(end[0] - start_[0]) / running;
+
+  PerfCounts delta;
+  for (int event = 0; event < kNumPerfEvents; ++event) {
+    delta.valid[event] = counters.valid()[event];
+    delta.values[event] = (end[2 + event] - start_[2 + event]) * scale;
+  }
+  GetPerfState().Total(ThreadPool::getTID()) += delta;
+}
+
+katana::PerfCounterRegion::PerfCounterRegion(const char* region)
+    : region_(region ? region : "(NULL)"), running_(PerfCountersEnabled()) {
+  if (running_) {
+    start_ = GetPerfState().SumTotals();
+  }
+}
+
+katana::PerfCounterRegion::~PerfCounterRegion() { Stop(); }
+
+void
+katana::PerfCounterRegion::Stop(uint64_t num_edges) {
+  if (!running_) {
+    return;
+  }
+  running_ = false;
+
+  PerfCounts counts = GetPerfState().SumTotals();
+  counts -= start_;
+  GetPerfState().Report(region_, counts, num_edges);
+}
@@ -2,6 +2,12 @@
 
 #include <sys/mman.h>
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
 #include "katana/Logging.h"
 #include "katana/Loops.h"
 #include "katana/Platform.h"
@@ -10,6 +16,7 @@
 #include "tsuba/Errors.h"
 #include "tsuba/FileFrame.h"
 #include "tsuba/RDG.h"
+#include "tsuba/RDGSlice.h"
 #include "tsuba/tsuba.h"
 
 namespace {
@@ -159,6 +166,137 @@ MakePropertyFileGraph(std::unique_ptr<tsuba::RDGFile> rdg_file) {
       std::move(rdg_file), std::move(rdg_result.value()));
 }
 
+/// The rows of the node and edge tables of a graph that make up a subgraph,
+/// and the topology of the subgraph. Null rows mean every row.
+struct SubgraphParts {
+  katana::GraphTopology topology;
+  std::shared_ptr<arrow::UInt64Array> node_rows;
+  std::shared_ptr<arrow::UInt64Array> edge_rows;
+};
+
+constexpr uint64_t kDroppedEdge = std::numeric_limits<uint64_t>::max();
+
+/// Build the topology of a graph of num_sub_nodes nodes from the edges of
+/// another, whose out_indices are given. Node n of the new graph is node
+/// old_node(n) of the other, and new_dest(e) is the destination of edge e in
+/// the new graph or kDroppedEdge. The rows of the kept edges are recorded
+/// unless all num_edges edges of the other graph are kept.
+///
+/// Degrees are counted in parallel, turned into indices with a parallel
+/// prefix sum and then the edges are filled in parallel.
+template <typename OldNodeFn, typename NewDestFn>
+katana::Result<void>
+FilterEdges(
+    const uint64_t* out_indices, uint64_t num_edges, uint64_t num_sub_nodes,
+    const OldNodeFn& old_node, const NewDestFn& new_dest,
+    SubgraphParts* parts) {
+  auto edge_begin = [&](uint64_t node) {
+    return node > 0 ? out_indices[node - 1] : 0;
+  };
+
+  arrow::UInt64Builder indices_builder;
+  if (auto r = indices_builder.Resize(num_sub_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  uint64_t* new_indices = num_sub_nodes ? &indices_builder[0] : nullptr;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_sub_nodes),
+      [&](uint64_t n) {
+        uint64_t node = old_node(n);
+        uint64_t count = 0;
+        for (uint64_t e = edge_begin(node); e < out_indices[node]; ++e) {
+          count += new_dest(e) != kDroppedEdge;
+        }
+        new_indices[n] = count;
+      },
+      katana::steal(), katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      new_indices, new_indices + num_sub_nodes, new_indices);
+  uint64_t num_sub_edges = num_sub_nodes ? new_indices[num_sub_nodes - 1] : 0;
+  bool all_edges_kept = num_sub_edges == num_edges;
+
+  arrow::UInt32Builder dests_builder;
+  arrow::UInt64Builder rows_builder;
+  if (auto r = dests_builder.Resize(num_sub_edges); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = rows_builder.Resize(all_edges_kept ? 0 : num_sub_edges);
+      !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  uint32_t* new_dests = num_sub_edges ? &dests_builder[0] : nullptr;
+  uint64_t* rows =
+      (!all_edges_kept && num_sub_edges) ? &rows_builder[0] : nullptr;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_sub_nodes),
+      [&](uint64_t n) {
+        uint64_t node = old_node(n);
+        uint64_t out = n > 0 ? new_indices[n - 1] : 0;
+        for (uint64_t e = edge_begin(node); e < out_indices[node]; ++e) {
+          uint64_t dest = new_dest(e);
+          if (dest == kDroppedEdge) {
+            continue;
+          }
+          new_dests[out] = dest;
+          if (rows) {
+            rows[out] = e;
+          }
+          ++out;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  if (auto r = indices_builder.Advance(num_sub_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = dests_builder.Advance(num_sub_edges); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = indices_builder.Finish(&parts->topology.out_indices); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = dests_builder.Finish(&parts->topology.out_dests); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (!all_edges_kept) {
+    if (auto r = rows_builder.Advance(num_sub_edges); !r.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+    if (auto r = rows_builder.Finish(&parts->edge_rows); !r.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+/// Gather rows of every column of table, one column at a time
+katana::Result<std::shared_ptr<arrow::Table>>
+TakeRows(
+    const std::shared_ptr<arrow::Table>& table,
+    const std::shared_ptr<arrow::UInt64Array>& rows) {
+  if (!rows) {
+    return table;
+  }
+  auto take_res = arrow::compute::Take(arrow::Datum(table), arrow::Datum(rows));
+  if (!take_res.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", take_res.status());
+    return katana::ErrorCode::ArrowError;
+  }
+  return take_res.ValueOrDie().table();
+}
+
+/// Make the subgraph of pfg described by parts
+katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
+MakeSubgraph(const katana::PropertyFileGraph& pfg, const SubgraphParts& parts) {
+  auto sub = std::make_unique<katana::PropertyFileGraph>();
+  if (auto res = katana::internal::SetTopologyAndTakeRows(
+          pfg, parts.topology, parts.node_rows, parts.edge_rows, sub.get());
+      !res) {
+    return res.error();
+  }
+  return std::unique_ptr<katana::PropertyFileGraph>(std::move(sub));
+}
+
 }  // namespace
 
 katana::PropertyFileGraph::PropertyFileGraph() = default;
@@ -239,6 +377,207 @@ katana::PropertyFileGraph::Make(
       edge_properties);
 }
 
+katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
+katana::PropertyFileGraph::MakeSlice(
+    const std::string& rdg_name, uint64_t node_begin, uint64_t node_end,
+    const std::vector<std::string>& node_properties,
+    const std::vector<std::string>& edge_properties) {
+  auto handle = tsuba::Open(rdg_name, tsuba::kReadOnly);
+  if (!handle) {
+    return handle.error();
+  }
+  tsuba::RDGFile rdg_file(handle.value());
+
+  constexpr uint64_t kHeaderFields = 4;
+  const std::vector<std::string> no_properties;
+
+  // Read just the topology header first to learn where out_indices and
+  // out_dests live in the topology file
+  auto header_res = tsuba::RDGSlice::Make(
+      rdg_file,
+      tsuba::RDGSlice::SliceArg{
+          .node_range = {0, 0},
+          .edge_range = {0, 0},
+          .topo_off = 0,
+          .topo_size = kHeaderFields * sizeof(uint64_t),
+      },
+      &no_properties, &no_properties);
+  if (!header_res) {
+    return header_res.error();
+  }
+  const tsuba::FileView& header_view =
+      header_res.value().topology_file_storage();
+  if (header_view.size() < kHeaderFields * sizeof(uint64_t)) {
+    return ErrorCode::InvalidArgument;
+  }
+  const auto* header = header_view.ptr<uint64_t>();
+  if (header[0] != 1 || header[1] != 0) {
+    return ErrorCode::InvalidArgument;
+  }
+  uint64_t num_nodes = header[2];
+  uint64_t num_edges = header[3];
+  if (header_view.size() < GetGraphSize(num_nodes, num_edges)) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  if (node_begin > node_end || node_end > num_nodes) {
+    KATANA_LOG_DEBUG(
+        "node range [{}, {}) not within graph of {} nodes", node_begin,
+        node_end, num_nodes);
+    return ErrorCode::InvalidArgument;
+  }
+
+  // out_indices[n] is one past the last edge of n, so the edges of the slice
+  // begin at out_indices[node_begin - 1]
+  uint64_t index_begin = node_begin > 0 ? node_begin - 1 : 0;
+  auto node_res = tsuba::RDGSlice::Make(
+      rdg_file,
+      tsuba::RDGSlice::SliceArg{
+          .node_range = {node_begin, node_end},
+          .edge_range = {0, 0},
+          .topo_off = (kHeaderFields + index_begin) * sizeof(uint64_t),
+          .topo_size = (node_end - index_begin) * sizeof(uint64_t),
+      },
+      &node_properties, &no_properties);
+  if (!node_res) {
+    return node_res.error();
+  }
+  const auto* out_indices =
+      node_res.value().topology_file_storage().ptr<uint64_t>(
+          kHeaderFields * sizeof(uint64_t));
+
+  uint64_t edge_begin = node_begin > 0 ? out_indices[node_begin - 1] : 0;
+  uint64_t edge_end =
+      node_end > node_begin ? out_indices[node_end - 1] : edge_begin;
+  if (edge_begin > edge_end || edge_end > num_edges) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  uint64_t dests_off = (kHeaderFields + num_nodes) * sizeof(uint64_t);
+  auto edge_res = tsuba::RDGSlice::Make(
+      rdg_file,
+      tsuba::RDGSlice::SliceArg{
+          .node_range = {0, 0},
+          .edge_range = {edge_begin, edge_end},
+          .topo_off = dests_off + edge_begin * sizeof(uint32_t),
+          .topo_size = (edge_end - edge_begin) * sizeof(uint32_t),
+      },
+      &no_properties, &edge_properties);
+  if (!edge_res) {
+    return edge_res.error();
+  }
+  const auto* out_dests =
+      edge_res.value().topology_file_storage().ptr<uint32_t>(dests_off);
+
+  // The destinations outside the slice become mirror nodes, which follow the
+  // nodes of the slice in increasing global ID order, as in PartitionGraph
+  uint64_t num_slice_nodes = node_end - node_begin;
+  katana::PerThreadStorage<std::vector<uint64_t>> found_mirrors;
+  katana::do_all(
+      katana::iterate(edge_begin, edge_end),
+      [&](uint64_t e) {
+        uint64_t dest = out_dests[e];
+        if (dest < node_begin || dest >= node_end) {
+          found_mirrors.getLocal()->emplace_back(dest);
+        }
+      },
+      katana::no_stats());
+  std::vector<uint64_t> mirrors;
+  for (unsigned t = 0; t < found_mirrors.size(); ++t) {
+    const std::vector<uint64_t>& found = *found_mirrors.getRemote(t);
+    mirrors.insert(mirrors.end(), found.begin(), found.end());
+  }
+  katana::ParallelSTL::sort(mirrors.begin(), mirrors.end());
+  mirrors.erase(std::unique(mirrors.begin(), mirrors.end()), mirrors.end());
+  uint64_t num_local = num_slice_nodes + mirrors.size();
+
+  auto to_local = [&](uint64_t dest) -> uint64_t {
+    if (dest >= node_begin && dest < node_end) {
+      return dest - node_begin;
+    }
+    return num_slice_nodes +
+           (std::lower_bound(mirrors.begin(), mirrors.end(), dest) -
+            mirrors.begin());
+  };
+
+  // Every out-edge of the slice is kept, in order; mirrors have no edges
+  uint64_t num_slice_edges = edge_end - edge_begin;
+  arrow::UInt64Builder indices_builder;
+  arrow::UInt32Builder dests_builder;
+  arrow::UInt64Builder l2g_builder;
+  arrow::UInt64Builder rows_builder;
+  if (auto r = indices_builder.Resize(num_local); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = dests_builder.Resize(num_slice_edges); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = l2g_builder.Resize(num_local); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = rows_builder.Resize(num_local); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  for (uint64_t n = 0; n < num_slice_nodes; ++n) {
+    indices_builder.UnsafeAppend(out_indices[node_begin + n] - edge_begin);
+    l2g_builder.UnsafeAppend(node_begin + n);
+    rows_builder.UnsafeAppend(n);
+  }
+  // Mirror rows of the node properties are null: they belong to the slice
+  // that has the mirror as one of its own nodes
+  for (uint64_t mirror : mirrors) {
+    indices_builder.UnsafeAppend(num_slice_edges);
+    l2g_builder.UnsafeAppend(mirror);
+    rows_builder.UnsafeAppendNull();
+  }
+  uint32_t* new_dests = num_slice_edges ? &dests_builder[0] : nullptr;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_slice_edges),
+      [&](uint64_t e) { new_dests[e] = to_local(out_dests[edge_begin + e]); },
+      katana::no_stats());
+  if (auto r = dests_builder.Advance(num_slice_edges); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  GraphTopology topology;
+  std::shared_ptr<arrow::Array> l2g;
+  std::shared_ptr<arrow::UInt64Array> node_rows;
+  if (auto r = indices_builder.Finish(&topology.out_indices); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = dests_builder.Finish(&topology.out_dests); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = l2g_builder.Finish(&l2g); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = rows_builder.Finish(&node_rows); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  auto node_table = TakeRows(
+      node_res.value().node_table(), mirrors.empty() ? nullptr : node_rows);
+  if (!node_table) {
+    return node_table.error();
+  }
+
+  auto g = std::make_unique<PropertyFileGraph>();
+  if (auto res = g->SetTopology(topology); !res) {
+    return res.error();
+  }
+
+  if (auto res = g->AddNodeProperties(node_table.value()); !res) {
+    return res.error();
+  }
+  if (auto res = g->AddEdgeProperties(edge_res.value().edge_table()); !res) {
+    return res.error();
+  }
+
+  g->set_local_to_global_vector(std::make_shared<arrow::ChunkedArray>(l2g));
+
+  return std::unique_ptr<PropertyFileGraph>(std::move(g));
+}
+
 katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
 katana::PropertyFileGraph::Copy() {
   return Copy(node_schema()->field_names(), edge_schema()->field_names());
@@ -252,6 +591,104 @@ katana::PropertyFileGraph::Copy(
   return Make(rdg_dir(), node_properties, edge_properties);
 }
 
+katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
+katana::PropertyFileGraph::InducedSubgraph(
+    const std::vector<bool>& node_mask) const {
+  uint64_t num_nodes = this->num_nodes();
+  if (node_mask.size() != num_nodes) {
+    KATANA_LOG_DEBUG(
+        "expected a mask of {} nodes found {} instead", num_nodes,
+        node_mask.size());
+    return ErrorCode::InvalidArgument;
+  }
+
+  // new_ids[n] - 1 is the subgraph ID of n if n is selected
+  std::vector<uint64_t> new_ids(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) { new_ids[n] = node_mask[n]; }, katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      new_ids.begin(), new_ids.end(), new_ids.begin());
+  uint64_t num_sub_nodes = num_nodes ? new_ids.back() : 0;
+
+  arrow::UInt64Builder rows_builder;
+  if (auto r = rows_builder.Resize(num_sub_nodes); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  uint64_t* sub_nodes = num_sub_nodes ? &rows_builder[0] : nullptr;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        if (node_mask[n]) {
+          sub_nodes[new_ids[n] - 1] = n;
+        }
+      },
+      katana::no_stats());
+
+  SubgraphParts parts;
+  const uint32_t* out_dests =
+      num_edges() ? topology().out_dests->raw_values() : nullptr;
+  auto new_dest = [&](uint64_t e) {
+    uint32_t dest = out_dests[e];
+    return node_mask[dest] ? new_ids[dest] - 1 : kDroppedEdge;
+  };
+  if (auto res = FilterEdges(
+          topology().out_indices->raw_values(), num_edges(), num_sub_nodes,
+          [&](uint64_t n) { return sub_nodes[n]; }, new_dest, &parts);
+      !res) {
+    return res.error();
+  }
+
+  if (auto r = rows_builder.Advance(num_sub_nodes); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  if (auto r = rows_builder.Finish(&parts.node_rows); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+
+  return MakeSubgraph(*this, parts);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
+katana::PropertyFileGraph::InducedSubgraph(
+    const std::vector<GraphTopology::Node>& node_list) const {
+  std::vector<bool> node_mask(num_nodes());
+  for (auto node : node_list) {
+    if (node >= num_nodes()) {
+      KATANA_LOG_DEBUG("node {} not in graph of {} nodes", node, num_nodes());
+      return ErrorCode::InvalidArgument;
+    }
+    node_mask[node] = true;
+  }
+  return InducedSubgraph(node_mask);
+}
+
+katana::Result<std::unique_ptr<katana::PropertyFileGraph>>
+katana::PropertyFileGraph::EdgeFilteredSubgraph(
+    const std::vector<bool>& edge_mask) const {
+  if (edge_mask.size() != num_edges()) {
+    KATANA_LOG_DEBUG(
+        "expected a mask of {} edges found {} instead", num_edges(),
+        edge_mask.size());
+    return ErrorCode::InvalidArgument;
+  }
+
+  SubgraphParts parts;
+  const uint32_t* out_dests =
+      num_edges() ? topology().out_dests->raw_values() : nullptr;
+  auto new_dest = [&](uint64_t e) {
+    return edge_mask[e] ? uint64_t{out_dests[e]} : kDroppedEdge;
+  };
+  if (auto res = FilterEdges(
+          topology().out_indices->raw_values(), num_edges(), num_nodes(),
+          [](uint64_t n) { return n; }, new_dest, &parts);
+      !res) {
+    return res.error();
+  }
+
+  return MakeSubgraph(*this, parts);
+}
+
 katana::Result<void>
 katana::PropertyFileGraph::WriteGraph(
     const std::string& uri, const std::string& command_line) {
@@ -291,6 +728,38 @@ katana::PropertyFileGraph::Write(
   return WriteGraph(rdg_name, command_line);
 }
 
+katana::Result<void>
+katana::PropertyFileGraph::WritePartitions(
+    const std::vector<std::unique_ptr<PropertyFileGraph>>& partitions,
+    const std::string& rdg_name, const std::string& command_line) {
+  if (auto res = tsuba::Create(rdg_name); !res) {
+    return res.error();
+  }
+  auto open_res = tsuba::Open(rdg_name, tsuba::kReadWrite);
+  if (!open_res) {
+    return open_res.error();
+  }
+  tsuba::RDGFile rdg_file(open_res.value());
+
+  std::vector<tsuba::RDG*> rdgs;
+  std::vector<std::unique_ptr<tsuba::FileFrame>> topologies;
+  for (const auto& part : partitions) {
+    rdgs.emplace_back(&part->rdg_);
+    if (part->rdg_.topology_file_storage().Valid()) {
+      topologies.emplace_back(nullptr);
+      continue;
+    }
+    auto ff_res = WriteTopology(part->topology_);
+    if (!ff_res) {
+      return ff_res.error();
+    }
+    topologies.emplace_back(std::move(ff_res.value()));
+  }
+
+  return tsuba::RDG::StorePartitions(
+      rdg_file, command_line, rdgs, std::move(topologies));
+}
+
 katana::Result<void>
 katana::PropertyFileGraph::AddNodeProperties(
     const std::shared_ptr<arrow::Table>& table) {
@@ -323,6 +792,7 @@ katana::PropertyFileGraph::SetTopology(const katana::GraphTopology& topology) {
     return res.error();
   }
   topology_ = topology;
+  rdg_.set_graph_profile({});
 
   return katana::ResultSuccess();
 }
@@ -372,6 +842,7 @@ katana::SortAllEdgesByDest(katana::PropertyFileGraph* pfg) {
       !r.ok()) {
     return ErrorCode::ArrowError;
   }
+  pfg->set_graph_profile({});
 
   std::shared_ptr<arrow::UInt64Array> out;
   if (permutation_vec_builder.Finish(&out).ok()) {
@@ -493,6 +964,68 @@ katana::SortNodesByDegree(katana::PropertyFileGraph* pfg) {
       katana::iterate(uint64_t{0}, num_edges), [&](uint32_t edge_id) {
         out_dests_view[edge_id] = new_out_dest[edge_id];
       });
+  pfg->set_graph_profile({});
 
   return katana::ResultSuccess();
 }
+
+katana::Result<void>
+katana::internal::SetTopologyAndTakeRows(
+    const PropertyFileGraph& src, const GraphTopology& topology,
+    const std::shared_ptr<arrow::UInt64Array>& node_rows,
+    const std::shared_ptr<arrow::UInt64Array>& edge_rows,
+    PropertyFileGraph* dst) {
+  // Gather everything from src before dst, which may be src, is modified
+  auto node_table = TakeRows(src.node_table(), node_rows);
+  if (!node_table) {
+    return node_table.error();
+  }
+  auto edge_table = TakeRows(src.edge_table(), edge_rows);
+  if (!edge_table) {
+    return edge_table.error();
+  }
+
+  std::shared_ptr<arrow::ChunkedArray> l2g = src.local_to_global_vector();
+  if (node_rows) {
+    if (l2g && static_cast<uint64_t>(l2g->length()) == src.num_nodes()) {
+      auto take_res =
+          arrow::compute::Take(arrow::Datum(l2g), arrow::Datum(node_rows));
+      if (!take_res.ok()) {
+        KATANA_LOG_DEBUG("arrow error: {}", take_res.status());
+        return ErrorCode::ArrowError;
+      }
+      l2g = take_res.ValueOrDie().chunked_array();
+    } else {
+      l2g = std::make_shared<arrow::ChunkedArray>(node_rows);
+    }
+  }
+
+  if (auto res = dst->SetTopology(topology); !res) {
+    return res.error();
+  }
+  for (int i = dst->node_schema()->num_fields(); i > 0; --i) {
+    if (auto res = dst->RemoveNodeProperty(i - 1); !res) {
+      return res.error();
+    }
+  }
+  for (int i = dst->edge_schema()->num_fields(); i > 0; --i) {
+    if (auto res = dst->RemoveEdgeProperty(i - 1); !res) {
+      return res.error();
+    }
+  }
+  if (node_table.value()->num_columns() > 0) {
+    if (auto res = dst->AddNodeProperties(node_table.value()); !res) {
+      return res.error();
+    }
+  }
+  if (edge_table.value()->num_columns() > 0) {
+    if (auto res = dst->AddEdgeProperties(edge_table.value()); !res) {
+      return res.error();
+    }
+  }
+  dst->MarkAllPropertiesPersistent();
+  if (l2g) {
+    dst->set_local_to_global_vector(std::move(l2g));
+  }
+  return ResultSuccess();
+}
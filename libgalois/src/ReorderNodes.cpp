@@ -0,0 +1,771 @@
+#include "katana/ReorderNodes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <arrow/compute/api.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Logging.h"
+#include "katana/Loops.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Timer.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using Edge = katana::GraphTopology::Edge;
+
+constexpr Node kNoNode = std::numeric_limits<Node>::max();
+
+/// Levels of a breadth-first search smaller than this are expanded serially;
+/// graphs with many small components would otherwise spend their time
+/// starting parallel loops.
+constexpr uint64_t kMinParallelLevel = 1024;
+
+/// The most breadth-first searches used to find a pseudo-peripheral node
+constexpr uint32_t kMaxPeripheralSweeps = 8;
+
+struct Csr {
+  const uint64_t* indices{nullptr};
+  const uint32_t* dests{nullptr};
+
+  Edge edge_begin(Node n) const { return n > 0 ? indices[n - 1] : 0; }
+  Edge edge_end(Node n) const { return indices[n]; }
+  uint64_t degree(Node n) const { return edge_end(n) - edge_begin(n); }
+};
+
+/// The in-edges of a graph in CSR form, with the sources of the in-edges of
+/// each node sorted
+struct Transpose {
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> sources;
+
+  Csr csr() const { return Csr{indices.data(), sources.data()}; }
+};
+
+Transpose
+MakeTranspose(const Csr& out, uint64_t num_nodes, uint64_t num_edges) {
+  Transpose in;
+  std::vector<std::atomic<uint64_t>> in_degree(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_edges),
+      [&](Edge e) { katana::atomicAdd(in_degree[out.dests[e]], uint64_t{1}); },
+      katana::no_stats());
+
+  in.indices.resize(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { in.indices[n] = in_degree[n].load(); }, katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      in.indices.begin(), in.indices.end(), in.indices.begin());
+
+  // Fill each node's in-edges from its end; in_degree counts down to zero
+  in.sources.resize(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node src) {
+        for (Edge e = out.edge_begin(src); e < out.edge_end(src); ++e) {
+          Node dest = out.dests[e];
+          uint64_t offset = katana::atomicSub(in_degree[dest], uint64_t{1});
+          in.sources[in.csr().edge_begin(dest) + offset - 1] = src;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  Csr in_csr = in.csr();
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        std::sort(
+            in.sources.begin() + in_csr.edge_begin(n),
+            in.sources.begin() + in_csr.edge_end(n));
+      },
+      katana::steal(), katana::no_stats());
+  return in;
+}
+
+/// Run fn on [begin, end), in parallel if the range is large
+template <typename Fn>
+void
+ForRange(uint64_t begin, uint64_t end, const Fn& fn) {
+  if (end - begin < kMinParallelLevel) {
+    for (uint64_t i = begin; i < end; ++i) {
+      fn(i);
+    }
+    return;
+  }
+  katana::do_all(
+      katana::iterate(begin, end), fn, katana::steal(), katana::no_stats());
+}
+
+/// Return the nodes sorted by degree(n), ascending or descending, and then by
+/// ID
+template <typename DegreeFn>
+std::vector<Node>
+NodesByDegree(uint64_t num_nodes, const DegreeFn& degree, bool ascending) {
+  std::vector<std::pair<uint64_t, Node>> keys(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        uint64_t d = degree(n);
+        keys[n] = std::make_pair(ascending ? d : ~d, n);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::sort(keys.begin(), keys.end());
+
+  std::vector<Node> nodes(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) { nodes[i] = keys[i].second; }, katana::no_stats());
+  return nodes;
+}
+
+std::vector<Node>
+DegreeGroupingOrder(const Csr& csr, uint64_t num_nodes, uint64_t num_edges) {
+  // Groups are [0, avg/2), [avg/2, avg), [avg, 2avg), [2avg, 4avg) and so
+  // on. Sorting by (inverted group, node) puts the highest degrees first and
+  // keeps the relative order of nodes within a group.
+  std::vector<Node> order(num_nodes);
+  if (num_edges == 0) {
+    std::iota(order.begin(), order.end(), Node{0});
+    return order;
+  }
+  double average_degree = double(num_edges) / num_nodes;
+  constexpr uint64_t kMaxGroup = 64;
+  auto group = [&](Node n) -> uint64_t {
+    double degree = csr.degree(n);
+    if (degree < average_degree) {
+      return degree < average_degree / 2 ? 0 : 1;
+    }
+    auto g = 2 + static_cast<uint64_t>(std::log2(degree / average_degree));
+    return std::min(g, kMaxGroup);
+  };
+
+  std::vector<uint64_t> keys(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { keys[n] = ((kMaxGroup - group(n)) << 32) | n; },
+      katana::no_stats());
+  katana::ParallelSTL::sort(keys.begin(), keys.end());
+
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t i) { order[i] = static_cast<Node>(keys[i]); },
+      katana::no_stats());
+  return order;
+}
+
+/// Breadth-first search that stamps the nodes it visits with the number of
+/// the search rather than clearing a visited set, so that each search costs
+/// only the size of the component it visits.
+class PeripheralFinder {
+public:
+  PeripheralFinder(const Csr& csr, uint64_t num_nodes)
+      : csr_(csr), stamps_(num_nodes) {}
+
+  /// Return a node of high eccentricity in the component of start (George
+  /// and Liu): search from start, restart from the node of least degree in
+  /// the last level and stop when the eccentricity stops growing.
+  Node Find(Node start) {
+    Node root = start;
+    uint32_t eccentricity = 0;
+    for (uint32_t sweep = 0; sweep < kMaxPeripheralSweeps; ++sweep) {
+      Node candidate = root;
+      uint32_t depth = Search(root, &candidate);
+      if (sweep > 0 && depth <= eccentricity) {
+        break;
+      }
+      eccentricity = depth;
+      root = candidate;
+    }
+    return root;
+  }
+
+private:
+  /// Return the depth of the search from root and set last to the node of
+  /// least degree, and then ID, in the last level.
+  uint32_t Search(Node root, Node* last) {
+    ++stamp_;
+    stamps_[root] = stamp_;
+    std::vector<Node> level{root};
+    uint32_t depth = 0;
+    while (true) {
+      katana::InsertBag<Node> next;
+      ForRange(0, level.size(), [&](uint64_t i) {
+        Node n = level[i];
+        for (Edge e = csr_.edge_begin(n); e < csr_.edge_end(n); ++e) {
+          Node dest = csr_.dests[e];
+          uint32_t seen = stamps_[dest].load(std::memory_order_relaxed);
+          if (seen != stamp_ &&
+              stamps_[dest].compare_exchange_strong(seen, stamp_)) {
+            next.push(dest);
+          }
+        }
+      });
+      if (next.empty()) {
+        break;
+      }
+      level.assign(next.begin(), next.end());
+      ++depth;
+    }
+    *last = *std::min_element(level.begin(), level.end(), [&](Node a, Node b) {
+      return std::make_pair(csr_.degree(a), a) <
+             std::make_pair(csr_.degree(b), b);
+    });
+    return depth;
+  }
+
+  const Csr& csr_;
+  std::vector<std::atomic<uint32_t>> stamps_;
+  uint32_t stamp_{0};
+};
+
+/// The breadth-first order of Cuthill-McKee (or of plain breadth-first search
+/// if by_degree is false), computed a level at a time in parallel.
+///
+/// The order matches that of a sequential search: every node of the next
+/// level is claimed by its neighbor earliest in the current level, and the
+/// next level is sorted by claiming neighbor, then by degree if by_degree,
+/// then by ID (Karantasis et al., "Parallelization of Reordering Algorithms
+/// for Bandwidth and Wavefront Reduction", SC 2014).
+std::vector<Node>
+BreadthFirstOrder(const Csr& csr, uint64_t num_nodes, bool by_degree) {
+  std::vector<Node> order;
+  order.reserve(num_nodes);
+
+  katana::DynamicBitset placed;
+  placed.resize(num_nodes);
+  // The position in order of the neighbor that claimed each node
+  std::vector<std::atomic<uint64_t>> parent(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) { parent[n] = std::numeric_limits<uint64_t>::max(); },
+      katana::no_stats());
+
+  struct Entry {
+    uint64_t parent;
+    uint64_t degree;
+    Node node;
+
+    bool operator<(const Entry& other) const {
+      return std::tie(parent, degree, node) <
+             std::tie(other.parent, other.degree, other.node);
+    }
+  };
+
+  // Cuthill-McKee starts from low-degree nodes on the periphery; plain
+  // breadth-first search starts from hubs
+  std::vector<Node> starts = NodesByDegree(
+      num_nodes, [&](Node n) { return csr.degree(n); }, by_degree);
+  std::unique_ptr<PeripheralFinder> finder;
+  if (by_degree) {
+    finder = std::make_unique<PeripheralFinder>(csr, num_nodes);
+  }
+
+  for (Node start : starts) {
+    if (placed.test(start)) {
+      continue;
+    }
+    Node root = (finder && csr.degree(start) > 0) ? finder->Find(start) : start;
+    placed.set(root);
+    order.emplace_back(root);
+
+    uint64_t level_begin = order.size() - 1;
+    while (level_begin < order.size()) {
+      uint64_t level_end = order.size();
+      ForRange(level_begin, level_end, [&](uint64_t p) {
+        Node n = order[p];
+        for (Edge e = csr.edge_begin(n); e < csr.edge_end(n); ++e) {
+          Node dest = csr.dests[e];
+          if (!placed.test(dest)) {
+            katana::atomicMin(parent[dest], p);
+          }
+        }
+      });
+
+      katana::InsertBag<Entry> claimed;
+      ForRange(level_begin, level_end, [&](uint64_t p) {
+        Node n = order[p];
+        for (Edge e = csr.edge_begin(n); e < csr.edge_end(n); ++e) {
+          Node dest = csr.dests[e];
+          if (parent[dest].load(std::memory_order_relaxed) == p &&
+              !placed.set(dest)) {
+            claimed.push(Entry{p, by_degree ? csr.degree(dest) : 0, dest});
+          }
+        }
+      });
+
+      std::vector<Entry> next(claimed.begin(), claimed.end());
+      katana::ParallelSTL::sort(next.begin(), next.end());
+      for (const Entry& entry : next) {
+        order.emplace_back(entry.node);
+      }
+      level_begin = level_end;
+    }
+  }
+  return order;
+}
+
+/// A priority queue of nodes with integer keys that change by one at a time,
+/// kept as a list of nodes per key (the unit heap of Gorder)
+class UnitHeap {
+public:
+  explicit UnitHeap(uint64_t size)
+      : key_(size, 0), prev_(size), next_(size), heads_(1, kNoNode) {
+    for (uint64_t i = size; i > 0; --i) {
+      Link(i - 1);
+    }
+  }
+
+  void Increment(Node n) {
+    if (key_[n] == kRemoved) {
+      return;
+    }
+    Unlink(n);
+    ++key_[n];
+    if (key_[n] >= heads_.size()) {
+      heads_.emplace_back(kNoNode);
+    }
+    Link(n);
+    top_ = std::max(top_, key_[n]);
+  }
+
+  void Decrement(Node n) {
+    if (key_[n] == kRemoved) {
+      return;
+    }
+    Unlink(n);
+    --key_[n];
+    Link(n);
+  }
+
+  void Remove(Node n) {
+    Unlink(n);
+    key_[n] = kRemoved;
+  }
+
+  /// Remove and return a node of the largest key
+  Node PopMax() {
+    while (heads_[top_] == kNoNode) {
+      --top_;
+    }
+    Node n = heads_[top_];
+    Remove(n);
+    return n;
+  }
+
+private:
+  static constexpr uint32_t kRemoved = std::numeric_limits<uint32_t>::max();
+
+  void Link(Node n) {
+    Node head = heads_[key_[n]];
+    prev_[n] = kNoNode;
+    next_[n] = head;
+    if (head != kNoNode) {
+      prev_[head] = n;
+    }
+    heads_[key_[n]] = n;
+  }
+
+  void Unlink(Node n) {
+    if (prev_[n] != kNoNode) {
+      next_[prev_[n]] = next_[n];
+    } else {
+      heads_[key_[n]] = next_[n];
+    }
+    if (next_[n] != kNoNode) {
+      prev_[next_[n]] = prev_[n];
+    }
+  }
+
+  std::vector<uint32_t> key_;
+  std::vector<Node> prev_;
+  std::vector<Node> next_;
+  std::vector<Node> heads_;
+  uint32_t top_{0};
+};
+
+std::vector<Node>
+GorderOrder(
+    const Csr& out, uint64_t num_nodes, uint64_t num_edges, uint32_t window) {
+  std::vector<Node> order;
+  order.reserve(num_nodes);
+  if (num_nodes == 0) {
+    return order;
+  }
+  Transpose transpose = MakeTranspose(out, num_nodes, num_edges);
+  const Csr in = transpose.csr();
+
+  // Counting the siblings of a node through a hub costs the hub's degree and
+  // says little about locality, so hubs are skipped as in Gorder
+  auto hub_degree = static_cast<uint64_t>(std::sqrt(double(num_nodes)));
+
+  UnitHeap heap(num_nodes);
+  // Add delta (one or minus one) to the score of every node that has an edge
+  // to or from n or that shares an in-neighbor with n
+  auto update = [&](Node n, bool increment) {
+    auto apply = [&](Node u) {
+      if (increment) {
+        heap.Increment(u);
+      } else {
+        heap.Decrement(u);
+      }
+    };
+    for (Edge e = out.edge_begin(n); e < out.edge_end(n); ++e) {
+      apply(out.dests[e]);
+    }
+    for (Edge e = in.edge_begin(n); e < in.edge_end(n); ++e) {
+      Node w = in.dests[e];
+      apply(w);
+      if (out.degree(w) > hub_degree) {
+        continue;
+      }
+      for (Edge f = out.edge_begin(w); f < out.edge_end(w); ++f) {
+        if (out.dests[f] != n) {
+          apply(out.dests[f]);
+        }
+      }
+    }
+  };
+
+  // Start from the node of highest in-degree
+  Node start = 0;
+  for (Node n = 1; n < num_nodes; ++n) {
+    if (in.degree(n) > in.degree(start)) {
+      start = n;
+    }
+  }
+  heap.Remove(start);
+  order.emplace_back(start);
+  update(start, true);
+
+  while (order.size() < num_nodes) {
+    Node n = heap.PopMax();
+    order.emplace_back(n);
+    update(n, true);
+    if (order.size() > window) {
+      update(order[order.size() - 1 - window], false);
+    }
+  }
+  return order;
+}
+
+/// Rabbit order: incremental aggregation of communities followed by a
+/// depth-first walk of the resulting dendrogram.
+///
+/// Adjacency lists are aggregated lazily: merging u into v appends u's list
+/// to v's, and a list is only compacted, by mapping neighbors to their
+/// current communities and summing the weights of duplicates, when its
+/// community is considered for merging.
+std::vector<Node>
+CommunityOrder(const Csr& out, uint64_t num_nodes, uint64_t num_edges) {
+  struct Neighbor {
+    Node node;
+    uint64_t weight;
+  };
+
+  Transpose transpose = MakeTranspose(out, num_nodes, num_edges);
+  const Csr in = transpose.csr();
+
+  // Treat every edge as undirected, dropping self-loops
+  std::vector<std::vector<Neighbor>> adjacency(num_nodes);
+  std::vector<uint64_t> degree(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](Node n) {
+        auto& list = adjacency[n];
+        list.reserve(out.degree(n) + in.degree(n));
+        for (const Csr* csr : {&out, &in}) {
+          for (Edge e = csr->edge_begin(n); e < csr->edge_end(n); ++e) {
+            if (csr->dests[e] != n) {
+              list.emplace_back(Neighbor{csr->dests[e], 1});
+            }
+          }
+        }
+        degree[n] = list.size();
+      },
+      katana::steal(), katana::no_stats());
+  double total_weight = std::accumulate(degree.begin(), degree.end(), 0.0);
+
+  // community[n] leads, through path compression, to the community n was
+  // merged into; the dendrogram is kept as lists of children
+  std::vector<Node> community(num_nodes);
+  std::iota(community.begin(), community.end(), Node{0});
+  auto find = [&](Node n) {
+    Node root = n;
+    while (community[root] != root) {
+      root = community[root];
+    }
+    while (community[n] != root) {
+      n = std::exchange(community[n], root);
+    }
+    return root;
+  };
+  std::vector<Node> first_child(num_nodes, kNoNode);
+  std::vector<Node> next_sibling(num_nodes, kNoNode);
+  std::vector<Node> top_level;
+
+  std::vector<Node> visit_order =
+      NodesByDegree(num_nodes, [&](Node n) { return degree[n]; }, true);
+  for (Node u : visit_order) {
+    auto& list = adjacency[u];
+    for (auto& neighbor : list) {
+      neighbor.node = find(neighbor.node);
+    }
+    std::sort(list.begin(), list.end(), [](const auto& a, const auto& b) {
+      return a.node < b.node;
+    });
+    size_t size = 0;
+    for (const auto& neighbor : list) {
+      if (neighbor.node == u) {
+        continue;
+      }
+      if (size > 0 && list[size - 1].node == neighbor.node) {
+        list[size - 1].weight += neighbor.weight;
+      } else {
+        list[size++] = neighbor;
+      }
+    }
+    list.resize(size);
+
+    // Merging u and v changes modularity by a multiple of
+    // w(u, v) / total - degree(u) degree(v) / total^2
+    Node best = kNoNode;
+    double best_gain = 0;
+    for (const auto& neighbor : list) {
+      double gain = neighbor.weight * total_weight -
+                    double(degree[u]) * double(degree[neighbor.node]);
+      if (gain > best_gain) {
+        best = neighbor.node;
+        best_gain = gain;
+      }
+    }
+    if (best == kNoNode) {
+      top_level.emplace_back(u);
+      continue;
+    }
+
+    community[u] = best;
+    degree[best] += degree[u];
+    auto& best_list = adjacency[best];
+    best_list.insert(best_list.end(), list.begin(), list.end());
+    std::vector<Neighbor>().swap(list);
+    next_sibling[u] = first_child[best];
+    first_child[best] = u;
+  }
+
+  std::vector<Node> order;
+  order.reserve(num_nodes);
+  std::vector<Node> stack;
+  for (Node root : top_level) {
+    stack.emplace_back(root);
+    while (!stack.empty()) {
+      Node n = stack.back();
+      stack.pop_back();
+      order.emplace_back(n);
+      for (Node c = first_child[n]; c != kNoNode; c = next_sibling[c]) {
+        stack.emplace_back(c);
+      }
+    }
+  }
+  return order;
+}
+
+/// Mark the first length values of builder, which were written in place, as
+/// appended and finish it
+template <typename Builder, typename Array>
+katana::Result<void>
+FinishBuilder(Builder* builder, int64_t length, std::shared_ptr<Array>* out) {
+  if (auto r = builder->Advance(length); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = builder->Finish(out); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  return katana::ResultSuccess();
+}
+
+/// Renumber the nodes of pfg so that node i is order[i], permuting its
+/// topology and properties, and return order as an array
+katana::Result<std::shared_ptr<arrow::UInt64Array>>
+Permute(
+    katana::PropertyFileGraph* pfg, const Csr& csr,
+    const std::vector<Node>& order) {
+  uint64_t num_nodes = pfg->num_nodes();
+  uint64_t num_edges = pfg->num_edges();
+
+  arrow::UInt64Builder new_to_old_builder;
+  arrow::UInt64Builder indices_builder;
+  if (auto r = new_to_old_builder.Resize(num_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = indices_builder.Resize(num_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  uint64_t* new_to_old = num_nodes ? &new_to_old_builder[0] : nullptr;
+  uint64_t* new_indices = num_nodes ? &indices_builder[0] : nullptr;
+
+  std::vector<Node> old_to_new(num_nodes);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        new_to_old[n] = order[n];
+        old_to_new[order[n]] = n;
+        new_indices[n] = csr.degree(order[n]);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      new_indices, new_indices + num_nodes, new_indices);
+
+  arrow::UInt32Builder dests_builder;
+  arrow::UInt64Builder edge_rows_builder;
+  if (auto r = dests_builder.Resize(num_edges); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = edge_rows_builder.Resize(num_edges); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  uint32_t* new_dests = num_edges ? &dests_builder[0] : nullptr;
+  uint64_t* edge_rows = num_edges ? &edge_rows_builder[0] : nullptr;
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_nodes),
+      [&](uint64_t n) {
+        Node old = order[n];
+        uint64_t out = n > 0 ? new_indices[n - 1] : 0;
+        for (Edge e = csr.edge_begin(old); e < csr.edge_end(old); ++e) {
+          new_dests[out] = old_to_new[csr.dests[e]];
+          edge_rows[out] = e;
+          ++out;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  std::shared_ptr<arrow::UInt64Array> new_to_old_array;
+  std::shared_ptr<arrow::UInt64Array> edge_rows_array;
+  katana::GraphTopology topology;
+  if (auto res = FinishBuilder(
+          &new_to_old_builder, num_nodes, &new_to_old_array);
+      !res) {
+    return res.error();
+  }
+  if (auto res =
+          FinishBuilder(&indices_builder, num_nodes, &topology.out_indices);
+      !res) {
+    return res.error();
+  }
+  if (auto res = FinishBuilder(&dests_builder, num_edges, &topology.out_dests);
+      !res) {
+    return res.error();
+  }
+  if (auto res = FinishBuilder(&edge_rows_builder, num_edges, &edge_rows_array);
+      !res) {
+    return res.error();
+  }
+
+  if (auto res = katana::internal::SetTopologyAndTakeRows(
+          *pfg, topology, new_to_old_array, edge_rows_array, pfg);
+      !res) {
+    return res.error();
+  }
+
+  return new_to_old_array;
+}
+
+}  // namespace
+
+katana::Result<std::shared_ptr<arrow::UInt64Array>>
+katana::ReorderNodes(PropertyFileGraph* pfg, ReorderPlan plan) {
+  if (pfg->partition_metadata().policy_id_ != 0) {
+    KATANA_LOG_DEBUG("cannot reorder the nodes of a partition");
+    return ErrorCode::InvalidArgument;
+  }
+
+  katana::StatTimer timer("ReorderNodes");
+  timer.start();
+
+  uint64_t num_nodes = pfg->num_nodes();
+  uint64_t num_edges = pfg->num_edges();
+  Csr csr{
+      num_nodes ? pfg->topology().out_indices->raw_values() : nullptr,
+      num_edges ? pfg->topology().out_dests->raw_values() : nullptr};
+
+  std::vector<Node> order;
+  switch (plan.algorithm()) {
+  case ReorderPlan::kDegreeGrouping:
+    order = DegreeGroupingOrder(csr, num_nodes, num_edges);
+    break;
+  case ReorderPlan::kBreadthFirst:
+    order = BreadthFirstOrder(csr, num_nodes, false);
+    break;
+  case ReorderPlan::kReverseCuthillMcKee:
+    order = BreadthFirstOrder(csr, num_nodes, true);
+    std::reverse(order.begin(), order.end());
+    break;
+  case ReorderPlan::kGorder:
+    order = GorderOrder(csr, num_nodes, num_edges, plan.window());
+    break;
+  case ReorderPlan::kCommunity:
+    order = CommunityOrder(csr, num_nodes, num_edges);
+    break;
+  default:
+    return ErrorCode::InvalidArgument;
+  }
+  KATANA_LOG_DEBUG_ASSERT(order.size() == num_nodes);
+
+  auto res = Permute(pfg, csr, order);
+  timer.stop();
+  return res;
+}
+
+katana::Result<std::shared_ptr<arrow::UInt64Array>>
+katana::InvertPermutation(
+    const std::shared_ptr<arrow::UInt64Array>& new_to_old) {
+  uint64_t size = new_to_old->length();
+  arrow::UInt64Builder builder;
+  if (auto r = builder.Resize(size); !r.ok()) {
+    return ErrorCode::ArrowError;
+  }
+  uint64_t* old_to_new = size ? &builder[0] : nullptr;
+  const uint64_t* values = new_to_old->raw_values();
+  katana::do_all(
+      katana::iterate(uint64_t{0}, size),
+      [&](uint64_t n) { old_to_new[values[n]] = n; }, katana::no_stats());
+
+  std::shared_ptr<arrow::UInt64Array> out;
+  if (auto res = FinishBuilder(&builder, size, &out); !res) {
+    return res.error();
+  }
+  return out;
+}
+
+katana::Result<std::shared_ptr<arrow::ChunkedArray>>
+katana::RestoreNodeOrder(
+    const std::shared_ptr<arrow::ChunkedArray>& property,
+    const std::shared_ptr<arrow::UInt64Array>& new_to_old) {
+  if (property->length() != new_to_old->length()) {
+    KATANA_LOG_DEBUG(
+        "expected a property of {} nodes found {} instead",
+        new_to_old->length(), property->length());
+    return ErrorCode::InvalidArgument;
+  }
+  auto old_to_new = InvertPermutation(new_to_old);
+  if (!old_to_new) {
+    return old_to_new.error();
+  }
+  auto take_res = arrow::compute::Take(
+      arrow::Datum(property), arrow::Datum(old_to_new.value()));
+  if (!take_res.ok()) {
+    KATANA_LOG_DEBUG("arrow error: {}", take_res.status());
+    return ErrorCode::ArrowError;
+  }
+  return take_res.ValueOrDie().chunked_array();
+}
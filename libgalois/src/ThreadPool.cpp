@@ -22,9 +22,18 @@
 #include <algorithm>
 #include <iostream>
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+
 #include "katana/Env.h"
 #include "katana/HWTopo.h"
 #include "katana/Logging.h"
+#include "katana/Trace.h"
 
 // Forward declare this to avoid including PerThreadStorage.
 // We avoid this to stress that the thread Pool MUST NOT depend on PTS.
@@ -38,11 +47,88 @@ using katana::ThreadPool;
 
 thread_local ThreadPool::per_signal ThreadPool::my_box;
 
+namespace {
+
+/// The spin budget if it cannot be calibrated, e.g., with only one thread
+constexpr uint64_t kDefaultSpinBudgetNs = 50000;
+constexpr uint64_t kMinSpinBudgetNs = 1000;
+constexpr uint64_t kMaxSpinBudgetNs = 1000000;
+/// The number of runs over which the wakeup of parked threads is timed
+constexpr int kCalibrationRuns = 4;
+/// The number of pauses between checks of the clock while spinning
+constexpr int kPausesPerClockCheck = 64;
+
+uint64_t
+NanosecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+}  // namespace
+
+void
+ThreadPool::per_signal::wakeup() {
+  done = 0;
+  wakeupTime = std::chrono::steady_clock::now();
+  if (state.exchange(kReleased) != kParked) {
+    return;
+  }
+#ifdef __linux__
+  syscall(SYS_futex, &state, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+  std::lock_guard<std::mutex> lg(m);
+  cv.notify_one();
+#endif
+}
+
+void
+ThreadPool::per_signal::wait(bool fastmode, uint64_t spinBudgetNs) {
+  auto released = [this] {
+    return state.load(std::memory_order_acquire) == kReleased;
+  };
+
+  parked = false;
+  if (fastmode) {
+    while (!released()) {
+      asmPause();
+    }
+  } else if (!released()) {
+    auto start = std::chrono::steady_clock::now();
+    while (!released() && NanosecondsSince(start) < spinBudgetNs) {
+      for (int i = 0; i < kPausesPerClockCheck && !released(); ++i) {
+        asmPause();
+      }
+    }
+
+    // A wakeup after the exchange sees kParked and wakes this thread
+    uint32_t expected = kIdle;
+    if (state.compare_exchange_strong(expected, kParked)) {
+      parked = true;
+#ifdef __linux__
+      while (state.load() == kParked) {
+        syscall(
+            SYS_futex, &state, FUTEX_WAIT_PRIVATE, kParked, nullptr, nullptr,
+            0);
+      }
+#else
+      std::unique_lock<std::mutex> lg(m);
+      cv.wait(lg, [this] { return state.load() != kParked; });
+#endif
+    }
+  }
+
+  latencyNs = NanosecondsSince(wakeupTime);
+  // The next wakeup comes after this thread is done with this run
+  state.store(kIdle, std::memory_order_relaxed);
+}
+
 ThreadPool::ThreadPool()
     : mi(getHWTopo().machineTopoInfo),
       reserved(0),
       masterFastmode(false),
-      running(false) {
+      running(false),
+      spinBudgetNs(kDefaultSpinBudgetNs) {
   signals.resize(mi.maxThreads);
   initThread(0);
 
@@ -57,6 +143,42 @@ ThreadPool::ThreadPool()
   })) {
     std::atomic_thread_fence(std::memory_order_seq_cst);
   }
+
+  int spinUs = 0;
+  if (GetEnv("KATANA_WAKEUP_SPIN_US", &spinUs)) {
+    spinBudgetNs = std::max(0, spinUs) * uint64_t{1000};
+  } else {
+    calibrateSpinBudget();
+  }
+}
+
+void
+ThreadPool::calibrateSpinBudget() {
+  // Spinning for as long as waking up a parked thread takes is within a
+  // factor of two of the best choice between spinning and parking in
+  // hindsight, however long a thread waits
+  spinBudgetNs = 0;
+  uint64_t totalNs = 0;
+  uint64_t parked = 0;
+  for (int i = 0; i < kCalibrationRuns; ++i) {
+    // Time only wakeups of threads that are already asleep
+    for (unsigned tid = 1; tid < mi.maxThreads; ++tid) {
+      while (signals[tid]->state.load() != per_signal::kParked) {
+        std::this_thread::yield();
+      }
+    }
+    run(mi.maxThreads, []() {});
+    parked += lastWakeupStats.parked;
+    totalNs += lastWakeupStats.totalLatencyNs;
+  }
+  lastWakeupStats = WakeupStats{};
+
+  if (!parked) {
+    spinBudgetNs = kDefaultSpinBudgetNs;
+    return;
+  }
+  spinBudgetNs =
+      std::clamp(totalNs / parked, kMinSpinBudgetNs, kMaxSpinBudgetNs);
 }
 
 ThreadPool::~ThreadPool() {
@@ -130,6 +252,7 @@ void
 ThreadPool::initThread(unsigned tid) {
   signals[tid] = &my_box;
   my_box.topo = getHWTopo().threadTopoInfo[tid];
+  SetTraceThreadName(tid == 0 ? "main" : fmt::format("worker {}", tid));
   // Initialize
   initPTS(mi.maxThreads);
 
@@ -158,8 +281,8 @@ ThreadPool::threadLoop(unsigned tid) {
   bool fastmode = false;
   auto& me = my_box;
   do {
-    me.wait(fastmode);
-    cascade(fastmode);
+    me.wait(fastmode, spinBudgetNs.load(std::memory_order_relaxed));
+    cascade();
     try {
       work();
     } catch (const shutdown_ty&) {
@@ -202,7 +325,7 @@ ThreadPool::decascade() {
 }
 
 void
-ThreadPool::cascade(bool fastmode) {
+ThreadPool::cascade() {
   auto& me = my_box;
   KATANA_LOG_DEBUG_ASSERT(me.wbegin <= me.wend);
 
@@ -216,13 +339,13 @@ ThreadPool::cascade(bool fastmode) {
   auto* child1 = signals[me.wbegin];
   child1->wbegin = me.wbegin + 1;
   child1->wend = midpoint;
-  child1->wakeup(fastmode);
+  child1->wakeup();
 
   if (midpoint < me.wend) {
     auto* child2 = signals[midpoint];
     child2->wbegin = midpoint + 1;
     child2->wend = me.wend;
-    child2->wakeup(fastmode);
+    child2->wakeup();
   }
 }
 
@@ -240,7 +363,7 @@ ThreadPool::runInternal(unsigned num) {
 
   KATANA_LOG_DEBUG_ASSERT(!masterFastmode || masterFastmode == num);
   // launch threads
-  cascade(masterFastmode);
+  cascade();
   // Do master thread work
   try {
     work();
@@ -250,6 +373,17 @@ ThreadPool::runInternal(unsigned num) {
   }
   // wait for children
   decascade();
+
+  lastWakeupStats = WakeupStats{};
+  for (unsigned tid = 1; tid < num; ++tid) {
+    const per_signal& s = *signals[tid];
+    ++lastWakeupStats.wakeups;
+    lastWakeupStats.parked += s.parked;
+    lastWakeupStats.totalLatencyNs += s.latencyNs;
+    lastWakeupStats.maxLatencyNs =
+        std::max(lastWakeupStats.maxLatencyNs, s.latencyNs);
+  }
+
   // Clean up
   work = nullptr;
   running = false;
@@ -270,7 +404,7 @@ ThreadPool::runDedicated(std::function<void(void)>& f) {
   child->wbegin = 0;
   child->wend = 0;
   child->done = 0;
-  child->wakeup(masterFastmode);
+  child->wakeup();
   while (!child->done) {
     asmPause();
   }
@@ -0,0 +1,274 @@
+#include "katana/analytics/GraphProfile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/DynamicBitset.h"
+#include "katana/Env.h"
+#include "katana/Galois.h"
+#include "katana/JSON.h"
+#include "katana/Logging.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+namespace katana::analytics {
+
+void
+to_json(nlohmann::json& j, const GraphProfile& profile) {
+  j = nlohmann::json{
+      {"num_nodes", profile.num_nodes},
+      {"num_edges", profile.num_edges},
+      {"average_degree", profile.average_degree},
+      {"degree_skew", profile.degree_skew},
+      {"estimated_diameter", profile.estimated_diameter},
+      {"edges_sorted", profile.edges_sorted},
+  };
+}
+
+void
+from_json(const nlohmann::json& j, GraphProfile& profile) {
+  j.at("num_nodes").get_to(profile.num_nodes);
+  j.at("num_edges").get_to(profile.num_edges);
+  j.at("average_degree").get_to(profile.average_degree);
+  j.at("degree_skew").get_to(profile.degree_skew);
+  j.at("estimated_diameter").get_to(profile.estimated_diameter);
+  j.at("edges_sorted").get_to(profile.edges_sorted);
+}
+
+void
+from_json(const nlohmann::json& j, PlanCalibration& calibration) {
+  calibration.skew_threshold =
+      j.value("skew_threshold", calibration.skew_threshold);
+  calibration.min_skewed_average_degree = j.value(
+      "min_skewed_average_degree", calibration.min_skewed_average_degree);
+  calibration.high_diameter =
+      j.value("high_diameter", calibration.high_diameter);
+  calibration.edge_tile_size =
+      j.value("edge_tile_size", calibration.edge_tile_size);
+  calibration.afforest_min_average_degree = j.value(
+      "afforest_min_average_degree", calibration.afforest_min_average_degree);
+}
+
+}  // namespace katana::analytics
+
+namespace {
+
+constexpr uint32_t kNumDegreeSamples = 1000;
+/// The most breadth-first searches used to estimate the diameter
+constexpr uint32_t kNumDiameterSweeps = 4;
+
+double
+EstimateDegreeSkew(const katana::PropertyFileGraph& pfg) {
+  if (pfg.num_edges() == 0) {
+    return 0;
+  }
+  katana::analytics::SourcePicker picker(pfg);
+  std::vector<uint64_t> samples(
+      std::min<uint64_t>(kNumDegreeSamples, pfg.num_nodes()));
+  uint64_t sample_total = 0;
+  for (auto& sample : samples) {
+    sample = pfg.edges(picker.PickNext()).size();
+    sample_total += sample;
+  }
+  std::nth_element(
+      samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+  double sample_median = samples[samples.size() / 2];
+  double sample_average = static_cast<double>(sample_total) / samples.size();
+  return sample_average / sample_median;
+}
+
+/// Breadth-first search from source; return the distance of the farthest
+/// reachable node and set farthest to one such node.
+uint32_t
+Eccentricity(
+    const katana::PropertyFileGraph& pfg, uint32_t source, uint32_t* farthest,
+    katana::DynamicBitset* visited) {
+  visited->reset();
+  visited->set(source);
+
+  katana::InsertBag<uint32_t> frontiers[2];
+  katana::InsertBag<uint32_t>* current = &frontiers[0];
+  katana::InsertBag<uint32_t>* next = &frontiers[1];
+  current->push(source);
+
+  uint32_t level = 0;
+  *farthest = source;
+  while (true) {
+    katana::do_all(
+        katana::iterate(*current),
+        [&](uint32_t node) {
+          for (auto edge : pfg.edges(node)) {
+            uint32_t dest = *pfg.GetEdgeDest(edge);
+            if (!visited->set(dest)) {
+              next->push(dest);
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+    if (next->empty()) {
+      return level;
+    }
+    ++level;
+    *farthest = *next->begin();
+    current->clear();
+    std::swap(current, next);
+  }
+}
+
+uint32_t
+EstimateDiameter(const katana::PropertyFileGraph& pfg) {
+  if (pfg.num_edges() == 0) {
+    return 0;
+  }
+  katana::DynamicBitset visited;
+  visited.resize(pfg.num_nodes());
+
+  katana::analytics::SourcePicker picker(pfg);
+  uint32_t source = picker.PickNext();
+  uint32_t diameter = 0;
+  for (uint32_t sweep = 0; sweep < kNumDiameterSweeps; ++sweep) {
+    uint32_t farthest = source;
+    uint32_t eccentricity = Eccentricity(pfg, source, &farthest, &visited);
+    if (eccentricity <= diameter) {
+      break;
+    }
+    diameter = eccentricity;
+    source = farthest;
+  }
+  return diameter;
+}
+
+bool
+AreEdgesSorted(const katana::PropertyFileGraph& pfg) {
+  katana::GReduceLogicalAnd sorted;
+  katana::do_all(
+      katana::iterate(pfg),
+      [&](uint32_t node) {
+        auto edges = pfg.edges(node);
+        if (edges.empty()) {
+          return;
+        }
+        auto previous = *pfg.GetEdgeDest(*edges.begin());
+        for (auto edge : edges) {
+          auto dest = *pfg.GetEdgeDest(edge);
+          if (dest < previous) {
+            sorted.update(false);
+            return;
+          }
+          previous = dest;
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return sorted.reduce();
+}
+
+}  // namespace
+
+katana::Result<katana::analytics::GraphProfile>
+katana::analytics::GraphProfile::Compute(const PropertyFileGraph& pfg) {
+  katana::StatTimer timer("GraphProfile");
+  timer.start();
+
+  GraphProfile profile;
+  profile.num_nodes = pfg.num_nodes();
+  profile.num_edges = pfg.num_edges();
+  if (profile.num_nodes > 0) {
+    profile.average_degree =
+        static_cast<double>(profile.num_edges) / profile.num_nodes;
+  }
+  profile.degree_skew = EstimateDegreeSkew(pfg);
+  profile.estimated_diameter = EstimateDiameter(pfg);
+  profile.edges_sorted = AreEdgesSorted(pfg);
+
+  timer.stop();
+  return profile;
+}
+
+katana::Result<katana::analytics::GraphProfile>
+katana::analytics::GraphProfile::Get(PropertyFileGraph* pfg) {
+  if (!pfg->graph_profile().empty()) {
+    auto profile_res = FromJson(pfg->graph_profile());
+    if (profile_res && profile_res.value().num_nodes == pfg->num_nodes() &&
+        profile_res.value().num_edges == pfg->num_edges()) {
+      return profile_res;
+    }
+  }
+
+  auto profile_res = Compute(*pfg);
+  if (!profile_res) {
+    return profile_res.error();
+  }
+  auto json_res = profile_res.value().ToJson();
+  if (!json_res) {
+    return json_res.error();
+  }
+  pfg->set_graph_profile(std::move(json_res.value()));
+  return profile_res;
+}
+
+std::optional<katana::analytics::GraphProfile>
+katana::analytics::GraphProfile::ForAutomaticPlan(PropertyFileGraph* pfg) {
+  auto profile_res = Get(pfg);
+  if (!profile_res) {
+    KATANA_LOG_WARN(
+        "profiling graph for automatic plan: {}; using default plan",
+        profile_res.error());
+    return std::nullopt;
+  }
+  return profile_res.value();
+}
+
+katana::Result<katana::analytics::GraphProfile>
+katana::analytics::GraphProfile::FromJson(const std::string& json) {
+  return katana::JsonParse<GraphProfile>(json);
+}
+
+katana::Result<std::string>
+katana::analytics::GraphProfile::ToJson() const {
+  return katana::JsonDump(*this);
+}
+
+void
+katana::analytics::GraphProfile::Print(std::ostream& os) const {
+  os << "Number of nodes = " << num_nodes << std::endl;
+  os << "Number of edges = " << num_edges << std::endl;
+  os << "Average degree = " << average_degree << std::endl;
+  os << "Degree skew = " << degree_skew << std::endl;
+  os << "Estimated diameter = " << estimated_diameter << std::endl;
+  os << "Edges sorted = " << edges_sorted << std::endl;
+}
+
+katana::Result<katana::analytics::PlanCalibration>
+katana::analytics::PlanCalibration::FromFile(const std::string& path) {
+  std::ifstream in(path);
+  if (!in) {
+    return katana::ResultErrno();
+  }
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  std::string contents = buffer.str();
+  return katana::JsonParse<PlanCalibration>(contents);
+}
+
+const katana::analytics::PlanCalibration&
+katana::analytics::PlanCalibration::Get() {
+  static PlanCalibration calibration = [] {
+    std::string path;
+    if (!katana::GetEnv("KATANA_PLAN_CALIBRATION", &path) || path.empty()) {
+      return PlanCalibration();
+    }
+    auto calibration_res = FromFile(path);
+    if (!calibration_res) {
+      KATANA_LOG_WARN(
+          "reading plan calibration {}: {}; using defaults", path,
+          calibration_res.error());
+      return PlanCalibration();
+    }
+    return calibration_res.value();
+  }();
+  return calibration;
+}
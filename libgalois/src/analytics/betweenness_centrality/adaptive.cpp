@@ -0,0 +1,367 @@
+#include <atomic>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include "betweenness_centrality_impl.h"
+#include "katana/Bag.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/CentralitySampling.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using NodeDataAdaptive = std::tuple<>;
+using EdgeDataAdaptive = std::tuple<>;
+
+using AdaptiveGraph =
+    katana::PropertyGraph<NodeDataAdaptive, EdgeDataAdaptive>;
+using AdaptiveGNode = typename AdaptiveGraph::Node;
+
+constexpr static uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+/// Number of samples drawn before the stopping rule is first checked; the
+/// sample size doubles between checks.
+constexpr static uint64_t kFirstCheck = 1024;
+
+/// Upper bound on the number of BFSs used to bound the vertex diameter of a
+/// symmetric graph with many components.
+constexpr static uint32_t kMaxDiameterSearches = 16;
+
+/// Whether every edge has a reverse edge. The edges and the reversed edges
+/// are compared as multisets through a sum of hashes, so a graph that is not
+/// symmetric is reported as symmetric with negligible probability.
+bool
+IsSymmetric(const AdaptiveGraph& graph) {
+  katana::GAccumulator<uint64_t> forward;
+  katana::GAccumulator<uint64_t> backward;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const AdaptiveGNode& node) {
+        for (auto e : graph.edges(node)) {
+          uint64_t dest = *graph.GetEdgeDest(e);
+          forward += SplitMix64((uint64_t{node} << 32) | dest)();
+          backward += SplitMix64((dest << 32) | node)();
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return forward.reduce() == backward.reduce();
+}
+
+/// Parallel BFS from source over nodes not reached by any earlier search.
+/// Returns the eccentricity of source and adds the number of nodes reached to
+/// num_reached.
+uint32_t
+Eccentricity(
+    const AdaptiveGraph& graph, AdaptiveGNode source,
+    std::vector<std::atomic<uint32_t>>* distance, uint64_t* num_reached) {
+  katana::InsertBag<AdaptiveGNode> current;
+  katana::InsertBag<AdaptiveGNode> next;
+  (*distance)[source] = 0;
+  current.push(source);
+  *num_reached += 1;
+
+  uint32_t level = 0;
+  while (true) {
+    katana::GAccumulator<uint64_t> reached;
+    katana::do_all(
+        katana::iterate(current),
+        [&](const AdaptiveGNode& node) {
+          for (auto e : graph.edges(node)) {
+            auto dest = *graph.GetEdgeDest(e);
+            uint32_t expected = kInfinity;
+            if ((*distance)[dest].load(std::memory_order_relaxed) ==
+                    kInfinity &&
+                (*distance)[dest].compare_exchange_strong(
+                    expected, level + 1)) {
+              next.push(dest);
+              reached += 1;
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+    if (next.empty()) {
+      return level;
+    }
+    *num_reached += reached.reduce();
+    current.swap(next);
+    next.clear();
+    ++level;
+  }
+}
+
+/// An upper bound on the vertex diameter, the largest number of nodes on a
+/// shortest path. In a symmetric graph, a component's vertex diameter is at
+/// most 2 * e + 1, where e is the eccentricity of any of its nodes. Each BFS
+/// starts at the highest degree node left and components that are not
+/// searched are bounded by the number of nodes they have together. There is
+/// no cheap bound for directed graphs, so the number of nodes is used.
+uint64_t
+VertexDiameterBound(const AdaptiveGraph& graph) {
+  uint64_t num_nodes = graph.size();
+  if (!IsSymmetric(graph)) {
+    return num_nodes;
+  }
+
+  std::vector<std::atomic<uint32_t>> distance(num_nodes);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const AdaptiveGNode& node) { distance[node] = kInfinity; },
+      katana::no_stats());
+
+  uint64_t bound = 1;
+  uint64_t num_reached = 0;
+  for (uint32_t i = 0;
+       i < kMaxDiameterSearches && num_nodes - num_reached > bound; ++i) {
+    // Highest degree node left, packed as degree << 32 | node
+    katana::GReduceMax<uint64_t> start;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const AdaptiveGNode& node) {
+          if (distance[node].load(std::memory_order_relaxed) == kInfinity) {
+            uint64_t degree = graph.edges(node).size();
+            start.update((degree << 32) | node);
+          }
+        },
+        katana::no_stats());
+    auto source = static_cast<AdaptiveGNode>(start.reduce() & 0xffffffff);
+    uint64_t eccentricity =
+        Eccentricity(graph, source, &distance, &num_reached);
+    bound = std::max(bound, 2 * eccentricity + 1);
+  }
+
+  return std::max(bound, num_nodes - num_reached);
+}
+
+/// Per-thread state for drawing shortest paths. The state of a search is
+/// kept only for the nodes it visits, indexed by their position in the BFS
+/// queue, so it grows with the largest search rather than with the graph.
+class PathSampler {
+  const AdaptiveGraph* graph_{nullptr};
+  /// Visited nodes in BFS order
+  std::vector<AdaptiveGNode> queue_;
+  /// Distance from the source and number of shortest paths of queue_[i]
+  std::vector<uint32_t> distance_;
+  std::vector<double> num_paths_;
+  /// Position of each visited node in queue_
+  std::unordered_map<AdaptiveGNode, uint32_t> position_;
+  std::vector<size_t> level_begin_;
+
+public:
+  void Init(const AdaptiveGraph* graph) { graph_ = graph; }
+
+  /// Draw a shortest path from source to target uniformly at random and
+  /// append its internal nodes to path. Nothing is appended if there is no
+  /// path.
+  void Sample(
+      AdaptiveGNode source, AdaptiveGNode target, SplitMix64* rng,
+      std::vector<AdaptiveGNode>* path) {
+    queue_.clear();
+    distance_.clear();
+    num_paths_.clear();
+    position_.clear();
+    level_begin_.clear();
+    queue_.push_back(source);
+    distance_.push_back(0);
+    num_paths_.push_back(1);
+    position_.emplace(source, 0);
+
+    // BFS counting shortest paths; it can stop once the level of target is
+    // reached because only the levels before it are needed.
+    uint32_t target_distance = kInfinity;
+    size_t head = 0;
+    for (; head < queue_.size(); ++head) {
+      AdaptiveGNode node = queue_[head];
+      uint32_t node_distance = distance_[head];
+      if (node_distance >= target_distance) {
+        break;
+      }
+      if (level_begin_.size() == node_distance) {
+        level_begin_.push_back(head);
+      }
+      for (auto e : graph_->edges(node)) {
+        auto dest = *graph_->GetEdgeDest(e);
+        auto [it, inserted] = position_.try_emplace(dest, queue_.size());
+        if (inserted) {
+          queue_.push_back(dest);
+          distance_.push_back(node_distance + 1);
+          num_paths_.push_back(num_paths_[head]);
+          if (dest == target) {
+            target_distance = node_distance + 1;
+          }
+        } else if (distance_[it->second] == node_distance + 1) {
+          num_paths_[it->second] += num_paths_[head];
+        }
+      }
+    }
+    if (target_distance == kInfinity) {
+      return;
+    }
+    // head is now the first node at the level of target
+    level_begin_.push_back(head);
+
+    // Walk back from target, picking each predecessor with probability
+    // proportional to its number of shortest paths. Only out-edges are
+    // available, so predecessors are found by scanning the previous level.
+    AdaptiveGNode current = target;
+    for (uint32_t level = target_distance - 1; level > 0; --level) {
+      double total = 0;
+      AdaptiveGNode chosen = current;
+      for (size_t i = level_begin_[level]; i < level_begin_[level + 1]; ++i) {
+        AdaptiveGNode candidate = queue_[i];
+        for (auto e : graph_->edges(candidate)) {
+          if (*graph_->GetEdgeDest(e) != current) {
+            continue;
+          }
+          total += num_paths_[i];
+          if (rng->UniformReal() * total < num_paths_[i]) {
+            chosen = candidate;
+          }
+        }
+      }
+      KATANA_LOG_DEBUG_ASSERT(chosen != current);
+      path->push_back(chosen);
+      current = chosen;
+    }
+  }
+};
+
+/// Draw random shortest paths until the estimates are within plan.epsilon()
+/// with probability 1 - plan.delta(). Counts how often each node is an
+/// internal node of a path in num_hits and returns the number of paths drawn.
+uint64_t
+SampleShortestPaths(
+    const AdaptiveGraph& graph, const BetweennessCentralityPlan& plan,
+    std::vector<std::atomic<uint64_t>>* num_hits) {
+  uint64_t num_nodes = graph.size();
+  if (num_nodes < 3) {
+    return 0;
+  }
+
+  // Half of delta goes to the bound of Riondato and Kornaropoulos on the
+  // largest sample, half to the checks before it.
+  uint64_t vertex_diameter = VertexDiameterBound(graph);
+  uint64_t max_internal_nodes = vertex_diameter > 3 ? vertex_diameter - 2 : 1;
+  double epsilon = plan.epsilon();
+  double max_samples = std::ceil(
+      0.5 / (epsilon * epsilon) *
+      (std::floor(std::log2(max_internal_nodes)) + 1 +
+       std::log(2 / plan.delta())));
+  auto sample_bound = static_cast<uint64_t>(max_samples);
+  SampleMeanBound bound(plan.delta() / 2, num_nodes);
+
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "VertexDiameterBound", vertex_diameter);
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "SampleBound", sample_bound);
+
+  katana::PerThreadStorage<PathSampler> samplers;
+  katana::on_each(
+      [&](unsigned, unsigned) { samplers.getLocal()->Init(&graph); });
+  katana::PerThreadStorage<std::vector<AdaptiveGNode>> paths;
+
+  uint64_t num_samples = 0;
+  uint64_t next_check = std::min(kFirstCheck, sample_bound);
+  for (uint32_t check = 0;; ++check) {
+    katana::do_all(
+        katana::iterate(num_samples, next_check),
+        [&](uint64_t sample) {
+          SplitMix64 rng(sample);
+          auto source = static_cast<AdaptiveGNode>(rng.Uniform(num_nodes));
+          auto target = static_cast<AdaptiveGNode>(rng.Uniform(num_nodes - 1));
+          if (target >= source) {
+            ++target;
+          }
+          std::vector<AdaptiveGNode>* path = paths.getLocal();
+          path->clear();
+          samplers.getLocal()->Sample(source, target, &rng, path);
+          for (AdaptiveGNode node : *path) {
+            (*num_hits)[node].fetch_add(1, std::memory_order_relaxed);
+          }
+        },
+        katana::steal(), katana::loopname("BetweennessCentralitySample"));
+    num_samples = next_check;
+    if (num_samples >= sample_bound) {
+      return num_samples;
+    }
+
+    // Each sample adds 0 or 1 to a node's count, so the sum of squares is the
+    // count.
+    katana::GReduceMax<double> max_radius;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const AdaptiveGNode& node) {
+          double hits = (*num_hits)[node].load(std::memory_order_relaxed);
+          max_radius.update(bound.Radius(check, hits, hits, num_samples));
+        },
+        katana::no_stats());
+    if (max_radius.reduce() <= epsilon) {
+      return num_samples;
+    }
+    next_check = std::min(2 * next_check, sample_bound);
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+BetweennessCentralityAdaptive(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    BetweennessCentralityPlan plan) {
+  if (!(plan.epsilon() > 0 && plan.epsilon() < 1) ||
+      !(plan.delta() > 0 && plan.delta() < 1)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto pg_result =
+      katana::PropertyGraph<NodeDataAdaptive, EdgeDataAdaptive>::Make(
+          pfg, {}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  AdaptiveGraph graph = pg_result.value();
+  uint64_t num_nodes = graph.size();
+
+  katana::reportPageAlloc("MeminfoPre");
+
+  katana::StatTimer exec_time("Adaptive", "BetweennessCentrality");
+  exec_time.start();
+
+  std::vector<std::atomic<uint64_t>> num_hits(num_nodes);
+  uint64_t num_samples = SampleShortestPaths(graph, plan, &num_hits);
+
+  exec_time.stop();
+  katana::ReportStatSingle("BetweennessCentrality", "Samples", num_samples);
+
+  arrow::FloatBuilder builder;
+  if (auto r = builder.Resize(num_nodes); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  // Scale to the number of ordered pairs to match the exact algorithms
+  double scale = num_samples > 0 ? double(num_nodes) * (num_nodes - 1) /
+                                       double(num_samples)
+                                 : 0;
+  for (uint64_t node = 0; node < num_nodes; ++node) {
+    if (auto r = builder.Append(num_hits[node].load() * scale); !r.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+  }
+  std::shared_ptr<arrow::FloatArray> values;
+  if (auto r = builder.Finish(&values); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, arrow::float32())}),
+      {values});
+  if (auto r = pfg->AddNodeProperties(table); !r) {
+    return r.error();
+  }
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
@@ -41,6 +41,8 @@ katana::analytics::BetweennessCentrality(
     return BetweennessCentralityLevel(pfg, sources, output_property_name, plan);
   case BetweennessCentralityPlan::kOuter:
     return BetweennessCentralityOuter(pfg, sources, output_property_name, plan);
+  case BetweennessCentralityPlan::kAdaptiveSampling:
+    return BetweennessCentralityAdaptive(pfg, output_property_name, plan);
   default:
     return katana::ErrorCode::InvalidArgument;
   }
@@ -16,4 +16,8 @@ katana::Result<void> BetweennessCentralityLevel(
     const std::string& output_property_name,
     katana::analytics::BetweennessCentralityPlan plan);
 
+katana::Result<void> BetweennessCentralityAdaptive(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan);
+
 #endif
@@ -20,6 +20,8 @@
 #include <deque>
 #include <type_traits>
 
+#include "katana/Frontier.h"
+#include "katana/analytics/GraphProfile.h"
 #include "katana/analytics/bfs/bfs_internal.h"
 
 using namespace katana::analytics;
@@ -225,6 +227,37 @@ SynchronousAlgo(
   }
 }
 
+/// Synchronous BFS over frontiers of nodes, which EdgeMap keeps sparse while
+/// levels are small and switches to dense bitmaps for the large middle levels
+/// of low-diameter graphs
+void
+SynchronousFrontierAlgo(Graph* graph, Graph::Node source, bool symmetric) {
+  Dist next_level = 0U;
+  graph->GetData<BfsNodeDistance>(source) = 0U;
+
+  katana::EdgeMapOptions options;
+  options.loopname = "Synchronous";
+  options.symmetric = symmetric;
+  katana::Frontier frontier =
+      katana::Frontier::FromNodes(graph->num_nodes(), {source});
+
+  while (!frontier.empty()) {
+    ++next_level;
+    frontier = katana::EdgeMap(
+        *graph, &frontier,
+        [&](Graph::Node, Graph::Node dest, auto) {
+          auto& dest_data = graph->GetData<BfsNodeDistance>(dest);
+          return __sync_bool_compare_and_swap(
+              &dest_data, BfsImplementation::kDistanceInfinity, next_level);
+        },
+        [&](Graph::Node dest) {
+          return graph->GetData<BfsNodeDistance>(dest) ==
+                 BfsImplementation::kDistanceInfinity;
+        },
+        options);
+  }
+}
+
 template <bool CONCURRENT>
 void
 RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
@@ -243,8 +276,12 @@ RunAlgo(BfsPlan algo, Graph* graph, const Graph::Node& source) {
         graph, source, EdgeTilePushWrap{graph, impl}, TileRangeFn());
     break;
   case BfsPlan::kSynchronous:
-    SynchronousAlgo<CONCURRENT, Graph::Node>(
-        graph, source, NodePushWrap(), OutEdgeRangeFn{graph});
+    if (CONCURRENT) {
+      SynchronousFrontierAlgo(graph, source, algo.symmetric());
+    } else {
+      SynchronousAlgo<CONCURRENT, Graph::Node>(
+          graph, source, NodePushWrap(), OutEdgeRangeFn{graph});
+    }
     break;
   default:
     std::cerr << "ERROR: unkown algo type\n";
@@ -280,6 +317,23 @@ BfsImpl(
   return katana::ResultSuccess();
 }
 
+katana::analytics::BfsPlan
+katana::analytics::BfsPlan::Automatic(PropertyFileGraph* pfg) {
+  auto profile_opt = GraphProfile::ForAutomaticPlan(pfg);
+  if (!profile_opt) {
+    return {};
+  }
+  const GraphProfile& profile = *profile_opt;
+  const PlanCalibration& calibration = PlanCalibration::Get();
+
+  bool tile = calibration.IsPowerLaw(profile);
+  if (calibration.IsHighDiameter(profile)) {
+    return tile ? AsynchronousTile(calibration.edge_tile_size)
+                : Asynchronous();
+  }
+  return tile ? SynchronousTile(calibration.edge_tile_size) : Synchronous();
+}
+
 katana::Result<void>
 katana::analytics::Bfs(
     katana::PropertyFileGraph* pfg, size_t start_node,
@@ -0,0 +1,312 @@
+#include "katana/analytics/closeness_centrality/closeness_centrality.h"
+
+#include <atomic>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/CentralitySampling.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int ClosenessCentralityPlan::kChunkSize = 64;
+
+namespace {
+
+struct NodeCentrality : public katana::PODProperty<double> {};
+
+using NodeData = std::tuple<NodeCentrality>;
+using EdgeData = std::tuple<>;
+using Graph = katana::PropertyGraph<NodeData, EdgeData>;
+using GNode = Graph::Node;
+
+/// Number of sources searched together, one per bit of a word
+constexpr uint32_t kBatchSize = 64;
+
+/// Number of sources searched before the stopping rule is first checked; the
+/// number doubles between checks.
+constexpr uint64_t kFirstCheck = 1024;
+
+/// Per-node sums over the sources searched so far. Sources do not count
+/// towards their own sums.
+struct SourceSums {
+  /// The number of sources that reach the node
+  std::vector<uint64_t> num_reached;
+  std::vector<uint64_t> distance;
+  std::vector<double> inverse_distance;
+  std::vector<double> inverse_distance_squares;
+  /// The number of times the node was a source itself
+  std::vector<uint32_t> num_self;
+
+  explicit SourceSums(size_t num_nodes)
+      : num_reached(num_nodes),
+        distance(num_nodes),
+        inverse_distance(num_nodes),
+        inverse_distance_squares(num_nodes),
+        num_self(num_nodes) {}
+};
+
+/// Multi-source BFS: bit i of a node's words belongs to the i-th source of
+/// the batch, so one visit of a node advances every search that reached it
+/// in the previous level.
+class BatchSearch {
+  const Graph& graph_;
+  std::vector<uint64_t> seen_;
+  std::vector<uint64_t> visit_;
+  std::vector<std::atomic<uint64_t>> visit_next_;
+  katana::InsertBag<GNode> frontier_;
+  katana::InsertBag<GNode> next_frontier_;
+
+public:
+  explicit BatchSearch(const Graph& graph)
+      : graph_(graph),
+        seen_(graph.size()),
+        visit_(graph.size()),
+        visit_next_(graph.size()) {}
+
+  /// Search from up to kBatchSize sources and add the distances found to
+  /// sums.
+  void Run(const std::vector<GNode>& sources, SourceSums* sums) {
+    KATANA_LOG_DEBUG_ASSERT(sources.size() <= kBatchSize);
+    for (size_t i = 0; i < sources.size(); ++i) {
+      GNode source = sources[i];
+      if (!seen_[source]) {
+        frontier_.push(source);
+      }
+      seen_[source] |= uint64_t{1} << i;
+      visit_[source] |= uint64_t{1} << i;
+      sums->num_self[source] += 1;
+    }
+
+    for (uint32_t level = 1; !frontier_.empty(); ++level) {
+      katana::do_all(
+          katana::iterate(frontier_),
+          [&](const GNode& node) {
+            uint64_t bits = visit_[node];
+            for (auto e : graph_.edges(node)) {
+              auto dest = *graph_.GetEdgeDest(e);
+              uint64_t new_bits = bits & ~seen_[dest];
+              if (!new_bits || (visit_next_[dest].load(
+                                    std::memory_order_relaxed) &
+                                new_bits) == new_bits) {
+                continue;
+              }
+              if (visit_next_[dest].fetch_or(new_bits) == 0) {
+                next_frontier_.push(dest);
+              }
+            }
+            visit_[node] = 0;
+          },
+          katana::steal(),
+          katana::chunk_size<ClosenessCentralityPlan::kChunkSize>(),
+          katana::no_stats());
+
+      double inverse_level = 1.0 / level;
+      katana::do_all(
+          katana::iterate(next_frontier_),
+          [&](const GNode& node) {
+            uint64_t new_bits = visit_next_[node].load();
+            visit_next_[node].store(0, std::memory_order_relaxed);
+            seen_[node] |= new_bits;
+            visit_[node] = new_bits;
+
+            uint64_t count = __builtin_popcountll(new_bits);
+            sums->num_reached[node] += count;
+            sums->distance[node] += count * level;
+            sums->inverse_distance[node] += count * inverse_level;
+            sums->inverse_distance_squares[node] +=
+                count * inverse_level * inverse_level;
+          },
+          katana::steal(),
+          katana::chunk_size<ClosenessCentralityPlan::kChunkSize>(),
+          katana::no_stats());
+
+      frontier_.swap(next_frontier_);
+      next_frontier_.clear();
+    }
+
+    katana::do_all(
+        katana::iterate(graph_), [&](const GNode& node) { seen_[node] = 0; },
+        katana::no_stats());
+  }
+};
+
+/// Search from num_sources sources, either every node in order or random
+/// nodes, starting with the first_source-th, and add to sums.
+void
+SearchSources(
+    const Graph& graph, BatchSearch* search, uint64_t first_source,
+    uint64_t num_sources, bool random, SourceSums* sums) {
+  std::vector<GNode> batch;
+  for (uint64_t i = first_source; i < first_source + num_sources; ++i) {
+    auto source =
+        static_cast<GNode>(random ? SplitMix64(i).Uniform(graph.size()) : i);
+    batch.emplace_back(source);
+    if (batch.size() == kBatchSize) {
+      search->Run(batch, sums);
+      batch.clear();
+    }
+  }
+  if (!batch.empty()) {
+    search->Run(batch, sums);
+  }
+}
+
+/// Search from random sources until every harmonic centrality estimate is
+/// within plan.epsilon() with probability 1 - plan.delta(), or from every node
+/// if that is cheaper. Returns the number of sources.
+uint64_t
+SampleSources(
+    const Graph& graph, const ClosenessCentralityPlan& plan, SourceSums* sums) {
+  uint64_t num_nodes = graph.size();
+  BatchSearch search(graph);
+  SampleMeanBound bound(plan.delta(), num_nodes);
+
+  uint64_t num_sources = 0;
+  uint64_t next_check = kFirstCheck;
+  for (uint32_t check = 0;; ++check) {
+    if (next_check >= num_nodes) {
+      *sums = SourceSums(num_nodes);
+      SearchSources(graph, &search, 0, num_nodes, false, sums);
+      return num_nodes;
+    }
+    SearchSources(
+        graph, &search, num_sources, next_check - num_sources, true, sums);
+    num_sources = next_check;
+
+    katana::GReduceMax<double> max_radius;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& node) {
+          max_radius.update(bound.Radius(
+              check, sums->inverse_distance[node],
+              sums->inverse_distance_squares[node],
+              num_sources - sums->num_self[node]));
+        },
+        katana::no_stats());
+    if (max_radius.reduce() <= plan.epsilon()) {
+      return num_sources;
+    }
+    next_check *= 2;
+  }
+}
+
+katana::Result<void>
+Run(katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    const ClosenessCentralityPlan& plan) {
+  if (auto result = ConstructNodeProperties<NodeData>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph graph = pg_result.value();
+  uint64_t num_nodes = graph.size();
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("ClosenessCentrality");
+  exec_time.start();
+
+  SourceSums sums(num_nodes);
+  uint64_t num_sources = 0;
+  if (plan.algorithm() == ClosenessCentralityPlan::kExact) {
+    BatchSearch search(graph);
+    SearchSources(graph, &search, 0, num_nodes, false, &sums);
+    num_sources = num_nodes;
+  } else {
+    num_sources = SampleSources(graph, plan, &sums);
+  }
+
+  // With other_sources sources other than the node itself, the sums estimate
+  // the exact sums scaled by other_sources / (n - 1); closeness is invariant
+  // to that scale once written as reached^2 / (other_sources * distance).
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        uint64_t other_sources = num_sources - sums.num_self[node];
+        double centrality = 0;
+        if (other_sources > 0 &&
+            plan.measure() == ClosenessCentralityPlan::kHarmonic) {
+          centrality = sums.inverse_distance[node] / other_sources;
+        } else if (other_sources > 0 && sums.distance[node] > 0) {
+          double reached = sums.num_reached[node];
+          centrality = reached * reached /
+                       (double(other_sources) * sums.distance[node]);
+        }
+        graph.GetData<NodeCentrality>(node) = centrality;
+      },
+      katana::no_stats());
+
+  exec_time.stop();
+  katana::ReportStatSingle("ClosenessCentrality", "Sources", num_sources);
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::ClosenessCentrality(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    ClosenessCentralityPlan plan) {
+  switch (plan.algorithm()) {
+  case ClosenessCentralityPlan::kExact:
+    return Run(pfg, output_property_name, plan);
+  case ClosenessCentralityPlan::kAdaptiveSampling:
+    if (!(plan.epsilon() > 0 && plan.epsilon() < 1) ||
+        !(plan.delta() > 0 && plan.delta() < 1)) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    return Run(pfg, output_property_name, plan);
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+void
+katana::analytics::ClosenessCentralityStatistics::Print(
+    std::ostream& os) const {
+  os << "Maximum centrality = " << max_centrality << std::endl;
+  os << "Minimum centrality = " << min_centrality << std::endl;
+  os << "Average centrality = " << average_centrality << std::endl;
+}
+
+katana::Result<ClosenessCentralityStatistics>
+katana::analytics::ClosenessCentralityStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<double>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  size_t num_nodes = property->length();
+
+  katana::GReduceMax<double> max_centrality;
+  katana::GReduceMin<double> min_centrality;
+  katana::GAccumulator<double> total_centrality;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        max_centrality.update(property->Value(i));
+        min_centrality.update(property->Value(i));
+        total_centrality += property->Value(i);
+      },
+      katana::no_stats());
+
+  if (num_nodes == 0) {
+    return ClosenessCentralityStatistics{0, 0, 0};
+  }
+  return ClosenessCentralityStatistics{
+      max_centrality.reduce(), min_centrality.reduce(),
+      total_centrality.reduce() / num_nodes};
+}
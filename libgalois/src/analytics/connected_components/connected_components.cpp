@@ -20,6 +20,8 @@
 #include "katana/analytics/connected_components/connected_components.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/Frontier.h"
+#include "katana/analytics/GraphProfile.h"
 
 using namespace katana::analytics;
 
@@ -162,19 +164,17 @@ struct ConnectedComponentsSynchronousAlgo {
   typedef katana::PropertyGraph<NodeData, EdgeData> Graph;
   typedef typename Graph::Node GNode;
 
-  struct Edge {
-    GNode src;
-    ConnectedComponentsNode* ddata;
-    int count;
-    Edge(GNode src, ConnectedComponentsNode* ddata, int count)
-        : src(src), ddata(ddata), count(count) {}
-  };
-
+  /// The component each node of the frontier merges with next
+  katana::LargeArray<ComponentType> pending_component_;
+  /// The edge to pending_component_ of each node of the frontier
+  katana::LargeArray<uint64_t> pending_edge_;
   ConnectedComponentsPlan& plan_;
   ConnectedComponentsSynchronousAlgo(ConnectedComponentsPlan& plan)
       : plan_(plan) {}
 
   void Initialize(Graph* graph) {
+    pending_component_.allocateBlocked(graph->size());
+    pending_edge_.allocateBlocked(graph->size());
     katana::do_all(katana::iterate(*graph), [&](const GNode& node) {
       graph->GetData<NodeComponent>(node) = new ConnectedComponentsNode();
     });
@@ -193,45 +193,39 @@ struct ConnectedComponentsSynchronousAlgo {
     size_t rounds = 0;
     katana::GAccumulator<size_t> empty_merges;
 
-    katana::InsertBag<Edge> wls[2];
-    katana::InsertBag<Edge>* next_bag;
-    katana::InsertBag<Edge>* current_bag;
-
-    current_bag = &wls[0];
-    next_bag = &wls[1];
-
-    katana::do_all(katana::iterate(*graph), [&](const GNode& src) {
-      for (auto ii : graph->edges(src)) {
-        auto dest = graph->GetEdgeDest(ii);
-        if (src >= *dest)
-          continue;
-        auto& ddata = graph->GetData<NodeComponent>(dest);
-        current_bag->push(Edge(src, ddata, 0));
-        break;
-      }
-    });
+    // The frontier holds the nodes with an edge, to a node with a higher ID,
+    // that may still join two components
+    katana::Frontier frontier = katana::Frontier::All(graph->num_nodes());
+    frontier = frontier.Filter(
+        [&](const GNode& src) {
+          for (auto ii : graph->edges(src)) {
+            auto dest = graph->GetEdgeDest(ii);
+            if (src >= *dest)
+              continue;
+            pending_component_[src] = graph->GetData<NodeComponent>(dest);
+            pending_edge_[src] = ii;
+            return true;
+          }
+          return false;
+        },
+        "Initialize");
 
-    while (!current_bag->empty()) {
-      katana::do_all(
-          katana::iterate(*current_bag),
-          [&](const Edge& edge) {
-            auto& sdata = graph->GetData<NodeComponent>(edge.src);
-            if (!sdata->merge(edge.ddata))
+    while (!frontier.empty()) {
+      frontier.Map(
+          [&](const GNode& src) {
+            auto& sdata = graph->GetData<NodeComponent>(src);
+            if (!sdata->merge(pending_component_[src]))
               empty_merges += 1;
           },
-          katana::loopname("Merge"));
+          "Merge");
 
-      katana::do_all(
-          katana::iterate(*current_bag),
-          [&](const Edge& edge) {
-            GNode src = edge.src;
+      frontier = frontier.Filter(
+          [&](const GNode& src) {
             auto& sdata = graph->GetData<NodeComponent>(src);
             ConnectedComponentsNode* src_component = sdata->findAndCompress();
-            Graph::edge_iterator ii = graph->edge_begin(src);
+            Graph::edge_iterator ii(pending_edge_[src] + 1);
             Graph::edge_iterator ei = graph->edge_end(src);
-            int count = edge.count + 1;
-            std::advance(ii, count);
-            for (; ii != ei; ++ii, ++count) {
+            for (; ii != ei; ++ii) {
               auto dest = graph->GetEdgeDest(ii);
               if (src >= *dest)
                 continue;
@@ -239,15 +233,15 @@ struct ConnectedComponentsSynchronousAlgo {
               ConnectedComponentsNode* dest_component =
                   ddata->findAndCompress();
               if (src_component != dest_component) {
-                next_bag->push(Edge(src, dest_component, count));
-                break;
+                pending_component_[src] = dest_component;
+                pending_edge_[src] = *ii;
+                return true;
               }
             }
+            return false;
           },
-          katana::loopname("Find"));
+          "Find");
 
-      current_bag->clear();
-      std::swap(current_bag, next_bag);
       rounds += 1;
     }
 
@@ -1109,6 +1103,24 @@ ConnectedComponentsWithWrap(
   return katana::ResultSuccess();
 }
 
+katana::analytics::ConnectedComponentsPlan
+katana::analytics::ConnectedComponentsPlan::Automatic(PropertyFileGraph* pfg) {
+  auto profile_opt = GraphProfile::ForAutomaticPlan(pfg);
+  if (!profile_opt) {
+    return {};
+  }
+  const GraphProfile& profile = *profile_opt;
+  const PlanCalibration& calibration = PlanCalibration::Get();
+
+  if (profile.average_degree < calibration.afforest_min_average_degree) {
+    return Asynchronous();
+  }
+  if (calibration.IsPowerLaw(profile)) {
+    return EdgeTiledAfforest(calibration.edge_tile_size);
+  }
+  return Afforest();
+}
+
 katana::Result<void>
 katana::analytics::ConnectedComponents(
     PropertyFileGraph* pfg, const std::string& output_property_name,
@@ -0,0 +1,364 @@
+#include "katana/analytics/core_decomposition/core_decomposition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int CoreDecompositionPlan::kChunkSize = 64;
+
+namespace {
+
+constexpr uint32_t kUnset = std::numeric_limits<uint32_t>::max();
+
+struct NodeCoreNumber {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = katana::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+struct NodeCurrentDegree {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = katana::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+using NodeData = std::tuple<NodeCoreNumber, NodeCurrentDegree>;
+using EdgeData = std::tuple<>;
+using Graph = katana::PropertyGraph<NodeData, EdgeData>;
+using GNode = Graph::Node;
+
+template <typename GraphTy>
+uint32_t
+Degree(const GraphTy& graph, const typename GraphTy::Node& node) {
+  uint32_t degree = 0;
+  for (auto e : graph.edges(node)) {
+    if (*graph.GetEdgeDest(e) != node) {
+      ++degree;
+    }
+  }
+  return degree;
+}
+
+/// Batagelj and Zaversnik, "An O(m) Algorithm for Cores Decomposition of
+/// Networks". Nodes are kept sorted by current degree with a bin sort and
+/// removed in that order.
+template <typename GraphTy>
+std::vector<uint32_t>
+SerialCoreNumbers(const GraphTy& graph) {
+  size_t num_nodes = graph.size();
+  std::vector<uint32_t> degree(num_nodes);
+  uint32_t max_degree = 0;
+  for (size_t n = 0; n < num_nodes; ++n) {
+    degree[n] = Degree(graph, n);
+    max_degree = std::max(max_degree, degree[n]);
+  }
+
+  // bin[d] is the position in vert of the first node with degree d
+  std::vector<size_t> bin(size_t{max_degree} + 1);
+  for (uint32_t d : degree) {
+    bin[d]++;
+  }
+  size_t start = 0;
+  for (auto& b : bin) {
+    size_t count = b;
+    b = start;
+    start += count;
+  }
+
+  std::vector<uint32_t> vert(num_nodes);
+  std::vector<size_t> pos(num_nodes);
+  for (size_t n = 0; n < num_nodes; ++n) {
+    pos[n] = bin[degree[n]]++;
+    vert[pos[n]] = n;
+  }
+  for (size_t d = max_degree; d > 0; --d) {
+    bin[d] = bin[d - 1];
+  }
+  bin[0] = 0;
+
+  for (size_t i = 0; i < num_nodes; ++i) {
+    uint32_t v = vert[i];
+    for (auto e : graph.edges(v)) {
+      uint32_t u = *graph.GetEdgeDest(e);
+      if (u == v || degree[u] <= degree[v]) {
+        continue;
+      }
+      // Move u to the front of its bin, then shrink the bin past it
+      uint32_t du = degree[u];
+      size_t pu = pos[u];
+      size_t pw = bin[du];
+      uint32_t w = vert[pw];
+      if (u != w) {
+        std::swap(vert[pu], vert[pw]);
+        pos[u] = pw;
+        pos[w] = pu;
+      }
+      bin[du]++;
+      degree[u]--;
+    }
+  }
+
+  return degree;
+}
+
+struct SerialAlgo {
+  void operator()(Graph* graph, const CoreDecompositionPlan&) {
+    std::vector<uint32_t> core = SerialCoreNumbers(*graph);
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) {
+          graph->GetData<NodeCoreNumber>(node).store(core[node]);
+        },
+        katana::no_stats());
+  }
+};
+
+/// Parallel bucketed peeling in the style of Julienne (Dhulipala et al.,
+/// SPAA 2017). A node is pushed to bucket max(degree, k) whenever its degree
+/// drops while k is the level being peeled, so buckets may hold stale and
+/// duplicate entries; a node is only peeled once, by whoever sets its core
+/// number.
+struct BucketedAlgo {
+  void operator()(Graph* graph, const CoreDecompositionPlan& plan) {
+    const uint32_t num_open = std::max(plan.num_open_buckets(), 1u);
+    std::vector<katana::InsertBag<GNode>> buckets(num_open);
+    katana::InsertBag<GNode> overflow;
+    katana::InsertBag<GNode> next_overflow;
+    katana::InsertBag<GNode> frontier;
+
+    uint32_t base = 0;
+    auto place = [&](const GNode& node, uint32_t bucket,
+                     katana::InsertBag<GNode>* rest) {
+      if (bucket - base < num_open) {
+        buckets[bucket - base].push(node);
+      } else {
+        rest->push(node);
+      }
+    };
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) {
+          uint32_t degree = Degree(*graph, node);
+          graph->GetData<NodeCurrentDegree>(node).store(degree);
+          graph->GetData<NodeCoreNumber>(node).store(kUnset);
+          place(node, degree, &overflow);
+        },
+        katana::steal(), katana::loopname("CoreDecomposition Initialize"));
+
+    size_t num_peeled = 0;
+    size_t num_rounds = 0;
+    uint32_t k = 0;
+    while (num_peeled < graph->size()) {
+      if (k - base == num_open) {
+        // Every node left has degree of at least k and is in the overflow
+        // bucket; open the window at the smallest such degree.
+        katana::GReduceMin<uint32_t> min_degree;
+        katana::do_all(
+            katana::iterate(overflow),
+            [&](const GNode& node) {
+              if (graph->GetData<NodeCoreNumber>(node).load() == kUnset) {
+                min_degree.update(
+                    graph->GetData<NodeCurrentDegree>(node).load());
+              }
+            },
+            katana::no_stats());
+        if (min_degree.reduce() == kUnset) {
+          KATANA_LOG_DEBUG_ASSERT(false);
+          break;
+        }
+        base = std::max(k, min_degree.reduce());
+        k = base;
+
+        katana::do_all(
+            katana::iterate(overflow),
+            [&](const GNode& node) {
+              if (graph->GetData<NodeCoreNumber>(node).load() == kUnset) {
+                uint32_t degree =
+                    graph->GetData<NodeCurrentDegree>(node).load();
+                place(node, std::max(degree, k), &next_overflow);
+              }
+            },
+            katana::steal(), katana::no_stats());
+        overflow.swap(next_overflow);
+        next_overflow.clear();
+      }
+
+      katana::InsertBag<GNode>& bucket = buckets[k - base];
+      if (bucket.empty()) {
+        ++k;
+        continue;
+      }
+      frontier.swap(bucket);
+      ++num_rounds;
+
+      katana::GAccumulator<size_t> peeled;
+      katana::do_all(
+          katana::iterate(frontier),
+          [&](const GNode& node) {
+            uint32_t expected = kUnset;
+            if (!graph->GetData<NodeCoreNumber>(node).compare_exchange_strong(
+                    expected, k)) {
+              return;
+            }
+            peeled += 1;
+            for (auto e : graph->edges(node)) {
+              auto dest = *graph->GetEdgeDest(e);
+              if (dest == node ||
+                  graph->GetData<NodeCoreNumber>(dest).load() != kUnset) {
+                continue;
+              }
+              uint32_t old_degree = katana::atomicSub(
+                  graph->GetData<NodeCurrentDegree>(dest), 1u);
+              if (old_degree > k) {
+                uint32_t bucket = std::max(old_degree - 1, k);
+                if (bucket - base < num_open) {
+                  buckets[bucket - base].push(dest);
+                }
+              }
+            }
+          },
+          katana::steal(),
+          katana::chunk_size<CoreDecompositionPlan::kChunkSize>(),
+          katana::loopname("CoreDecomposition Peel"));
+
+      num_peeled += peeled.reduce();
+      frontier.clear();
+    }
+
+    katana::ReportStatSingle("CoreDecomposition", "Rounds", num_rounds);
+  }
+};
+
+template <typename Algo>
+katana::Result<void>
+Run(katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    const CoreDecompositionPlan& plan) {
+  katana::analytics::TemporaryPropertyGuard temporary_property{pfg};
+  if (auto result = ConstructNodeProperties<NodeData>(
+          pfg, {output_property_name, temporary_property.name()});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(
+      pfg, {output_property_name, temporary_property.name()}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph graph = pg_result.value();
+
+  katana::Prealloc(
+      1, CoreDecompositionPlan::kChunkSize * sizeof(GNode) * graph.size());
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("CoreDecomposition");
+
+  exec_time.start();
+  Algo()(&graph, plan);
+  exec_time.stop();
+
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::CoreDecomposition(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    CoreDecompositionPlan plan) {
+  switch (plan.algorithm()) {
+  case CoreDecompositionPlan::kBucketed:
+    return Run<BucketedAlgo>(pfg, output_property_name, plan);
+  case CoreDecompositionPlan::kSerial:
+    return Run<SerialAlgo>(pfg, output_property_name, plan);
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+katana::Result<void>
+katana::analytics::CoreDecompositionAssertValid(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto pg_result =
+      katana::PropertyGraph<std::tuple<NodeCoreNumber>, std::tuple<>>::Make(
+          pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  std::vector<uint32_t> expected = SerialCoreNumbers(graph);
+
+  katana::GReduceLogicalOr has_error;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        if (graph.GetData<NodeCoreNumber>(node).load() != expected[node]) {
+          has_error.update(true);
+        }
+      },
+      katana::no_stats());
+  if (has_error.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+void
+katana::analytics::CoreDecompositionStatistics::Print(std::ostream& os) const {
+  os << "Degeneracy = " << degeneracy << std::endl;
+  os << "Number of nodes in the max core = " << num_nodes_in_max_core
+     << std::endl;
+  os << "Number of distinct core numbers = " << num_distinct_cores
+     << std::endl;
+  os << "Average core number = " << average_core_number << std::endl;
+}
+
+katana::Result<CoreDecompositionStatistics>
+katana::analytics::CoreDecompositionStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<uint32_t>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  size_t num_nodes = property->length();
+
+  katana::GReduceMax<uint32_t> max_core;
+  katana::GAccumulator<uint64_t> total_core;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        max_core.update(property->Value(i));
+        total_core += property->Value(i);
+      },
+      katana::no_stats());
+  uint32_t degeneracy = max_core.reduce();
+
+  std::vector<uint64_t> shell_sizes(num_nodes > 0 ? size_t{degeneracy} + 1 : 0);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    shell_sizes[property->Value(i)]++;
+  }
+  uint64_t num_distinct_cores = std::count_if(
+      shell_sizes.begin(), shell_sizes.end(), [](uint64_t s) { return s > 0; });
+
+  double average = num_nodes > 0 ? double(total_core.reduce()) / num_nodes : 0;
+
+  return CoreDecompositionStatistics{
+      degeneracy, shell_sizes.empty() ? 0 : shell_sizes.back(),
+      num_distinct_cores, average};
+}
@@ -0,0 +1,587 @@
+#include "katana/analytics/graph_coloring/graph_coloring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int GraphColoringPlan::kChunkSize = 64;
+
+namespace {
+
+constexpr uint32_t kUncolored = std::numeric_limits<uint32_t>::max();
+
+struct NodeColor {
+  using ArrowType = arrow::CTypeTraits<uint32_t>::ArrowType;
+  using ViewType = katana::PODPropertyView<std::atomic<uint32_t>>;
+};
+
+using NodeData = std::tuple<NodeColor>;
+using EdgeData = std::tuple<>;
+using Graph = katana::PropertyGraph<NodeData, EdgeData>;
+using GNode = Graph::Node;
+
+uint64_t
+Hash(uint64_t val) {
+  // splitmix64 finalizer
+  val = (val ^ (val >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  val = (val ^ (val >> 27)) * 0x94d049bb133111ebULL;
+  return val ^ (val >> 31);
+}
+
+/// Call fn on every node within distance hops of node, other than node
+/// itself. Nodes reachable by several paths are visited several times.
+template <typename GraphTy, typename F>
+void
+ForEachNearby(
+    const GraphTy& graph, const typename GraphTy::Node& node, uint32_t distance,
+    F fn) {
+  for (auto e : graph.edges(node)) {
+    auto dest = *graph.GetEdgeDest(e);
+    if (dest == node) {
+      continue;
+    }
+    fn(dest);
+    if (distance < 2) {
+      continue;
+    }
+    for (auto e2 : graph.edges(dest)) {
+      auto dest2 = *graph.GetEdgeDest(e2);
+      if (dest2 != node && dest2 != dest) {
+        fn(dest2);
+      }
+    }
+  }
+}
+
+/// Per-thread scratch space for finding colors used around a node. A color c
+/// is in use if marks[c] == stamp, so the marks never need clearing.
+struct ColorMarks {
+  std::vector<uint64_t> marks;
+  uint64_t stamp{0};
+
+  void Reset() { ++stamp; }
+
+  void Mark(uint32_t color) {
+    if (color >= marks.size()) {
+      marks.resize(size_t{color} + 1, 0);
+    }
+    marks[color] = stamp;
+  }
+
+  bool IsMarked(uint32_t color) const {
+    return color < marks.size() && marks[color] == stamp;
+  }
+};
+
+void
+MarkNearbyColors(
+    const Graph& graph, const GNode& node, uint32_t distance,
+    ColorMarks* marks) {
+  marks->Reset();
+  ForEachNearby(graph, node, distance, [&](const GNode& dest) {
+    uint32_t color = graph.GetData<NodeColor>(dest).load();
+    if (color != kUncolored) {
+      marks->Mark(color);
+    }
+  });
+}
+
+/// The smallest color not used within distance hops of node
+uint32_t
+FirstFit(
+    const Graph& graph, const GNode& node, uint32_t distance,
+    ColorMarks* marks) {
+  MarkNearbyColors(graph, node, distance, marks);
+  uint32_t color = 0;
+  while (marks->IsMarked(color)) {
+    ++color;
+  }
+  return color;
+}
+
+struct SpeculativeAlgo {
+  void operator()(Graph* graph, const GraphColoringPlan& plan) {
+    const uint32_t distance = plan.distance();
+    katana::PerThreadStorage<ColorMarks> marks;
+    katana::InsertBag<GNode> worklist;
+    katana::InsertBag<GNode> next;
+
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) { worklist.push(node); }, katana::no_stats());
+
+    size_t num_rounds = 0;
+    size_t num_conflicts = 0;
+    while (!worklist.empty()) {
+      ++num_rounds;
+
+      katana::do_all(
+          katana::iterate(worklist),
+          [&](const GNode& node) {
+            graph->GetData<NodeColor>(node).store(
+                FirstFit(*graph, node, distance, marks.getLocal()));
+          },
+          katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+          katana::loopname("GraphColoring Speculate"));
+
+      // Nodes colored in earlier rounds are visible to every node colored in
+      // this one, so conflicts are only between nodes of this round, and the
+      // largest of those always keeps its color.
+      katana::GAccumulator<size_t> conflicts;
+      katana::do_all(
+          katana::iterate(worklist),
+          [&](const GNode& node) {
+            uint32_t color = graph->GetData<NodeColor>(node).load();
+            bool conflict = false;
+            ForEachNearby(*graph, node, distance, [&](const GNode& dest) {
+              if (dest > node &&
+                  graph->GetData<NodeColor>(dest).load() == color) {
+                conflict = true;
+              }
+            });
+            if (conflict) {
+              conflicts += 1;
+              next.push(node);
+            }
+          },
+          katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+          katana::loopname("GraphColoring DetectConflicts"));
+
+      num_conflicts += conflicts.reduce();
+      worklist.swap(next);
+      next.clear();
+    }
+
+    katana::ReportStatSingle("GraphColoring", "Rounds", num_rounds);
+    katana::ReportStatSingle("GraphColoring", "Conflicts", num_conflicts);
+  }
+};
+
+/// Matula and Beck: repeatedly remove a node of minimum remaining degree,
+/// with nodes kept sorted by degree in a bin sort. Returns the nodes in
+/// removal order.
+std::vector<uint32_t>
+SmallestLastOrder(const Graph& graph) {
+  size_t num_nodes = graph.size();
+  std::vector<uint32_t> degree(num_nodes);
+  uint32_t max_degree = 0;
+  for (size_t n = 0; n < num_nodes; ++n) {
+    for (auto e : graph.edges(n)) {
+      if (*graph.GetEdgeDest(e) != n) {
+        degree[n]++;
+      }
+    }
+    max_degree = std::max(max_degree, degree[n]);
+  }
+
+  // bin[d] is the position in order of the first node with degree d
+  std::vector<size_t> bin(size_t{max_degree} + 1);
+  for (uint32_t d : degree) {
+    bin[d]++;
+  }
+  size_t start = 0;
+  for (auto& b : bin) {
+    size_t count = b;
+    b = start;
+    start += count;
+  }
+
+  std::vector<uint32_t> order(num_nodes);
+  std::vector<size_t> pos(num_nodes);
+  for (size_t n = 0; n < num_nodes; ++n) {
+    pos[n] = bin[degree[n]]++;
+    order[pos[n]] = n;
+  }
+  for (size_t d = max_degree; d > 0; --d) {
+    bin[d] = bin[d - 1];
+  }
+  bin[0] = 0;
+
+  for (size_t i = 0; i < num_nodes; ++i) {
+    uint32_t v = order[i];
+    for (auto e : graph.edges(v)) {
+      uint32_t u = *graph.GetEdgeDest(e);
+      if (u == v || degree[u] <= degree[v]) {
+        continue;
+      }
+      uint32_t du = degree[u];
+      size_t pu = pos[u];
+      size_t pw = bin[du];
+      uint32_t w = order[pw];
+      if (u != w) {
+        std::swap(order[pu], order[pw]);
+        pos[u] = pw;
+        pos[w] = pu;
+      }
+      bin[du]++;
+      degree[u]--;
+    }
+  }
+
+  return order;
+}
+
+std::vector<uint64_t>
+ComputePriorities(const Graph& graph, GraphColoringPlan::Algorithm algorithm) {
+  std::vector<uint64_t> priority(graph.size());
+
+  if (algorithm == GraphColoringPlan::kSmallestLast) {
+    std::vector<uint32_t> order = SmallestLastOrder(graph);
+    katana::do_all(
+        katana::iterate(size_t{0}, order.size()),
+        [&](size_t i) { priority[order[i]] = i; }, katana::no_stats());
+    return priority;
+  }
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        if (algorithm == GraphColoringPlan::kLargestDegreeFirst) {
+          uint64_t degree = graph.edges(node).size();
+          priority[node] = (degree << 32) | (Hash(node) & 0xffffffff);
+        } else {
+          priority[node] = Hash(node);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return priority;
+}
+
+/// Jones-Plassmann, asynchronously: every node counts the nodes within
+/// distance hops that precede it, and is colored once all of them are. Nodes
+/// being colored at the same time are therefore never within distance hops
+/// of each other.
+struct JonesPlassmannAlgo {
+  void operator()(Graph* graph, const GraphColoringPlan& plan) {
+    const uint32_t distance = plan.distance();
+    std::vector<uint64_t> priority =
+        ComputePriorities(*graph, plan.algorithm());
+    auto precedes = [&](const GNode& a, const GNode& b) {
+      return std::make_pair(priority[a], a) > std::make_pair(priority[b], b);
+    };
+
+    // Nodes reachable by several paths are counted once per path, both here
+    // and when predecessors are colored. With distance > 1 the number of
+    // paths can exceed 32 bits.
+    std::vector<std::atomic<uint64_t>> num_waiting(graph->size());
+    katana::InsertBag<GNode> initial;
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) {
+          uint64_t count = 0;
+          ForEachNearby(*graph, node, distance, [&](const GNode& dest) {
+            if (precedes(dest, node)) {
+              ++count;
+            }
+          });
+          num_waiting[node].store(count);
+          if (count == 0) {
+            initial.push(node);
+          }
+        },
+        katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring Initialize"));
+
+    katana::PerThreadStorage<ColorMarks> marks;
+    katana::for_each(
+        katana::iterate(initial),
+        [&](const GNode& node, auto& ctx) {
+          graph->GetData<NodeColor>(node).store(
+              FirstFit(*graph, node, distance, marks.getLocal()));
+          ForEachNearby(*graph, node, distance, [&](const GNode& dest) {
+            if (precedes(node, dest) && num_waiting[dest].fetch_sub(1) == 1) {
+              ctx.push(dest);
+            }
+          });
+        },
+        katana::disable_conflict_detection(),
+        katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring JonesPlassmann"));
+  }
+};
+
+/// Atomically increment counter if it is below bound
+bool
+IncrementIfBelow(std::atomic<uint64_t>& counter, uint64_t bound) {
+  uint64_t old_value = counter.load();
+  while (old_value < bound) {
+    if (counter.compare_exchange_weak(old_value, old_value + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Atomically decrement counter if it is above bound
+bool
+DecrementIfAbove(std::atomic<uint64_t>& counter, uint64_t bound) {
+  uint64_t old_value = counter.load();
+  while (old_value > bound) {
+    if (counter.compare_exchange_weak(old_value, old_value - 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Guided recoloring in the style of Lu et al., "Balanced Coloring for
+/// Parallel Computing Applications" (IPDPS 2015). Nodes of color classes
+/// larger than the target size move to the smallest permissible color whose
+/// class is below it. Class sizes are reserved atomically so that classes
+/// above the target only shrink and classes below it only grow; a node can
+/// therefore always return to its old color, which is how conflicts between
+/// nodes moved in the same round are undone.
+void
+Balance(Graph* graph, uint32_t distance) {
+  katana::GReduceMax<uint32_t> max_color;
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        max_color.update(graph->GetData<NodeColor>(node).load());
+      },
+      katana::no_stats());
+  if (graph->size() == 0) {
+    return;
+  }
+  const uint32_t num_colors = max_color.reduce() + 1;
+  const uint64_t target = (graph->size() + num_colors - 1) / num_colors;
+
+  std::vector<std::atomic<uint64_t>> sizes(num_colors);
+  katana::do_all(
+      katana::iterate(*graph),
+      [&](const GNode& node) {
+        sizes[graph->GetData<NodeColor>(node).load()].fetch_add(1);
+      },
+      katana::no_stats());
+
+  katana::PerThreadStorage<ColorMarks> marks;
+  katana::InsertBag<std::pair<GNode, uint32_t>> moved;
+  size_t num_moves = 0;
+  size_t num_rounds = 0;
+  while (true) {
+    ++num_rounds;
+
+    katana::GAccumulator<size_t> num_moved;
+    katana::do_all(
+        katana::iterate(*graph),
+        [&](const GNode& node) {
+          auto& node_color = graph->GetData<NodeColor>(node);
+          uint32_t old_color = node_color.load();
+          if (sizes[old_color].load() <= target) {
+            return;
+          }
+          ColorMarks* local_marks = marks.getLocal();
+          MarkNearbyColors(*graph, node, distance, local_marks);
+          for (uint32_t color = 0; color < num_colors; ++color) {
+            if (color == old_color || local_marks->IsMarked(color) ||
+                !IncrementIfBelow(sizes[color], target)) {
+              continue;
+            }
+            if (!DecrementIfAbove(sizes[old_color], target)) {
+              sizes[color].fetch_sub(1);
+              return;
+            }
+            node_color.store(color);
+            moved.push(std::make_pair(node, old_color));
+            num_moved += 1;
+            return;
+          }
+        },
+        katana::steal(), katana::chunk_size<GraphColoringPlan::kChunkSize>(),
+        katana::loopname("GraphColoring Balance"));
+
+    katana::GAccumulator<size_t> reverted;
+    katana::do_all(
+        katana::iterate(moved),
+        [&](const std::pair<GNode, uint32_t>& move) {
+          GNode node = move.first;
+          auto& node_color = graph->GetData<NodeColor>(node);
+          uint32_t color = node_color.load();
+          bool conflict = false;
+          ForEachNearby(*graph, node, distance, [&](const GNode& dest) {
+            if (dest > node &&
+                graph->GetData<NodeColor>(dest).load() == color) {
+              conflict = true;
+            }
+          });
+          if (conflict) {
+            node_color.store(move.second);
+            sizes[color].fetch_sub(1);
+            sizes[move.second].fetch_add(1);
+            reverted += 1;
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    moved.clear();
+    if (num_moved.reduce() == reverted.reduce()) {
+      break;
+    }
+    num_moves += num_moved.reduce() - reverted.reduce();
+  }
+
+  katana::ReportStatSingle("GraphColoring", "BalanceRounds", num_rounds);
+  katana::ReportStatSingle("GraphColoring", "BalanceMoves", num_moves);
+}
+
+template <typename Algo>
+katana::Result<void>
+Run(katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    const GraphColoringPlan& plan) {
+  if (auto result = ConstructNodeProperties<NodeData>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph graph = pg_result.value();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        graph.GetData<NodeColor>(node).store(kUncolored);
+      },
+      katana::no_stats());
+
+  katana::Prealloc(
+      1, GraphColoringPlan::kChunkSize * sizeof(GNode) * graph.size());
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("GraphColoring");
+
+  exec_time.start();
+  Algo()(&graph, plan);
+  if (plan.balance()) {
+    Balance(&graph, plan.distance());
+  }
+  exec_time.stop();
+
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::GraphColoring(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    GraphColoringPlan plan) {
+  if (plan.distance() != 1 && plan.distance() != 2) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  switch (plan.algorithm()) {
+  case GraphColoringPlan::kSpeculative:
+    return Run<SpeculativeAlgo>(pfg, output_property_name, plan);
+  case GraphColoringPlan::kJonesPlassmann:
+  case GraphColoringPlan::kLargestDegreeFirst:
+  case GraphColoringPlan::kSmallestLast:
+    return Run<JonesPlassmannAlgo>(pfg, output_property_name, plan);
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+}
+
+katana::Result<void>
+katana::analytics::GraphColoringAssertValid(
+    katana::PropertyFileGraph* pfg, const std::string& property_name,
+    uint32_t distance) {
+  if (distance != 1 && distance != 2) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::GReduceLogicalOr has_error;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        uint32_t color = graph.GetData<NodeColor>(node).load();
+        if (color == kUncolored) {
+          has_error.update(true);
+          return;
+        }
+        ForEachNearby(graph, node, distance, [&](const GNode& dest) {
+          if (graph.GetData<NodeColor>(dest).load() == color) {
+            has_error.update(true);
+          }
+        });
+      },
+      katana::steal(), katana::no_stats());
+  if (has_error.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+void
+katana::analytics::GraphColoringStatistics::Print(std::ostream& os) const {
+  os << "Number of colors = " << num_colors << std::endl;
+  os << "Largest color class size = " << largest_color_class_size
+     << std::endl;
+  os << "Smallest color class size = " << smallest_color_class_size
+     << std::endl;
+  os << "Average color class size = " << average_color_class_size
+     << std::endl;
+}
+
+katana::Result<GraphColoringStatistics>
+katana::analytics::GraphColoringStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<uint32_t>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  size_t num_nodes = property->length();
+
+  std::vector<uint64_t> class_sizes;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    uint32_t color = property->Value(i);
+    if (color >= class_sizes.size()) {
+      class_sizes.resize(size_t{color} + 1, 0);
+    }
+    class_sizes[color]++;
+  }
+
+  uint32_t num_colors = 0;
+  uint64_t largest = 0;
+  uint64_t smallest = std::numeric_limits<uint64_t>::max();
+  for (uint64_t size : class_sizes) {
+    if (size == 0) {
+      continue;
+    }
+    ++num_colors;
+    largest = std::max(largest, size);
+    smallest = std::min(smallest, size);
+  }
+  if (num_colors == 0) {
+    smallest = 0;
+  }
+
+  double average = num_colors > 0 ? double(num_nodes) / num_colors : 0;
+
+  return GraphColoringStatistics{num_colors, largest, smallest, average};
+}
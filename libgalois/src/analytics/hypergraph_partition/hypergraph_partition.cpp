@@ -0,0 +1,967 @@
+#include "katana/analytics/hypergraph_partition/hypergraph_partition.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int HypergraphPartitionPlan::kChunkSize = 64;
+
+namespace {
+
+constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t kNoHyperedge = std::numeric_limits<uint32_t>::max();
+/// Coarsening stops once a hypergraph has fewer hyperedges or nodes than these
+constexpr uint32_t kCoarsestHyperedgeLimit = 1000;
+constexpr uint32_t kCoarsestNodeLimit = 300;
+
+struct NodePartition : public katana::PODProperty<uint32_t> {};
+
+using Graph = katana::PropertyGraph<std::tuple<NodePartition>, std::tuple<>>;
+
+/// A hypergraph in CSR form, indexed both ways: the pins of each hyperedge,
+/// sorted by id, and the hyperedges incident to each node.
+struct Hypergraph {
+  std::vector<uint64_t> pin_indices;
+  std::vector<uint32_t> pins;
+  std::vector<uint64_t> incidence_indices;
+  std::vector<uint32_t> incidence;
+  std::vector<uint32_t> weights;
+  uint64_t total_weight{0};
+
+  uint32_t num_nodes() const { return weights.size(); }
+  uint32_t num_hyperedges() const { return pin_indices.size() - 1; }
+
+  auto Pins(uint32_t hyperedge) const {
+    return katana::MakeStandardRange(
+        pins.begin() + pin_indices[hyperedge],
+        pins.begin() + pin_indices[hyperedge + 1]);
+  }
+
+  auto Hyperedges(uint32_t node) const {
+    return katana::MakeStandardRange(
+        incidence.begin() + incidence_indices[node],
+        incidence.begin() + incidence_indices[node + 1]);
+  }
+
+  uint64_t NumPins(uint32_t hyperedge) const {
+    return pin_indices[hyperedge + 1] - pin_indices[hyperedge];
+  }
+};
+
+/// CSR indices for counts, i.e., their exclusive prefix sum with the total
+/// appended.
+std::vector<uint64_t>
+CountsToIndices(const std::vector<uint64_t>& counts) {
+  std::vector<uint64_t> indices(counts.size() + 1, 0);
+  katana::ParallelSTL::partial_sum(
+      counts.begin(), counts.end(), indices.begin() + 1);
+  return indices;
+}
+
+/// Build a hypergraph from pin lists, given as ranges [pin_indices[h],
+/// pin_indices[h + 1]) of pins. The pins of each hyperedge are sorted and
+/// deduplicated, and hyperedges left with fewer than two pins, which can never
+/// be cut, are dropped.
+Hypergraph
+MakeHypergraph(
+    const std::vector<uint64_t>& pin_indices, std::vector<uint32_t>* pins,
+    std::vector<uint32_t> weights) {
+  uint32_t num_hyperedges = pin_indices.size() - 1;
+  std::vector<uint64_t> counts(num_hyperedges);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) {
+        auto begin = pins->begin() + pin_indices[h];
+        auto end = pins->begin() + pin_indices[h + 1];
+        std::sort(begin, end);
+        uint64_t count = std::distance(begin, std::unique(begin, end));
+        counts[h] = count < 2 ? 0 : count;
+      },
+      katana::steal(), katana::no_stats());
+
+  std::vector<uint64_t> kept(num_hyperedges);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) { kept[h] = counts[h] > 0; }, katana::no_stats());
+  std::vector<uint64_t> new_ids = CountsToIndices(kept);
+  std::vector<uint64_t> new_counts(new_ids.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) {
+        if (kept[h]) {
+          new_counts[new_ids[h]] = counts[h];
+        }
+      },
+      katana::no_stats());
+
+  Hypergraph hg;
+  hg.pin_indices = CountsToIndices(new_counts);
+  hg.pins.resize(hg.pin_indices.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) {
+        if (kept[h]) {
+          std::copy_n(
+              pins->begin() + pin_indices[h], counts[h],
+              hg.pins.begin() + hg.pin_indices[new_ids[h]]);
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  // Index the hyperedges of each node; sorting each list keeps the order
+  // independent of the schedule
+  uint32_t num_nodes = weights.size();
+  std::vector<std::atomic<uint64_t>> degrees(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, hg.num_hyperedges()),
+      [&](uint32_t h) {
+        for (uint32_t node : hg.Pins(h)) {
+          degrees[node].fetch_add(1, std::memory_order_relaxed);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  std::vector<uint64_t> node_counts(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        node_counts[n] = degrees[n].load(std::memory_order_relaxed);
+        degrees[n].store(0, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  hg.incidence_indices = CountsToIndices(node_counts);
+  hg.incidence.resize(hg.incidence_indices.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, hg.num_hyperedges()),
+      [&](uint32_t h) {
+        for (uint32_t node : hg.Pins(h)) {
+          uint64_t offset =
+              degrees[node].fetch_add(1, std::memory_order_relaxed);
+          hg.incidence[hg.incidence_indices[node] + offset] = h;
+        }
+      },
+      katana::steal(), katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        std::sort(
+            hg.incidence.begin() + hg.incidence_indices[n],
+            hg.incidence.begin() + hg.incidence_indices[n + 1]);
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::GAccumulator<uint64_t> total_weight;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) { total_weight += weights[n]; }, katana::no_stats());
+  hg.weights = std::move(weights);
+  hg.total_weight = total_weight.reduce();
+
+  return hg;
+}
+
+/// The hypergraph stored in a PropertyFileGraph, along with the hypergraph
+/// node or hyperedge id of each node of the PropertyFileGraph.
+struct InputHypergraph {
+  Hypergraph hypergraph;
+  std::vector<uint8_t> is_hyperedge;
+  std::vector<uint32_t> ids;
+};
+
+katana::Result<std::vector<uint8_t>>
+ReadHyperedgeFlags(
+    katana::PropertyFileGraph* pfg,
+    const std::string& hyperedge_property_name) {
+  std::vector<uint8_t> is_hyperedge(pfg->num_nodes());
+  if (auto uint8_result =
+          pfg->NodePropertyTyped<uint8_t>(hyperedge_property_name)) {
+    auto array = uint8_result.value();
+    katana::do_all(
+        katana::iterate(size_t{0}, is_hyperedge.size()),
+        [&](size_t n) { is_hyperedge[n] = array->Value(n) != 0; },
+        katana::no_stats());
+    return is_hyperedge;
+  }
+  auto bool_result = pfg->NodePropertyTyped<bool>(hyperedge_property_name);
+  if (!bool_result) {
+    return bool_result.error();
+  }
+  auto array = bool_result.value();
+  katana::do_all(
+      katana::iterate(size_t{0}, is_hyperedge.size()),
+      [&](size_t n) { is_hyperedge[n] = array->Value(n); }, katana::no_stats());
+  return is_hyperedge;
+}
+
+/// Read pfg as a bipartite graph of hyperedges and nodes. The pins of a
+/// hyperedge are its neighbors by out-edges and by in-edges, so both
+/// directions are gathered from the out-edges without a transpose.
+template <typename GraphTy>
+katana::Result<InputHypergraph>
+MakeInputHypergraph(
+    katana::PropertyFileGraph* pfg, const GraphTy& graph,
+    const std::string& hyperedge_property_name) {
+  auto flags_result = ReadHyperedgeFlags(pfg, hyperedge_property_name);
+  if (!flags_result) {
+    return flags_result.error();
+  }
+
+  InputHypergraph input;
+  input.is_hyperedge = std::move(flags_result.value());
+  const std::vector<uint8_t>& is_hyperedge = input.is_hyperedge;
+  uint32_t num_graph_nodes = graph.size();
+
+  // The id of a hyperedge is the number of hyperedges before it, and likewise
+  // for nodes
+  std::vector<uint64_t> hyperedge_counts(num_graph_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_graph_nodes),
+      [&](uint32_t n) { hyperedge_counts[n] = is_hyperedge[n]; },
+      katana::no_stats());
+  std::vector<uint64_t> hyperedge_ranks = CountsToIndices(hyperedge_counts);
+  uint32_t num_hyperedges = hyperedge_ranks.back();
+  uint32_t num_nodes = num_graph_nodes - num_hyperedges;
+  input.ids.resize(num_graph_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_graph_nodes),
+      [&](uint32_t n) {
+        input.ids[n] = is_hyperedge[n] ? hyperedge_ranks[n]
+                                       : n - hyperedge_ranks[n];
+      },
+      katana::no_stats());
+
+  auto for_each_pin = [&](uint32_t src, const auto& fn) {
+    for (auto e : graph.edges(src)) {
+      uint32_t dst = *graph.GetEdgeDest(e);
+      if (is_hyperedge[src] && !is_hyperedge[dst]) {
+        fn(input.ids[src], input.ids[dst]);
+      } else if (!is_hyperedge[src] && is_hyperedge[dst]) {
+        fn(input.ids[dst], input.ids[src]);
+      }
+    }
+  };
+
+  std::vector<std::atomic<uint64_t>> num_pins(num_hyperedges);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        for_each_pin(n, [&](uint32_t h, uint32_t) {
+          num_pins[h].fetch_add(1, std::memory_order_relaxed);
+        });
+      },
+      katana::steal(), katana::no_stats());
+  std::vector<uint64_t> counts(num_hyperedges);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) {
+        counts[h] = num_pins[h].load(std::memory_order_relaxed);
+        num_pins[h].store(0, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  std::vector<uint64_t> pin_indices = CountsToIndices(counts);
+  std::vector<uint32_t> pins(pin_indices.back());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        for_each_pin(n, [&](uint32_t h, uint32_t pin) {
+          uint64_t offset = num_pins[h].fetch_add(1, std::memory_order_relaxed);
+          pins[pin_indices[h] + offset] = pin;
+        });
+      },
+      katana::steal(), katana::no_stats());
+
+  input.hypergraph = MakeHypergraph(
+      pin_indices, &pins, std::vector<uint32_t>(num_nodes, 1));
+  return input;
+}
+
+/// The order in which nodes prefer hyperedges to be merged along; smaller is
+/// preferred and ties are broken by a hash of the id and then by the id.
+struct Priority {
+  int64_t value;
+  uint32_t hash;
+  uint32_t id;
+
+  bool operator<(const Priority& other) const {
+    return std::tie(value, hash, id) <
+           std::tie(other.value, other.hash, other.id);
+  }
+};
+
+uint32_t
+Hash(uint32_t value) {
+  int64_t seed = value * int64_t{1103515245} + 12345;
+  return (seed / 65536) % 32768;
+}
+
+Priority
+HyperedgePriority(
+    const Hypergraph& hg, uint32_t h,
+    HypergraphPartitionPlan::MatchingPolicy policy) {
+  int64_t weight = 0;
+  if (policy == HypergraphPartitionPlan::kHigherWeight ||
+      policy == HypergraphPartitionPlan::kLowerWeight) {
+    for (uint32_t node : hg.Pins(h)) {
+      weight += hg.weights[node];
+    }
+  }
+  int64_t degree = hg.NumPins(h);
+  switch (policy) {
+  case HypergraphPartitionPlan::kHigherDegree:
+    return {-degree, Hash(h), h};
+  case HypergraphPartitionPlan::kLowerDegree:
+    return {degree, Hash(h), h};
+  case HypergraphPartitionPlan::kHigherWeight:
+    return {-weight, Hash(h), h};
+  case HypergraphPartitionPlan::kLowerWeight:
+    return {weight, Hash(h), h};
+  case HypergraphPartitionPlan::kRandom:
+  default:
+    return {Hash(h), 0, h};
+  }
+}
+
+/// Coarsen hg by one level. Every node picks its preferred hyperedge, and the
+/// nodes that picked the same hyperedge are merged, up to weight_limit. A node
+/// that is left alone joins the lightest merged node among the pins of its
+/// hyperedge, if any. Writes the coarse node of each node of hg to coarse_ids.
+Hypergraph
+Coarsen(
+    const Hypergraph& hg, HypergraphPartitionPlan::MatchingPolicy policy,
+    uint64_t weight_limit, std::vector<uint32_t>* coarse_ids) {
+  uint32_t num_nodes = hg.num_nodes();
+  uint32_t num_hyperedges = hg.num_hyperedges();
+
+  std::vector<Priority> priorities(num_hyperedges);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) { priorities[h] = HyperedgePriority(hg, h, policy); },
+      katana::steal(), katana::no_stats());
+
+  std::vector<uint32_t> choices(num_nodes, kNoHyperedge);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        for (uint32_t h : hg.Hyperedges(n)) {
+          if (choices[n] == kNoHyperedge ||
+              priorities[h] < priorities[choices[n]]) {
+            choices[n] = h;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  // Each node picked a single hyperedge, so the groups are disjoint and every
+  // node is written by at most one hyperedge. The representative of a group is
+  // its smallest node.
+  std::vector<uint32_t> parents(num_nodes, kNoNode);
+  std::vector<uint64_t> group_weights(num_nodes, 0);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_hyperedges),
+      [&](uint32_t h) {
+        uint64_t weight = 0;
+        uint32_t size = 0;
+        auto end = hg.Pins(h).begin();
+        for (auto it = hg.Pins(h).begin(); it != hg.Pins(h).end(); ++it) {
+          if (choices[*it] != h) {
+            continue;
+          }
+          if (weight + hg.weights[*it] > weight_limit) {
+            break;
+          }
+          weight += hg.weights[*it];
+          ++size;
+          end = it + 1;
+        }
+        if (size < 2) {
+          return;
+        }
+        uint32_t representative = kNoNode;
+        for (auto it = hg.Pins(h).begin(); it != end; ++it) {
+          if (choices[*it] == h) {
+            if (representative == kNoNode) {
+              representative = *it;
+            }
+            parents[*it] = representative;
+          }
+        }
+        group_weights[representative] = weight;
+      },
+      katana::steal(),
+      katana::chunk_size<HypergraphPartitionPlan::kChunkSize>(),
+      katana::no_stats());
+
+  std::vector<uint32_t> joined(num_nodes, kNoNode);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        if (parents[n] != kNoNode) {
+          return;
+        }
+        joined[n] = n;
+        if (choices[n] == kNoHyperedge) {
+          return;
+        }
+        uint64_t lightest = weight_limit - std::min<uint64_t>(
+                                               weight_limit, hg.weights[n]);
+        for (uint32_t pin : hg.Pins(choices[n])) {
+          uint32_t representative = parents[pin];
+          if (representative == kNoNode) {
+            continue;
+          }
+          uint64_t weight = group_weights[representative];
+          if (weight <= lightest &&
+              (weight < lightest || representative < joined[n])) {
+            lightest = weight;
+            joined[n] = representative;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        if (parents[n] == kNoNode) {
+          parents[n] = joined[n];
+        }
+      },
+      katana::no_stats());
+
+  std::vector<uint64_t> is_representative(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) { is_representative[n] = parents[n] == n; },
+      katana::no_stats());
+  std::vector<uint64_t> representative_ids = CountsToIndices(is_representative);
+  uint32_t num_coarse_nodes = representative_ids.back();
+
+  coarse_ids->resize(num_nodes);
+  std::vector<std::atomic<uint32_t>> coarse_weights(num_coarse_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        uint32_t coarse_id = representative_ids[parents[n]];
+        (*coarse_ids)[n] = coarse_id;
+        coarse_weights[coarse_id].fetch_add(
+            hg.weights[n], std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  std::vector<uint32_t> weights(num_coarse_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_coarse_nodes),
+      [&](uint32_t n) {
+        weights[n] = coarse_weights[n].load(std::memory_order_relaxed);
+      },
+      katana::no_stats());
+
+  std::vector<uint32_t> pins(hg.pins.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, pins.size()),
+      [&](size_t i) { pins[i] = (*coarse_ids)[hg.pins[i]]; },
+      katana::no_stats());
+
+  return MakeHypergraph(hg.pin_indices, &pins, std::move(weights));
+}
+
+/// The sub-hypergraph of the nodes on the given side of a bisection, and the
+/// node of hg for each of its nodes.
+std::pair<Hypergraph, std::vector<uint32_t>>
+RestrictToSide(
+    const Hypergraph& hg, const std::vector<uint8_t>& sides, uint8_t side) {
+  uint32_t num_nodes = hg.num_nodes();
+  std::vector<uint64_t> on_side(num_nodes);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) { on_side[n] = sides[n] == side; }, katana::no_stats());
+  std::vector<uint64_t> local_ids = CountsToIndices(on_side);
+
+  std::vector<uint32_t> nodes(local_ids.back());
+  std::vector<uint32_t> weights(local_ids.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, num_nodes),
+      [&](uint32_t n) {
+        if (on_side[n]) {
+          nodes[local_ids[n]] = n;
+          weights[local_ids[n]] = hg.weights[n];
+        }
+      },
+      katana::no_stats());
+
+  std::vector<uint64_t> counts(hg.num_hyperedges());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, hg.num_hyperedges()),
+      [&](uint32_t h) {
+        counts[h] = std::count_if(
+            hg.Pins(h).begin(), hg.Pins(h).end(),
+            [&](uint32_t pin) { return on_side[pin]; });
+      },
+      katana::steal(), katana::no_stats());
+  std::vector<uint64_t> pin_indices = CountsToIndices(counts);
+  std::vector<uint32_t> pins(pin_indices.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, hg.num_hyperedges()),
+      [&](uint32_t h) {
+        uint64_t offset = pin_indices[h];
+        for (uint32_t pin : hg.Pins(h)) {
+          if (on_side[pin]) {
+            pins[offset++] = local_ids[pin];
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return std::make_pair(
+      MakeHypergraph(pin_indices, &pins, std::move(weights)), std::move(nodes));
+}
+
+/// A bisection of a hypergraph along with the bookkeeping to move nodes
+/// between its sides.
+class Bisection {
+  const Hypergraph& hg_;
+  std::vector<uint8_t>* sides_;
+  uint64_t max_weights_[2];
+  uint64_t weights_[2];
+  /// The number of pins of each hyperedge on each side
+  std::vector<uint32_t> pin_counts_;
+
+public:
+  Bisection(
+      const Hypergraph& hg, std::vector<uint8_t>* sides,
+      const uint64_t max_weights[2])
+      : hg_(hg),
+        sides_(sides),
+        max_weights_{max_weights[0], max_weights[1]},
+        pin_counts_(2 * hg.num_hyperedges()) {
+    katana::GAccumulator<uint64_t> weight_0;
+    katana::do_all(
+        katana::iterate(uint32_t{0}, hg_.num_nodes()),
+        [&](uint32_t n) {
+          if ((*sides_)[n] == 0) {
+            weight_0 += hg_.weights[n];
+          }
+        },
+        katana::no_stats());
+    weights_[0] = weight_0.reduce();
+    weights_[1] = hg_.total_weight - weights_[0];
+  }
+
+  /// The number of hyperedges no longer cut minus the number newly cut if
+  /// node moved to the other side, given up to date pin counts.
+  int64_t Gain(uint32_t node) const {
+    uint8_t side = (*sides_)[node];
+    int64_t gain = 0;
+    for (uint32_t h : hg_.Hyperedges(node)) {
+      uint32_t same = pin_counts_[2 * h + side];
+      uint32_t other = pin_counts_[2 * h + 1 - side];
+      if (other == 0) {
+        gain -= same > 1;
+      } else if (same == 1) {
+        gain += 1;
+      }
+    }
+    return gain;
+  }
+
+  void UpdatePinCounts() {
+    katana::do_all(
+        katana::iterate(uint32_t{0}, hg_.num_hyperedges()),
+        [&](uint32_t h) {
+          uint32_t on_1 = 0;
+          for (uint32_t pin : hg_.Pins(h)) {
+            on_1 += (*sides_)[pin];
+          }
+          pin_counts_[2 * h] = hg_.NumPins(h) - on_1;
+          pin_counts_[2 * h + 1] = on_1;
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  /// The nodes on side with gain at least min_gain, by decreasing gain and
+  /// then by id. Pin counts must be up to date.
+  std::vector<std::pair<int64_t, uint32_t>> Candidates(
+      uint8_t side, int64_t min_gain) const {
+    std::vector<int64_t> gains(hg_.num_nodes());
+    std::vector<uint64_t> is_candidate(hg_.num_nodes());
+    katana::do_all(
+        katana::iterate(uint32_t{0}, hg_.num_nodes()),
+        [&](uint32_t n) {
+          if ((*sides_)[n] == side) {
+            gains[n] = Gain(n);
+            is_candidate[n] = gains[n] >= min_gain;
+          }
+        },
+        katana::steal(), katana::no_stats());
+    std::vector<uint64_t> offsets = CountsToIndices(is_candidate);
+    std::vector<std::pair<int64_t, uint32_t>> candidates(offsets.back());
+    katana::do_all(
+        katana::iterate(uint32_t{0}, hg_.num_nodes()),
+        [&](uint32_t n) {
+          if (is_candidate[n]) {
+            candidates[offsets[n]] = std::make_pair(-gains[n], n);
+          }
+        },
+        katana::no_stats());
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+  }
+
+  /// Move node to the other side if that side stays within its maximum
+  /// weight.
+  bool Move(uint32_t node) {
+    uint8_t side = (*sides_)[node];
+    uint32_t weight = hg_.weights[node];
+    if (weights_[1 - side] + weight > max_weights_[1 - side]) {
+      return false;
+    }
+    (*sides_)[node] = 1 - side;
+    weights_[side] -= weight;
+    weights_[1 - side] += weight;
+    return true;
+  }
+
+  /// Greedy initial bisection: start with every node on side 1 and move the
+  /// nodes with the highest gain to side 0, in batches of about the square
+  /// root of the number of nodes, until side 0 has its share of the weight.
+  void Initialize(uint64_t target_weight_0) {
+    std::fill(sides_->begin(), sides_->end(), 1);
+    weights_[0] = 0;
+    weights_[1] = hg_.total_weight;
+    size_t batch_size = std::max<size_t>(1, std::sqrt(hg_.num_nodes()));
+    while (weights_[0] < target_weight_0) {
+      UpdatePinCounts();
+      auto candidates = Candidates(1, std::numeric_limits<int64_t>::min());
+      size_t moved = 0;
+      for (const auto& candidate : candidates) {
+        if (moved == batch_size || weights_[0] >= target_weight_0) {
+          break;
+        }
+        moved += Move(candidate.second);
+      }
+      if (moved == 0) {
+        break;
+      }
+    }
+  }
+
+  /// One pass of refinement: swap equal numbers of the nodes with positive
+  /// gain on each side, best first, then restore the balance.
+  void Refine() {
+    UpdatePinCounts();
+    auto candidates_0 = Candidates(0, 1);
+    auto candidates_1 = Candidates(1, 1);
+    size_t num_swaps = std::min(candidates_0.size(), candidates_1.size());
+    for (size_t i = 0; i < num_swaps; ++i) {
+      uint32_t node_0 = candidates_0[i].second;
+      uint32_t node_1 = candidates_1[i].second;
+      (*sides_)[node_0] = 1;
+      (*sides_)[node_1] = 0;
+      int64_t delta = int64_t{hg_.weights[node_1]} - hg_.weights[node_0];
+      weights_[0] += delta;
+      weights_[1] -= delta;
+    }
+    Rebalance();
+  }
+
+  /// Move the nodes with the highest gain off a side heavier than its maximum
+  /// weight until it is not.
+  void Rebalance() {
+    size_t batch_size = std::max<size_t>(1, std::sqrt(hg_.num_nodes()));
+    for (uint8_t side : {0, 1}) {
+      while (weights_[side] > max_weights_[side]) {
+        UpdatePinCounts();
+        auto candidates =
+            Candidates(side, std::numeric_limits<int64_t>::min());
+        size_t moved = 0;
+        for (const auto& candidate : candidates) {
+          if (moved == batch_size || weights_[side] <= max_weights_[side]) {
+            break;
+          }
+          moved += Move(candidate.second);
+        }
+        if (moved == 0) {
+          break;
+        }
+      }
+    }
+  }
+};
+
+/// Bisect hg into sides of about num_parts_0 and num_parts_1 parts' worth of
+/// weight, through coarsening, initial bisection and refinement.
+std::vector<uint8_t>
+Bisect(
+    const Hypergraph& hg, uint32_t num_parts_0, uint32_t num_parts_1,
+    const HypergraphPartitionPlan& plan) {
+  double share_0 = static_cast<double>(num_parts_0) /
+                   static_cast<double>(num_parts_0 + num_parts_1);
+  uint64_t target_weight_0 = std::llround(share_0 * hg.total_weight);
+  uint64_t max_weights[2] = {
+      static_cast<uint64_t>(std::ceil(
+          (1 + plan.imbalance_tolerance()) * share_0 * hg.total_weight)),
+      static_cast<uint64_t>(std::ceil(
+          (1 + plan.imbalance_tolerance()) * (1 - share_0) *
+          hg.total_weight))};
+  // As in BiPart, a coarse node may weigh at most a quarter of the heavier
+  // side
+  uint64_t weight_limit =
+      std::max<uint64_t>(1, std::max(max_weights[0], max_weights[1]) / 4);
+
+  std::vector<Hypergraph> coarse_levels;
+  std::vector<std::vector<uint32_t>> coarse_ids;
+  auto level = [&](size_t i) -> const Hypergraph& {
+    return i == 0 ? hg : coarse_levels[i - 1];
+  };
+  while (coarse_levels.size() < plan.max_coarsening_levels()) {
+    const Hypergraph& fine = level(coarse_levels.size());
+    if (fine.num_hyperedges() < kCoarsestHyperedgeLimit ||
+        fine.num_nodes() < kCoarsestNodeLimit) {
+      break;
+    }
+    std::vector<uint32_t> ids;
+    Hypergraph coarse =
+        Coarsen(fine, plan.matching_policy(), weight_limit, &ids);
+    if (coarse.num_nodes() == fine.num_nodes()) {
+      break;
+    }
+    coarse_levels.emplace_back(std::move(coarse));
+    coarse_ids.emplace_back(std::move(ids));
+  }
+
+  size_t num_levels = coarse_levels.size();
+  std::vector<uint8_t> sides(level(num_levels).num_nodes());
+  {
+    Bisection bisection(level(num_levels), &sides, max_weights);
+    bisection.Initialize(target_weight_0);
+    for (uint32_t i = 0; i < plan.refinement_iterations(); ++i) {
+      bisection.Refine();
+    }
+    bisection.Rebalance();
+  }
+
+  for (size_t i = num_levels; i > 0; --i) {
+    const Hypergraph& fine = level(i - 1);
+    const std::vector<uint32_t>& ids = coarse_ids[i - 1];
+    std::vector<uint8_t> fine_sides(fine.num_nodes());
+    katana::do_all(
+        katana::iterate(uint32_t{0}, fine.num_nodes()),
+        [&](uint32_t n) { fine_sides[n] = sides[ids[n]]; }, katana::no_stats());
+    sides = std::move(fine_sides);
+
+    Bisection bisection(fine, &sides, max_weights);
+    for (uint32_t j = 0; j < plan.refinement_iterations(); ++j) {
+      bisection.Refine();
+    }
+    bisection.Rebalance();
+  }
+
+  return sides;
+}
+
+/// Partition hg into num_parts parts by recursive bisection, splitting the
+/// parts as evenly as possible at each step.
+std::vector<uint32_t>
+PartitionRecursively(
+    const Hypergraph& hg, uint32_t num_parts,
+    const HypergraphPartitionPlan& plan) {
+  std::vector<uint32_t> parts(hg.num_nodes(), 0);
+  if (num_parts < 2 || hg.num_nodes() == 0) {
+    return parts;
+  }
+
+  uint32_t num_parts_0 = (num_parts + 1) / 2;
+  uint32_t num_parts_1 = num_parts / 2;
+  std::vector<uint8_t> sides = Bisect(hg, num_parts_0, num_parts_1, plan);
+
+  for (uint8_t side : {0, 1}) {
+    auto [sub_hg, nodes] = RestrictToSide(hg, sides, side);
+    std::vector<uint32_t> sub_parts = PartitionRecursively(
+        sub_hg, side == 0 ? num_parts_0 : num_parts_1, plan);
+    uint32_t first_part = side == 0 ? 0 : num_parts_0;
+    katana::do_all(
+        katana::iterate(size_t{0}, nodes.size()),
+        [&](size_t i) { parts[nodes[i]] = first_part + sub_parts[i]; },
+        katana::no_stats());
+  }
+  return parts;
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::HypergraphPartition(
+    katana::PropertyFileGraph* pfg, const std::string& hyperedge_property_name,
+    uint32_t num_partitions, const std::string& output_property_name,
+    HypergraphPartitionPlan plan) {
+  if (num_partitions == 0 || plan.imbalance_tolerance() < 0 ||
+      plan.algorithm() != HypergraphPartitionPlan::kBiPart) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  if (auto result = ConstructNodeProperties<std::tuple<NodePartition>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("HypergraphPartition");
+  exec_time.start();
+
+  auto input_result =
+      MakeInputHypergraph(pfg, graph, hyperedge_property_name);
+  if (!input_result) {
+    return input_result.error();
+  }
+  const InputHypergraph& input = input_result.value();
+  std::vector<uint32_t> parts =
+      PartitionRecursively(input.hypergraph, num_partitions, plan);
+
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        graph.GetData<NodePartition>(node) = input.is_hyperedge[node]
+                                                 ? kHyperedgePartition
+                                                 : parts[input.ids[node]];
+      },
+      katana::no_stats());
+
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::HypergraphPartitionAssertValid(
+    katana::PropertyFileGraph* pfg, const std::string& hyperedge_property_name,
+    uint32_t num_partitions, const std::string& property_name) {
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  auto flags_result = ReadHyperedgeFlags(pfg, hyperedge_property_name);
+  if (!flags_result) {
+    return flags_result.error();
+  }
+  const std::vector<uint8_t>& is_hyperedge = flags_result.value();
+
+  katana::GReduceLogicalOr has_error;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        uint32_t part = graph.GetData<NodePartition>(node);
+        if (is_hyperedge[node] ? part != kHyperedgePartition
+                               : part >= num_partitions) {
+          has_error.update(true);
+        }
+      },
+      katana::no_stats());
+  if (has_error.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+double
+katana::analytics::HypergraphPartitionStatistics::Imbalance() const {
+  if (part_sizes.empty()) {
+    return 1;
+  }
+  uint64_t total = 0;
+  uint64_t largest = 0;
+  for (uint64_t size : part_sizes) {
+    total += size;
+    largest = std::max(largest, size);
+  }
+  if (total == 0) {
+    return 1;
+  }
+  return static_cast<double>(largest) * part_sizes.size() / total;
+}
+
+void
+katana::analytics::HypergraphPartitionStatistics::Print(
+    std::ostream& os) const {
+  os << "Number of cut hyperedges = " << num_cut_hyperedges << std::endl;
+  os << "Number of parts = " << part_sizes.size() << std::endl;
+  for (size_t i = 0; i < part_sizes.size(); ++i) {
+    os << "Size of part " << i << " = " << part_sizes[i] << std::endl;
+  }
+  os << "Imbalance = " << Imbalance() << std::endl;
+}
+
+katana::Result<HypergraphPartitionStatistics>
+katana::analytics::HypergraphPartitionStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& hyperedge_property_name,
+    const std::string& property_name) {
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  auto input_result = MakeInputHypergraph(pfg, graph, hyperedge_property_name);
+  if (!input_result) {
+    return input_result.error();
+  }
+  const InputHypergraph& input = input_result.value();
+  const Hypergraph& hg = input.hypergraph;
+
+  std::vector<uint32_t> parts(hg.num_nodes());
+  katana::GReduceMax<uint32_t> max_part;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        if (!input.is_hyperedge[node]) {
+          uint32_t part = graph.GetData<NodePartition>(node);
+          parts[input.ids[node]] = part;
+          max_part.update(part);
+        }
+      },
+      katana::no_stats());
+
+  katana::GAccumulator<uint64_t> num_cut_hyperedges;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, hg.num_hyperedges()),
+      [&](uint32_t h) {
+        uint32_t first_part = parts[*hg.Pins(h).begin()];
+        for (uint32_t pin : hg.Pins(h)) {
+          if (parts[pin] != first_part) {
+            num_cut_hyperedges += 1;
+            return;
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  std::vector<uint64_t> part_sizes(
+      hg.num_nodes() == 0 ? 0 : max_part.reduce() + 1, 0);
+  for (uint32_t part : parts) {
+    part_sizes[part] += 1;
+  }
+
+  return HypergraphPartitionStatistics{
+      num_cut_hyperedges.reduce(), std::move(part_sizes)};
+}
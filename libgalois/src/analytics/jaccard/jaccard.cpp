@@ -19,6 +19,7 @@
 
 #include "katana/analytics/jaccard/jaccard.h"
 
+#include "katana/analytics/GraphProfile.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -131,6 +132,17 @@ JaccardImpl(
 
 }  // namespace
 
+katana::analytics::JaccardPlan
+katana::analytics::JaccardPlan::Automatic(PropertyFileGraph* pfg) {
+  auto profile_opt = GraphProfile::ForAutomaticPlan(pfg);
+  if (!profile_opt) {
+    return {};
+  }
+  const GraphProfile& profile = *profile_opt;
+
+  return profile.edges_sorted ? Sorted() : Unsorted();
+}
+
 katana::Result<void>
 katana::analytics::Jaccard(
     PropertyFileGraph* pfg, uint32_t compare_node,
@@ -20,6 +20,7 @@
 #include "katana/analytics/k_core/k_core.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/Frontier.h"
 
 using namespace katana::analytics;
 
@@ -85,49 +86,46 @@ SetupInitialWorklist(
 }
 
 /**
- * Starting with initial dead nodes as current worklist; decrement degree;
- * add to next worklist; switch next with current and repeat until worklist
+ * Starting with initial dead nodes as current frontier; decrement degree;
+ * add to next frontier; switch next with current and repeat until frontier
  * is empty (i.e. no more dead nodes).
  *
+ * The graph is symmetric, so once the frontier is large, EdgeMap pulls: each
+ * live node counts its dead neighbors only until it dies itself.
+ *
  * @param graph Graph to operate on
  * @param k_core_number Each node in the core is expected to have degree <= k_core_number
  */
 void
 SyncCascadeKCore(Graph* graph, uint32_t k_core_number) {
-  katana::InsertBag<GNode>* current = new katana::InsertBag<GNode>;
-  katana::InsertBag<GNode>* next = new katana::InsertBag<GNode>;
-
-  //! Setup worklist.
-  SetupInitialWorklist(*graph, *next, k_core_number);
-
-  while (!next->empty()) {
-    //! Make "next" into current.
-    std::swap(current, next);
-    next->clear();
-
-    katana::do_all(
-        katana::iterate(*current),
-        [&](const GNode& dead_node) {
-          //! Decrement degree of all neighbors.
-          for (auto e : graph->edges(dead_node)) {
-            auto dest = graph->GetEdgeDest(e);
-            auto& dest_current_degree =
-                graph->GetData<KCoreNodeCurrentDegree>(dest);
-            uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
-
-            if (old_degree == k_core_number) {
-              //! This thread was responsible for putting degree of destination
-              //! below threshold; add to worklist.
-              next->emplace(*dest);
-            }
-          }
+  auto is_alive = [&](const GNode& node) {
+    return graph->GetData<KCoreNodeCurrentDegree>(node) >= k_core_number;
+  };
+
+  //! Setup frontier.
+  katana::Frontier frontier = katana::Frontier::All(graph->num_nodes());
+  frontier = frontier.Filter(
+      [&](const GNode& node) { return !is_alive(node); },
+      "InitialWorklistSetup");
+
+  katana::EdgeMapOptions options;
+  options.symmetric = true;
+  options.chunk_size = KCorePlan::kChunkSize;
+  options.loopname = "KCore Synchronous";
+  while (!frontier.empty()) {
+    //! Decrement degree of all live neighbors.
+    frontier = katana::EdgeMap(
+        *graph, &frontier,
+        [&](const GNode&, const GNode& dest, auto) {
+          auto& dest_current_degree =
+              graph->GetData<KCoreNodeCurrentDegree>(dest);
+          uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
+          //! This thread was responsible for putting degree of destination
+          //! below threshold; add to frontier.
+          return old_degree == k_core_number;
         },
-        katana::steal(), katana::chunk_size<KCorePlan::kChunkSize>(),
-        katana::loopname("KCore Synchronous"));
+        is_alive, options);
   }
-
-  delete current;
-  delete next;
 }
 
 /**
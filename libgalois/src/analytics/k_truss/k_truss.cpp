@@ -20,6 +20,8 @@
 #include "katana/analytics/k_truss/k_truss.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/Frontier.h"
+#include "katana/analytics/GraphProfile.h"
 
 using namespace katana::analytics;
 
@@ -33,7 +35,6 @@ typedef typename Graph::Node GNode;
 
 using Edge = std::pair<GNode, GNode>;
 using EdgeVec = katana::InsertBag<Edge>;
-using NodeVec = katana::InsertBag<GNode>;
 
 static const uint32_t valid = 0x0;
 static const uint32_t removed = 0x1;
@@ -263,20 +264,19 @@ BSPTrussAlgo(Graph* g, unsigned int k) {
 struct KeepValidNodes {
   Graph* g;
   unsigned int j;
-  NodeVec& s;
 
-  void operator()(GNode n) {
+  bool operator()(GNode n) const {
     if (IsValidDegreeNoLessThanJ(*g, n, j)) {
-      s.push_back(n);
-    } else {
-      for (auto e : g->edges(n)) {
-        auto dest = g->GetEdgeDest(e);
-        g->template GetEdgeData<EdgeFlag>(
-            katana::FindEdgeSortedByDest(*g, n, *dest)) = removed;
-        g->template GetEdgeData<EdgeFlag>(
-            katana::FindEdgeSortedByDest(*g, *dest, n)) = removed;
-      }
+      return true;
+    }
+    for (auto e : g->edges(n)) {
+      auto dest = g->GetEdgeDest(e);
+      g->template GetEdgeData<EdgeFlag>(
+          katana::FindEdgeSortedByDest(*g, n, *dest)) = removed;
+      g->template GetEdgeData<EdgeFlag>(
+          katana::FindEdgeSortedByDest(*g, *dest, n)) = removed;
     }
+    return false;
   }
 };
 
@@ -286,22 +286,12 @@ struct KeepValidNodes {
 /// 3. Go back to 1.
 katana::Result<void>
 BSPCoreAlgo(Graph* g, uint32_t k) {
-  NodeVec work[2];
-  NodeVec *cur = &work[0], *next = &work[1];
-  size_t curSize = g->num_nodes(), nextSize;
-
-  katana::do_all(
-      katana::iterate(*g), KeepValidNodes{g, k, *next}, katana::steal());
-  nextSize = std::distance(next->begin(), next->end());
-
-  while (curSize != nextSize) {
-    cur->clear();
-    curSize = nextSize;
-    std::swap(cur, next);
+  katana::Frontier cur = katana::Frontier::All(g->num_nodes());
+  katana::Frontier next = cur.Filter(KeepValidNodes{g, k});
 
-    katana::do_all(
-        katana::iterate(*cur), KeepValidNodes{g, k, *next}, katana::steal());
-    nextSize = std::distance(next->begin(), next->end());
+  while (cur.size() != next.size()) {
+    cur = std::move(next);
+    next = cur.Filter(KeepValidNodes{g, k});
   }
   return katana::ResultSuccess();
 }
@@ -335,6 +325,21 @@ BSPCoreThenTrussAlgo(Graph* g, uint32_t k) {
   return katana::ResultSuccess();
 }
 
+katana::analytics::KTrussPlan
+katana::analytics::KTrussPlan::Automatic(PropertyFileGraph* pfg) {
+  auto profile_opt = GraphProfile::ForAutomaticPlan(pfg);
+  if (!profile_opt) {
+    return {};
+  }
+  const GraphProfile& profile = *profile_opt;
+  const PlanCalibration& calibration = PlanCalibration::Get();
+
+  if (calibration.IsPowerLaw(profile)) {
+    return BspCoreThenTruss();
+  }
+  return Bsp();
+}
+
 katana::Result<void>
 katana::analytics::KTruss(
     katana::PropertyFileGraph* pfg, uint32_t k_truss_number,
@@ -0,0 +1,553 @@
+#include "katana/analytics/label_propagation/label_propagation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int LabelPropagationPlan::kChunkSize = 64;
+
+namespace {
+
+/// Internally, a label is the id of a node: the node itself without seeds, or
+/// the smallest node with the same seed label.
+constexpr uint32_t kUnlabeled = std::numeric_limits<uint32_t>::max();
+constexpr uint64_t kUnlabeledOutput = std::numeric_limits<uint64_t>::max();
+
+struct NodeLabel : public katana::PODProperty<uint64_t> {};
+
+template <typename Weight>
+struct EdgeWeight : public katana::PODProperty<Weight> {};
+
+template <typename Weight>
+using EdgeData = std::conditional_t<
+    std::is_void_v<Weight>, std::tuple<>, std::tuple<EdgeWeight<Weight>>>;
+
+template <typename Weight>
+using Graph =
+    katana::PropertyGraph<std::tuple<NodeLabel>, EdgeData<Weight>>;
+
+using GNode = uint32_t;
+
+uint64_t
+Hash(uint64_t val) {
+  // splitmix64 finalizer
+  val = (val ^ (val >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  val = (val ^ (val >> 27)) * 0x94d049bb133111ebULL;
+  return val ^ (val >> 31);
+}
+
+/// Per-thread vote counts for the labels around one node. Small
+/// neighborhoods use an open addressing table sized to the degree; nodes
+/// whose degree is a large fraction of the number of labels use an array
+/// indexed by label, which then costs no more than the table. Only touched
+/// entries are cleared between nodes, so no per-node allocation is needed.
+class LabelHistogram {
+  constexpr static size_t kDenseFactor = 4;
+  constexpr static size_t kMinCapacity = 16;
+
+  std::vector<uint32_t> keys_;
+  std::vector<double> weights_;
+  std::vector<double> dense_weights_;
+  std::vector<uint8_t> dense_seen_;
+  std::vector<uint32_t> used_;
+  size_t mask_{0};
+  bool dense_{false};
+
+  size_t Slot(uint32_t label) const {
+    return ((uint64_t{label} * 0x9e3779b97f4a7c15ULL) >> 32) & mask_;
+  }
+
+public:
+  /// Prepare for at most num_votes distinct labels out of num_labels
+  void Reset(size_t num_votes, size_t num_labels) {
+    dense_ = num_votes * kDenseFactor >= num_labels;
+    if (dense_) {
+      if (dense_weights_.size() < num_labels) {
+        dense_weights_.resize(num_labels, 0);
+        dense_seen_.resize(num_labels, 0);
+      }
+      return;
+    }
+    size_t capacity = kMinCapacity;
+    while (capacity < 2 * num_votes) {
+      capacity *= 2;
+    }
+    if (keys_.size() < capacity) {
+      keys_.resize(capacity, kUnlabeled);
+      weights_.resize(capacity, 0);
+    }
+    mask_ = capacity - 1;
+  }
+
+  void Add(uint32_t label, double weight) {
+    if (dense_) {
+      if (!dense_seen_[label]) {
+        dense_seen_[label] = 1;
+        used_.emplace_back(label);
+      }
+      dense_weights_[label] += weight;
+      return;
+    }
+    size_t slot = Slot(label);
+    while (keys_[slot] != label) {
+      if (keys_[slot] == kUnlabeled) {
+        keys_[slot] = label;
+        used_.emplace_back(slot);
+        break;
+      }
+      slot = (slot + 1) & mask_;
+    }
+    weights_[slot] += weight;
+  }
+
+  /// The label with the largest weight, or current if there were no votes.
+  /// Ties are broken in favor of current and otherwise by a hash of each
+  /// label with salt, since always picking, e.g., the smallest label lets
+  /// a few labels flood the graph while most votes are still ties. Clears the
+  /// histogram.
+  uint32_t Best(uint32_t current, uint64_t salt) {
+    uint32_t best = current;
+    uint64_t best_rank = 0;
+    double best_weight = -std::numeric_limits<double>::infinity();
+    double current_weight = best_weight;
+    for (uint32_t u : used_) {
+      uint32_t label = dense_ ? u : keys_[u];
+      double& weight = dense_ ? dense_weights_[u] : weights_[u];
+      uint64_t rank = Hash(label ^ salt);
+      if (weight > best_weight || (weight == best_weight && rank < best_rank)) {
+        best = label;
+        best_rank = rank;
+        best_weight = weight;
+      }
+      if (label == current) {
+        current_weight = weight;
+      }
+      weight = 0;
+      if (dense_) {
+        dense_seen_[u] = 0;
+      } else {
+        keys_[u] = kUnlabeled;
+      }
+    }
+    used_.clear();
+    return current_weight == best_weight ? current : best;
+  }
+};
+
+template <typename Weight, typename GraphTy>
+uint32_t
+Vote(
+    const GraphTy& graph, const GNode& node,
+    const std::vector<std::atomic<uint32_t>>& labels, uint32_t current,
+    uint32_t iteration, LabelHistogram* histogram) {
+  auto edges = graph.edges(node);
+  histogram->Reset(std::distance(edges.begin(), edges.end()), graph.size());
+  for (auto e : edges) {
+    auto dest = *graph.GetEdgeDest(e);
+    if (dest == node) {
+      continue;
+    }
+    uint32_t label = labels[dest].load(std::memory_order_relaxed);
+    if (label == kUnlabeled) {
+      continue;
+    }
+    if constexpr (std::is_void_v<Weight>) {
+      histogram->Add(label, 1);
+    } else {
+      histogram->Add(
+          label, graph.template GetEdgeData<EdgeWeight<Weight>>(e));
+    }
+  }
+  return histogram->Best(current, Hash((uint64_t{iteration} << 32) | node));
+}
+
+/// Initial internal labels and which nodes are fixed. With seeds, also maps
+/// every representative node to its seed label.
+struct Seeding {
+  std::vector<std::atomic<uint32_t>> labels;
+  std::vector<uint8_t> is_fixed;
+  std::shared_ptr<arrow::UInt64Array> seeds;
+
+  uint64_t OutputLabel(uint32_t label) const {
+    if (label == kUnlabeled) {
+      return kUnlabeledOutput;
+    }
+    return seeds ? seeds->Value(label) : label;
+  }
+};
+
+katana::Result<Seeding>
+MakeSeeding(katana::PropertyFileGraph* pfg, const std::string& seed_name) {
+  size_t num_nodes = pfg->num_nodes();
+  Seeding seeding;
+  seeding.labels = std::vector<std::atomic<uint32_t>>(num_nodes);
+  seeding.is_fixed.resize(num_nodes, 0);
+
+  if (seed_name.empty()) {
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { seeding.labels[n].store(n); }, katana::no_stats());
+    return seeding;
+  }
+
+  auto seeds_result = pfg->NodePropertyTyped<uint64_t>(seed_name);
+  if (!seeds_result) {
+    return seeds_result.error();
+  }
+  seeding.seeds = seeds_result.value();
+
+  std::unordered_map<uint64_t, uint32_t> representatives;
+  for (size_t n = 0; n < num_nodes; ++n) {
+    if (seeding.seeds->IsNull(n)) {
+      seeding.labels[n].store(kUnlabeled);
+      continue;
+    }
+    auto it = representatives.emplace(seeding.seeds->Value(n), n).first;
+    seeding.labels[n].store(it->second);
+    seeding.is_fixed[n] = 1;
+  }
+  return seeding;
+}
+
+template <typename Weight>
+void
+Propagate(
+    const Graph<Weight>& graph, const LabelPropagationPlan& plan,
+    Seeding* seeding) {
+  auto& labels = seeding->labels;
+  const auto& is_fixed = seeding->is_fixed;
+  const bool is_synchronous =
+      plan.algorithm() == LabelPropagationPlan::kSynchronous;
+
+  katana::PerThreadStorage<LabelHistogram> histograms;
+  std::vector<uint32_t> next_labels(is_synchronous ? graph.size() : 0);
+  std::vector<std::atomic<uint8_t>> is_queued(graph.size());
+  katana::InsertBag<GNode> frontier;
+  katana::InsertBag<GNode> next_frontier;
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        if (!is_fixed[node]) {
+          frontier.push(node);
+        }
+      },
+      katana::no_stats());
+
+  katana::GAccumulator<size_t> num_changed;
+  auto update = [&](const GNode& node, uint32_t label) {
+    if (label == labels[node].load(std::memory_order_relaxed)) {
+      return;
+    }
+    labels[node].store(label, std::memory_order_relaxed);
+    num_changed += 1;
+    for (auto e : graph.edges(node)) {
+      auto dest = *graph.GetEdgeDest(e);
+      if (!is_fixed[dest] && !is_queued[dest].exchange(1)) {
+        next_frontier.push(dest);
+      }
+    }
+  };
+
+  uint32_t num_iterations = 0;
+  while (!frontier.empty() && num_iterations < plan.max_iterations()) {
+    ++num_iterations;
+
+    if (is_synchronous) {
+      katana::do_all(
+          katana::iterate(frontier),
+          [&](const GNode& node) {
+            next_labels[node] = Vote<Weight>(
+                graph, node, labels, labels[node].load(), num_iterations,
+                histograms.getLocal());
+          },
+          katana::steal(),
+          katana::chunk_size<LabelPropagationPlan::kChunkSize>(),
+          katana::loopname("LabelPropagation Vote"));
+      katana::do_all(
+          katana::iterate(frontier),
+          [&](const GNode& node) { update(node, next_labels[node]); },
+          katana::steal(),
+          katana::chunk_size<LabelPropagationPlan::kChunkSize>(),
+          katana::loopname("LabelPropagation Update"));
+    } else {
+      katana::do_all(
+          katana::iterate(frontier),
+          [&](const GNode& node) {
+            uint32_t label = Vote<Weight>(
+                graph, node, labels, labels[node].load(), num_iterations,
+                histograms.getLocal());
+            update(node, label);
+          },
+          katana::steal(),
+          katana::chunk_size<LabelPropagationPlan::kChunkSize>(),
+          katana::loopname("LabelPropagation Vote"));
+    }
+
+    frontier.swap(next_frontier);
+    next_frontier.clear();
+    katana::do_all(
+        katana::iterate(frontier),
+        [&](const GNode& node) { is_queued[node].store(0); },
+        katana::no_stats());
+  }
+
+  katana::ReportStatSingle("LabelPropagation", "Iterations", num_iterations);
+  katana::ReportStatSingle(
+      "LabelPropagation", "LabelChanges", num_changed.reduce());
+}
+
+template <typename Weight>
+katana::Result<void>
+Run(katana::PropertyFileGraph* pfg, const std::string& edge_weight_name,
+    const std::string& seed_name, const std::string& output_property_name,
+    const LabelPropagationPlan& plan) {
+  auto seeding_result = MakeSeeding(pfg, seed_name);
+  if (!seeding_result) {
+    return seeding_result.error();
+  }
+  Seeding seeding = std::move(seeding_result.value());
+
+  if (auto result = ConstructNodeProperties<std::tuple<NodeLabel>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  std::vector<std::string> edge_properties;
+  if (!edge_weight_name.empty()) {
+    edge_properties.emplace_back(edge_weight_name);
+  }
+  auto pg_result =
+      Graph<Weight>::Make(pfg, {output_property_name}, edge_properties);
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph<Weight> graph = pg_result.value();
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("LabelPropagation");
+
+  exec_time.start();
+  Propagate<Weight>(graph, plan, &seeding);
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        graph.template GetData<NodeLabel>(node) =
+            seeding.OutputLabel(seeding.labels[node].load());
+      },
+      katana::no_stats());
+
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+template <typename Weight>
+katana::Result<void>
+AssertValidImpl(
+    katana::PropertyFileGraph* pfg, const std::string& edge_weight_name,
+    const std::string& seed_name, const std::string& property_name) {
+  auto seeding_result = MakeSeeding(pfg, seed_name);
+  if (!seeding_result) {
+    return seeding_result.error();
+  }
+  Seeding seeding = std::move(seeding_result.value());
+
+  std::vector<std::string> edge_properties;
+  if (!edge_weight_name.empty()) {
+    edge_properties.emplace_back(edge_weight_name);
+  }
+  auto pg_result = Graph<Weight>::Make(pfg, {property_name}, edge_properties);
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph<Weight> graph = pg_result.value();
+
+  // Map the output labels back to internal labels
+  std::unordered_map<uint64_t, uint32_t> seed_representatives;
+  if (seeding.seeds) {
+    for (size_t n = 0; n < graph.size(); ++n) {
+      if (seeding.is_fixed[n]) {
+        seed_representatives.emplace(
+            seeding.seeds->Value(n), seeding.labels[n].load());
+      }
+    }
+  }
+  std::vector<std::atomic<uint32_t>> labels(graph.size());
+  for (size_t n = 0; n < graph.size(); ++n) {
+    uint64_t output = graph.template GetData<NodeLabel>(n);
+    if (output == kUnlabeledOutput) {
+      labels[n].store(kUnlabeled);
+    } else if (!seeding.seeds) {
+      if (output >= graph.size()) {
+        return katana::ErrorCode::AssertionFailed;
+      }
+      labels[n].store(output);
+    } else {
+      auto it = seed_representatives.find(output);
+      if (it == seed_representatives.end()) {
+        return katana::ErrorCode::AssertionFailed;
+      }
+      labels[n].store(it->second);
+    }
+  }
+
+  katana::PerThreadStorage<LabelHistogram> histograms;
+  katana::GReduceLogicalOr has_error;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& node) {
+        uint32_t label = labels[node].load();
+        if (seeding.is_fixed[node]) {
+          if (label != seeding.labels[node].load()) {
+            has_error.update(true);
+          }
+          return;
+        }
+        if (Vote<Weight>(
+                graph, node, labels, label, 0, histograms.getLocal()) !=
+            label) {
+          has_error.update(true);
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (has_error.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+/// Call fn<Weight>() with the C type of the edge weight property, or void if
+/// there is none
+template <typename F>
+katana::Result<void>
+DispatchWeight(
+    katana::PropertyFileGraph* pfg, const std::string& edge_weight_name, F fn) {
+  if (edge_weight_name.empty()) {
+    return fn(static_cast<void*>(nullptr));
+  }
+  auto property = pfg->EdgeProperty(edge_weight_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  switch (property->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return fn(static_cast<uint32_t*>(nullptr));
+  case arrow::Int32Type::type_id:
+    return fn(static_cast<int32_t*>(nullptr));
+  case arrow::UInt64Type::type_id:
+    return fn(static_cast<uint64_t*>(nullptr));
+  case arrow::Int64Type::type_id:
+    return fn(static_cast<int64_t*>(nullptr));
+  case arrow::FloatType::type_id:
+    return fn(static_cast<float*>(nullptr));
+  case arrow::DoubleType::type_id:
+    return fn(static_cast<double*>(nullptr));
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::LabelPropagation(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& seed_property_name,
+    const std::string& output_property_name, LabelPropagationPlan plan) {
+  switch (plan.algorithm()) {
+  case LabelPropagationPlan::kSynchronous:
+  case LabelPropagationPlan::kAsynchronous:
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  return DispatchWeight(pfg, edge_weight_property_name, [&](auto* tag) {
+    using Weight = std::remove_pointer_t<decltype(tag)>;
+    return Run<Weight>(
+        pfg, edge_weight_property_name, seed_property_name,
+        output_property_name, plan);
+  });
+}
+
+katana::Result<void>
+katana::analytics::LabelPropagationAssertValid(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& seed_property_name, const std::string& property_name) {
+  return DispatchWeight(pfg, edge_weight_property_name, [&](auto* tag) {
+    using Weight = std::remove_pointer_t<decltype(tag)>;
+    return AssertValidImpl<Weight>(
+        pfg, edge_weight_property_name, seed_property_name, property_name);
+  });
+}
+
+void
+katana::analytics::LabelPropagationStatistics::Print(std::ostream& os) const {
+  os << "Total number of communities = " << total_communities << std::endl;
+  os << "Total number of non trivial communities = "
+     << total_non_trivial_communities << std::endl;
+  os << "Number of nodes in the largest community = " << largest_community_size
+     << std::endl;
+  os << "Ratio of nodes in the largest community = " << ratio_largest_community
+     << std::endl;
+  os << "Number of unlabeled nodes = " << num_unlabeled_nodes << std::endl;
+}
+
+katana::Result<LabelPropagationStatistics>
+katana::analytics::LabelPropagationStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<uint64_t>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  size_t num_nodes = property->length();
+
+  std::unordered_map<uint64_t, uint64_t> community_sizes;
+  uint64_t num_unlabeled = 0;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    uint64_t label = property->Value(i);
+    if (label == kUnlabeledOutput) {
+      ++num_unlabeled;
+    } else {
+      community_sizes[label]++;
+    }
+  }
+
+  uint64_t non_trivial = 0;
+  uint64_t largest = 0;
+  for (const auto& [label, size] : community_sizes) {
+    if (size > 1) {
+      ++non_trivial;
+    }
+    largest = std::max(largest, size);
+  }
+
+  double ratio = num_nodes > 0 ? double(largest) / num_nodes : 0;
+
+  return LabelPropagationStatistics{
+      community_sizes.size(), non_trivial, largest, ratio, num_unlabeled};
+}
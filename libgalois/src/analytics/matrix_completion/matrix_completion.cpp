@@ -0,0 +1,880 @@
+#include "katana/analytics/matrix_completion/matrix_completion.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/counting_iterator.hpp>
+
+#include "katana/DynamicBitset.h"
+#include "katana/Galois.h"
+#include "katana/LargeArray.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SimpleLock.h"
+#include "katana/TiledExecutor.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int MatrixCompletionPlan::kChunkSize = 64;
+
+// The latent vector kernels are compiled for AVX-512 and AVX2 as well as for
+// the baseline architecture, and the best version for the running CPU is
+// picked when the library is loaded.
+#if defined(__x86_64__) && defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define KATANA_LATENT_KERNEL \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+#ifndef KATANA_LATENT_KERNEL
+#define KATANA_LATENT_KERNEL
+#endif
+
+namespace {
+
+constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+/// Latent vectors are stored padded with zeros to a multiple of this many
+/// floats, one AVX2 register, so that kernels need no remainder loops and
+/// every vector is aligned. The padding stays zero under all updates.
+constexpr uint32_t kLanes = 8;
+
+template <typename Rating>
+struct EdgeRating : public katana::PODProperty<Rating> {};
+
+template <typename Rating>
+using Graph =
+    katana::PropertyGraph<std::tuple<>, std::tuple<EdgeRating<Rating>>>;
+
+/// The dot product of a and b. Partial sums are kept per lane so the
+/// reduction vectorizes without reassociating floating point additions.
+inline float
+Dot(const float* __restrict__ a, const float* __restrict__ b, uint32_t size) {
+  a = static_cast<const float*>(__builtin_assume_aligned(a, 32));
+  b = static_cast<const float*>(__builtin_assume_aligned(b, 32));
+  float sums[kLanes] = {};
+  for (uint32_t i = 0; i < size; i += kLanes) {
+    for (uint32_t j = 0; j < kLanes; ++j) {
+      sums[j] += a[i + j] * b[i + j];
+    }
+  }
+  float sum = 0;
+  for (float partial : sums) {
+    sum += partial;
+  }
+  return sum;
+}
+
+KATANA_LATENT_KERNEL float
+PredictionError(
+    const float* __restrict__ item, const float* __restrict__ user,
+    uint32_t size, float rating) {
+  return Dot(item, user, size) - rating;
+}
+
+/// Take one SGD step on the squared error of rating plus lambda times the
+/// squared norms of item and user. Returns the error before the step.
+KATANA_LATENT_KERNEL float
+GradientUpdate(
+    float* __restrict__ item, float* __restrict__ user, uint32_t size,
+    float rating, float lambda, float step) {
+  float error = Dot(item, user, size) - rating;
+  item = static_cast<float*>(__builtin_assume_aligned(item, 32));
+  user = static_cast<float*>(__builtin_assume_aligned(user, 32));
+  for (uint32_t i = 0; i < size; ++i) {
+    float old_item = item[i];
+    float old_user = user[i];
+    item[i] -= step * (error * old_user + lambda * old_item);
+    user[i] -= step * (error * old_item + lambda * old_user);
+  }
+  return error;
+}
+
+/// y += alpha * x
+KATANA_LATENT_KERNEL void
+Axpy(float alpha, const float* __restrict__ x, float* __restrict__ y,
+     uint32_t size) {
+  x = static_cast<const float*>(__builtin_assume_aligned(x, 32));
+  y = static_cast<float*>(__builtin_assume_aligned(y, 32));
+  for (uint32_t i = 0; i < size; ++i) {
+    y[i] += alpha * x[i];
+  }
+}
+
+/// The ratings of a PropertyFileGraph in CSR form, with items and users
+/// numbered contiguously, items first, and the ratings of each item sorted by
+/// user. It provides the part of the LC_CSR_Graph interface that
+/// Fixed2DGraphTiledExecutor uses, over the ratings of items.
+struct RatingGraph {
+  using GraphNode = uint32_t;
+  using iterator = boost::counting_iterator<uint32_t>;
+  using edge_iterator = boost::counting_iterator<uint64_t>;
+
+  uint32_t num_items{0};
+  uint32_t num_users{0};
+  /// The node of the PropertyFileGraph for each item and user
+  std::vector<uint32_t> nodes;
+  /// The item and user of each node of the PropertyFileGraph, or kNone
+  std::vector<uint32_t> item_ids;
+  std::vector<uint32_t> user_ids;
+
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> users;
+  std::vector<float> ratings;
+
+  size_t size() const { return num_items + num_users; }
+  size_t sizeEdges() const { return users.size(); }
+
+  iterator begin() const { return iterator(0); }
+  iterator end() const { return iterator(size()); }
+
+  edge_iterator edge_begin(
+      GraphNode n, katana::MethodFlag = katana::MethodFlag::WRITE) const {
+    return edge_iterator(n < num_items ? indices[n] : indices[num_items]);
+  }
+
+  edge_iterator edge_end(
+      GraphNode n, katana::MethodFlag = katana::MethodFlag::WRITE) const {
+    return edge_iterator(n < num_items ? indices[n + 1] : indices[num_items]);
+  }
+
+  GraphNode getEdgeDst(edge_iterator e) const { return users[*e]; }
+};
+
+/// The ratings of each user, i.e., the transpose of the item ratings, for
+/// alternating least squares.
+struct UserRatings {
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> items;
+  std::vector<float> ratings;
+};
+
+template <typename Rating>
+RatingGraph
+MakeRatingGraph(const Graph<Rating>& graph) {
+  uint32_t num_nodes = graph.size();
+  katana::DynamicBitset is_user;
+  is_user.resize(num_nodes);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        for (auto e : graph.edges(n)) {
+          is_user.set(*graph.GetEdgeDest(e));
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  std::vector<uint64_t> item_counts(num_nodes);
+  std::vector<uint64_t> user_counts(num_nodes);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        item_counts[n] = graph.edge_begin(n) != graph.edge_end(n);
+        user_counts[n] = is_user.test(n);
+      },
+      katana::no_stats());
+  std::vector<uint64_t> item_offsets(num_nodes + 1, 0);
+  std::vector<uint64_t> user_offsets(num_nodes + 1, 0);
+  katana::ParallelSTL::partial_sum(
+      item_counts.begin(), item_counts.end(), item_offsets.begin() + 1);
+  katana::ParallelSTL::partial_sum(
+      user_counts.begin(), user_counts.end(), user_offsets.begin() + 1);
+
+  RatingGraph ratings;
+  ratings.num_items = item_offsets.back();
+  ratings.num_users = user_offsets.back();
+  ratings.nodes.resize(ratings.size());
+  ratings.item_ids.resize(num_nodes, kNone);
+  ratings.user_ids.resize(num_nodes, kNone);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t n) {
+        if (item_counts[n]) {
+          ratings.item_ids[n] = item_offsets[n];
+          ratings.nodes[item_offsets[n]] = n;
+        }
+        if (user_counts[n]) {
+          ratings.user_ids[n] = ratings.num_items + user_offsets[n];
+          ratings.nodes[ratings.num_items + user_offsets[n]] = n;
+        }
+      },
+      katana::no_stats());
+
+  std::vector<uint64_t> degrees(ratings.num_items);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, ratings.num_items),
+      [&](uint32_t item) {
+        uint32_t n = ratings.nodes[item];
+        degrees[item] = std::distance(graph.edge_begin(n), graph.edge_end(n));
+      },
+      katana::no_stats());
+  ratings.indices.resize(ratings.num_items + 1, 0);
+  katana::ParallelSTL::partial_sum(
+      degrees.begin(), degrees.end(), ratings.indices.begin() + 1);
+
+  ratings.users.resize(ratings.indices.back());
+  ratings.ratings.resize(ratings.indices.back());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, ratings.num_items),
+      [&](uint32_t item) {
+        uint32_t n = ratings.nodes[item];
+        std::vector<std::pair<uint32_t, float>> item_ratings;
+        for (auto e : graph.edges(n)) {
+          item_ratings.emplace_back(
+              ratings.user_ids[*graph.GetEdgeDest(e)],
+              graph.template GetEdgeData<EdgeRating<Rating>>(e));
+        }
+        std::sort(item_ratings.begin(), item_ratings.end());
+        uint64_t offset = ratings.indices[item];
+        for (const auto& [user, rating] : item_ratings) {
+          ratings.users[offset] = user;
+          ratings.ratings[offset] = rating;
+          ++offset;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return ratings;
+}
+
+UserRatings
+TransposeRatings(const RatingGraph& ratings) {
+  UserRatings transpose;
+  std::vector<std::atomic<uint64_t>> degrees(ratings.num_users);
+  katana::do_all(
+      katana::iterate(size_t{0}, ratings.users.size()),
+      [&](size_t e) {
+        degrees[ratings.users[e] - ratings.num_items].fetch_add(
+            1, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  std::vector<uint64_t> counts(ratings.num_users);
+  katana::do_all(
+      katana::iterate(uint32_t{0}, ratings.num_users),
+      [&](uint32_t user) {
+        counts[user] = degrees[user].load(std::memory_order_relaxed);
+        degrees[user].store(0, std::memory_order_relaxed);
+      },
+      katana::no_stats());
+  transpose.indices.resize(ratings.num_users + 1, 0);
+  katana::ParallelSTL::partial_sum(
+      counts.begin(), counts.end(), transpose.indices.begin() + 1);
+
+  transpose.items.resize(ratings.users.size());
+  transpose.ratings.resize(ratings.users.size());
+  katana::do_all(
+      katana::iterate(uint32_t{0}, ratings.num_items),
+      [&](uint32_t item) {
+        for (uint64_t e = ratings.indices[item]; e < ratings.indices[item + 1];
+             ++e) {
+          uint32_t user = ratings.users[e] - ratings.num_items;
+          uint64_t offset =
+              transpose.indices[user] +
+              degrees[user].fetch_add(1, std::memory_order_relaxed);
+          transpose.items[offset] = item;
+          transpose.ratings[offset] = ratings.ratings[e];
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return transpose;
+}
+
+/// The latent vectors of all items and users, each padded to stride floats.
+class LatentVectors {
+  katana::LargeArray<float> values_;
+  uint32_t size_;
+  uint32_t stride_;
+
+public:
+  LatentVectors(uint32_t num_vectors, uint32_t size)
+      : size_(size), stride_((size + kLanes - 1) / kLanes * kLanes) {
+    values_.allocateBlocked(static_cast<size_t>(num_vectors) * stride_);
+    // Deterministic initial values, uniform in [0, 1 / sqrt(size)) as in
+    // the lonestar application
+    std::uniform_real_distribution<float> dist(0, 1 / std::sqrt(size));
+    katana::do_all(
+        katana::iterate(uint32_t{0}, num_vectors),
+        [&](uint32_t n) {
+          std::minstd_rand generator(n + 1);
+          float* vector = (*this)[n];
+          for (uint32_t i = 0; i < stride_; ++i) {
+            vector[i] = i < size_ ? dist(generator) : 0;
+          }
+        },
+        katana::no_stats());
+  }
+
+  float* operator[](uint32_t n) { return &values_[size_t{n} * stride_]; }
+  const float* operator[](uint32_t n) const {
+    return &values_[size_t{n} * stride_];
+  }
+
+  uint32_t size() const { return size_; }
+  uint32_t stride() const { return stride_; }
+};
+
+double
+SumSquaredError(const RatingGraph& ratings, const LatentVectors& vectors) {
+  katana::GAccumulator<double> error;
+  katana::do_all(
+      katana::iterate(uint32_t{0}, ratings.num_items),
+      [&](uint32_t item) {
+        for (uint64_t e = ratings.indices[item]; e < ratings.indices[item + 1];
+             ++e) {
+          float difference = PredictionError(
+              vectors[item], vectors[ratings.users[e]], vectors.stride(),
+              ratings.ratings[e]);
+          error += difference * difference;
+        }
+      },
+      katana::steal(), katana::no_stats());
+  return error.reduce();
+}
+
+float
+StepSize(const MatrixCompletionPlan& plan, uint32_t round, float bold_rate) {
+  double rate = plan.learning_rate();
+  double decay = plan.decay_rate();
+  switch (plan.step_function()) {
+  case MatrixCompletionPlan::kPurdue:
+    return rate * 1.5 / (1.0 + decay * std::pow(round + 1, 1.5));
+  case MatrixCompletionPlan::kIntel:
+    return rate * std::pow(decay, round);
+  case MatrixCompletionPlan::kBottou:
+    return rate / (1.0 + rate * plan.lambda() * round);
+  case MatrixCompletionPlan::kInverse:
+    return 1.0 / (round + 1);
+  case MatrixCompletionPlan::kBold:
+  default:
+    return bold_rate;
+  }
+}
+
+/// Run rounds of fn until the relative change in the squared error drops
+/// below the tolerance of the plan. fn is called with the SGD step size of
+/// the round.
+template <typename RoundFn>
+void
+RunUntilConverged(
+    const MatrixCompletionPlan& plan, const RatingGraph& ratings,
+    const LatentVectors& vectors, const RoundFn& fn) {
+  double last_error = SumSquaredError(ratings, vectors);
+  float bold_rate = plan.learning_rate();
+  for (uint32_t round = 0; round < plan.max_rounds(); ++round) {
+    float step = StepSize(plan, round, bold_rate);
+    fn(step);
+    double error = SumSquaredError(ratings, vectors);
+    if (!std::isfinite(error)) {
+      break;
+    }
+    // The bold driver grows the step while the error falls and halves it
+    // when the error rises
+    bold_rate = error > last_error ? step * 0.5 : step * 1.05;
+    bool converged = last_error == 0 ||
+                     std::abs((last_error - error) / last_error) <
+                         plan.tolerance();
+    last_error = error;
+    if (converged) {
+      break;
+    }
+  }
+}
+
+void
+SGDBlockedEdges(
+    const MatrixCompletionPlan& plan, RatingGraph* ratings,
+    LatentVectors* vectors) {
+  float lambda = plan.lambda();
+  uint32_t stride = vectors->stride();
+  RunUntilConverged(plan, *ratings, *vectors, [&](float step) {
+    katana::Fixed2DGraphTiledExecutor<RatingGraph> executor(*ratings);
+    executor.execute(
+        ratings->begin(), ratings->begin() + ratings->num_items,
+        ratings->begin() + ratings->num_items, ratings->end(),
+        plan.items_per_block(), plan.users_per_block(),
+        [&](uint32_t item, uint32_t user, RatingGraph::edge_iterator e) {
+          GradientUpdate(
+              (*vectors)[item], (*vectors)[user], stride,
+              ratings->ratings[*e], lambda, step);
+        },
+        true);
+  });
+}
+
+void
+SGDByItems(
+    const MatrixCompletionPlan& plan, const RatingGraph& ratings,
+    LatentVectors* vectors) {
+  float lambda = plan.lambda();
+  uint32_t stride = vectors->stride();
+  // Each item is updated by one thread at a time, but users are shared
+  std::vector<katana::SimpleLock> user_locks(ratings.num_users);
+  RunUntilConverged(plan, ratings, *vectors, [&](float step) {
+    katana::do_all(
+        katana::iterate(uint32_t{0}, ratings.num_items),
+        [&](uint32_t item) {
+          for (uint64_t e = ratings.indices[item];
+               e < ratings.indices[item + 1]; ++e) {
+            uint32_t user = ratings.users[e];
+            std::lock_guard<katana::SimpleLock> lock(
+                user_locks[user - ratings.num_items]);
+            GradientUpdate(
+                (*vectors)[item], (*vectors)[user], stride,
+                ratings.ratings[e], lambda, step);
+          }
+        },
+        katana::steal(), katana::chunk_size<MatrixCompletionPlan::kChunkSize>(),
+        katana::no_stats());
+  });
+}
+
+/// Solve (A + lambda I) x = b for symmetric positive definite A by Cholesky
+/// decomposition, in double precision. Only the lower triangle of A is read.
+/// Returns false, leaving x untouched, if A + lambda I is not positive
+/// definite.
+bool
+SolveNormalEquations(
+    const float* a, uint32_t stride, const float* b, uint32_t size,
+    double lambda, std::vector<double>* scratch, float* x) {
+  scratch->assign(size * size + size, 0);
+  double* l = scratch->data();
+  double* y = l + size * size;
+  for (uint32_t i = 0; i < size; ++i) {
+    for (uint32_t j = 0; j <= i; ++j) {
+      double sum = a[i * stride + j] + (i == j ? lambda : 0);
+      for (uint32_t k = 0; k < j; ++k) {
+        sum -= l[i * size + k] * l[j * size + k];
+      }
+      if (i == j) {
+        if (sum <= 0) {
+          return false;
+        }
+        l[i * size + i] = std::sqrt(sum);
+      } else {
+        l[i * size + j] = sum / l[j * size + j];
+      }
+    }
+  }
+  for (uint32_t i = 0; i < size; ++i) {
+    double sum = b[i];
+    for (uint32_t k = 0; k < i; ++k) {
+      sum -= l[i * size + k] * y[k];
+    }
+    y[i] = sum / l[i * size + i];
+  }
+  for (uint32_t i = size; i-- > 0;) {
+    double sum = y[i];
+    for (uint32_t k = i + 1; k < size; ++k) {
+      sum -= l[k * size + i] * y[k];
+    }
+    y[i] = sum / l[i * size + i];
+  }
+  for (uint32_t i = 0; i < size; ++i) {
+    x[i] = y[i];
+  }
+  return true;
+}
+
+/// Per-thread scratch space for alternating least squares.
+struct ALSScratch {
+  std::vector<float> gram;
+  std::vector<float> rhs;
+  std::vector<double> solver;
+};
+
+/// Zero the first size floats of buffer, after 32 byte alignment like latent
+/// vectors, and return them.
+float*
+ZeroAligned(std::vector<float>* buffer, size_t size) {
+  buffer->assign(size + kLanes, 0);
+  void* begin = buffer->data();
+  size_t space = buffer->size() * sizeof(float);
+  return static_cast<float*>(
+      std::align(32, size * sizeof(float), begin, space));
+}
+
+/// Solve for the latent vector of each node in [begin, end), with ratings of
+/// fixed vectors given by indices, others and values, where the vector of
+/// node n is vectors[begin + n] and the vector of other o is
+/// vectors[others_begin + o].
+void
+SolveLeastSquares(
+    uint32_t begin, uint32_t end, uint32_t others_begin,
+    const std::vector<uint64_t>& indices, const std::vector<uint32_t>& others,
+    const std::vector<float>& values, double lambda,
+    katana::PerThreadStorage<ALSScratch>* scratch, LatentVectors* vectors) {
+  uint32_t size = vectors->size();
+  uint32_t stride = vectors->stride();
+  katana::do_all(
+      katana::iterate(begin, end),
+      [&](uint32_t n) {
+        uint32_t local = n - begin;
+        if (indices[local] == indices[local + 1]) {
+          return;
+        }
+        ALSScratch& local_scratch = *scratch->getLocal();
+        // Rows of the Gram matrix are padded to stride, so each stays aligned
+        float* rows = ZeroAligned(&local_scratch.gram, size * stride);
+        float* rhs = ZeroAligned(&local_scratch.rhs, stride);
+        for (uint64_t e = indices[local]; e < indices[local + 1]; ++e) {
+          const float* other = (*vectors)[others_begin + others[e]];
+          for (uint32_t i = 0; i < size; ++i) {
+            Axpy(other[i], other, rows + i * stride, stride);
+          }
+          Axpy(values[e], other, rhs, stride);
+        }
+        SolveNormalEquations(
+            rows, stride, rhs, size, lambda, &local_scratch.solver,
+            (*vectors)[n]);
+      },
+      katana::steal(), katana::no_stats());
+}
+
+void
+ALS(const MatrixCompletionPlan& plan, const RatingGraph& ratings,
+    LatentVectors* vectors) {
+  UserRatings transpose = TransposeRatings(ratings);
+  std::vector<uint32_t> user_offsets(ratings.users.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, ratings.users.size()),
+      [&](size_t e) { user_offsets[e] = ratings.users[e] - ratings.num_items; },
+      katana::no_stats());
+
+  katana::PerThreadStorage<ALSScratch> scratch;
+  RunUntilConverged(plan, ratings, *vectors, [&](float) {
+    SolveLeastSquares(
+        ratings.num_items, ratings.size(), 0, transpose.indices,
+        transpose.items, transpose.ratings, plan.lambda(), &scratch, vectors);
+    SolveLeastSquares(
+        0, ratings.num_items, ratings.num_items, ratings.indices, user_offsets,
+        ratings.ratings, plan.lambda(), &scratch, vectors);
+  });
+}
+
+/// A fixed_size_list<float> array of the latent vectors of the nodes of the
+/// PropertyFileGraph, where ids maps nodes to latent vectors, or kNone for
+/// null.
+katana::Result<std::shared_ptr<arrow::Array>>
+MakeLatentArray(
+    const std::vector<uint32_t>& ids, const LatentVectors& vectors) {
+  auto values_builder = std::make_shared<arrow::FloatBuilder>();
+  arrow::FixedSizeListBuilder builder(
+      arrow::default_memory_pool(), values_builder, vectors.size());
+  if (auto r = builder.Reserve(ids.size()); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  if (auto r = values_builder->Reserve(ids.size() * vectors.size()); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  for (uint32_t id : ids) {
+    // AppendNull also appends a list of nulls to the values
+    auto r = id == kNone ? builder.AppendNull() : builder.Append();
+    if (r.ok() && id != kNone) {
+      r = values_builder->AppendValues(vectors[id], vectors.size());
+    }
+    if (!r.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+  }
+  std::shared_ptr<arrow::Array> array;
+  if (auto r = builder.Finish(&array); !r.ok()) {
+    return katana::ErrorCode::ArrowError;
+  }
+  return array;
+}
+
+/// Read the latent vectors of property_name back into vectors, with ids
+/// mapping nodes to latent vectors.
+katana::Result<void>
+ReadLatentArray(
+    katana::PropertyFileGraph* pfg, const std::string& property_name,
+    const std::vector<uint32_t>& ids, LatentVectors* vectors) {
+  auto property = pfg->NodeProperty(property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  auto array =
+      std::dynamic_pointer_cast<arrow::FixedSizeListArray>(property->chunk(0));
+  if (!array || array->value_length() != static_cast<int>(vectors->size())) {
+    return katana::ErrorCode::TypeError;
+  }
+  auto values = std::dynamic_pointer_cast<arrow::FloatArray>(array->values());
+  if (!values) {
+    return katana::ErrorCode::TypeError;
+  }
+
+  katana::GReduceLogicalOr has_null;
+  katana::do_all(
+      katana::iterate(size_t{0}, ids.size()),
+      [&](size_t n) {
+        if (ids[n] == kNone) {
+          return;
+        }
+        if (array->IsNull(n)) {
+          has_null.update(true);
+          return;
+        }
+        std::copy_n(
+            values->raw_values() + array->value_offset(n), vectors->size(),
+            (*vectors)[ids[n]]);
+      },
+      katana::no_stats());
+  if (has_null.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+template <typename Rating>
+katana::Result<void>
+MatrixCompletionImpl(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name, const MatrixCompletionPlan& plan) {
+  if (plan.latent_vector_size() == 0 || plan.lambda() < 0) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  if (plan.algorithm() == MatrixCompletionPlan::kSGDBlockedEdges &&
+      (plan.items_per_block() == 0 || plan.users_per_block() == 0)) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  auto pg_result = Graph<Rating>::Make(pfg, {}, {rating_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("MatrixCompletion");
+  exec_time.start();
+
+  RatingGraph ratings = MakeRatingGraph(graph);
+  LatentVectors vectors(ratings.size(), plan.latent_vector_size());
+
+  switch (plan.algorithm()) {
+  case MatrixCompletionPlan::kSGDBlockedEdges:
+    SGDBlockedEdges(plan, &ratings, &vectors);
+    break;
+  case MatrixCompletionPlan::kSGDByItems:
+    SGDByItems(plan, ratings, &vectors);
+    break;
+  case MatrixCompletionPlan::kALS:
+    ALS(plan, ratings, &vectors);
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  exec_time.stop();
+
+  std::vector<std::shared_ptr<arrow::Array>> arrays;
+  for (const auto* ids : {&ratings.item_ids, &ratings.user_ids}) {
+    auto array_result = MakeLatentArray(*ids, vectors);
+    if (!array_result) {
+      return array_result.error();
+    }
+    arrays.emplace_back(std::move(array_result.value()));
+  }
+  auto type = arrow::fixed_size_list(arrow::float32(), vectors.size());
+  auto table = arrow::Table::Make(
+      arrow::schema(
+          {arrow::field(item_property_name, type),
+           arrow::field(user_property_name, type)}),
+      arrays);
+  if (auto r = pfg->AddNodeProperties(table); !r) {
+    return r.error();
+  }
+
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+/// Read back the ratings and latent vectors of a call to MatrixCompletion
+template <typename Rating>
+katana::Result<std::pair<RatingGraph, LatentVectors>>
+ReadResult(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name) {
+  auto pg_result = Graph<Rating>::Make(pfg, {}, {rating_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  auto property = pfg->NodeProperty(item_property_name);
+  if (!property) {
+    return katana::ErrorCode::PropertyNotFound;
+  }
+  auto type = std::dynamic_pointer_cast<arrow::FixedSizeListType>(
+      property->type());
+  if (!type) {
+    return katana::ErrorCode::TypeError;
+  }
+
+  RatingGraph ratings = MakeRatingGraph(graph);
+  LatentVectors vectors(ratings.size(), type->list_size());
+  if (auto r = ReadLatentArray(
+          pfg, item_property_name, ratings.item_ids, &vectors);
+      !r) {
+    return r.error();
+  }
+  if (auto r = ReadLatentArray(
+          pfg, user_property_name, ratings.user_ids, &vectors);
+      !r) {
+    return r.error();
+  }
+  return std::make_pair(std::move(ratings), std::move(vectors));
+}
+
+template <typename Rating>
+katana::Result<void>
+MatrixCompletionAssertValidImpl(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name) {
+  auto result = ReadResult<Rating>(
+      pfg, rating_property_name, item_property_name, user_property_name);
+  if (!result) {
+    return result.error();
+  }
+  const auto& [ratings, vectors] = result.value();
+
+  if (!std::isfinite(SumSquaredError(ratings, vectors))) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+  return katana::ResultSuccess();
+}
+
+template <typename Rating>
+katana::Result<MatrixCompletionStatistics>
+ComputeStatistics(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name) {
+  auto result = ReadResult<Rating>(
+      pfg, rating_property_name, item_property_name, user_property_name);
+  if (!result) {
+    return result.error();
+  }
+  const auto& [ratings, vectors] = result.value();
+
+  uint64_t num_ratings = ratings.sizeEdges();
+  double error = SumSquaredError(ratings, vectors);
+  return MatrixCompletionStatistics{
+      num_ratings, num_ratings ? std::sqrt(error / num_ratings) : 0};
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MatrixCompletion(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name, MatrixCompletionPlan plan) {
+  switch (pfg->EdgeProperty(rating_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return MatrixCompletionImpl<uint32_t>(
+        pfg, rating_property_name, item_property_name, user_property_name,
+        plan);
+  case arrow::Int32Type::type_id:
+    return MatrixCompletionImpl<int32_t>(
+        pfg, rating_property_name, item_property_name, user_property_name,
+        plan);
+  case arrow::UInt64Type::type_id:
+    return MatrixCompletionImpl<uint64_t>(
+        pfg, rating_property_name, item_property_name, user_property_name,
+        plan);
+  case arrow::Int64Type::type_id:
+    return MatrixCompletionImpl<int64_t>(
+        pfg, rating_property_name, item_property_name, user_property_name,
+        plan);
+  case arrow::FloatType::type_id:
+    return MatrixCompletionImpl<float>(
+        pfg, rating_property_name, item_property_name, user_property_name,
+        plan);
+  case arrow::DoubleType::type_id:
+    return MatrixCompletionImpl<double>(
+        pfg, rating_property_name, item_property_name, user_property_name,
+        plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<void>
+katana::analytics::MatrixCompletionAssertValid(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name) {
+  switch (pfg->EdgeProperty(rating_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return MatrixCompletionAssertValidImpl<uint32_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::Int32Type::type_id:
+    return MatrixCompletionAssertValidImpl<int32_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::UInt64Type::type_id:
+    return MatrixCompletionAssertValidImpl<uint64_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::Int64Type::type_id:
+    return MatrixCompletionAssertValidImpl<int64_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::FloatType::type_id:
+    return MatrixCompletionAssertValidImpl<float>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::DoubleType::type_id:
+    return MatrixCompletionAssertValidImpl<double>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+void
+katana::analytics::MatrixCompletionStatistics::Print(std::ostream& os) const {
+  os << "Number of ratings = " << num_ratings << std::endl;
+  os << "Root mean square error = " << root_mean_square_error << std::endl;
+}
+
+katana::Result<MatrixCompletionStatistics>
+katana::analytics::MatrixCompletionStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& rating_property_name,
+    const std::string& item_property_name,
+    const std::string& user_property_name) {
+  switch (pfg->EdgeProperty(rating_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return ComputeStatistics<uint32_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::Int32Type::type_id:
+    return ComputeStatistics<int32_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::UInt64Type::type_id:
+    return ComputeStatistics<uint64_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::Int64Type::type_id:
+    return ComputeStatistics<int64_t>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::FloatType::type_id:
+    return ComputeStatistics<float>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  case arrow::DoubleType::type_id:
+    return ComputeStatistics<double>(
+        pfg, rating_property_name, item_property_name, user_property_name);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
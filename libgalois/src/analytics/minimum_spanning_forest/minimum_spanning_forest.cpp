@@ -0,0 +1,529 @@
+#include "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int MinimumSpanningForestPlan::kChunkSize = 64;
+
+namespace {
+
+constexpr uint64_t kNoEdge = std::numeric_limits<uint64_t>::max();
+/// Below this many edges, FilterKruskal sorts instead of partitioning
+constexpr size_t kKruskalBaseSize = 1 << 14;
+
+template <typename Weight>
+struct EdgeWeight : public katana::PODProperty<Weight> {};
+
+struct EdgeInForest : public katana::PODProperty<uint8_t> {};
+
+template <typename Weight>
+using Graph = katana::PropertyGraph<
+    std::tuple<>, std::tuple<EdgeWeight<Weight>, EdgeInForest>>;
+
+template <typename Weight>
+struct WeightedEdge {
+  Weight weight;
+  uint32_t src;
+  uint32_t dst;
+  uint64_t id;
+
+  /// Edges are ordered by weight and then id, so all edges are distinct and
+  /// the minimum spanning forest is unique.
+  bool operator<(const WeightedEdge& other) const {
+    return weight < other.weight || (weight == other.weight && id < other.id);
+  }
+};
+
+/// Lock-free union-find: roots are linked by CAS, the larger id under the
+/// smaller, and finds halve paths as they go.
+class ConcurrentUnionFind {
+  std::vector<std::atomic<uint32_t>> parents_;
+
+public:
+  explicit ConcurrentUnionFind(size_t num_nodes) : parents_(num_nodes) {
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { parents_[n].store(n, std::memory_order_relaxed); },
+        katana::no_stats());
+  }
+
+  uint32_t Find(uint32_t node) {
+    while (true) {
+      uint32_t parent = parents_[node].load(std::memory_order_relaxed);
+      if (parent == node) {
+        return node;
+      }
+      uint32_t grandparent = parents_[parent].load(std::memory_order_relaxed);
+      if (parent != grandparent) {
+        parents_[node].compare_exchange_weak(
+            parent, grandparent, std::memory_order_relaxed);
+      }
+      node = grandparent;
+    }
+  }
+
+  /// Merge the sets of a and b; returns false if they were already merged
+  bool Unite(uint32_t a, uint32_t b) {
+    while (true) {
+      a = Find(a);
+      b = Find(b);
+      if (a == b) {
+        return false;
+      }
+      if (a > b) {
+        std::swap(a, b);
+      }
+      uint32_t expected = b;
+      if (parents_[b].compare_exchange_strong(expected, a)) {
+        return true;
+      }
+    }
+  }
+};
+
+/// Stable parallel partition of data[0, size) by pred, through scratch of
+/// the same size. Returns the number of elements satisfying pred, which end
+/// up first.
+template <typename T, typename Predicate>
+size_t
+StablePartition(T* data, size_t size, T* scratch, const Predicate& pred) {
+  constexpr size_t kMinBlockSize = 1 << 12;
+  const size_t num_blocks = std::max<size_t>(
+      1, std::min<size_t>(
+             size / kMinBlockSize, 4 * katana::getActiveThreads()));
+  const size_t block_size = (size + num_blocks - 1) / num_blocks;
+  auto block_range = [&](size_t block) {
+    return std::make_pair(
+        std::min(block * block_size, size),
+        std::min((block + 1) * block_size, size));
+  };
+
+  std::vector<size_t> num_selected(num_blocks);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        auto [begin, end] = block_range(block);
+        num_selected[block] = std::count_if(data + begin, data + end, pred);
+      },
+      katana::no_stats());
+
+  std::vector<size_t> selected_offsets(num_blocks);
+  size_t total_selected = 0;
+  for (size_t block = 0; block < num_blocks; ++block) {
+    selected_offsets[block] = total_selected;
+    total_selected += num_selected[block];
+  }
+
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        auto [begin, end] = block_range(block);
+        size_t selected = selected_offsets[block];
+        size_t rejected = total_selected + begin - selected;
+        for (size_t i = begin; i < end; ++i) {
+          if (pred(data[i])) {
+            scratch[selected++] = data[i];
+          } else {
+            scratch[rejected++] = data[i];
+          }
+        }
+      },
+      katana::no_stats());
+
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        auto [begin, end] = block_range(block);
+        std::copy(scratch + begin, scratch + end, data + begin);
+      },
+      katana::no_stats());
+
+  return total_selected;
+}
+
+template <typename Weight, typename GraphTy>
+std::vector<WeightedEdge<Weight>>
+CollectEdges(const GraphTy& graph) {
+  std::vector<WeightedEdge<Weight>> edges(graph.num_edges());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        for (auto e : graph.edges(node)) {
+          edges[e] = WeightedEdge<Weight>{
+              graph.template GetEdgeData<EdgeWeight<Weight>>(e), node,
+              *graph.GetEdgeDest(e), e};
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  // Self loops are never in the forest
+  std::vector<WeightedEdge<Weight>> scratch(edges.size());
+  size_t num_kept = StablePartition(
+      edges.data(), edges.size(), scratch.data(),
+      [](const WeightedEdge<Weight>& edge) { return edge.src != edge.dst; });
+  edges.resize(num_kept);
+  return edges;
+}
+
+template <typename Weight>
+void
+FilterKruskal(
+    WeightedEdge<Weight>* edges, size_t size, WeightedEdge<Weight>* scratch,
+    ConcurrentUnionFind* union_find, std::vector<uint8_t>* in_forest) {
+  using Edge = WeightedEdge<Weight>;
+
+  if (size <= kKruskalBaseSize) {
+    std::sort(edges, edges + size);
+    for (size_t i = 0; i < size; ++i) {
+      if (union_find->Unite(edges[i].src, edges[i].dst)) {
+        (*in_forest)[edges[i].id] = 1;
+      }
+    }
+    return;
+  }
+
+  // Median of a strided sample. Edges are distinct, so both sides of the
+  // partition are non-empty.
+  constexpr size_t kSampleSize = 63;
+  std::vector<Edge> sample;
+  for (size_t i = 0; i < kSampleSize; ++i) {
+    sample.emplace_back(edges[i * (size / kSampleSize)]);
+  }
+  std::nth_element(
+      sample.begin(), sample.begin() + kSampleSize / 2, sample.end());
+  Edge pivot = sample[kSampleSize / 2];
+  size_t num_light = StablePartition(
+      edges, size, scratch, [&](const Edge& edge) { return !(pivot < edge); });
+
+  FilterKruskal(edges, num_light, scratch, union_find, in_forest);
+
+  Edge* heavy = edges + num_light;
+  size_t num_heavy = StablePartition(
+      heavy, size - num_light, scratch, [&](const Edge& edge) {
+        return union_find->Find(edge.src) != union_find->Find(edge.dst);
+      });
+  FilterKruskal(heavy, num_heavy, scratch, union_find, in_forest);
+}
+
+/// Atomically lower best to index if edges[index] is lighter than
+/// edges[best]
+template <typename Weight>
+void
+WriteMin(
+    std::atomic<uint64_t>& best, uint64_t index,
+    const std::vector<WeightedEdge<Weight>>& edges) {
+  uint64_t current = best.load(std::memory_order_relaxed);
+  while (current == kNoEdge || edges[index] < edges[current]) {
+    if (best.compare_exchange_weak(current, index)) {
+      return;
+    }
+  }
+}
+
+template <typename Weight>
+void
+BoruvkaAlgo(
+    std::vector<WeightedEdge<Weight>>* edges, size_t num_nodes,
+    const MinimumSpanningForestPlan& plan, ConcurrentUnionFind* union_find,
+    std::vector<uint8_t>* in_forest) {
+  std::vector<std::atomic<uint64_t>> best(num_nodes);
+  std::vector<WeightedEdge<Weight>> scratch(edges->size());
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) { best[n].store(kNoEdge, std::memory_order_relaxed); },
+      katana::no_stats());
+
+  size_t num_rounds = 0;
+  while (edges->size() > plan.kruskal_threshold()) {
+    ++num_rounds;
+
+    // Every component finds its lightest edge to another component. Since
+    // all edges are distinct, the picked edges form a forest, except that
+    // two components may pick the same edge.
+    katana::do_all(
+        katana::iterate(size_t{0}, edges->size()),
+        [&](size_t i) {
+          const auto& edge = (*edges)[i];
+          uint32_t src = union_find->Find(edge.src);
+          uint32_t dst = union_find->Find(edge.dst);
+          if (src != dst) {
+            WriteMin(best[src], i, *edges);
+            WriteMin(best[dst], i, *edges);
+          }
+        },
+        katana::steal(),
+        katana::chunk_size<MinimumSpanningForestPlan::kChunkSize>(),
+        katana::loopname("MinimumSpanningForest FindLightest"));
+
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) {
+          uint64_t index = best[n].load(std::memory_order_relaxed);
+          if (index == kNoEdge) {
+            return;
+          }
+          best[n].store(kNoEdge, std::memory_order_relaxed);
+          const auto& edge = (*edges)[index];
+          if (union_find->Unite(edge.src, edge.dst)) {
+            (*in_forest)[edge.id] = 1;
+          }
+        },
+        katana::steal(), katana::loopname("MinimumSpanningForest Merge"));
+
+    size_t num_kept = StablePartition(
+        edges->data(), edges->size(), scratch.data(),
+        [&](const WeightedEdge<Weight>& edge) {
+          return union_find->Find(edge.src) != union_find->Find(edge.dst);
+        });
+    edges->resize(num_kept);
+  }
+
+  katana::ReportStatSingle(
+      "MinimumSpanningForest", "BoruvkaRounds", num_rounds);
+  katana::ReportStatSingle(
+      "MinimumSpanningForest", "KruskalEdges", edges->size());
+
+  FilterKruskal(
+      edges->data(), edges->size(), scratch.data(), union_find, in_forest);
+}
+
+template <typename Weight>
+katana::Result<void>
+MinimumSpanningForestImpl(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name,
+    const MinimumSpanningForestPlan& plan) {
+  if (auto result = ConstructEdgeProperties<std::tuple<EdgeInForest>>(
+          pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph<Weight>::Make(
+      pfg, {}, {edge_weight_property_name, output_property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("MinimumSpanningForest");
+  exec_time.start();
+
+  std::vector<WeightedEdge<Weight>> edges = CollectEdges<Weight>(graph);
+  std::vector<uint8_t> in_forest(graph.num_edges(), 0);
+  ConcurrentUnionFind union_find(graph.size());
+
+  switch (plan.algorithm()) {
+  case MinimumSpanningForestPlan::kBoruvka:
+    BoruvkaAlgo(&edges, graph.size(), plan, &union_find, &in_forest);
+    break;
+  case MinimumSpanningForestPlan::kFilterKruskal: {
+    std::vector<WeightedEdge<Weight>> scratch(edges.size());
+    FilterKruskal(
+        edges.data(), edges.size(), scratch.data(), &union_find, &in_forest);
+    break;
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  exec_time.stop();
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        for (auto e : graph.edges(node)) {
+          graph.template GetEdgeData<EdgeInForest>(e) = in_forest[e];
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+template <typename Weight>
+katana::Result<void>
+MinimumSpanningForestAssertValidImpl(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto pg_result =
+      Graph<Weight>::Make(pfg, {}, {edge_weight_property_name, property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  // The forest is unique, so compare against serial Kruskal
+  std::vector<WeightedEdge<Weight>> edges = CollectEdges<Weight>(graph);
+  std::sort(edges.begin(), edges.end());
+  std::vector<uint8_t> expected(graph.num_edges(), 0);
+  ConcurrentUnionFind union_find(graph.size());
+  for (const auto& edge : edges) {
+    if (union_find.Unite(edge.src, edge.dst)) {
+      expected[edge.id] = 1;
+    }
+  }
+
+  katana::GReduceLogicalOr has_error;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        for (auto e : graph.edges(node)) {
+          if (graph.template GetEdgeData<EdgeInForest>(e) != expected[e]) {
+            has_error.update(true);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+  if (has_error.reduce()) {
+    return katana::ErrorCode::AssertionFailed;
+  }
+
+  return katana::ResultSuccess();
+}
+
+template <typename Weight>
+katana::Result<MinimumSpanningForestStatistics>
+ComputeStatistics(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  auto pg_result =
+      Graph<Weight>::Make(pfg, {}, {edge_weight_property_name, property_name});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  auto graph = pg_result.value();
+
+  katana::GAccumulator<uint64_t> num_forest_edges;
+  katana::GAccumulator<double> total_weight;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](uint32_t node) {
+        for (auto e : graph.edges(node)) {
+          if (graph.template GetEdgeData<EdgeInForest>(e)) {
+            num_forest_edges += 1;
+            total_weight += graph.template GetEdgeData<EdgeWeight<Weight>>(e);
+          }
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  return MinimumSpanningForestStatistics{
+      num_forest_edges.reduce(), graph.size() - num_forest_edges.reduce(),
+      total_weight.reduce()};
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForest(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& output_property_name, MinimumSpanningForestPlan plan) {
+  switch (pfg->EdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return MinimumSpanningForestImpl<uint32_t>(
+        pfg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return MinimumSpanningForestImpl<int32_t>(
+        pfg, edge_weight_property_name, output_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return MinimumSpanningForestImpl<uint64_t>(
+        pfg, edge_weight_property_name, output_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return MinimumSpanningForestImpl<int64_t>(
+        pfg, edge_weight_property_name, output_property_name, plan);
+  case arrow::FloatType::type_id:
+    return MinimumSpanningForestImpl<float>(
+        pfg, edge_weight_property_name, output_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return MinimumSpanningForestImpl<double>(
+        pfg, edge_weight_property_name, output_property_name, plan);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+katana::Result<void>
+katana::analytics::MinimumSpanningForestAssertValid(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  switch (pfg->EdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return MinimumSpanningForestAssertValidImpl<uint32_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::Int32Type::type_id:
+    return MinimumSpanningForestAssertValidImpl<int32_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::UInt64Type::type_id:
+    return MinimumSpanningForestAssertValidImpl<uint64_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::Int64Type::type_id:
+    return MinimumSpanningForestAssertValidImpl<int64_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::FloatType::type_id:
+    return MinimumSpanningForestAssertValidImpl<float>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::DoubleType::type_id:
+    return MinimumSpanningForestAssertValidImpl<double>(
+        pfg, edge_weight_property_name, property_name);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
+
+void
+katana::analytics::MinimumSpanningForestStatistics::Print(
+    std::ostream& os) const {
+  os << "Number of forest edges = " << num_forest_edges << std::endl;
+  os << "Number of trees = " << num_trees << std::endl;
+  os << "Total weight = " << total_weight << std::endl;
+}
+
+katana::Result<MinimumSpanningForestStatistics>
+katana::analytics::MinimumSpanningForestStatistics::Compute(
+    katana::PropertyFileGraph* pfg,
+    const std::string& edge_weight_property_name,
+    const std::string& property_name) {
+  switch (pfg->EdgeProperty(edge_weight_property_name)->type()->id()) {
+  case arrow::UInt32Type::type_id:
+    return ComputeStatistics<uint32_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::Int32Type::type_id:
+    return ComputeStatistics<int32_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::UInt64Type::type_id:
+    return ComputeStatistics<uint64_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::Int64Type::type_id:
+    return ComputeStatistics<int64_t>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::FloatType::type_id:
+    return ComputeStatistics<float>(
+        pfg, edge_weight_property_name, property_name);
+  case arrow::DoubleType::type_id:
+    return ComputeStatistics<double>(
+        pfg, edge_weight_property_name, property_name);
+  default:
+    return katana::ErrorCode::TypeError;
+  }
+}
@@ -0,0 +1,375 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/analytics/Utils.h"
+#include "pagerank-impl.h"
+
+using katana::atomicAdd;
+using katana::analytics::PersonalizedPagerankPlan;
+
+namespace {
+
+using NodeData = std::tuple<>;
+using EdgeData = std::tuple<>;
+typedef katana::PropertyGraph<NodeData, EdgeData> Graph;
+typedef typename Graph::Node GNode;
+
+using SeedSets = std::vector<std::vector<uint32_t>>;
+using RankedNodes = std::vector<std::pair<uint32_t, PRTy>>;
+
+/// The residual a node needs to be pushed
+PRTy
+PushThreshold(
+    const Graph& graph, const GNode& node,
+    const PersonalizedPagerankPlan& plan) {
+  return plan.tolerance() * std::max<size_t>(graph.edges(node).size(), 1);
+}
+
+/// Keep the top_k highest ranked nodes with a non-zero rank, highest first.
+/// Ties go to the smaller node id.
+void
+KeepTop(uint32_t top_k, RankedNodes* ranked) {
+  ranked->erase(
+      std::remove_if(
+          ranked->begin(), ranked->end(),
+          [](const auto& node_rank) { return !(node_rank.second > 0); }),
+      ranked->end());
+  auto higher = [](const auto& a, const auto& b) {
+    return a.second != b.second ? a.second > b.second : a.first < b.first;
+  };
+  size_t num_kept = std::min<size_t>(top_k, ranked->size());
+  std::partial_sort(
+      ranked->begin(), ranked->begin() + num_kept, ranked->end(), higher);
+  ranked->resize(num_kept);
+}
+
+/// Serial forward push for one seed set at a time. Residuals and ranks are
+/// kept in hash tables, so the cost only depends on the nodes reached.
+class LocalPusher {
+  const Graph& graph_;
+  PersonalizedPagerankPlan plan_;
+  std::unordered_map<uint32_t, PRTy> residual_;
+  std::deque<GNode> queue_;
+
+public:
+  LocalPusher(const Graph& graph, const PersonalizedPagerankPlan& plan)
+      : graph_(graph), plan_(plan) {}
+
+  /// Compute the non-zero ranks for seeds
+  void Run(
+      const std::vector<uint32_t>& seeds,
+      std::unordered_map<uint32_t, PRTy>* ranks) {
+    residual_.clear();
+    ranks->clear();
+
+    PRTy initial_residual = (1 - plan_.alpha()) / seeds.size();
+    for (uint32_t seed : seeds) {
+      residual_[seed] += initial_residual;
+      queue_.push_back(seed);
+    }
+
+    while (!queue_.empty()) {
+      GNode src = queue_.front();
+      queue_.pop_front();
+
+      auto& src_residual = residual_[src];
+      if (!(src_residual > PushThreshold(graph_, src, plan_))) {
+        continue;
+      }
+      PRTy old_residual = src_residual;
+      src_residual = 0;
+      (*ranks)[src] += old_residual;
+
+      size_t src_nout = graph_.edges(src).size();
+      if (src_nout == 0) {
+        continue;
+      }
+      PRTy delta = old_residual * plan_.alpha() / src_nout;
+      for (const auto& jj : graph_.edges(src)) {
+        auto dest = *graph_.GetEdgeDest(jj);
+        PRTy& dest_residual = residual_[dest];
+        PRTy old = dest_residual;
+        dest_residual += delta;
+        PRTy threshold = PushThreshold(graph_, dest, plan_);
+        if (old <= threshold && dest_residual > threshold) {
+          queue_.push_back(dest);
+        }
+      }
+    }
+  }
+};
+
+/// Parallel asynchronous push for a batch of seed sets at once. Node n keeps
+/// the residual and rank of the i-th seed set of the batch at
+/// n * width + i, so pushing n reads one contiguous vector and each edge is
+/// scanned once for the whole batch.
+class BatchedPusher {
+  const Graph& graph_;
+  PersonalizedPagerankPlan plan_;
+  uint32_t width_{0};
+  std::vector<std::atomic<PRTy>> residual_;
+  std::vector<std::atomic<PRTy>> ranks_;
+
+  size_t Index(const GNode& node, uint32_t set) const {
+    return size_t{node} * width_ + set;
+  }
+
+public:
+  BatchedPusher(const Graph& graph, const PersonalizedPagerankPlan& plan)
+      : graph_(graph),
+        plan_(plan),
+        residual_(graph.size() * plan.batch_size()),
+        ranks_(graph.size() * plan.batch_size()) {}
+
+  PRTy Rank(const GNode& node, uint32_t set) const {
+    return ranks_[Index(node, set)].load(std::memory_order_relaxed);
+  }
+
+  /// Compute the ranks of seed_sets[begin, end)
+  void Run(const SeedSets& seed_sets, size_t begin, size_t end) {
+    width_ = end - begin;
+    KATANA_LOG_DEBUG_ASSERT(width_ <= plan_.batch_size());
+
+    katana::do_all(
+        katana::iterate(size_t{0}, graph_.size() * width_),
+        [&](size_t i) {
+          residual_[i] = 0;
+          ranks_[i] = 0;
+        },
+        katana::no_stats(), katana::loopname("Initialize"));
+
+    std::vector<GNode> seeds;
+    for (size_t set = begin; set < end; ++set) {
+      PRTy initial_residual = (1 - plan_.alpha()) / seed_sets[set].size();
+      for (uint32_t seed : seed_sets[set]) {
+        atomicAdd(residual_[Index(seed, set - begin)], initial_residual);
+        seeds.push_back(seed);
+      }
+    }
+
+    typedef katana::PerSocketChunkFIFO<
+        katana::analytics::PagerankPlan::kChunkSize>
+        WL;
+    katana::for_each(
+        katana::iterate(seeds),
+        [&](const GNode& src, auto& ctx) {
+          PRTy threshold = PushThreshold(graph_, src, plan_);
+          size_t src_nout = graph_.edges(src).size();
+
+          std::array<PRTy, PersonalizedPagerankPlan::kMaxBatchSize> delta;
+          bool has_delta = false;
+          for (uint32_t i = 0; i < width_; ++i) {
+            auto& src_residual = residual_[Index(src, i)];
+            delta[i] = 0;
+            if (src_residual > threshold) {
+              PRTy old_residual = src_residual.exchange(0.0);
+              atomicAdd(ranks_[Index(src, i)], old_residual);
+              if (src_nout > 0) {
+                delta[i] = old_residual * plan_.alpha() / src_nout;
+                has_delta |= delta[i] > 0;
+              }
+            }
+          }
+          if (!has_delta) {
+            return;
+          }
+
+          //! For each out-going neighbors.
+          for (const auto& jj : graph_.edges(src)) {
+            auto dest = *graph_.GetEdgeDest(jj);
+            PRTy dest_threshold = PushThreshold(graph_, dest, plan_);
+            bool activated = false;
+            for (uint32_t i = 0; i < width_; ++i) {
+              if (delta[i] > 0) {
+                auto old = atomicAdd(residual_[Index(dest, i)], delta[i]);
+                activated |=
+                    old <= dest_threshold && old + delta[i] > dest_threshold;
+              }
+            }
+            if (activated) {
+              ctx.push(dest);
+            }
+          }
+        },
+        katana::loopname("PersonalizedPagerankBatchedPush"),
+        katana::disable_conflict_detection(), katana::wl<WL>());
+  }
+};
+
+katana::Result<Graph>
+MakeGraph(
+    katana::PropertyFileGraph* pfg, const SeedSets& seed_sets,
+    const PersonalizedPagerankPlan& plan) {
+  if (!(plan.tolerance() > 0) || !(plan.alpha() >= 0 && plan.alpha() < 1) ||
+      plan.batch_size() == 0 ||
+      plan.batch_size() > PersonalizedPagerankPlan::kMaxBatchSize) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  for (const auto& seeds : seed_sets) {
+    if (seeds.empty()) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    for (uint32_t seed : seeds) {
+      if (seed >= pfg->num_nodes()) {
+        return katana::ErrorCode::InvalidArgument;
+      }
+    }
+  }
+  return Graph::Make(pfg, {}, {});
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::PersonalizedPagerank(
+    katana::PropertyFileGraph* pfg, const SeedSets& seed_sets,
+    const std::vector<std::string>& output_property_names,
+    PersonalizedPagerankPlan plan) {
+  if (seed_sets.size() != output_property_names.size()) {
+    return katana::ErrorCode::InvalidArgument;
+  }
+  auto graph_result = MakeGraph(pfg, seed_sets, plan);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  Graph graph = graph_result.value();
+
+  std::vector<std::vector<PRTy>> columns(seed_sets.size());
+  katana::StatTimer exec_time("PersonalizedPagerank");
+  exec_time.start();
+  switch (plan.algorithm()) {
+  case PersonalizedPagerankPlan::kLocalPush: {
+    katana::PerThreadStorage<std::unique_ptr<LocalPusher>> pushers;
+    katana::PerThreadStorage<std::unordered_map<uint32_t, PRTy>> ranks;
+    katana::do_all(
+        katana::iterate(size_t{0}, seed_sets.size()),
+        [&](size_t set) {
+          auto& pusher = *pushers.getLocal();
+          if (!pusher) {
+            pusher = std::make_unique<LocalPusher>(graph, plan);
+          }
+          pusher->Run(seed_sets[set], ranks.getLocal());
+          columns[set].resize(graph.size());
+          for (const auto& [node, rank] : *ranks.getLocal()) {
+            columns[set][node] = rank;
+          }
+        },
+        katana::steal(), katana::chunk_size<1>(),
+        katana::loopname("PersonalizedPagerankLocalPush"));
+    break;
+  }
+  case PersonalizedPagerankPlan::kBatchedPush: {
+    BatchedPusher pusher(graph, plan);
+    for (size_t begin = 0; begin < seed_sets.size();
+         begin += plan.batch_size()) {
+      size_t end =
+          std::min<size_t>(begin + plan.batch_size(), seed_sets.size());
+      pusher.Run(seed_sets, begin, end);
+      for (size_t set = begin; set < end; ++set) {
+        columns[set].resize(graph.size());
+        katana::do_all(
+            katana::iterate(graph),
+            [&](const GNode& node) {
+              columns[set][node] = pusher.Rank(node, set - begin);
+            },
+            katana::no_stats());
+      }
+    }
+    break;
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+  exec_time.stop();
+
+  std::vector<std::shared_ptr<arrow::Field>> fields;
+  std::vector<std::shared_ptr<arrow::Array>> arrays;
+  for (size_t set = 0; set < seed_sets.size(); ++set) {
+    arrow::FloatBuilder builder;
+    if (auto r = builder.AppendValues(columns[set]); !r.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+    std::shared_ptr<arrow::Array> array;
+    if (auto r = builder.Finish(&array); !r.ok()) {
+      return katana::ErrorCode::ArrowError;
+    }
+    std::vector<PRTy>().swap(columns[set]);
+    fields.emplace_back(
+        arrow::field(output_property_names[set], arrow::float32()));
+    arrays.emplace_back(std::move(array));
+  }
+
+  auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+  if (auto r = pfg->AddNodeProperties(table); !r) {
+    return r.error();
+  }
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::vector<RankedNodes>>
+katana::analytics::PersonalizedPagerankTopK(
+    katana::PropertyFileGraph* pfg, const SeedSets& seed_sets, uint32_t top_k,
+    PersonalizedPagerankPlan plan) {
+  auto graph_result = MakeGraph(pfg, seed_sets, plan);
+  if (!graph_result) {
+    return graph_result.error();
+  }
+  Graph graph = graph_result.value();
+
+  std::vector<RankedNodes> top(seed_sets.size());
+  katana::StatTimer exec_time("PersonalizedPagerankTopK");
+  exec_time.start();
+  switch (plan.algorithm()) {
+  case PersonalizedPagerankPlan::kLocalPush: {
+    katana::PerThreadStorage<std::unique_ptr<LocalPusher>> pushers;
+    katana::PerThreadStorage<std::unordered_map<uint32_t, PRTy>> ranks;
+    katana::do_all(
+        katana::iterate(size_t{0}, seed_sets.size()),
+        [&](size_t set) {
+          auto& pusher = *pushers.getLocal();
+          if (!pusher) {
+            pusher = std::make_unique<LocalPusher>(graph, plan);
+          }
+          pusher->Run(seed_sets[set], ranks.getLocal());
+          top[set].assign(ranks.getLocal()->begin(), ranks.getLocal()->end());
+          KeepTop(top_k, &top[set]);
+        },
+        katana::steal(), katana::chunk_size<1>(),
+        katana::loopname("PersonalizedPagerankLocalPush"));
+    break;
+  }
+  case PersonalizedPagerankPlan::kBatchedPush: {
+    BatchedPusher pusher(graph, plan);
+    for (size_t begin = 0; begin < seed_sets.size();
+         begin += plan.batch_size()) {
+      size_t end =
+          std::min<size_t>(begin + plan.batch_size(), seed_sets.size());
+      pusher.Run(seed_sets, begin, end);
+      katana::do_all(
+          katana::iterate(begin, end),
+          [&](size_t set) {
+            for (const GNode& node : graph) {
+              PRTy rank = pusher.Rank(node, set - begin);
+              if (rank > 0) {
+                top[set].emplace_back(node, rank);
+              }
+            }
+            KeepTop(top_k, &top[set]);
+          },
+          katana::steal(), katana::chunk_size<1>(), katana::no_stats());
+    }
+    break;
+  }
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+  exec_time.stop();
+
+  return top;
+}
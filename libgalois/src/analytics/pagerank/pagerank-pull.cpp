@@ -17,6 +17,7 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include "katana/PerfCounters.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
 
@@ -178,6 +179,7 @@ void
 ComputePRTopological(Graph* graph, katana::analytics::PagerankPlan plan) {
   unsigned int iteration = 0;
   katana::GAccumulator<float> accum;
+  katana::PerfCounterRegion counters("PagerankPullTopological");
 
   float base_score = (1.0f - plan.alpha()) / graph->size();
   while (true) {
@@ -222,6 +224,8 @@ ComputePRTopological(Graph* graph, katana::analytics::PagerankPlan plan) {
 
   }  ///< End while(true).
 
+  //! Every iteration pulls along every edge.
+  counters.Stop(uint64_t{iteration} * graph->num_edges());
   katana::ReportStatSingle("PageRank", "Iterations", iteration);
 }
 
@@ -17,8 +17,29 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include "katana/analytics/GraphProfile.h"
 #include "pagerank-impl.h"
 
+katana::analytics::PagerankPlan
+katana::analytics::PagerankPlan::Automatic(
+    PropertyFileGraph* pfg, float tolerance, unsigned int max_iterations,
+    float alpha) {
+  if (!pfg->partition_metadata().transposed_) {
+    return PushAsynchronous(tolerance, alpha);
+  }
+  auto profile_opt = GraphProfile::ForAutomaticPlan(pfg);
+  if (!profile_opt) {
+    return PullTopological(tolerance, max_iterations, alpha);
+  }
+  const GraphProfile& profile = *profile_opt;
+  const PlanCalibration& calibration = PlanCalibration::Get();
+
+  if (calibration.IsPowerLaw(profile)) {
+    return PullResidual(tolerance, max_iterations, alpha);
+  }
+  return PullTopological(tolerance, max_iterations, alpha);
+}
+
 katana::Result<void>
 katana::analytics::Pagerank(
     katana::PropertyFileGraph* pfg, const std::string& output_property_name,
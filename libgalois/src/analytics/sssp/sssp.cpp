@@ -17,6 +17,9 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <functional>
+#include <vector>
+
 #include "katana/analytics/sssp/sssp.h"
 
 // Implementation
@@ -58,10 +61,31 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
   using OBIMBarrier = typename katana::OrderedByIntegerMetric<
       UpdateRequestIndexer, PSchunk>::template with_barrier<true>::type;
 
+  /// Orders requests by their exact distance, for worklists that do not need
+  /// integer priorities
+  struct UpdateRequestDistance {
+    template <typename R>
+    Dist operator()(const R& req) const {
+      return req.dist;
+    }
+  };
+
+  using MultiQueue = katana::MultiQueue<UpdateRequestDistance>;
+
   template <typename T, typename OBIMTy = OBIM, typename P, typename R>
   static void DeltaStepAlgo(
       Graph* graph, const typename Graph::Node& source, const P& pushWrap,
       const R& edgeRange, unsigned stepShift) {
+    PriorityAlgo<T, OBIMTy>(
+        graph, source, pushWrap, edgeRange, UpdateRequestIndexer{stepShift});
+  }
+
+  /// Label-correcting SSSP over any priority worklist WL constructed from
+  /// indexer
+  template <typename T, typename WL, typename P, typename R, typename Indexer>
+  static void PriorityAlgo(
+      Graph* graph, const typename Graph::Node& source, const P& pushWrap,
+      const R& edgeRange, const Indexer& indexer) {
     //! [reducible for self-defined stats]
     katana::GAccumulator<size_t> BadWork;
     //! [reducible for self-defined stats]
@@ -101,7 +125,7 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
             }
           }
         },
-        katana::wl<OBIMTy>(UpdateRequestIndexer{stepShift}),
+        katana::wl<WL>(indexer),
         katana::disable_conflict_detection(), katana::loopname("SSSP"));
 
     if (kTrackWork) {
@@ -199,6 +223,57 @@ struct SsspImplementation : public katana::analytics::BfsSsspImplementationBase<
     katana::ReportStatSingle("SSSP-Dijkstra", "Iterations", iter);
   }
 
+  /// Dijkstra with the ordered executor. A request only locks its own node,
+  /// so requests for different nodes run together. Relaxed destinations are
+  /// updated with atomicMin, which commutes with the other requests of the
+  /// round.
+  static void OrderedAlgo(Graph* graph, const typename Graph::Node& source) {
+    katana::LargeArray<katana::Lockable> locks;
+    locks.allocateInterleaved(graph->size());
+
+    katana::do_all(
+        katana::iterate(size_t{0}, graph->size()),
+        [&](size_t i) { locks.constructAt(i); }, katana::no_stats(),
+        katana::loopname("initLocks"));
+
+    katana::GAccumulator<size_t> WLEmptyWork;
+
+    graph->template GetData<NodeDistance>(source) = 0;
+
+    std::vector<UpdateRequest> initial{UpdateRequest(source, 0)};
+
+    katana::for_each_ordered(
+        initial.begin(), initial.end(), std::less<UpdateRequest>(),
+        [&](const UpdateRequest& req) {
+          katana::acquire(&locks[req.src], katana::MethodFlag::WRITE);
+        },
+        [&](const UpdateRequest& req, auto& ctx) {
+          const auto& sdata = graph->template GetData<NodeDistance>(req.src);
+
+          if (sdata < req.dist) {
+            if (kTrackWork)
+              WLEmptyWork += 1;
+            return;
+          }
+
+          for (auto e : graph->edges(req.src)) {
+            auto dest = graph->GetEdgeDest(e);
+            auto& ddist = graph->template GetData<NodeDistance>(dest);
+            Dist ew = graph->template GetEdgeData<EdgeWeight>(e);
+            const Dist new_dist = sdata + ew;
+            if (new_dist < katana::atomicMin(ddist, new_dist)) {
+              ctx.push(UpdateRequest(*dest, new_dist));
+            }
+          }
+        },
+        "SSSP-Ordered");
+
+    if (kTrackWork) {
+      katana::ReportStatSingle(
+          "SSSP-Ordered", "WLEmptyWork", WLEmptyWork.reduce());
+    }
+  }
+
   static void TopoAlgo(Graph* graph, const typename Graph::Node& source) {
     katana::LargeArray<Dist> old_dist;
     old_dist.allocateInterleaved(graph->size());
@@ -351,6 +426,14 @@ public:
       DeltaStepAlgo<UpdateRequest, OBIMBarrier>(
           &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph}, plan.delta());
       break;
+    case SsspPlan::kMultiQueue:
+      PriorityAlgo<UpdateRequest, MultiQueue>(
+          &graph, source, ReqPushWrap(), OutEdgeRangeFn{&graph},
+          UpdateRequestDistance());
+      break;
+    case SsspPlan::kOrdered:
+      OrderedAlgo(&graph, source);
+      break;
     default:
       return katana::ErrorCode::InvalidArgument;
     }
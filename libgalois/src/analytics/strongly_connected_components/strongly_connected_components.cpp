@@ -0,0 +1,662 @@
+#include "katana/analytics/strongly_connected_components/strongly_connected_components.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/Galois.h"
+#include "katana/Properties.h"
+#include "katana/PropertyGraph.h"
+#include "katana/Reduction.h"
+#include "katana/Timer.h"
+#include "katana/analytics/Utils.h"
+
+using namespace katana::analytics;
+
+const int StronglyConnectedComponentsPlan::kChunkSize = 64;
+
+namespace {
+
+constexpr uint64_t kUnassigned = std::numeric_limits<uint64_t>::max();
+
+struct NodeComponent {
+  using ArrowType = arrow::CTypeTraits<uint64_t>::ArrowType;
+  using ViewType = katana::PODPropertyView<std::atomic<uint64_t>>;
+};
+
+using NodeData = std::tuple<NodeComponent>;
+using EdgeData = std::tuple<>;
+using Graph = katana::PropertyGraph<NodeData, EdgeData>;
+using GNode = Graph::Node;
+
+/// The in-edges of a graph, built from its out-edges
+class InEdges {
+  std::vector<uint64_t> indices_;
+  std::vector<GNode> sources_;
+
+public:
+  template <typename GraphTy>
+  explicit InEdges(const GraphTy& graph)
+      : indices_(graph.size() + 1), sources_(graph.num_edges()) {
+    std::vector<std::atomic<uint64_t>> counts(graph.size() + 1);
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& src) {
+          for (auto e : graph.edges(src)) {
+            counts[*graph.GetEdgeDest(e) + 1].fetch_add(
+                1, std::memory_order_relaxed);
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    for (size_t i = 1; i < indices_.size(); ++i) {
+      indices_[i] = indices_[i - 1] + counts[i].load();
+      counts[i - 1].store(indices_[i - 1]);
+    }
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& src) {
+          for (auto e : graph.edges(src)) {
+            uint64_t pos = counts[*graph.GetEdgeDest(e)].fetch_add(
+                1, std::memory_order_relaxed);
+            sources_[pos] = src;
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  auto sources(GNode node) const {
+    return katana::MakeStandardRange(
+        sources_.data() + indices_[node], sources_.data() + indices_[node + 1]);
+  }
+};
+
+/// Tarjan's algorithm over the subgraph induced by the nodes for which in_set
+/// is true, starting from each node of roots in turn. assign(node, id) is
+/// called for every node reached, with the id of the root of its component.
+template <typename GraphTy, typename InSet, typename Assign>
+void
+Tarjan(
+    const GraphTy& graph, const std::vector<GNode>& roots, InSet in_set,
+    Assign assign) {
+  constexpr uint32_t kUnvisited = std::numeric_limits<uint32_t>::max();
+
+  struct Frame {
+    GNode node;
+    uint64_t edge;
+    uint64_t end;
+  };
+
+  std::vector<uint32_t> index(graph.size(), kUnvisited);
+  std::vector<uint32_t> low(graph.size());
+  std::vector<bool> on_stack(graph.size());
+  std::vector<GNode> stack;
+  std::vector<Frame> frames;
+  uint32_t next_index = 0;
+
+  auto visit = [&](GNode v) {
+    index[v] = low[v] = next_index++;
+    stack.emplace_back(v);
+    on_stack[v] = true;
+    auto edges = graph.edges(v);
+    frames.emplace_back(Frame{v, *edges.begin(), *edges.end()});
+  };
+
+  for (GNode root : roots) {
+    if (index[root] != kUnvisited) {
+      continue;
+    }
+    visit(root);
+
+    while (!frames.empty()) {
+      Frame& frame = frames.back();
+      if (frame.edge != frame.end) {
+        GNode v = frame.node;
+        GNode w = *graph.GetEdgeDest(frame.edge++);
+        if (!in_set(w)) {
+          continue;
+        }
+        if (index[w] == kUnvisited) {
+          visit(w);
+        } else if (on_stack[w]) {
+          low[v] = std::min(low[v], index[w]);
+        }
+        continue;
+      }
+
+      GNode v = frame.node;
+      frames.pop_back();
+      if (!frames.empty()) {
+        GNode parent = frames.back().node;
+        low[parent] = std::min(low[parent], low[v]);
+      }
+      if (low[v] == index[v]) {
+        GNode w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          assign(w, v);
+        } while (w != v);
+      }
+    }
+  }
+}
+
+class SccAlgo {
+  /// Node labels of the forward-backward searches. Each set of nodes that may
+  /// still share components has its own label.
+  enum Label : uint32_t { kRest, kForward, kBackward, kDone, kFirstFree };
+
+  struct Task {
+    uint32_t label;
+    std::vector<GNode> nodes;
+  };
+
+  Graph* graph_;
+  StronglyConnectedComponentsPlan plan_;
+  InEdges in_edges_;
+  std::vector<std::atomic<uint32_t>> labels_;
+  std::atomic<uint32_t> next_label_{kFirstFree};
+
+  std::atomic<uint64_t>& Component(GNode node) {
+    return graph_->GetData<NodeComponent>(node);
+  }
+
+  bool IsAssigned(GNode node) {
+    return Component(node).load(std::memory_order_relaxed) != kUnassigned;
+  }
+
+  bool Assign(GNode node, uint64_t id) {
+    uint64_t expected = kUnassigned;
+    return Component(node).compare_exchange_strong(expected, id);
+  }
+
+  /// Make every node without in- or out-edges from other unassigned nodes a
+  /// component of its own, transitively. Returns the node that is most likely
+  /// to be in a large component, or kUnassigned if all nodes were trimmed.
+  uint64_t Trim() {
+    std::vector<std::atomic<uint32_t>> in_count(graph_->size());
+    std::vector<std::atomic<uint32_t>> out_count(graph_->size());
+    katana::InsertBag<GNode> initial;
+
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](const GNode& node) {
+          uint32_t out = 0;
+          for (auto e : graph_->edges(node)) {
+            out += *graph_->GetEdgeDest(e) != node;
+          }
+          uint32_t in = 0;
+          for (GNode src : in_edges_.sources(node)) {
+            in += src != node;
+          }
+          out_count[node].store(out, std::memory_order_relaxed);
+          in_count[node].store(in, std::memory_order_relaxed);
+          if (in == 0 || out == 0) {
+            initial.push(node);
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    katana::GAccumulator<size_t> trimmed;
+    katana::for_each(
+        katana::iterate(initial),
+        [&](const GNode& node, auto& ctx) {
+          if (!Assign(node, node)) {
+            return;
+          }
+          trimmed += 1;
+          for (auto e : graph_->edges(node)) {
+            GNode dst = *graph_->GetEdgeDest(e);
+            if (dst != node && in_count[dst].fetch_sub(1) == 1) {
+              ctx.push(dst);
+            }
+          }
+          for (GNode src : in_edges_.sources(node)) {
+            if (src != node && out_count[src].fetch_sub(1) == 1) {
+              ctx.push(src);
+            }
+          }
+        },
+        katana::disable_conflict_detection(),
+        katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+        katana::loopname("SCC Trim"));
+    katana::ReportStatSingle(
+        "StronglyConnectedComponents", "Trimmed", trimmed.reduce());
+
+    // Pack the product of degrees above the node id to pick the largest
+    katana::GReduceMax<uint64_t> best;
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](const GNode& node) {
+          if (!IsAssigned(node)) {
+            uint64_t score = std::min<uint64_t>(
+                uint64_t{in_count[node].load()} * out_count[node].load(),
+                std::numeric_limits<uint32_t>::max());
+            best.update(score << 32 | node);
+          }
+        },
+        katana::no_stats());
+    if (trimmed.reduce() == graph_->size()) {
+      return kUnassigned;
+    }
+    return best.reduce() & std::numeric_limits<uint32_t>::max();
+  }
+
+  /// Assign the component of pivot with parallel searches and label the
+  /// unassigned nodes kForward, kBackward or kRest by whether pivot reaches
+  /// them or they reach pivot.
+  void ParallelForwardBackward(GNode pivot) {
+    labels_[pivot].store(kForward);
+    katana::for_each(
+        katana::iterate({pivot}),
+        [&](const GNode& node, auto& ctx) {
+          for (auto e : graph_->edges(node)) {
+            GNode dst = *graph_->GetEdgeDest(e);
+            uint32_t expected = kRest;
+            if (!IsAssigned(dst) &&
+                labels_[dst].compare_exchange_strong(expected, kForward)) {
+              ctx.push(dst);
+            }
+          }
+        },
+        katana::disable_conflict_detection(),
+        katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+        katana::loopname("SCC Forward"));
+
+    Assign(pivot, pivot);
+    labels_[pivot].store(kDone);
+    katana::for_each(
+        katana::iterate({pivot}),
+        [&](const GNode& node, auto& ctx) {
+          for (GNode src : in_edges_.sources(node)) {
+            uint32_t expected = kRest;
+            if (IsAssigned(src)) {
+              continue;
+            }
+            if (labels_[src].compare_exchange_strong(expected, kBackward)) {
+              ctx.push(src);
+            } else if (expected == kForward && Assign(src, pivot)) {
+              labels_[src].store(kDone);
+              ctx.push(src);
+            }
+          }
+        },
+        katana::disable_conflict_detection(),
+        katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+        katana::loopname("SCC Backward"));
+  }
+
+  /// Split task into the component of its first node and the forward,
+  /// backward and remaining sets, searching serially
+  template <typename Context>
+  void SerialForwardBackward(Task& task, Context& ctx) {
+    GNode pivot = task.nodes.front();
+    if (task.nodes.size() == 1) {
+      Assign(pivot, pivot);
+      return;
+    }
+
+    uint32_t forward = next_label_.fetch_add(2);
+    uint32_t backward = forward + 1;
+    std::vector<GNode> stack;
+
+    labels_[pivot].store(forward, std::memory_order_relaxed);
+    stack.emplace_back(pivot);
+    while (!stack.empty()) {
+      GNode node = stack.back();
+      stack.pop_back();
+      for (auto e : graph_->edges(node)) {
+        GNode dst = *graph_->GetEdgeDest(e);
+        if (labels_[dst].load(std::memory_order_relaxed) == task.label &&
+            !IsAssigned(dst)) {
+          labels_[dst].store(forward, std::memory_order_relaxed);
+          stack.emplace_back(dst);
+        }
+      }
+    }
+
+    Assign(pivot, pivot);
+    labels_[pivot].store(kDone, std::memory_order_relaxed);
+    stack.emplace_back(pivot);
+    while (!stack.empty()) {
+      GNode node = stack.back();
+      stack.pop_back();
+      for (GNode src : in_edges_.sources(node)) {
+        uint32_t label = labels_[src].load(std::memory_order_relaxed);
+        if (IsAssigned(src)) {
+          continue;
+        }
+        if (label == forward) {
+          Assign(src, pivot);
+          labels_[src].store(kDone, std::memory_order_relaxed);
+          stack.emplace_back(src);
+        } else if (label == task.label) {
+          labels_[src].store(backward, std::memory_order_relaxed);
+          stack.emplace_back(src);
+        }
+      }
+    }
+
+    Task forward_task{forward, {}};
+    Task backward_task{backward, {}};
+    Task rest_task{task.label, {}};
+    for (GNode node : task.nodes) {
+      uint32_t label = labels_[node].load(std::memory_order_relaxed);
+      if (label == forward) {
+        forward_task.nodes.emplace_back(node);
+      } else if (label == backward) {
+        backward_task.nodes.emplace_back(node);
+      } else if (label == task.label) {
+        rest_task.nodes.emplace_back(node);
+      }
+    }
+    for (Task* t : {&forward_task, &backward_task, &rest_task}) {
+      if (!t->nodes.empty()) {
+        ctx.push(std::move(*t));
+      }
+    }
+  }
+
+  void RecursiveForwardBackward() {
+    katana::InsertBag<GNode> sets[kDone];
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](const GNode& node) {
+          if (!IsAssigned(node)) {
+            sets[labels_[node].load()].push(node);
+          }
+        },
+        katana::no_stats());
+
+    std::vector<Task> initial;
+    for (uint32_t label = kRest; label < kDone; ++label) {
+      if (!sets[label].empty()) {
+        initial.emplace_back(Task{
+            label, std::vector<GNode>(sets[label].begin(), sets[label].end())});
+      }
+    }
+
+    katana::for_each(
+        katana::iterate(initial),
+        [&](Task& task, auto& ctx) { SerialForwardBackward(task, ctx); },
+        katana::disable_conflict_detection(), katana::chunk_size<1>(),
+        katana::loopname("SCC ForwardBackward"));
+  }
+
+  /// Coloring rounds until at most serial_threshold nodes are unassigned,
+  /// then Tarjan's algorithm on the rest
+  void Coloring() {
+    std::vector<std::atomic<GNode>> colors(graph_->size());
+    katana::InsertBag<GNode> active;
+    katana::InsertBag<GNode> remaining;
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](const GNode& node) {
+          if (!IsAssigned(node)) {
+            active.push(node);
+          }
+        },
+        katana::no_stats());
+
+    size_t num_rounds = 0;
+    for (;;) {
+      katana::GAccumulator<size_t> num_remaining;
+      katana::do_all(
+          katana::iterate(active),
+          [&](const GNode& node) {
+            if (!IsAssigned(node)) {
+              remaining.push(node);
+              num_remaining += 1;
+            }
+          },
+          katana::no_stats());
+      active.clear();
+      if (num_remaining.reduce() == 0) {
+        break;
+      }
+
+      if (num_remaining.reduce() <= plan_.serial_threshold()) {
+        std::vector<GNode> roots(remaining.begin(), remaining.end());
+        Tarjan(
+            *graph_, roots, [&](GNode node) { return !IsAssigned(node); },
+            [&](GNode node, GNode root) {
+              Component(node).store(root, std::memory_order_relaxed);
+            });
+        break;
+      }
+      ++num_rounds;
+
+      katana::do_all(
+          katana::iterate(remaining),
+          [&](const GNode& node) {
+            colors[node].store(node, std::memory_order_relaxed);
+          },
+          katana::no_stats());
+
+      // Each node takes the largest id of the nodes that reach it
+      katana::for_each(
+          katana::iterate(remaining),
+          [&](const GNode& node, auto& ctx) {
+            GNode color = colors[node].load(std::memory_order_relaxed);
+            for (auto e : graph_->edges(node)) {
+              GNode dst = *graph_->GetEdgeDest(e);
+              if (!IsAssigned(dst) && katana::atomicMax(colors[dst], color) <
+                                          color) {
+                ctx.push(dst);
+              }
+            }
+          },
+          katana::disable_conflict_detection(),
+          katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+          katana::loopname("SCC Color"));
+
+      // The nodes of a color that reach its root form the root's component
+      katana::InsertBag<GNode> roots;
+      katana::do_all(
+          katana::iterate(remaining),
+          [&](const GNode& node) {
+            if (colors[node].load(std::memory_order_relaxed) == node) {
+              Assign(node, node);
+              roots.push(node);
+            }
+          },
+          katana::no_stats());
+      katana::for_each(
+          katana::iterate(roots),
+          [&](const GNode& node, auto& ctx) {
+            GNode color = colors[node].load(std::memory_order_relaxed);
+            for (GNode src : in_edges_.sources(node)) {
+              if (colors[src].load(std::memory_order_relaxed) == color &&
+                  Assign(src, color)) {
+                ctx.push(src);
+              }
+            }
+          },
+          katana::disable_conflict_detection(),
+          katana::chunk_size<StronglyConnectedComponentsPlan::kChunkSize>(),
+          katana::loopname("SCC ColorBackward"));
+
+      active.swap(remaining);
+      remaining.clear();
+    }
+
+    katana::ReportStatSingle(
+        "StronglyConnectedComponents", "ColoringRounds", num_rounds);
+  }
+
+public:
+  SccAlgo(Graph* graph, const StronglyConnectedComponentsPlan& plan)
+      : graph_(graph),
+        plan_(plan),
+        in_edges_(*graph),
+        labels_(graph->size()) {}
+
+  void operator()() {
+    katana::do_all(
+        katana::iterate(*graph_),
+        [&](const GNode& node) {
+          Component(node).store(kUnassigned, std::memory_order_relaxed);
+          labels_[node].store(kRest, std::memory_order_relaxed);
+        },
+        katana::no_stats());
+
+    uint64_t pivot = Trim();
+    if (pivot == kUnassigned) {
+      return;
+    }
+    ParallelForwardBackward(pivot);
+
+    if (plan_.algorithm() == StronglyConnectedComponentsPlan::kMultistep) {
+      Coloring();
+    } else {
+      RecursiveForwardBackward();
+    }
+  }
+};
+
+struct SerialAlgo {
+  void operator()(Graph* graph) {
+    std::vector<GNode> roots(graph->begin(), graph->end());
+    Tarjan(
+        *graph, roots, [](GNode) { return true; },
+        [&](GNode node, GNode root) {
+          graph->GetData<NodeComponent>(node).store(root);
+        });
+  }
+};
+
+}  // namespace
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponents(
+    katana::PropertyFileGraph* pfg, const std::string& output_property_name,
+    StronglyConnectedComponentsPlan plan) {
+  if (auto result =
+          ConstructNodeProperties<NodeData>(pfg, {output_property_name});
+      !result) {
+    return result.error();
+  }
+
+  auto pg_result = Graph::Make(pfg, {output_property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph graph = pg_result.value();
+
+  katana::reportPageAlloc("MeminfoPre");
+  katana::StatTimer exec_time("StronglyConnectedComponents");
+  exec_time.start();
+
+  switch (plan.algorithm()) {
+  case StronglyConnectedComponentsPlan::kSerial:
+    SerialAlgo()(&graph);
+    break;
+  case StronglyConnectedComponentsPlan::kForwardBackward:
+  case StronglyConnectedComponentsPlan::kMultistep:
+    SccAlgo(&graph, plan)();
+    break;
+  default:
+    return katana::ErrorCode::InvalidArgument;
+  }
+
+  exec_time.stop();
+  katana::reportPageAlloc("MeminfoPost");
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::StronglyConnectedComponentsAssertValid(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto pg_result = Graph::Make(pfg, {property_name}, {});
+  if (!pg_result) {
+    return pg_result.error();
+  }
+  Graph graph = pg_result.value();
+
+  std::vector<GNode> expected(graph.size());
+  std::vector<GNode> roots(graph.begin(), graph.end());
+  Tarjan(
+      graph, roots, [](GNode) { return true; },
+      [&](GNode node, GNode root) { expected[node] = root; });
+
+  // The two labelings must induce the same partition: map each component id
+  // to the reference id of its first node and check the rest agree.
+  std::vector<uint64_t> to_expected(graph.size(), kUnassigned);
+  std::vector<uint64_t> from_expected(graph.size(), kUnassigned);
+  for (GNode node : graph) {
+    uint64_t id = graph.GetData<NodeComponent>(node).load();
+    if (id >= graph.size()) {
+      KATANA_LOG_DEBUG("{} has invalid component {}", node, id);
+      return katana::ErrorCode::AssertionFailed;
+    }
+    if (to_expected[id] == kUnassigned &&
+        from_expected[expected[node]] == kUnassigned) {
+      to_expected[id] = expected[node];
+      from_expected[expected[node]] = id;
+    }
+    if (to_expected[id] != expected[node] ||
+        from_expected[expected[node]] != id) {
+      KATANA_LOG_DEBUG(
+          "{} (component: {}) should be in the component of {}", node, id,
+          expected[node]);
+      return katana::ErrorCode::AssertionFailed;
+    }
+  }
+
+  return katana::ResultSuccess();
+}
+
+void
+katana::analytics::StronglyConnectedComponentsStatistics::Print(
+    std::ostream& os) const {
+  os << "Total number of components = " << total_components << std::endl;
+  os << "Total number of non trivial components = "
+     << total_non_trivial_components << std::endl;
+  os << "Number of nodes in the largest component = " << largest_component_size
+     << std::endl;
+  os << "Ratio of nodes in the largest component = " << ratio_largest_component
+     << std::endl;
+}
+
+katana::Result<StronglyConnectedComponentsStatistics>
+katana::analytics::StronglyConnectedComponentsStatistics::Compute(
+    katana::PropertyFileGraph* pfg, const std::string& property_name) {
+  auto property_result = pfg->NodePropertyTyped<uint64_t>(property_name);
+  if (!property_result) {
+    return property_result.error();
+  }
+  auto property = property_result.value();
+  size_t num_nodes = property->length();
+
+  std::vector<uint64_t> sizes(num_nodes);
+  for (size_t i = 0; i < num_nodes; ++i) {
+    uint64_t id = property->Value(i);
+    if (id >= num_nodes) {
+      return katana::ErrorCode::InvalidArgument;
+    }
+    sizes[id]++;
+  }
+
+  uint64_t total_components = 0;
+  uint64_t total_non_trivial_components = 0;
+  uint64_t largest_component_size = 0;
+  for (uint64_t size : sizes) {
+    total_components += size > 0;
+    total_non_trivial_components += size > 1;
+    largest_component_size = std::max(largest_component_size, size);
+  }
+
+  double ratio_largest_component =
+      num_nodes > 0 ? double(largest_component_size) / num_nodes : 0;
+
+  return StronglyConnectedComponentsStatistics{
+      total_components, total_non_trivial_components, largest_component_size,
+      ratio_largest_component};
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+
+namespace {
+
+constexpr uint32_t kNumNodes = 1 << 14;
+constexpr uint32_t kDegree = 8;
+constexpr uint32_t kMaxWeight = 100;
+constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+constexpr uint32_t kNumTasks = 1 << 12;
+constexpr uint32_t kNumBuckets = 64;
+
+struct Graph {
+  std::vector<uint32_t> out_indices;
+  std::vector<uint32_t> out_dests;
+  std::vector<uint32_t> weights;
+};
+
+struct Node : public katana::Lockable {
+  uint32_t dist{kInfinity};
+};
+
+struct Request {
+  uint32_t dist;
+  uint32_t node;
+};
+
+struct RequestLess {
+  bool operator()(const Request& a, const Request& b) const {
+    return a.dist < b.dist;
+  }
+};
+
+Graph
+MakeRandomGraph() {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<uint32_t> node_dist(0, kNumNodes - 1);
+  std::uniform_int_distribution<uint32_t> weight_dist(1, kMaxWeight);
+
+  Graph g;
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    for (uint32_t i = 0; i < kDegree; ++i) {
+      g.out_dests.emplace_back(node_dist(gen));
+      g.weights.emplace_back(weight_dist(gen));
+    }
+    g.out_indices.emplace_back(g.out_dests.size());
+  }
+  return g;
+}
+
+std::vector<uint32_t>
+SerialDijkstra(const Graph& g) {
+  auto greater = [](const Request& a, const Request& b) {
+    return a.dist > b.dist;
+  };
+  std::priority_queue<Request, std::vector<Request>, decltype(greater)> queue(
+      greater);
+  std::vector<uint32_t> dist(kNumNodes, kInfinity);
+
+  queue.push(Request{0, 0});
+  while (!queue.empty()) {
+    Request r = queue.top();
+    queue.pop();
+    if (r.dist >= dist[r.node]) {
+      continue;
+    }
+    dist[r.node] = r.dist;
+    uint32_t begin = r.node == 0 ? 0 : g.out_indices[r.node - 1];
+    for (uint32_t e = begin; e < g.out_indices[r.node]; ++e) {
+      queue.push(Request{r.dist + g.weights[e], g.out_dests[e]});
+    }
+  }
+  return dist;
+}
+
+/// Dijkstra with the ordered executor. A request only touches its own node,
+/// and relaxing an edge never produces an earlier request, so the sources of
+/// each window are stable.
+template <typename... StableTest>
+std::vector<uint32_t>
+OrderedDijkstra(const Graph& g, const StableTest&... stable_test) {
+  std::vector<Node> nodes(kNumNodes);
+  std::vector<Request> initial{Request{0, 0}};
+
+  auto nh_func = [&](const Request& r) {
+    katana::acquire(&nodes[r.node], katana::MethodFlag::WRITE);
+  };
+  auto op_func = [&](const Request& r, katana::UserContext<Request>& ctx) {
+    Node& node = nodes[r.node];
+    if (r.dist >= node.dist) {
+      return;
+    }
+    node.dist = r.dist;
+    uint32_t begin = r.node == 0 ? 0 : g.out_indices[r.node - 1];
+    for (uint32_t e = begin; e < g.out_indices[r.node]; ++e) {
+      ctx.push(Request{r.dist + g.weights[e], g.out_dests[e]});
+    }
+  };
+
+  katana::for_each_ordered(
+      initial.begin(), initial.end(), RequestLess(), nh_func, op_func,
+      stable_test..., "OrderedDijkstra");
+
+  std::vector<uint32_t> dist;
+  for (const Node& node : nodes) {
+    dist.emplace_back(node.dist);
+  }
+  return dist;
+}
+
+struct Bucket : public katana::Lockable {
+  std::vector<uint32_t> log;
+};
+
+struct Task {
+  uint32_t priority;
+  uint32_t bucket;
+};
+
+struct TaskLess {
+  bool operator()(const Task& a, const Task& b) const {
+    return a.priority < b.priority;
+  }
+};
+
+/// Each task appends its priority to the log of its bucket, and the initial
+/// tasks push one later task to another bucket. Priorities are distinct, so
+/// the logs are fixed only if conflicting tasks commit in priority order.
+std::vector<std::vector<uint32_t>>
+OrderedLogs() {
+  std::vector<Task> initial;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<uint32_t> bucket_dist(0, kNumBuckets - 1);
+  for (uint32_t i = 0; i < kNumTasks; ++i) {
+    initial.emplace_back(Task{i, bucket_dist(gen)});
+  }
+  std::shuffle(initial.begin(), initial.end(), gen);
+
+  std::vector<Bucket> buckets(kNumBuckets);
+  auto nh_func = [&](const Task& t) {
+    katana::acquire(&buckets[t.bucket], katana::MethodFlag::WRITE);
+  };
+  auto op_func = [&](const Task& t, katana::UserContext<Task>& ctx) {
+    buckets[t.bucket].log.emplace_back(t.priority);
+    if (t.priority < kNumTasks) {
+      ctx.push(Task{t.priority + kNumTasks, (t.bucket * 7 + 3) % kNumBuckets});
+    }
+  };
+
+  katana::for_each_ordered(
+      initial.begin(), initial.end(), TaskLess(), nh_func, op_func,
+      "OrderedLogs");
+
+  std::vector<std::vector<uint32_t>> logs;
+  for (const Bucket& bucket : buckets) {
+    logs.emplace_back(bucket.log);
+  }
+  return logs;
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  Graph g = MakeRandomGraph();
+
+  std::vector<uint32_t> expected = SerialDijkstra(g);
+  std::vector<uint32_t> stable = OrderedDijkstra(g);
+  KATANA_LOG_ASSERT(stable == expected);
+
+  // Deferring unstable sources delays them but must not change the result
+  auto even_nodes = [](const Request& r) { return r.node % 2 == 0; };
+  std::vector<uint32_t> unstable = OrderedDijkstra(g, even_nodes);
+  KATANA_LOG_ASSERT(unstable == expected);
+
+  // Tasks of a bucket commit in priority order
+  std::vector<std::vector<uint32_t>> logs = OrderedLogs();
+  size_t num_logged = 0;
+  for (const std::vector<uint32_t>& log : logs) {
+    KATANA_LOG_ASSERT(std::is_sorted(log.begin(), log.end()));
+    num_logged += log.size();
+  }
+  KATANA_LOG_ASSERT(num_logged == 2 * kNumTasks);
+
+  return 0;
+}
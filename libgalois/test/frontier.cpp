@@ -0,0 +1,142 @@
+#include <atomic>
+#include <deque>
+#include <limits>
+
+#include "TestPropertyGraph.h"
+#include "katana/Frontier.h"
+#include "katana/Logging.h"
+#include "katana/PropertyFileGraph.h"
+#include "katana/Reduction.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+constexpr uint32_t kNumNodes = 1000;
+constexpr uint32_t kInfinity = std::numeric_limits<uint32_t>::max();
+
+/// Connect each node to the width nodes before and after it on a ring, so
+/// that the graph is symmetric
+class RingPolicy : public Policy {
+  size_t width_{};
+
+public:
+  RingPolicy(size_t width) : width_(width) {}
+
+  std::vector<uint32_t> GenerateNeighbors(
+      size_t node_id, size_t num_nodes) override {
+    std::vector<uint32_t> r;
+    for (size_t i = 1; i <= width_; ++i) {
+      r.emplace_back((node_id + i) % num_nodes);
+      r.emplace_back((node_id + num_nodes - i) % num_nodes);
+    }
+    return r;
+  }
+};
+
+void
+TestForms() {
+  katana::Frontier sparse = katana::Frontier::FromNodes(kNumNodes, {7, 3, 64});
+  KATANA_LOG_ASSERT(!sparse.is_dense() && sparse.size() == 3);
+  sparse.ToDense();
+  KATANA_LOG_ASSERT(sparse.is_dense() && sparse.size() == 3);
+  KATANA_LOG_ASSERT(sparse.Contains(3) && sparse.Contains(64));
+  KATANA_LOG_ASSERT(!sparse.Contains(4));
+  sparse.ToSparse();
+  KATANA_LOG_ASSERT(sparse.nodes() == std::vector<uint32_t>({3, 7, 64}));
+
+  // kNumNodes is not a multiple of the bitmap word size
+  katana::Frontier all = katana::Frontier::All(kNumNodes);
+  KATANA_LOG_ASSERT(all.is_dense() && all.size() == kNumNodes);
+  KATANA_LOG_ASSERT(all.bitmap().count() == kNumNodes);
+
+  katana::GAccumulator<uint64_t> sum;
+  all.Map([&](uint32_t node) { sum += node; });
+  KATANA_LOG_ASSERT(sum.reduce() == uint64_t{kNumNodes} * (kNumNodes - 1) / 2);
+
+  // Large results stay dense and small ones become sparse
+  katana::Frontier even =
+      all.Filter([](uint32_t node) { return node % 2 == 0; });
+  KATANA_LOG_ASSERT(even.is_dense() && even.size() == kNumNodes / 2);
+  KATANA_LOG_ASSERT(even.Contains(10) && !even.Contains(11));
+
+  katana::Frontier few = even.Filter([](uint32_t node) { return node < 6; });
+  KATANA_LOG_ASSERT(!few.is_dense());
+  KATANA_LOG_ASSERT(few.nodes() == std::vector<uint32_t>({0, 2, 4}));
+
+  katana::Frontier none = few.Filter([](uint32_t) { return false; });
+  KATANA_LOG_ASSERT(none.empty());
+}
+
+std::vector<uint32_t>
+SerialBfs(const katana::PropertyFileGraph& g, uint32_t source) {
+  std::vector<uint32_t> dist(g.num_nodes(), kInfinity);
+  std::deque<uint32_t> queue{source};
+  dist[source] = 0;
+  while (!queue.empty()) {
+    uint32_t node = queue.front();
+    queue.pop_front();
+    for (auto e : g.edges(node)) {
+      uint32_t dest = *g.GetEdgeDest(e);
+      if (dist[dest] == kInfinity) {
+        dist[dest] = dist[node] + 1;
+        queue.push_back(dest);
+      }
+    }
+  }
+  return dist;
+}
+
+void
+TestEdgeMap(Policy* policy, bool symmetric) {
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, policy);
+  std::vector<uint32_t> expected = SerialBfs(*g, 0);
+
+  for (auto direction :
+       {katana::EdgeMapDirection::kAuto, katana::EdgeMapDirection::kPush,
+        katana::EdgeMapDirection::kPull}) {
+    katana::EdgeMapOptions options;
+    options.direction = direction;
+    options.symmetric = symmetric;
+
+    std::vector<std::atomic<uint32_t>> dist(kNumNodes);
+    for (auto& d : dist) {
+      d = kInfinity;
+    }
+    dist[0] = 0;
+
+    katana::Frontier frontier = katana::Frontier::FromNodes(kNumNodes, {0});
+    for (uint32_t level = 1; !frontier.empty(); ++level) {
+      frontier = katana::EdgeMap(
+          *g, &frontier,
+          [&](uint32_t, uint32_t dst, auto) {
+            uint32_t infinity = kInfinity;
+            return dist[dst].compare_exchange_strong(infinity, level);
+          },
+          [&](uint32_t dst) { return dist[dst] == kInfinity; }, options);
+    }
+
+    for (uint32_t n = 0; n < kNumNodes; ++n) {
+      KATANA_LOG_VASSERT(
+          dist[n] == expected[n], "direction {} node {}: {} != {}",
+          static_cast<int>(direction), n, dist[n].load(), expected[n]);
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestForms();
+
+  LinePolicy line{3};
+  RandomPolicy random{4};
+  RingPolicy ring{2};
+  TestEdgeMap(&line, false);
+  TestEdgeMap(&random, false);
+  TestEdgeMap(&ring, true);
+
+  return 0;
+}
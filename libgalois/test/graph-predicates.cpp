@@ -4,7 +4,10 @@
 #include "katana/Logging.h"
 #include "katana/PropertyFileGraph.h"
 #include "katana/SharedMemSys.h"
+#include "katana/analytics/GraphProfile.h"
 #include "katana/analytics/Utils.h"
+#include "katana/analytics/bfs/bfs.h"
+#include "katana/analytics/jaccard/jaccard.h"
 
 namespace cll = llvm::cl;
 
@@ -31,12 +34,62 @@ TestIsApproximateDegreeDistributionPowerLaw() {
   }
 }
 
+void
+TestGraphProfile() {
+  {
+    LinePolicy policy{11};
+    auto g = MakeFileGraph<uint32_t>(100, 1, &policy);
+
+    auto profile_res = katana::analytics::GraphProfile::Get(g.get());
+    KATANA_LOG_ASSERT(profile_res);
+    katana::analytics::GraphProfile profile = profile_res.value();
+    KATANA_LOG_ASSERT(profile.num_nodes == 100);
+    KATANA_LOG_ASSERT(profile.num_edges == 11 * 100);
+    KATANA_LOG_ASSERT(profile.average_degree == 11);
+    // Every node is within 9 hops of all others, 11 nodes at a time
+    KATANA_LOG_ASSERT(profile.estimated_diameter == 9);
+    // The edges of the last nodes wrap around to node 0
+    KATANA_LOG_ASSERT(!profile.edges_sorted);
+    KATANA_LOG_ASSERT(
+        !katana::analytics::PlanCalibration().IsPowerLaw(profile));
+
+    // The profile is stored with the graph until the topology changes
+    KATANA_LOG_ASSERT(!g->graph_profile().empty());
+    KATANA_LOG_ASSERT(katana::SortAllEdgesByDest(g.get()));
+    KATANA_LOG_ASSERT(g->graph_profile().empty());
+    profile_res = katana::analytics::GraphProfile::Get(g.get());
+    KATANA_LOG_ASSERT(profile_res && profile_res.value().edges_sorted);
+
+    KATANA_LOG_ASSERT(
+        katana::analytics::JaccardPlan::Automatic(g.get()).edge_sorting() ==
+        katana::analytics::JaccardPlan::kSorted);
+    KATANA_LOG_ASSERT(
+        katana::analytics::BfsPlan::Automatic(g.get()).algorithm() ==
+        katana::analytics::BfsPlan::kSynchronous);
+  }
+  {
+    auto g = katana::PropertyFileGraph::Make(rmat10InputFile);
+    auto profile_res =
+        katana::analytics::GraphProfile::Get(g.assume_value().get());
+    KATANA_LOG_ASSERT(profile_res);
+    KATANA_LOG_ASSERT(
+        katana::analytics::PlanCalibration().IsPowerLaw(profile_res.value()));
+
+    auto round_trip_res = katana::analytics::GraphProfile::FromJson(
+        profile_res.value().ToJson().value());
+    KATANA_LOG_ASSERT(round_trip_res);
+    KATANA_LOG_ASSERT(
+        round_trip_res.value().degree_skew == profile_res.value().degree_skew);
+  }
+}
+
 int
 main(int argc, char** argv) {
   katana::SharedMemSys sys;
   cll::ParseCommandLineOptions(argc, argv);
 
   TestIsApproximateDegreeDistributionPowerLaw();
+  TestGraphProfile();
 
   return 0;
 }
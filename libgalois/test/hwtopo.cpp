@@ -29,6 +29,9 @@ printMyTopo() {
   std::cout << "T,C,P,N: " << t.machineTopoInfo.maxThreads << " "
             << t.machineTopoInfo.maxCores << " " << t.machineTopoInfo.maxSockets
             << " " << t.machineTopoInfo.maxNumaNodes << "\n";
+  std::cout << "host threads: " << t.machineTopoInfo.hostThreads
+            << " cpu quota threads: " << t.machineTopoInfo.cpuQuotaThreads
+            << "\n";
   for (unsigned i = 0; i < t.machineTopoInfo.maxThreads; ++i) {
     auto& c = t.threadTopoInfo[i];
     std::cout << "tid: " << c.tid << " leader: " << c.socketLeader
@@ -61,6 +64,16 @@ test(
   }
 }
 
+void
+test(const std::string& name, unsigned found, unsigned expected) {
+  if (found != expected) {
+    std::cerr << "test " << name << " failed\n";
+    std::cerr << "found: " << found << "\n";
+    std::cerr << "expected: " << expected << "\n";
+    std::abort();
+  }
+}
+
 int
 main() {
   printMyTopo();
@@ -82,5 +95,24 @@ main() {
       "parse range", parseCPUList("     0-4   \n"),
       std::vector<int>{0, 1, 2, 3, 4});
 
+  test("parse no cpu.max quota", parseCgroupCPUMax("max 100000\n"), 0);
+  test("parse cpu.max quota", parseCgroupCPUMax("200000 100000\n"), 2);
+  test(
+      "parse fractional cpu.max quota", parseCgroupCPUMax("150000 100000\n"),
+      2);
+  test("parse small cpu.max quota", parseCgroupCPUMax("1000 100000\n"), 1);
+  test("parse empty cpu.max", parseCgroupCPUMax(""), 0);
+  test("parse no cfs quota", parseCgroupCFSQuota("-1\n", "100000\n"), 0);
+  test("parse cfs quota", parseCgroupCFSQuota("400000\n", "100000\n"), 4);
+  test("parse empty cfs quota", parseCgroupCFSQuota("", ""), 0);
+
+  auto t = getHWTopo();
+  if (t.machineTopoInfo.maxThreads > t.machineTopoInfo.hostThreads ||
+      (t.machineTopoInfo.cpuQuotaThreads &&
+       t.machineTopoInfo.maxThreads > t.machineTopoInfo.cpuQuotaThreads)) {
+    std::cerr << "test threads within quota failed\n";
+    std::abort();
+  }
+
   return 0;
 }
@@ -0,0 +1,102 @@
+#include <arrow/api.h>
+
+#include "TestPropertyGraph.h"
+#include "katana/LC_CSR_PropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+
+struct NodeId : public katana::PODProperty<int32_t> {};
+struct NodeValue : public katana::PODProperty<int32_t> {};
+struct EdgeId : public katana::PODProperty<int32_t> {};
+
+template <typename T>
+std::shared_ptr<arrow::Table>
+MakeTable(const std::string& name, size_t size) {
+  katana::TableBuilder builder{size};
+
+  katana::ColumnOptions options;
+  options.name = name;
+  options.ascending_values = true;
+  builder.AddColumn<T>(options);
+  return builder.Finish();
+}
+
+void
+TestView() {
+  constexpr size_t num_nodes = 100;
+  constexpr size_t num_edges = 400;
+
+  RandomPolicy policy{4};
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 1, &policy);
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeTable<int32_t>("node-id", num_nodes)));
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeTable<int32_t>("node-value", num_nodes)));
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(MakeTable<int32_t>("edge-id", num_edges)));
+
+  std::vector<uint32_t> original_dests(
+      g->topology().out_dests->raw_values(),
+      g->topology().out_dests->raw_values() + num_edges);
+
+  using Graph = katana::LC_CSR_PropertyGraph<
+      std::tuple<NodeId, NodeValue>, std::tuple<EdgeId>>;
+  auto view_result =
+      Graph::Make(g.get(), {"node-id", "node-value"}, {"edge-id"});
+  if (!view_result) {
+    KATANA_LOG_FATAL("could not make view: {}", view_result.error());
+  }
+  Graph graph = std::move(view_result.value());
+
+  KATANA_LOG_ASSERT(graph.size() == num_nodes);
+  KATANA_LOG_ASSERT(graph.sizeEdges() == num_edges);
+
+  for (Graph::GraphNode n : graph) {
+    auto [id, value] = graph.getData(n);
+    KATANA_LOG_ASSERT(id == static_cast<int32_t>(n));
+    value = -id;
+    KATANA_LOG_ASSERT(graph.getDegree(n) == 4);
+    for (auto e : graph.edges(n)) {
+      KATANA_LOG_ASSERT(graph.getEdgeDst(e) == original_dests[*e]);
+      KATANA_LOG_ASSERT(graph.getEdgeData(e) == static_cast<int32_t>(*e));
+    }
+  }
+
+  // Writes through the view land in the property arrays
+  auto values = std::static_pointer_cast<arrow::Int32Array>(
+      g->NodeProperty("node-value")->chunk(0));
+  for (size_t n = 0; n < num_nodes; ++n) {
+    KATANA_LOG_ASSERT(values->Value(n) == -static_cast<int32_t>(n));
+  }
+
+  // Sorting moves edge data with the destinations
+  graph.sortAllEdgesByDst();
+  for (Graph::GraphNode n : graph) {
+    Graph::GraphNode prev = 0;
+    for (auto e : graph.edges(n)) {
+      Graph::GraphNode dest = graph.getEdgeDst(e);
+      KATANA_LOG_ASSERT(prev <= dest);
+      KATANA_LOG_ASSERT(original_dests[graph.getEdgeData(e)] == dest);
+      KATANA_LOG_ASSERT(
+          graph.findEdgeSortedByDst(n, dest) != graph.edge_end(n));
+      KATANA_LOG_ASSERT(graph.findEdge(n, dest) != graph.edge_end(n));
+      prev = dest;
+    }
+  }
+  KATANA_LOG_ASSERT(
+      g->topology().out_dests->Value(0) ==
+      graph.getEdgeDst(graph.edge_begin(0)));
+
+  auto bad_result =
+      Graph::Make(g.get(), {"node-id", "no-such-property"}, {"edge-id"});
+  KATANA_LOG_ASSERT(!bad_result);
+}
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestView();
+
+  return 0;
+}
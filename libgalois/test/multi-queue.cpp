@@ -0,0 +1,109 @@
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/MultiQueue.h"
+
+namespace {
+
+constexpr uint32_t kNumItems = 1 << 14;
+
+struct Item {
+  float priority;
+  uint32_t id;
+};
+
+struct ItemIndexer {
+  float operator()(const Item& item) const { return item.priority; }
+};
+
+std::vector<Item>
+MakeItems() {
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dist(0, 1);
+
+  std::vector<Item> items;
+  for (uint32_t i = 0; i < kNumItems; ++i) {
+    items.emplace_back(Item{dist(gen), i});
+  }
+  return items;
+}
+
+/// With one queue and one thread, a MultiQueue is an exact priority queue
+template <bool UseDescending>
+void
+TestSerialOrder() {
+  using WL = typename katana::MultiQueue<ItemIndexer, 1, UseDescending>::
+      template retype<Item>::template rethread<false>;
+
+  std::vector<Item> items = MakeItems();
+  WL wl;
+  wl.push(items.begin(), items.end());
+
+  std::vector<float> popped;
+  while (auto item = wl.pop()) {
+    popped.emplace_back(item->priority);
+  }
+  KATANA_LOG_ASSERT(popped.size() == kNumItems);
+  for (size_t i = 1; i < popped.size(); ++i) {
+    KATANA_LOG_ASSERT(
+        UseDescending ? popped[i - 1] >= popped[i]
+                      : popped[i - 1] <= popped[i]);
+  }
+}
+
+/// Every item, including those pushed during the loop, is processed once
+void
+TestForEach() {
+  std::vector<Item> items = MakeItems();
+  std::vector<std::atomic<uint32_t>> counts(2 * kNumItems);
+
+  katana::for_each(
+      katana::iterate(items),
+      [&](const Item& item, auto& ctx) {
+        counts[item.id].fetch_add(1);
+        if (item.id < kNumItems) {
+          ctx.push(Item{item.priority + 1, item.id + kNumItems});
+        }
+      },
+      katana::wl<katana::MultiQueue<ItemIndexer>>(),
+      katana::disable_conflict_detection(), katana::loopname("MultiQueue"));
+
+  for (const auto& count : counts) {
+    KATANA_LOG_ASSERT(count.load() == 1);
+  }
+}
+
+/// Integer priorities through the default indexer
+void
+TestIntegerPriorities() {
+  std::vector<int> items(kNumItems);
+  std::iota(items.begin(), items.end(), 0);
+  std::atomic<int64_t> sum{0};
+
+  katana::for_each(
+      katana::iterate(items), [&](int x, auto&) { sum += x; },
+      katana::wl<katana::MultiQueue<>>(),
+      katana::disable_conflict_detection());
+
+  KATANA_LOG_ASSERT(sum.load() == int64_t{kNumItems} * (kNumItems - 1) / 2);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestSerialOrder<false>();
+  TestSerialOrder<true>();
+  TestForEach();
+  TestIntegerPriorities();
+
+  return 0;
+}
@@ -0,0 +1,201 @@
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "TestPropertyGraph.h"
+#include "katana/CommBackend.h"
+#include "katana/Logging.h"
+#include "katana/PartitionGraph.h"
+#include "katana/PropertyFileGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Uri.h"
+#include "tsuba/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr size_t kNumNodes = 100;
+constexpr uint32_t kNumPartitions = 4;
+
+std::shared_ptr<arrow::Table>
+MakeIdTable(const std::string& name, size_t size) {
+  katana::TableBuilder builder{size};
+
+  katana::ColumnOptions options;
+  options.name = name;
+  options.ascending_values = true;
+  builder.AddColumn<int64_t>(options);
+  return builder.Finish();
+}
+
+/// A graph whose node and edge properties are their ids
+std::unique_ptr<katana::PropertyFileGraph>
+MakeIdGraph() {
+  RandomPolicy policy{4};
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 1, &policy);
+
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeIdTable("node-id", g->num_nodes())));
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(MakeIdTable("edge-id", g->num_edges())));
+  return g;
+}
+
+std::vector<uint64_t>
+ToVector(const std::shared_ptr<arrow::ChunkedArray>& array) {
+  std::vector<uint64_t> ret;
+  for (const auto& chunk : array->chunks()) {
+    auto typed = std::static_pointer_cast<arrow::UInt64Array>(chunk);
+    for (int64_t i = 0; i < typed->length(); ++i) {
+      ret.emplace_back(typed->Value(i));
+    }
+  }
+  return ret;
+}
+
+void
+CheckPartitions(
+    katana::PropertyFileGraph* g,
+    const std::vector<std::unique_ptr<katana::PropertyFileGraph>>& parts) {
+  KATANA_LOG_ASSERT(parts.size() == kNumPartitions);
+
+  const auto* dests = g->topology().out_dests->raw_values();
+  std::vector<uint32_t> num_masters(g->num_nodes());
+  std::vector<uint32_t> num_copies(g->num_edges());
+
+  for (uint32_t p = 0; p < parts.size(); ++p) {
+    katana::PropertyFileGraph* part = parts[p].get();
+    const tsuba::PartitionMetadata& meta = part->partition_metadata();
+
+    KATANA_LOG_ASSERT(meta.num_global_nodes_ == g->num_nodes());
+    KATANA_LOG_ASSERT(meta.num_global_edges_ == g->num_edges());
+    KATANA_LOG_ASSERT(meta.num_nodes_ == part->num_nodes());
+    KATANA_LOG_ASSERT(meta.num_edges_ == part->num_edges());
+
+    std::vector<uint64_t> l2g = ToVector(part->local_to_global_vector());
+    KATANA_LOG_ASSERT(l2g.size() == part->num_nodes());
+
+    auto node_ids = std::static_pointer_cast<arrow::Int64Array>(
+        part->NodeProperty("node-id")->chunk(0));
+    for (uint32_t n = 0; n < part->num_nodes(); ++n) {
+      KATANA_LOG_ASSERT(node_ids->Value(n) == static_cast<int64_t>(l2g[n]));
+      if (n < meta.num_owned_) {
+        num_masters[l2g[n]]++;
+      }
+    }
+
+    // Every local edge is a copy of a global edge between the same endpoints
+    if (part->num_edges() > 0) {
+      auto edge_ids = std::static_pointer_cast<arrow::Int64Array>(
+          part->EdgeProperty("edge-id")->chunk(0));
+      const auto* local_dests = part->topology().out_dests->raw_values();
+      for (uint32_t n = 0; n < part->num_nodes(); ++n) {
+        for (auto e : part->edges(n)) {
+          auto global_edge = static_cast<uint64_t>(edge_ids->Value(e));
+          auto global_edges = g->edges(l2g[n]);
+          KATANA_LOG_ASSERT(
+              *global_edges.begin() <= global_edge &&
+              global_edge < *global_edges.end());
+          KATANA_LOG_ASSERT(dests[global_edge] == l2g[local_dests[e]]);
+          num_copies[global_edge]++;
+        }
+      }
+    }
+
+    // Mirrors of p owned by h are masters of h mirrored on p
+    KATANA_LOG_ASSERT(part->mirror_nodes().size() == parts.size());
+    KATANA_LOG_ASSERT(part->master_nodes().size() == parts.size());
+    for (uint32_t h = 0; h < parts.size(); ++h) {
+      KATANA_LOG_ASSERT(
+          ToVector(part->mirror_nodes()[h]) ==
+          ToVector(parts[h]->master_nodes()[p]));
+    }
+  }
+
+  for (uint32_t count : num_masters) {
+    KATANA_LOG_ASSERT(count == 1);
+  }
+  for (uint32_t count : num_copies) {
+    KATANA_LOG_ASSERT(count == 1);
+  }
+}
+
+void
+TestPolicy(katana::PartitionPolicy policy) {
+  auto g = MakeIdGraph();
+
+  auto parts_res = katana::PartitionGraph(g.get(), kNumPartitions, policy);
+  if (!parts_res) {
+    KATANA_LOG_FATAL("partitioning graph: {}", parts_res.error());
+  }
+  CheckPartitions(g.get(), parts_res.value());
+}
+
+void
+TestWriteAndLoad() {
+  auto g = MakeIdGraph();
+
+  auto parts_res = katana::PartitionGraph(
+      g.get(), kNumPartitions, katana::PartitionPolicy::kOutgoingEdgeCut);
+  if (!parts_res) {
+    KATANA_LOG_FATAL("partitioning graph: {}", parts_res.error());
+  }
+  const auto& parts = parts_res.value();
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/partition-graph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  if (auto res = katana::PropertyFileGraph::WritePartitions(
+          parts, rdg_dir, "partition-graph");
+      !res) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing partitions: {}", res.error());
+  }
+
+  // Load each partition as the host that owns it would
+  KATANA_LOG_ASSERT(tsuba::Fini());
+  for (uint32_t h = 0; h < kNumPartitions; ++h) {
+    katana::NullCommBackend comm;
+    comm.ID = h;
+    comm.Num = kNumPartitions;
+    KATANA_LOG_ASSERT(tsuba::Init(&comm));
+
+    auto load_res = katana::PropertyFileGraph::Make(rdg_dir);
+    if (!load_res) {
+      fs::remove_all(rdg_dir);
+      KATANA_LOG_FATAL("loading partition {}: {}", h, load_res.error());
+    }
+    auto loaded = std::move(load_res.value());
+
+    KATANA_LOG_ASSERT(loaded->topology().Equals(parts[h]->topology()));
+    KATANA_LOG_ASSERT(loaded->node_table()->Equals(*parts[h]->node_table()));
+    KATANA_LOG_ASSERT(loaded->edge_table()->Equals(*parts[h]->edge_table()));
+    KATANA_LOG_ASSERT(
+        ToVector(loaded->local_to_global_vector()) ==
+        ToVector(parts[h]->local_to_global_vector()));
+    KATANA_LOG_ASSERT(
+        loaded->partition_metadata().num_owned_ ==
+        parts[h]->partition_metadata().num_owned_);
+
+    loaded.reset();
+    KATANA_LOG_ASSERT(tsuba::Fini());
+  }
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  fs::remove_all(rdg_dir);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestPolicy(katana::PartitionPolicy::kOutgoingEdgeCut);
+  TestPolicy(katana::PartitionPolicy::kIncomingEdgeCut);
+  TestPolicy(katana::PartitionPolicy::kCartesianVertexCut);
+  TestWriteAndLoad();
+
+  return 0;
+}
@@ -239,6 +239,192 @@ TestTopologyAccess() {
   KATANA_LOG_ASSERT(n_nodes == 10);
 }
 
+void
+TestMakeSlice() {
+  constexpr size_t num_nodes = 10;
+  constexpr size_t num_edges = 30;
+  constexpr uint64_t node_begin = 3;
+  constexpr uint64_t node_end = 7;
+
+  // Some edges of the nodes in the slice leave it, e.g., 6 -> 7, and must be
+  // kept
+  LinePolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 1, &policy);
+
+  // Properties whose values are the original node and edge ids
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeTable<int32_t>("node-id", num_nodes)));
+  KATANA_LOG_ASSERT(g->MarkNodePropertiesPersistent({"", "node-id"}));
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(MakeTable<int32_t>("edge-id", num_edges)));
+  KATANA_LOG_ASSERT(g->MarkEdgePropertiesPersistent({"", "edge-id"}));
+
+  auto uri_res = katana::Uri::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  std::string rdg_dir(uri_res.value().path());  // path() because local
+
+  auto write_result = g->Write(rdg_dir, command_line);
+  if (!write_result) {
+    fs::remove_all(rdg_dir);
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  auto bad_range_result = katana::PropertyFileGraph::MakeSlice(
+      rdg_dir, node_begin, num_nodes + 1, {"node-id"}, {"edge-id"});
+  KATANA_LOG_ASSERT(!bad_range_result);
+
+  auto slice_result = katana::PropertyFileGraph::MakeSlice(
+      rdg_dir, node_begin, node_end, {"node-id"}, {"edge-id"});
+  fs::remove_all(rdg_dir);
+  if (!slice_result) {
+    KATANA_LOG_FATAL("making slice: {}", slice_result.error());
+  }
+  std::unique_ptr<katana::PropertyFileGraph> slice =
+      std::move(slice_result.value());
+
+  constexpr uint64_t num_slice_nodes = node_end - node_begin;
+  KATANA_LOG_ASSERT(slice->num_nodes() > num_slice_nodes);
+  KATANA_LOG_ASSERT(slice->node_schema()->num_fields() == 1);
+  KATANA_LOG_ASSERT(slice->edge_schema()->num_fields() == 1);
+
+  auto node_ids = std::static_pointer_cast<arrow::Int32Array>(
+      slice->NodeProperty(0)->chunk(0));
+  auto edge_ids = std::static_pointer_cast<arrow::Int32Array>(
+      slice->EdgeProperty(0)->chunk(0));
+  auto l2g = std::static_pointer_cast<arrow::UInt64Array>(
+      slice->local_to_global_vector()->chunk(0));
+  KATANA_LOG_ASSERT(static_cast<uint64_t>(l2g->length()) == slice->num_nodes());
+
+  const auto* dests = g->topology().out_dests->raw_values();
+  const auto* slice_dests = slice->topology().out_dests->raw_values();
+
+  uint64_t slice_edge = 0;
+  uint64_t num_crossing = 0;
+  for (uint64_t n = 0; n < num_slice_nodes; ++n) {
+    uint64_t original = n + node_begin;
+    KATANA_LOG_ASSERT(node_ids->Value(n) == static_cast<int32_t>(original));
+    KATANA_LOG_ASSERT(l2g->Value(n) == original);
+
+    // The slice keeps every edge of original, in its original order, and its
+    // destination is a node of the slice that maps to the original one
+    KATANA_LOG_ASSERT(*slice->edges(n).begin() == slice_edge);
+    for (auto e : g->edges(original)) {
+      KATANA_LOG_ASSERT(slice_dests[slice_edge] < slice->num_nodes());
+      KATANA_LOG_ASSERT(l2g->Value(slice_dests[slice_edge]) == dests[e]);
+      KATANA_LOG_ASSERT(
+          edge_ids->Value(slice_edge) == static_cast<int32_t>(e));
+      num_crossing += dests[e] < node_begin || dests[e] >= node_end;
+      ++slice_edge;
+    }
+  }
+  KATANA_LOG_ASSERT(num_crossing > 0);
+  KATANA_LOG_ASSERT(slice_edge == slice->num_edges());
+
+  // Mirrors follow the nodes of the slice in increasing global ID order, with
+  // no edges and null properties
+  for (uint64_t n = num_slice_nodes; n < slice->num_nodes(); ++n) {
+    KATANA_LOG_ASSERT(l2g->Value(n) < node_begin || l2g->Value(n) >= node_end);
+    KATANA_LOG_ASSERT(
+        n == num_slice_nodes || l2g->Value(n - 1) < l2g->Value(n));
+    KATANA_LOG_ASSERT(slice->edges(n).empty());
+    KATANA_LOG_ASSERT(node_ids->IsNull(n));
+  }
+}
+
+void
+TestSubgraphs() {
+  constexpr size_t num_nodes = 10;
+  constexpr size_t num_edges = 30;
+
+  LinePolicy policy{3};
+  auto g = MakeFileGraph<uint32_t>(num_nodes, 1, &policy);
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeTable<int32_t>("node-id", num_nodes)));
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(MakeTable<int32_t>("edge-id", num_edges)));
+  const auto* dests = g->topology().out_dests->raw_values();
+
+  KATANA_LOG_ASSERT(!g->InducedSubgraph(std::vector<bool>(num_nodes + 1)));
+  KATANA_LOG_ASSERT(!g->InducedSubgraph(
+      std::vector<katana::PropertyFileGraph::Node>{num_nodes}));
+  KATANA_LOG_ASSERT(!g->EdgeFilteredSubgraph(std::vector<bool>(num_edges - 1)));
+
+  // Every other node, listed out of order and with duplicates
+  std::vector<katana::PropertyFileGraph::Node> node_list{8, 0, 4, 2, 6, 0};
+  auto induced_result = g->InducedSubgraph(node_list);
+  if (!induced_result) {
+    KATANA_LOG_FATAL("making induced subgraph: {}", induced_result.error());
+  }
+  std::unique_ptr<katana::PropertyFileGraph> induced =
+      std::move(induced_result.value());
+
+  KATANA_LOG_ASSERT(induced->num_nodes() == 5);
+  auto node_ids = std::static_pointer_cast<arrow::Int32Array>(
+      induced->NodeProperty("node-id")->chunk(0));
+  auto edge_ids = std::static_pointer_cast<arrow::Int32Array>(
+      induced->EdgeProperty("edge-id")->chunk(0));
+  auto l2g = std::static_pointer_cast<arrow::UInt64Array>(
+      induced->local_to_global_vector()->chunk(0));
+  const auto* induced_dests = induced->topology().out_dests->raw_values();
+
+  uint64_t induced_edge = 0;
+  for (uint64_t n = 0; n < induced->num_nodes(); ++n) {
+    uint64_t original = 2 * n;
+    KATANA_LOG_ASSERT(node_ids->Value(n) == static_cast<int32_t>(original));
+    KATANA_LOG_ASSERT(l2g->Value(n) == original);
+    for (auto e : g->edges(original)) {
+      if (dests[e] % 2 != 0) {
+        continue;
+      }
+      KATANA_LOG_ASSERT(induced_dests[induced_edge] == dests[e] / 2);
+      KATANA_LOG_ASSERT(
+          edge_ids->Value(induced_edge) == static_cast<int32_t>(e));
+      ++induced_edge;
+    }
+  }
+  KATANA_LOG_ASSERT(induced_edge == induced->num_edges());
+
+  // Subgraphs of subgraphs map back to the IDs of the first graph
+  auto nested_result = induced->InducedSubgraph(
+      std::vector<bool>{false, true, true, false, true});
+  KATANA_LOG_ASSERT(nested_result);
+  auto nested_l2g = std::static_pointer_cast<arrow::UInt64Array>(
+      nested_result.value()->local_to_global_vector()->chunk(0));
+  KATANA_LOG_ASSERT(nested_l2g->length() == 3);
+  KATANA_LOG_ASSERT(nested_l2g->Value(0) == 2);
+  KATANA_LOG_ASSERT(nested_l2g->Value(1) == 4);
+  KATANA_LOG_ASSERT(nested_l2g->Value(2) == 8);
+
+  // Drop the first edge of every node
+  std::vector<bool> edge_mask(num_edges, true);
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    edge_mask[*g->edges(n).begin()] = false;
+  }
+  auto filtered_result = g->EdgeFilteredSubgraph(edge_mask);
+  if (!filtered_result) {
+    KATANA_LOG_FATAL(
+        "making edge filtered subgraph: {}", filtered_result.error());
+  }
+  std::unique_ptr<katana::PropertyFileGraph> filtered =
+      std::move(filtered_result.value());
+
+  KATANA_LOG_ASSERT(filtered->num_nodes() == num_nodes);
+  KATANA_LOG_ASSERT(filtered->num_edges() == num_edges - num_nodes);
+  KATANA_LOG_ASSERT(filtered->NodeProperty("node-id")->Equals(
+      g->NodeProperty("node-id")));
+  edge_ids = std::static_pointer_cast<arrow::Int32Array>(
+      filtered->EdgeProperty("edge-id")->chunk(0));
+  const auto* filtered_dests = filtered->topology().out_dests->raw_values();
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    KATANA_LOG_ASSERT(filtered->edges(n).size() == 2);
+    for (auto e : filtered->edges(n)) {
+      uint64_t original = edge_ids->Value(e);
+      KATANA_LOG_ASSERT(edge_mask[original]);
+      KATANA_LOG_ASSERT(filtered_dests[e] == dests[original]);
+    }
+  }
+}
+
 int
 main(int argc, char** argv) {
   katana::SharedMemSys sys;
@@ -255,6 +441,8 @@ main(int argc, char** argv) {
   TestGarbageMetadata();
   TestSimplePGs();
   TestTopologyAccess();
+  TestMakeSlice();
+  TestSubgraphs();
 
   return 0;
 }
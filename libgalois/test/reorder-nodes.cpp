@@ -0,0 +1,187 @@
+#include <arrow/api.h>
+
+#include "TestPropertyGraph.h"
+#include "katana/Logging.h"
+#include "katana/PropertyFileGraph.h"
+#include "katana/ReorderNodes.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+constexpr size_t kNumNodes = 100;
+
+std::shared_ptr<arrow::Table>
+MakeIdTable(const std::string& name, size_t size) {
+  katana::TableBuilder builder{size};
+
+  katana::ColumnOptions options;
+  options.name = name;
+  options.ascending_values = true;
+  builder.AddColumn<int64_t>(options);
+  return builder.Finish();
+}
+
+/// A graph whose node and edge properties are their ids
+std::unique_ptr<katana::PropertyFileGraph>
+MakeIdGraph(Policy* policy) {
+  auto g = MakeFileGraph<uint32_t>(kNumNodes, 0, policy);
+
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(MakeIdTable("node-id", g->num_nodes())));
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(MakeIdTable("edge-id", g->num_edges())));
+  return g;
+}
+
+/// Check that reordered is original with its nodes renumbered by new_to_old
+void
+CheckReordered(
+    const katana::PropertyFileGraph& original,
+    const katana::PropertyFileGraph& reordered,
+    const std::shared_ptr<arrow::UInt64Array>& new_to_old) {
+  uint64_t num_nodes = original.num_nodes();
+  KATANA_LOG_ASSERT(reordered.num_nodes() == num_nodes);
+  KATANA_LOG_ASSERT(reordered.num_edges() == original.num_edges());
+  KATANA_LOG_ASSERT(static_cast<uint64_t>(new_to_old->length()) == num_nodes);
+
+  std::vector<uint64_t> old_to_new(num_nodes, num_nodes);
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    uint64_t old = new_to_old->Value(n);
+    KATANA_LOG_ASSERT(old < num_nodes && old_to_new[old] == num_nodes);
+    old_to_new[old] = n;
+  }
+
+  auto node_ids = std::static_pointer_cast<arrow::Int64Array>(
+      reordered.NodeProperty("node-id")->chunk(0));
+  auto edge_ids = std::static_pointer_cast<arrow::Int64Array>(
+      reordered.EdgeProperty("edge-id")->chunk(0));
+  auto l2g = std::static_pointer_cast<arrow::UInt64Array>(
+      reordered.local_to_global_vector()->chunk(0));
+  const auto* dests = original.topology().out_dests->raw_values();
+  const auto* new_dests = reordered.topology().out_dests->raw_values();
+
+  for (uint64_t n = 0; n < num_nodes; ++n) {
+    uint64_t old = new_to_old->Value(n);
+    KATANA_LOG_ASSERT(node_ids->Value(n) == static_cast<int64_t>(old));
+    KATANA_LOG_ASSERT(l2g->Value(n) == old);
+
+    // Each node keeps its edges, in their original order
+    auto old_edges = original.edges(old);
+    KATANA_LOG_ASSERT(reordered.edges(n).size() == old_edges.size());
+    auto old_edge = old_edges.begin();
+    for (auto e : reordered.edges(n)) {
+      KATANA_LOG_ASSERT(edge_ids->Value(e) == static_cast<int64_t>(*old_edge));
+      KATANA_LOG_ASSERT(new_dests[e] == old_to_new[dests[*old_edge]]);
+      ++old_edge;
+    }
+  }
+}
+
+void
+TestPlans() {
+  LinePolicy line{3};
+  RandomPolicy random{4};
+  for (Policy* policy : std::vector<Policy*>{&line, &random}) {
+    for (auto plan :
+         {katana::ReorderPlan::DegreeGrouping(),
+          katana::ReorderPlan::BreadthFirst(),
+          katana::ReorderPlan::ReverseCuthillMcKee(),
+          katana::ReorderPlan::Gorder(), katana::ReorderPlan::Community()}) {
+      auto original = MakeIdGraph(policy);
+      auto g = MakeIdGraph(policy);
+      // RandomPolicy draws new neighbors for each graph
+      KATANA_LOG_ASSERT(g->SetTopology(original->topology()));
+
+      auto reorder_result = katana::ReorderNodes(g.get(), plan);
+      if (!reorder_result) {
+        KATANA_LOG_FATAL(
+            "reordering with plan {}: {}", static_cast<int>(plan.algorithm()),
+            reorder_result.error());
+      }
+      CheckReordered(*original, *g, reorder_result.value());
+
+      // Results on the reordered graph map back to the original nodes
+      auto restored_result = katana::RestoreNodeOrder(
+          g->NodeProperty("node-id"), reorder_result.value());
+      KATANA_LOG_ASSERT(restored_result);
+      KATANA_LOG_ASSERT(
+          restored_result.value()->Equals(original->NodeProperty("node-id")));
+    }
+  }
+}
+
+void
+TestReverseCuthillMcKee() {
+  // A ring, whose bandwidth is at most 2 in Cuthill-McKee order, with nodes
+  // numbered so that neighbors are far apart
+  constexpr uint32_t kStride = 37;
+  std::vector<uint32_t> position(kNumNodes);
+  for (uint32_t i = 0; i < kNumNodes; ++i) {
+    position[i * kStride % kNumNodes] = i;
+  }
+  std::vector<uint64_t> indices;
+  std::vector<uint32_t> dests;
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    uint32_t p = position[n];
+    dests.emplace_back((p + 1) % kNumNodes * kStride % kNumNodes);
+    dests.emplace_back((p + kNumNodes - 1) % kNumNodes * kStride % kNumNodes);
+    indices.emplace_back(dests.size());
+  }
+
+  katana::PropertyFileGraph g;
+  KATANA_LOG_ASSERT(g.SetTopology(katana::GraphTopology{
+      .out_indices = std::static_pointer_cast<arrow::UInt64Array>(
+          katana::BuildArray(indices)),
+      .out_dests = std::static_pointer_cast<arrow::UInt32Array>(
+          katana::BuildArray(dests)),
+  }));
+
+  KATANA_LOG_ASSERT(
+      katana::ReorderNodes(&g, katana::ReorderPlan::ReverseCuthillMcKee()));
+  const auto* new_dests = g.topology().out_dests->raw_values();
+  for (uint32_t n = 0; n < kNumNodes; ++n) {
+    for (auto e : g.edges(n)) {
+      uint32_t gap = new_dests[e] > n ? new_dests[e] - n : n - new_dests[e];
+      KATANA_LOG_ASSERT(gap <= 2);
+    }
+  }
+}
+
+void
+TestComposition() {
+  LinePolicy policy{3};
+  auto g = MakeIdGraph(&policy);
+  KATANA_LOG_ASSERT(
+      katana::ReorderNodes(g.get(), katana::ReorderPlan::Gorder()));
+  KATANA_LOG_ASSERT(
+      katana::ReorderNodes(g.get(), katana::ReorderPlan::Community()));
+
+  // local_to_global_vector() still maps to the IDs of the first graph
+  auto node_ids = std::static_pointer_cast<arrow::Int64Array>(
+      g->NodeProperty("node-id")->chunk(0));
+  auto l2g = std::static_pointer_cast<arrow::UInt64Array>(
+      g->local_to_global_vector()->chunk(0));
+  for (uint64_t n = 0; n < g->num_nodes(); ++n) {
+    KATANA_LOG_ASSERT(
+        l2g->Value(n) == static_cast<uint64_t>(node_ids->Value(n)));
+  }
+
+  // Partitions keep their masters first
+  tsuba::PartitionMetadata meta = g->partition_metadata();
+  meta.policy_id_ = 1;
+  g->set_partition_metadata(meta);
+  KATANA_LOG_ASSERT(!katana::ReorderNodes(g.get()));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  TestPlans();
+  TestReverseCuthillMcKee();
+  TestComposition();
+
+  return 0;
+}
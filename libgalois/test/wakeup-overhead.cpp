@@ -20,6 +20,7 @@
 #include <chrono>
 #include <cmath>
 #include <iostream>
+#include <thread>
 #include <vector>
 
 #include <boost/iterator/counting_iterator.hpp>
@@ -41,6 +42,9 @@ static cll::opt<int> trials(
     "trials", cll::desc("number of trials"), cll::init(1));
 static cll::opt<unsigned> threads(
     "threads", cll::desc("number of threads"), cll::init(2));
+static cll::opt<int> idle(
+    "idle", cll::desc("microseconds between loops of DoAllIdle"),
+    cll::init(200));
 
 void
 runDoAllBurn(int num) {
@@ -64,6 +68,18 @@ runDoAll(int num) {
   }
 }
 
+//! Idle between loops, for longer than threads spin by default, so that the
+//! loop statistics show the latency of waking parked threads
+void
+runDoAllIdle(int num) {
+  for (int r = 0; r < rounds / 10; ++r) {
+    katana::do_all(
+        katana::iterate(0, num), [&](int) { asm volatile("" ::: "memory"); },
+        katana::loopname("DoAllIdle"));
+    std::this_thread::sleep_for(std::chrono::microseconds(idle));
+  }
+}
+
 void
 runExplicitThread(int num) {
   katana::Barrier& barrier = katana::GetBarrier(katana::getActiveThreads());
@@ -111,13 +127,15 @@ main(int argc, char* argv[]) {
   for (int t = 0; t < trials; ++t) {
     run(runDoAll, "DoAll");
     run(runDoAllBurn, "DoAllBurn");
+    run(runDoAllIdle, "DoAllIdle");
     run(runExplicitThread, "ExplicitThread");
   }
   EXIT = 1;
 
   std::cout << "threads: " << katana::getActiveThreads() << " usable threads: "
             << katana::GetThreadPool().getMaxUsableThreads()
-            << " rounds: " << rounds << " size: " << size << "\n";
+            << " rounds: " << rounds << " size: " << size << " spin budget: "
+            << katana::GetThreadPool().getSpinBudgetNs() << "ns\n";
 
   return 0;
 }
@@ -0,0 +1,83 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_TRACE_H_
+#define KATANA_LIBSUPPORT_KATANA_TRACE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "katana/Result.h"
+#include "katana/config.h"
+
+/// \file Trace.h
+///
+/// Timeline tracing of spans of time, e.g., each thread's part of a parallel
+/// loop, in the Chrome trace event format, which chrome://tracing and
+/// https://ui.perfetto.dev display as one timeline per thread.
+///
+/// Tracing is off unless the environment variable KATANA_TRACE_FILE is set
+/// when tracing is first used, in which case the trace is written to the file
+/// it names when the program exits. Each thread records its spans in its own
+/// ring buffer, without locks, holding the last KATANA_TRACE_BUFFER_EVENTS
+/// spans (default 65536); older spans are dropped.
+
+namespace katana {
+
+/// Return true if tracing is enabled.
+KATANA_EXPORT bool IsTraceEnabled();
+
+/// Return the time in nanoseconds on the clock of the trace.
+KATANA_EXPORT uint64_t TraceNow();
+
+/// Record a span of time from begin to end, on the clock of the trace, for
+/// the calling thread. name and category must remain valid until the trace
+/// is written, e.g., string literals or loop names. Does nothing if tracing is
+/// disabled.
+KATANA_EXPORT void TraceSpan(
+    const char* name, const char* category, uint64_t begin, uint64_t end);
+
+/// Name the timeline of the calling thread in the trace. Does nothing if
+/// tracing is disabled.
+KATANA_EXPORT void SetTraceThreadName(const std::string& name);
+
+/// Write the spans recorded so far to path in the Chrome trace event format.
+/// This is done automatically at exit if KATANA_TRACE_FILE is set.
+KATANA_EXPORT Result<void> WriteTrace(const std::string& path);
+
+/// Records a span from its construction to its destruction.
+///
+///     {
+///       katana::TraceScope scope("Load", "tsuba");
+///       ...
+///     }
+class TraceScope {
+public:
+  TraceScope(const char* name, const char* category)
+      : name_(name),
+        category_(category),
+        enabled_(IsTraceEnabled()),
+        begin_(enabled_ ? TraceNow() : 0) {}
+
+  ~TraceScope() {
+    if (enabled_) {
+      TraceSpan(name_, category_, begin_, TraceNow());
+    }
+  }
+
+  /// Do not record the span, e.g., because the attempt it times failed and
+  /// recording every failed attempt would flood the trace.
+  void Dismiss() { enabled_ = false; }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+  TraceScope(TraceScope&&) = delete;
+  TraceScope& operator=(TraceScope&&) = delete;
+
+private:
+  const char* name_;
+  const char* category_;
+  bool enabled_;
+  uint64_t begin_;
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,277 @@
+#include "katana/Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+
+namespace {
+
+struct TraceEvent {
+  const char* name;
+  const char* category;
+  uint64_t begin;
+  uint64_t end;
+};
+
+/// The spans of one thread at a time. Only the owning thread appends, so
+/// appends need no locks. Readers may copy the events while the owner appends
+/// (see Snapshot), so the fields of the events are atomics.
+class TraceBuffer {
+public:
+  TraceBuffer(uint32_t id, uint64_t capacity) : id_(id), slots_(capacity) {}
+
+  void Append(const TraceEvent& event) {
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[count % slots_.size()];
+    // Order the stores to the slot after the count of any earlier event, so
+    // that a reader that sees them also sees that count (see Snapshot)
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.category.store(event.category, std::memory_order_relaxed);
+    slot.begin.store(event.begin, std::memory_order_relaxed);
+    slot.end.store(event.end, std::memory_order_relaxed);
+    count_.store(count + 1, std::memory_order_release);
+  }
+
+  /// Copy the events still in the buffer to events, oldest first, and return
+  /// the number of events appended so far. Events that the owner overwrites
+  /// while they are copied are left out, like events older than the capacity.
+  uint64_t Snapshot(std::vector<TraceEvent>* events) const {
+    uint64_t capacity = slots_.size();
+    uint64_t count = count_.load(std::memory_order_acquire);
+    uint64_t first = count > capacity ? count - capacity : 0;
+    std::vector<TraceEvent> copy;
+    for (uint64_t i = first; i < count; ++i) {
+      const Slot& slot = slots_[i % capacity];
+      copy.emplace_back(TraceEvent{
+          slot.name.load(std::memory_order_relaxed),
+          slot.category.load(std::memory_order_relaxed),
+          slot.begin.load(std::memory_order_relaxed),
+          slot.end.load(std::memory_order_relaxed)});
+    }
+    // Sequence check: the slot of event i is reused by event i + capacity, so
+    // event i is intact if no event after i + capacity - 1 had started
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t after = count_.load(std::memory_order_relaxed);
+    uint64_t intact = after >= capacity ? after - capacity + 1 : 0;
+    uint64_t skip =
+        intact > first ? std::min(intact - first, count - first) : 0;
+    events->assign(copy.begin() + skip, copy.end());
+    return count;
+  }
+
+  uint32_t id() const { return id_; }
+
+  /// Guarded by the lock of the Tracer
+  std::string name;
+
+private:
+  struct Slot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<const char*> category{nullptr};
+    std::atomic<uint64_t> begin{0};
+    std::atomic<uint64_t> end{0};
+  };
+
+  uint32_t id_;
+  std::vector<Slot> slots_;
+  std::atomic<uint64_t> count_{0};
+};
+
+class Tracer {
+public:
+  Tracer() : epoch_(std::chrono::steady_clock::now()) {
+    std::string path;
+    enabled_ = katana::GetEnv("KATANA_TRACE_FILE", &path) && !path.empty();
+    int capacity = 0;
+    if (katana::GetEnv("KATANA_TRACE_BUFFER_EVENTS", &capacity) &&
+        capacity > 0) {
+      capacity_ = capacity;
+    }
+  }
+
+  ~Tracer() {
+    // Read the path again so that it can be changed or unset before exit
+    std::string path;
+    if (!enabled_ || !katana::GetEnv("KATANA_TRACE_FILE", &path) ||
+        path.empty()) {
+      return;
+    }
+    if (auto r = Write(path); !r) {
+      KATANA_LOG_ERROR("writing trace to {}: {}", path, r.error());
+    }
+  }
+
+  Tracer(const Tracer&) = delete;
+  Tracer& operator=(const Tracer&) = delete;
+  Tracer(Tracer&&) = delete;
+  Tracer& operator=(Tracer&&) = delete;
+
+  bool enabled() const { return enabled_; }
+
+  uint64_t Now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch_)
+        .count();
+  }
+
+  /// Get a buffer for a new thread, reusing the buffers of threads that have
+  /// exited so that short-lived threads, e.g., of std::async, share timelines
+  /// instead of each allocating a buffer.
+  TraceBuffer* Acquire() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_.empty()) {
+      TraceBuffer* buffer = free_.back();
+      free_.pop_back();
+      return buffer;
+    }
+    buffers_.emplace_back(
+        std::make_unique<TraceBuffer>(buffers_.size(), capacity_));
+    return buffers_.back().get();
+  }
+
+  void Release(TraceBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.emplace_back(buffer);
+  }
+
+  void SetName(TraceBuffer* buffer, const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer->name = name;
+  }
+
+  katana::Result<void> Write(const std::string& path);
+
+private:
+  std::chrono::steady_clock::time_point epoch_;
+  bool enabled_{false};
+  uint64_t capacity_{uint64_t{1} << 16};
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers_;
+  std::vector<TraceBuffer*> free_;
+};
+
+Tracer&
+GetTracer() {
+  static Tracer tracer;
+  return tracer;
+}
+
+/// The buffer of this thread, which is returned to the Tracer when the thread
+/// exits.
+class ThreadBuffer {
+public:
+  ~ThreadBuffer() {
+    if (buffer_) {
+      GetTracer().Release(buffer_);
+    }
+  }
+
+  TraceBuffer* get() {
+    if (!buffer_) {
+      buffer_ = GetTracer().Acquire();
+    }
+    return buffer_;
+  }
+
+private:
+  TraceBuffer* buffer_{nullptr};
+};
+
+thread_local ThreadBuffer kThreadBuffer;
+
+std::string
+Quote(const char* s) {
+  return nlohmann::json(s).dump();
+}
+
+katana::Result<void>
+Tracer::Write(const std::string& path) {
+  std::ofstream out(path);
+  if (!out) {
+    return katana::ResultErrno();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t dropped = 0;
+  out << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const auto& buffer : buffers_) {
+    std::string name = buffer->name.empty()
+                           ? fmt::format("thread {}", buffer->id())
+                           : buffer->name;
+    out << separator
+        << fmt::format(
+               "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+               "\"tid\":{},\"args\":{{\"name\":{}}}}}",
+               buffer->id(), Quote(name.c_str()));
+    separator = ",\n";
+
+    std::vector<TraceEvent> events;
+    dropped += buffer->Snapshot(&events) - events.size();
+    for (const TraceEvent& event : events) {
+      // Timestamps are in microseconds
+      out << separator
+          << fmt::format(
+                 "{{\"name\":{},\"cat\":{},\"ph\":\"X\",\"pid\":0,\"tid\":{},"
+                 "\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                 Quote(event.name), Quote(event.category), buffer->id(),
+                 event.begin / 1e3, (event.end - event.begin) / 1e3);
+    }
+  }
+  out << fmt::format(
+      "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{{\"dropped_events\":{}}}}}"
+      "\n",
+      dropped);
+
+  out.close();
+  if (!out) {
+    return katana::ResultErrno();
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+bool
+katana::IsTraceEnabled() {
+  return GetTracer().enabled();
+}
+
+uint64_t
+katana::TraceNow() {
+  return GetTracer().Now();
+}
+
+void
+katana::TraceSpan(
+    const char* name, const char* category, uint64_t begin, uint64_t end) {
+  if (!IsTraceEnabled()) {
+    return;
+  }
+  kThreadBuffer.get()->Append(TraceEvent{name, category, begin, end});
+}
+
+void
+katana::SetTraceThreadName(const std::string& name) {
+  if (!IsTraceEnabled()) {
+    return;
+  }
+  GetTracer().SetName(kThreadBuffer.get(), name);
+}
+
+katana::Result<void>
+katana::WriteTrace(const std::string& path) {
+  return GetTracer().Write(path);
+}
@@ -0,0 +1,92 @@
+#include "katana/Trace.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Random.h"
+
+int
+main() {
+  std::string path = "/tmp/katana-trace-" +
+                     katana::RandomAlphanumericString(12) + ".json";
+  // Tracing is configured on first use
+  KATANA_LOG_ASSERT(katana::SetEnv("KATANA_TRACE_FILE", path, true));
+  KATANA_LOG_ASSERT(katana::SetEnv("KATANA_TRACE_BUFFER_EVENTS", "8", true));
+  KATANA_LOG_ASSERT(katana::IsTraceEnabled());
+
+  katana::SetTraceThreadName("main");
+  { katana::TraceScope scope("outer", "test"); }
+  {
+    katana::TraceScope scope("dismissed", "test");
+    scope.Dismiss();
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 10; ++j) {
+        katana::TraceScope scope("inner", "test");
+      }
+    });
+  }
+  for (std::thread& t : threads) {
+    t.join();
+  }
+
+  KATANA_LOG_ASSERT(katana::WriteTrace(path));
+
+  std::ifstream in(path);
+  auto trace = nlohmann::json::parse(in);
+  std::map<std::string, int> counts;
+  bool named_main = false;
+  for (const auto& event : trace["traceEvents"]) {
+    if (event["ph"] == "M") {
+      named_main = named_main || event["args"]["name"] == "main";
+      continue;
+    }
+    KATANA_LOG_ASSERT(event["ph"] == "X");
+    KATANA_LOG_ASSERT(event["dur"].get<double>() >= 0);
+    counts[event["name"].get<std::string>()] += 1;
+  }
+  KATANA_LOG_ASSERT(named_main);
+  KATANA_LOG_ASSERT(counts["outer"] == 1);
+  KATANA_LOG_ASSERT(counts.count("dismissed") == 0);
+  // Each buffer keeps only its last 8 spans, and threads reuse the buffers of
+  // threads that exited before them, possibly all the same one
+  KATANA_LOG_ASSERT(counts["inner"] >= 7 && counts["inner"] <= 32);
+  KATANA_LOG_ASSERT(
+      trace["otherData"]["dropped_events"].get<int>() == 40 - counts["inner"]);
+
+  // The trace can be written while other threads record spans
+  std::atomic<bool> done{false};
+  std::thread recorder([&done]() {
+    while (!done.load()) {
+      katana::TraceScope scope("concurrent", "test");
+    }
+  });
+  for (int i = 0; i < 100; ++i) {
+    KATANA_LOG_ASSERT(katana::WriteTrace(path));
+    std::ifstream concurrent_in(path);
+    auto concurrent_trace = nlohmann::json::parse(concurrent_in);
+    for (const auto& event : concurrent_trace["traceEvents"]) {
+      if (event["ph"] == "X") {
+        KATANA_LOG_ASSERT(event["dur"].get<double>() >= 0);
+      }
+    }
+  }
+  done.store(true);
+  recorder.join();
+
+  KATANA_LOG_ASSERT(katana::UnsetEnv("KATANA_TRACE_FILE"));
+  std::remove(path.c_str());
+  return 0;
+}
@@ -48,6 +48,11 @@ public:
   /// to the LocalStorage when no protocol on the URI is provided
   virtual uint32_t Priority() const { return 0; }
 
+  /// Reads from storage classes that are cacheable may be served from the
+  /// local block cache (see KATANA_TSUBA_CACHE_DIR). Backends that are
+  /// already local should return false.
+  virtual bool Cacheable() const { return true; }
+
   // get on future can potentially block (bulk synchronous parallel)
   virtual std::future<katana::Result<void>> PutAsync(
       const std::string& uri, const uint8_t* data, uint64_t size) = 0;
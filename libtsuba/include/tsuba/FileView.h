@@ -26,6 +26,7 @@ class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
   int64_t cursor_{0};
   int64_t mem_start_{0};
   std::string filename_;
+  std::string version_;
   bool valid_{false};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
@@ -42,6 +43,7 @@ public:
         cursor_(other.cursor_),
         mem_start_(other.mem_start_),
         filename_(std::move(other.filename_)),
+        version_(std::move(other.version_)),
         valid_(other.valid_),
         filling_(std::move(other.filling_)),
         fetches_(std::move(other.fetches_)) {
@@ -59,6 +61,7 @@ public:
       cursor_ = other.cursor_;
       mem_start_ = other.mem_start_;
       filename_ = std::move(other.filename_);
+      version_ = std::move(other.version_);
       valid_ = other.valid_;
       filling_ = std::move(other.filling_);
       fetches_ =
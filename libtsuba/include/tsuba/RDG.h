@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <arrow/api.h>
 #include <arrow/chunked_array.h>
@@ -49,6 +50,16 @@ public:
       RDGHandle handle, const std::string& command_line,
       std::unique_ptr<FileFrame> ff = nullptr);
 
+  /// Store \param partitions as the partitions of a new version of the RDG at
+  /// \param handle; partitions[i] becomes the partition of host i. This lets
+  /// a single process write a graph that is loaded by partitions.size()
+  /// hosts. Each non-null element of \param topologies is persisted as the
+  /// topology of the corresponding partition.
+  static katana::Result<void> StorePartitions(
+      RDGHandle handle, const std::string& command_line,
+      const std::vector<RDG*>& partitions,
+      std::vector<std::unique_ptr<FileFrame>>&& topologies);
+
   katana::Result<void> AddNodeProperties(
       const std::shared_ptr<arrow::Table>& table);
 
@@ -127,6 +138,11 @@ public:
   const PartitionMetadata& part_metadata() const;
   void set_part_metadata(const PartitionMetadata& metadata);
 
+  /// A summary of the topology that is stored with the partition so that it
+  /// need not be recomputed when the RDG is loaded again, or the empty string
+  const std::string& graph_profile() const;
+  void set_graph_profile(std::string graph_profile);
+
   const FileView& topology_file_storage() const;
 
 private:
@@ -146,6 +162,14 @@ private:
   katana::Result<std::vector<tsuba::PropStorageInfo>> WritePartArrays(
       const katana::Uri& dir, tsuba::WriteGroup* desc);
 
+  void StoreTopology(
+      RDGHandle handle, std::unique_ptr<FileFrame> ff, WriteGroup* desc);
+
+  /// Write the data of this RDG as the partition of \param host_id without
+  /// committing a new version
+  katana::Result<void> DoStorePartition(
+      RDGHandle handle, uint32_t host_id, WriteGroup* desc);
+
   katana::Result<void> DoStore(
       RDGHandle handle, const std::string& command_line,
       std::unique_ptr<WriteGroup> desc);
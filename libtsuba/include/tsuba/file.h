@@ -29,6 +29,9 @@ RoundUpToBlock(T val) {
 
 struct StatBuf {
   uint64_t size{UINT64_C(0)};
+  /// Opaque token that changes whenever the contents of the file change
+  /// (e.g., an ETag or modification time); empty if the backend has none
+  std::string version;
 };
 
 // Returns an error file filename does not exist
@@ -0,0 +1,441 @@
+#include "BlockCache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "GlobalState.h"
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/Trace.h"
+#include "tsuba/Errors.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr int kDefaultCapacityMB = 10 << 10; /* 10G */
+constexpr const char* kTmpMarker = ".tmp.";
+
+uint64_t
+HashBytes(uint64_t hash, const std::string& bytes) {
+  // FNV-1a
+  for (char c : bytes) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= UINT64_C(0x100000001b3);
+  }
+  return hash;
+}
+
+std::string
+BlockPath(const std::string& object_dir, uint64_t block) {
+  return fmt::format("{}/{:016x}", object_dir, block);
+}
+
+bool
+IsTmpFile(const std::string& name) {
+  return name.find(kTmpMarker) != std::string::npos;
+}
+
+}  // namespace
+
+tsuba::BlockCache::~BlockCache() {
+  KATANA_LOG_DEBUG(
+      "block cache {}: {} hits {} misses {} bytes", dir_, hits_.load(),
+      misses_.load(), size());
+}
+
+katana::Result<std::unique_ptr<tsuba::BlockCache>>
+tsuba::BlockCache::Make(const std::string& dir, uint64_t capacity) {
+  if (boost::system::error_code err; !fs::create_directories(dir, err)) {
+    if (err) {
+      return err;
+    }
+  }
+
+  // new to access non-public constructor
+  std::unique_ptr<BlockCache> cache(new BlockCache(dir, capacity));
+  if (auto res = cache->Recover(); !res) {
+    return res.error();
+  }
+  return std::unique_ptr<BlockCache>(std::move(cache));
+}
+
+katana::Result<std::unique_ptr<tsuba::BlockCache>>
+tsuba::BlockCache::MakeFromEnv() {
+  std::string dir;
+  if (!katana::GetEnv("KATANA_TSUBA_CACHE_DIR", &dir) || dir.empty()) {
+    return std::unique_ptr<BlockCache>();
+  }
+
+  int capacity_mb = kDefaultCapacityMB;
+  if (katana::GetEnv("KATANA_TSUBA_CACHE_SIZE_MB") &&
+      (!katana::GetEnv("KATANA_TSUBA_CACHE_SIZE_MB", &capacity_mb) ||
+       capacity_mb < 0)) {
+    KATANA_LOG_ERROR("KATANA_TSUBA_CACHE_SIZE_MB must be a non-negative int");
+    return ErrorCode::InvalidArgument;
+  }
+
+  return Make(dir, static_cast<uint64_t>(capacity_mb) << 20);
+}
+
+katana::Result<void>
+tsuba::BlockCache::Recover() {
+  struct Found {
+    std::time_t mtime;
+    std::string path;
+    uint64_t size;
+  };
+  std::vector<Found> found;
+
+  boost::system::error_code err;
+  for (fs::directory_iterator obj(dir_, err), end; !err && obj != end;
+       obj.increment(err)) {
+    if (!fs::is_directory(obj->status())) {
+      continue;
+    }
+    for (fs::directory_iterator block(obj->path(), err); !err && block != end;
+         block.increment(err)) {
+      const fs::path& path = block->path();
+      if (IsTmpFile(path.filename().string())) {
+        // left behind by an interrupted WriteBlock
+        fs::remove(path, err);
+        err.clear();
+        continue;
+      }
+      uint64_t size = fs::file_size(path, err);
+      std::time_t mtime = fs::last_write_time(path, err);
+      if (err) {
+        return err;
+      }
+      found.emplace_back(Found{mtime, path.string(), size});
+    }
+  }
+  if (err) {
+    return err;
+  }
+
+  std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+    return a.mtime < b.mtime;
+  });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Found& f : found) {
+    lru_.push_front(Entry{std::move(f.path), f.size});
+    index_.emplace(lru_.front().path, lru_.begin());
+    size_ += f.size;
+  }
+  while (size_ > capacity_ && !lru_.empty()) {
+    unlink(lru_.back().path.c_str());
+    size_ -= lru_.back().size;
+    index_.erase(lru_.back().path);
+    lru_.pop_back();
+  }
+
+  return katana::ResultSuccess();
+}
+
+uint64_t
+tsuba::BlockCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+std::string
+tsuba::BlockCache::ObjectDir(
+    const std::string& uri, const StatBuf& stat) const {
+  std::string key =
+      fmt::format("{}{}{}{}{}", uri, '\0', stat.size, '\0', stat.version);
+  // Two independently seeded hashes make a 128-bit name; collisions between
+  // distinct objects are not a practical concern at that width
+  uint64_t high = HashBytes(UINT64_C(0xcbf29ce484222325), key);
+  uint64_t low = HashBytes(UINT64_C(0x84222325cbf29ce4), key);
+  return fmt::format("{}/{:016x}{:016x}", dir_, high, low);
+}
+
+bool
+tsuba::BlockCache::ReadBlock(
+    const std::string& path, uint64_t block_size, uint64_t offset,
+    uint64_t size, uint8_t* dest) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat s_buf;
+  if (fstat(fd, &s_buf) != 0 ||
+      static_cast<uint64_t>(s_buf.st_size) != block_size) {
+    // Something other than BlockCache changed this file; do not trust it
+    close(fd);
+    unlink(path.c_str());
+    Forget(path);
+    return false;
+  }
+
+  uint64_t done = 0;
+  while (done < size) {
+    ssize_t n = pread(fd, dest + done, size - done, offset + done);
+    if (n <= 0) {
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      close(fd);
+      return false;
+    }
+    done += n;
+  }
+  close(fd);
+  return true;
+}
+
+katana::Result<std::string>
+tsuba::BlockCache::WriteTmpBlock(
+    const std::string& path, const uint8_t* data, uint64_t size) {
+  std::string tmp_path =
+      fmt::format("{}{}{}.{}", path, kTmpMarker, getpid(), tmp_counter_++);
+  int fd = open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+  if (fd < 0) {
+    return katana::ResultErrno();
+  }
+
+  uint64_t done = 0;
+  while (done < size) {
+    ssize_t n = write(fd, data + done, size - done);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      auto err = katana::ResultErrno();
+      close(fd);
+      unlink(tmp_path.c_str());
+      return err;
+    }
+    done += n;
+  }
+  close(fd);
+  return tmp_path;
+}
+
+katana::Result<void>
+tsuba::BlockCache::PublishBlocks(
+    const std::string& object_dir,
+    const std::vector<std::pair<std::string, Entry>>& blocks) {
+  // Make the data durable before the renames make it visible so that a crash
+  // cannot expose a truncated block under its final name. One syncfs covers
+  // every block of the fill, where a sync per block would serialize the fill
+  // on the device's flush latency.
+  int dir_fd = open(object_dir.c_str(), O_RDONLY | O_DIRECTORY);
+  if (dir_fd < 0) {
+    return katana::ResultErrno();
+  }
+  if (syncfs(dir_fd) != 0) {
+    auto err = katana::ResultErrno();
+    close(dir_fd);
+    return err;
+  }
+  close(dir_fd);
+
+  for (const auto& [tmp_path, entry] : blocks) {
+    if (rename(tmp_path.c_str(), entry.path.c_str()) != 0) {
+      return katana::ResultErrno();
+    }
+    Touch(entry.path, entry.size, false);
+  }
+  return katana::ResultSuccess();
+}
+
+void
+tsuba::BlockCache::Touch(const std::string& path, uint64_t size, bool hit) {
+  std::vector<std::string> evicted;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto it = index_.find(path); it != index_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+    } else {
+      lru_.push_front(Entry{path, size});
+      index_.emplace(path, lru_.begin());
+      size_ += size;
+    }
+
+    while (size_ > capacity_ && !lru_.empty()) {
+      evicted.emplace_back(std::move(lru_.back().path));
+      size_ -= lru_.back().size;
+      index_.erase(evicted.back());
+      lru_.pop_back();
+    }
+  }
+
+  for (const std::string& victim : evicted) {
+    unlink(victim.c_str());
+  }
+
+  if (hit) {
+    // Persist recency so that Recover orders blocks sensibly after a restart
+    utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+  }
+}
+
+void
+tsuba::BlockCache::Forget(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto it = index_.find(path); it != index_.end()) {
+    size_ -= it->second->size;
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+}
+
+katana::Result<void>
+tsuba::BlockCache::Get(
+    FileStorage* fs, const std::string& uri, const StatBuf& stat,
+    uint64_t begin, uint64_t size, uint8_t* result_buf) {
+  if (size == 0) {
+    return katana::ResultSuccess();
+  }
+  uint64_t end = begin + size;
+  if (end > stat.size) {
+    KATANA_LOG_DEBUG(
+        "read [{}, {}) past end of {} ({} bytes)", begin, end, uri, stat.size);
+    return ErrorCode::InvalidArgument;
+  }
+
+  std::string object_dir = ObjectDir(uri, stat);
+
+  // Fetch blocks [run_first, run_last] from fs with one request and insert
+  // them into the cache
+  auto fetch_run = [&](uint64_t run_first,
+                       uint64_t run_last) -> katana::Result<void> {
+    uint64_t run_begin = run_first << kBlockShift;
+    uint64_t run_end = std::min((run_last + 1) << kBlockShift, stat.size);
+
+    std::vector<uint8_t> staging;
+    const uint8_t* src = nullptr;
+    if (run_begin >= begin && run_end <= end) {
+      uint8_t* dest = result_buf + (run_begin - begin);
+      if (auto res =
+              fs->GetMultiSync(uri, run_begin, run_end - run_begin, dest);
+          !res) {
+        return res.error();
+      }
+      src = dest;
+    } else {
+      // The run covers bytes outside of the caller's buffer; read whole
+      // blocks into a staging buffer and copy out the overlap
+      staging.resize(run_end - run_begin);
+      if (auto res = fs->GetMultiSync(
+              uri, run_begin, run_end - run_begin, staging.data());
+          !res) {
+        return res.error();
+      }
+      uint64_t overlap_begin = std::max(run_begin, begin);
+      uint64_t overlap_end = std::min(run_end, end);
+      std::memcpy(
+          result_buf + (overlap_begin - begin),
+          staging.data() + (overlap_begin - run_begin),
+          overlap_end - overlap_begin);
+      src = staging.data();
+    }
+
+    misses_ += run_last - run_first + 1;
+
+    // Failing to populate the cache only costs us a later miss
+    if (boost::system::error_code err;
+        !fs::create_directories(object_dir, err) && err) {
+      KATANA_LOG_DEBUG(
+          "block cache directory {}: {}", object_dir, err.message());
+      return katana::ResultSuccess();
+    }
+    std::vector<std::pair<std::string, Entry>> blocks;
+    for (uint64_t block = run_first; block <= run_last; ++block) {
+      uint64_t block_begin = block << kBlockShift;
+      uint64_t block_size = std::min(kBlockSize, stat.size - block_begin);
+      std::string path = BlockPath(object_dir, block);
+      auto tmp_res =
+          WriteTmpBlock(path, src + (block_begin - run_begin), block_size);
+      if (!tmp_res) {
+        KATANA_LOG_DEBUG("block cache write {}: {}", path, tmp_res.error());
+        continue;
+      }
+      blocks.emplace_back(
+          std::move(tmp_res.value()), Entry{std::move(path), block_size});
+    }
+    if (!blocks.empty()) {
+      if (auto res = PublishBlocks(object_dir, blocks); !res) {
+        KATANA_LOG_DEBUG("block cache publish {}: {}", object_dir, res.error());
+        for (const auto& block : blocks) {
+          unlink(block.first.c_str());
+        }
+      }
+    }
+    return katana::ResultSuccess();
+  };
+
+  uint64_t first_block = begin >> kBlockShift;
+  uint64_t last_block = (end - 1) >> kBlockShift;
+  bool in_run = false;
+  uint64_t run_first = 0;
+
+  for (uint64_t block = first_block; block <= last_block; ++block) {
+    uint64_t block_begin = block << kBlockShift;
+    uint64_t block_size = std::min(kBlockSize, stat.size - block_begin);
+    uint64_t overlap_begin = std::max(block_begin, begin);
+    uint64_t overlap_end = std::min(block_begin + block_size, end);
+    std::string path = BlockPath(object_dir, block);
+
+    uint8_t* dest = result_buf + (overlap_begin - begin);
+    if (ReadBlock(
+            path, block_size, overlap_begin - block_begin,
+            overlap_end - overlap_begin, dest)) {
+      ++hits_;
+      Touch(path, block_size, true);
+      if (in_run) {
+        if (auto res = fetch_run(run_first, block - 1); !res) {
+          return res.error();
+        }
+        in_run = false;
+      }
+    } else if (!in_run) {
+      run_first = block;
+      in_run = true;
+    }
+  }
+
+  if (in_run) {
+    if (auto res = fetch_run(run_first, last_block); !res) {
+      return res.error();
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+std::future<katana::Result<void>>
+tsuba::BlockCache::GetAsync(
+    FileStorage* fs, const std::string& uri, const StatBuf& stat,
+    uint64_t begin, uint64_t size, uint8_t* result_buf) {
+  return std::async(
+      std::launch::async,
+      [this, fs, uri, stat, begin, size, result_buf]() -> katana::Result<void> {
+        katana::TraceScope scope("BlockCache::GetAsync", "tsuba");
+        return Get(fs, uri, stat, begin, size, result_buf);
+      });
+}
+
+std::future<katana::Result<void>>
+tsuba::CachedFileGetAsync(
+    const std::string& uri, const StatBuf& stat, uint8_t* result_buffer,
+    uint64_t begin, uint64_t size) {
+  FileStorage* fs = FS(uri);
+  BlockCache* cache = GlobalState::Get().Cache();
+  // Without a version we cannot tell when a cached object goes stale
+  if (cache == nullptr || !fs->Cacheable() || stat.version.empty()) {
+    return fs->GetAsync(uri, begin, size, result_buffer);
+  }
+  return cache->GetAsync(fs, uri, stat, begin, size, result_buffer);
+}
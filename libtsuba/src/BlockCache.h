@@ -0,0 +1,134 @@
+#ifndef KATANA_LIBTSUBA_BLOCKCACHE_H_
+#define KATANA_LIBTSUBA_BLOCKCACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "katana/Result.h"
+#include "tsuba/FileStorage.h"
+#include "tsuba/file.h"
+
+namespace tsuba {
+
+/// BlockCache is a read-through cache of fixed-size file blocks kept in a
+/// directory on local storage (e.g., NVMe). It sits between FileView and the
+/// FileStorage backend of a URI so that repeated loads of the same version of
+/// a remote file are served from local disk.
+///
+/// Blocks are keyed by (URI, size, StatBuf::version, block index); a new
+/// version of an object gets new keys and the stale blocks age out through
+/// LRU eviction. The cache holds at most capacity() bytes of block data.
+///
+/// The directory contents are the only metadata. The blocks of a fill are
+/// written to temporary files, synced together and renamed into place, so a
+/// crash can leave behind stray temporary files but never a partially
+/// written block. Temporary files
+/// are removed and the LRU order is rebuilt from block modification times
+/// when the cache is opened.
+class BlockCache {
+public:
+  /// The block size matches the FileView page size so that FileView fills
+  /// map onto whole blocks
+  static constexpr uint64_t kBlockShift = 20; /* 1M */
+  static constexpr uint64_t kBlockSize = UINT64_C(1) << kBlockShift;
+
+  BlockCache(const BlockCache& no_copy) = delete;
+  BlockCache(BlockCache&& no_move) = delete;
+  BlockCache& operator=(const BlockCache& no_copy) = delete;
+  BlockCache& operator=(BlockCache&& no_move) = delete;
+  ~BlockCache();
+
+  /// Open (creating if necessary) the cache rooted at \param dir and evict
+  /// blocks until it holds at most \param capacity bytes
+  static katana::Result<std::unique_ptr<BlockCache>> Make(
+      const std::string& dir, uint64_t capacity);
+
+  /// Make a cache configured by KATANA_TSUBA_CACHE_DIR and
+  /// KATANA_TSUBA_CACHE_SIZE_MB. Returns nullptr if no cache directory is set.
+  static katana::Result<std::unique_ptr<BlockCache>> MakeFromEnv();
+
+  /// Read [begin, begin + size) of \param uri, which is stored in \param fs
+  /// and described by \param stat, into \param result_buf. Missing blocks are
+  /// fetched from \param fs and inserted into the cache.
+  katana::Result<void> Get(
+      FileStorage* fs, const std::string& uri, const StatBuf& stat,
+      uint64_t begin, uint64_t size, uint8_t* result_buf);
+
+  std::future<katana::Result<void>> GetAsync(
+      FileStorage* fs, const std::string& uri, const StatBuf& stat,
+      uint64_t begin, uint64_t size, uint8_t* result_buf);
+
+  const std::string& dir() const { return dir_; }
+  uint64_t capacity() const { return capacity_; }
+  uint64_t size() const;
+
+  uint64_t hits() const { return hits_; }
+  uint64_t misses() const { return misses_; }
+
+private:
+  struct Entry {
+    std::string path;
+    uint64_t size;
+  };
+  using LRUList = std::list<Entry>;
+
+  BlockCache(std::string dir, uint64_t capacity)
+      : dir_(std::move(dir)), capacity_(capacity) {}
+
+  katana::Result<void> Recover();
+
+  std::string ObjectDir(const std::string& uri, const StatBuf& stat) const;
+
+  /// Copy the cached block at \param path into \param dest if it is present
+  /// and holds exactly \param block_size bytes
+  bool ReadBlock(
+      const std::string& path, uint64_t block_size, uint64_t offset,
+      uint64_t size, uint8_t* dest);
+
+  /// Write \param size bytes of \param data to a new temporary file next to
+  /// \param path and return its name. The file is not synced.
+  katana::Result<std::string> WriteTmpBlock(
+      const std::string& path, const uint8_t* data, uint64_t size);
+
+  /// Sync the temporary blocks written by one fill of \param object_dir and
+  /// rename each into place
+  katana::Result<void> PublishBlocks(
+      const std::string& object_dir,
+      const std::vector<std::pair<std::string, Entry>>& blocks);
+
+  /// Record an access to path, inserting it if absent, and evict least
+  /// recently used blocks if the cache is over capacity. \param hit is true
+  /// when the block was read rather than just written.
+  void Touch(const std::string& path, uint64_t size, bool hit);
+  void Forget(const std::string& path);
+
+  std::string dir_;
+  uint64_t capacity_;
+
+  mutable std::mutex mutex_;
+  LRUList lru_;
+  std::unordered_map<std::string, LRUList::iterator> index_;
+  uint64_t size_{0};
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> tmp_counter_{0};
+};
+
+/// Read a part of \param uri into a caller defined buffer, going through the
+/// block cache when one is configured and the backend for uri allows it
+std::future<katana::Result<void>> CachedFileGetAsync(
+    const std::string& uri, const StatBuf& stat, uint8_t* result_buffer,
+    uint64_t begin, uint64_t size);
+
+}  // namespace tsuba
+
+#endif
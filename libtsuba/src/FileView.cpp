@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <string>
 
+#include "BlockCache.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
 #include "tsuba/Errors.h"
@@ -93,6 +94,7 @@ FileView::Bind(
   mem_start_ = -1;
   filling_.resize(page_number(buf.size) / 64 + 1, 0);
   file_size_ = buf.size;
+  version_ = buf.version;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
   if (auto res = Fill(begin, in_end, resolve); !res) {
     return res.error();
@@ -139,8 +141,11 @@ FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         return katana::ResultErrno();
       }
 
-      auto peek_fut =
-          FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
+      StatBuf stat;
+      stat.size = file_size_;
+      stat.version = version_;
+      auto peek_fut = CachedFileGetAsync(
+          filename_, stat, map_start_ + file_off, file_off, map_size);
       KATANA_LOG_ASSERT(peek_fut.valid());
       FillingRange fetch = {first_page, last_page, std::move(peek_fut)};
       fetches_->push_back(std::move(fetch));
@@ -81,6 +81,12 @@ tsuba::GlobalState::Init(
     }
   }
 
+  auto cache_res = BlockCache::MakeFromEnv();
+  if (!cache_res) {
+    return cache_res.error();
+  }
+  global_state->block_cache_ = std::move(cache_res.value());
+
   ref_ = std::move(global_state);
   return katana::ResultSuccess();
 }
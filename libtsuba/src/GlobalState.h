@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "BlockCache.h"
 #include "LocalStorage.h"
 #include "katana/CommBackend.h"
 #include "katana/Logging.h"
@@ -24,6 +25,7 @@ class GlobalState {
   tsuba::NameServerClient* name_server_client_;
 
   tsuba::LocalStorage local_storage_;
+  std::unique_ptr<BlockCache> block_cache_;
 
   GlobalState(katana::CommBackend* comm, tsuba::NameServerClient* ns)
       : comm_(comm), name_server_client_(ns) {
@@ -43,6 +45,9 @@ public:
   katana::CommBackend* Comm() const;
   NameServerClient* NS() const;
 
+  /// The local block cache for remote reads or nullptr if it is disabled
+  BlockCache* Cache() const { return block_cache_.get(); }
+
   /// Get the correct FileStorage based on the URI
   ///
   /// store object is selected based on scheme:
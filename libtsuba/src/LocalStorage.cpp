@@ -13,14 +13,23 @@
 #include <boost/filesystem.hpp>
 
 #include "GlobalState.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
+#include "katana/Trace.h"
 #include "katana/Uri.h"
 #include "tsuba/Errors.h"
 #include "tsuba/file.h"
 
 namespace fs = boost::filesystem;
 
+katana::Result<void>
+tsuba::LocalStorage::Init() {
+  cacheable_ = false;
+  katana::GetEnv("KATANA_TSUBA_CACHE_LOCAL", &cacheable_);
+  return katana::ResultSuccess();
+}
+
 void
 tsuba::LocalStorage::CleanUri(std::string* uri) {
   if (uri->find(uri_scheme()) != 0) {
@@ -114,6 +123,11 @@ tsuba::LocalStorage::Stat(const std::string& uri, StatBuf* s_buf) {
     return katana::ResultErrno();
   }
   s_buf->size = local_s_buf.st_size;
+  // A file replaced by a rename gets a new inode even if its modification
+  // time does not move
+  s_buf->version = fmt::format(
+      "{}.{}.{}.{}", local_s_buf.st_dev, local_s_buf.st_ino,
+      local_s_buf.st_mtim.tv_sec, local_s_buf.st_mtim.tv_nsec);
   return katana::ResultSuccess();
 }
 
@@ -122,6 +136,7 @@ std::future<katana::Result<void>>
 tsuba::LocalStorage::ListAsync(
     const std::string& uri, std::vector<std::string>* list,
     std::vector<uint64_t>* size) {
+  katana::TraceScope scope("LocalStorage::ListAsync", "tsuba");
   // Implement with synchronous calls
   DIR* dirp;
   struct dirent* dp;
@@ -9,6 +9,7 @@
 #include <thread>
 
 #include "katana/Result.h"
+#include "katana/Trace.h"
 #include "tsuba/FileStorage.h"
 
 namespace tsuba {
@@ -16,6 +17,8 @@ namespace tsuba {
 /// Store byte arrays to the local file system; Provided as a convenience for
 /// testing only (un-optimized)
 class LocalStorage : public FileStorage {
+  bool cacheable_{false};
+
   void CleanUri(std::string* uri);
   katana::Result<void> WriteFile(
       std::string, const uint8_t* data, uint64_t size);
@@ -28,12 +31,16 @@ class LocalStorage : public FileStorage {
 public:
   LocalStorage() : FileStorage("file://") {}
 
-  katana::Result<void> Init() override { return katana::ResultSuccess(); }
+  katana::Result<void> Init() override;
   katana::Result<void> Fini() override { return katana::ResultSuccess(); }
   katana::Result<void> Stat(const std::string& uri, StatBuf* size) override;
 
   uint32_t Priority() const override { return 1; }
 
+  /// Local files are only worth caching when they live on a network file
+  /// system; see KATANA_TSUBA_CACHE_LOCAL
+  bool Cacheable() const override { return cacheable_; }
+
   katana::Result<void> GetMultiSync(
       const std::string& uri, uint64_t start, uint64_t size,
       uint8_t* result_buf) override {
@@ -55,6 +62,7 @@ public:
   std::future<katana::Result<void>> PutAsync(
       const std::string& uri, const uint8_t* data, uint64_t size) override {
     // No need for AsyncPut to local storage right now
+    katana::TraceScope scope("LocalStorage::PutAsync", "tsuba");
     if (auto write_res = WriteFile(uri, data, size); !write_res) {
       return std::async(
           [=]() -> katana::Result<void> { return write_res.error(); });
@@ -66,6 +74,7 @@ public:
       const std::string& uri, uint64_t start, uint64_t size,
       uint8_t* result_buf) override {
     // I suppose there is no need for AsyncGet to local storage either
+    katana::TraceScope scope("LocalStorage::GetAsync", "tsuba");
     if (auto read_res = ReadFile(uri, start, size, result_buf); !read_res) {
       return std::async(
           [=]() -> katana::Result<void> { return read_res.error(); });
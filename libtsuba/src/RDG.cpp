@@ -148,11 +148,12 @@ WriteTable(
 
 katana::Result<void>
 CommitRDG(
-    tsuba::RDGHandle handle, uint32_t policy_id, bool transposed,
-    const tsuba::RDGLineage& lineage, std::unique_ptr<tsuba::WriteGroup> desc) {
+    tsuba::RDGHandle handle, uint32_t num_hosts, uint32_t policy_id,
+    bool transposed, const tsuba::RDGLineage& lineage,
+    std::unique_ptr<tsuba::WriteGroup> desc) {
   katana::CommBackend* comm = tsuba::Comm();
   tsuba::RDGMeta new_meta = handle.impl_->rdg_meta().NextVersion(
-      comm->Num, policy_id, transposed, lineage);
+      num_hosts, policy_id, transposed, lineage);
 
   // wait for all the work we queued to finish
   TSUBA_PTP(tsuba::internal::FaultSensitivity::High);
@@ -284,9 +285,8 @@ tsuba::RDG::WritePartArrays(const katana::Uri& dir, tsuba::WriteGroup* desc) {
 }
 
 katana::Result<void>
-tsuba::RDG::DoStore(
-    RDGHandle handle, const std::string& command_line,
-    std::unique_ptr<WriteGroup> write_group) {
+tsuba::RDG::DoStorePartition(
+    RDGHandle handle, uint32_t host_id, WriteGroup* write_group) {
   if (core_->part_header().topology_path().empty()) {
     // No topology file; create one
     katana::Uri t_path = MakeTopologyFileName(handle);
@@ -303,7 +303,7 @@ tsuba::RDG::DoStore(
 
   auto node_write_result = WriteTable(
       *core_->node_table(), core_->part_header().node_prop_info_list(),
-      handle.impl_->rdg_meta().dir(), write_group.get());
+      handle.impl_->rdg_meta().dir(), write_group);
   if (!node_write_result) {
     KATANA_LOG_DEBUG("failed to write node properties");
     return node_write_result.error();
@@ -315,7 +315,7 @@ tsuba::RDG::DoStore(
 
   auto edge_write_result = WriteTable(
       *core_->edge_table(), core_->part_header().edge_prop_info_list(),
-      handle.impl_->rdg_meta().dir(), write_group.get());
+      handle.impl_->rdg_meta().dir(), write_group);
   if (!edge_write_result) {
     KATANA_LOG_DEBUG("failed to write edge properties");
     return edge_write_result.error();
@@ -326,7 +326,7 @@ tsuba::RDG::DoStore(
       std::move(edge_write_result.value()));
 
   auto part_write_result =
-      WritePartArrays(handle.impl_->rdg_meta().dir(), write_group.get());
+      WritePartArrays(handle.impl_->rdg_meta().dir(), write_group);
 
   if (!part_write_result) {
     KATANA_LOG_DEBUG("failed: WritePartMetadata for part_prop_info_list");
@@ -335,16 +335,29 @@ tsuba::RDG::DoStore(
   core_->part_header().set_part_properties(
       std::move(part_write_result.value()));
 
-  if (auto write_result = core_->part_header().Write(handle, write_group.get());
+  if (auto write_result =
+          core_->part_header().Write(handle, write_group, host_id);
       !write_result) {
     KATANA_LOG_DEBUG("error: metadata write");
     return write_result.error();
   }
 
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+tsuba::RDG::DoStore(
+    RDGHandle handle, const std::string& command_line,
+    std::unique_ptr<WriteGroup> write_group) {
+  if (auto res = DoStorePartition(handle, Comm()->ID, write_group.get());
+      !res) {
+    return res.error();
+  }
+
   // Update lineage and commit
   lineage_.AddCommandLine(command_line);
   if (auto res = CommitRDG(
-          handle, core_->part_header().metadata().policy_id_,
+          handle, Comm()->Num, core_->part_header().metadata().policy_id_,
           core_->part_header().metadata().transposed_, lineage_,
           std::move(write_group));
       !res) {
@@ -492,18 +505,77 @@ tsuba::RDG::Store(
   std::unique_ptr<WriteGroup> desc = std::move(desc_res.value());
 
   if (ff) {
-    katana::Uri t_path = handle.impl_->rdg_meta().dir().RandFile("topology");
-
-    ff->Bind(t_path.string());
-    TSUBA_PTP(internal::FaultSensitivity::Normal);
-    desc->StartStore(std::move(ff));
-    TSUBA_PTP(internal::FaultSensitivity::Normal);
-    core_->part_header().set_topology_path(t_path.BaseName());
+    StoreTopology(handle, std::move(ff), desc.get());
   }
 
   return DoStore(handle, command_line, std::move(desc));
 }
 
+katana::Result<void>
+tsuba::RDG::StorePartitions(
+    RDGHandle handle, const std::string& command_line,
+    const std::vector<RDG*>& partitions,
+    std::vector<std::unique_ptr<FileFrame>>&& topologies) {
+  if (!handle.impl_->AllowsWrite()) {
+    KATANA_LOG_DEBUG("failed: handle does not allow write");
+    return ErrorCode::InvalidArgument;
+  }
+  if (Comm()->Num != 1) {
+    KATANA_LOG_ERROR("partitions can only be stored from a single host");
+    return ErrorCode::InvalidArgument;
+  }
+  if (partitions.empty() || partitions.size() != topologies.size()) {
+    return ErrorCode::InvalidArgument;
+  }
+
+  const PartitionMetadata& metadata = partitions[0]->part_metadata();
+  for (const RDG* part : partitions) {
+    if (part->part_metadata().policy_id_ != metadata.policy_id_ ||
+        part->part_metadata().transposed_ != metadata.transposed_) {
+      KATANA_LOG_DEBUG("failed: partitions disagree on partitioning policy");
+      return ErrorCode::InvalidArgument;
+    }
+  }
+
+  auto desc_res = WriteGroup::Make();
+  if (!desc_res) {
+    return desc_res.error();
+  }
+  // All write buffers must outlive desc
+  std::unique_ptr<WriteGroup> desc = std::move(desc_res.value());
+
+  for (uint32_t host_id = 0; host_id < partitions.size(); ++host_id) {
+    RDG* part = partitions[host_id];
+    if (handle.impl_->rdg_meta().dir() != part->rdg_dir_) {
+      part->core_->part_header().UnbindFromStorage();
+    }
+    if (topologies[host_id]) {
+      part->StoreTopology(handle, std::move(topologies[host_id]), desc.get());
+    }
+    if (auto res = part->DoStorePartition(handle, host_id, desc.get()); !res) {
+      return res.error();
+    }
+  }
+
+  RDGLineage lineage = partitions[0]->lineage_;
+  lineage.AddCommandLine(command_line);
+  return CommitRDG(
+      handle, partitions.size(), metadata.policy_id_, metadata.transposed_,
+      lineage, std::move(desc));
+}
+
+void
+tsuba::RDG::StoreTopology(
+    RDGHandle handle, std::unique_ptr<FileFrame> ff, WriteGroup* desc) {
+  katana::Uri t_path = handle.impl_->rdg_meta().dir().RandFile("topology");
+
+  ff->Bind(t_path.string());
+  TSUBA_PTP(internal::FaultSensitivity::Normal);
+  desc->StartStore(std::move(ff));
+  TSUBA_PTP(internal::FaultSensitivity::Normal);
+  core_->part_header().set_topology_path(t_path.BaseName());
+}
+
 katana::Result<void>
 tsuba::RDG::AddNodeProperties(const std::shared_ptr<arrow::Table>& table) {
   if (auto res = core_->AddNodeProperties(table); !res) {
@@ -583,6 +655,16 @@ tsuba::RDG::set_part_metadata(const tsuba::PartitionMetadata& metadata) {
   core_->part_header().set_metadata(metadata);
 }
 
+const std::string&
+tsuba::RDG::graph_profile() const {
+  return core_->part_header().graph_profile();
+}
+
+void
+tsuba::RDG::set_graph_profile(std::string graph_profile) {
+  core_->part_header().set_graph_profile(std::move(graph_profile));
+}
+
 const std::shared_ptr<arrow::Table>&
 tsuba::RDG::node_table() const {
   return core_->node_table();
@@ -28,6 +28,7 @@ const char* kNodePropertyKey = "kg.v1.node_property";
 const char* kEdgePropertyKey = "kg.v1.edge_property";
 const char* kPartPropertyFilesKey = "kg.v1.part_property_files";
 const char* kPartProperyMetaKey = "kg.v1.part_property_meta";
+const char* kGraphProfileKey = "kg.v1.graph_profile";
 //
 //constexpr std::string_view  mirror_nodes_prop_name = "mirror_nodes";
 //constexpr std::string_view  master_nodes_prop_name = "master_nodes";
@@ -207,7 +208,8 @@ RDGPartHeader::Make(const katana::Uri& partition_path) {
 }
 
 Result<void>
-RDGPartHeader::Write(RDGHandle handle, WriteGroup* writes) const {
+RDGPartHeader::Write(
+    RDGHandle handle, WriteGroup* writes, uint32_t host_id) const {
   auto serialized_res = katana::JsonDump(*this);
   if (!serialized_res) {
     return serialized_res.error();
@@ -229,7 +231,7 @@ RDGPartHeader::Write(RDGHandle handle, WriteGroup* writes) const {
   }
 
   ff->Bind(RDGMeta::PartitionFileName(
-               handle.impl_->rdg_meta().dir(), Comm()->ID,
+               handle.impl_->rdg_meta().dir(), host_id,
                handle.impl_->rdg_meta().version() + 1)
                .string());
 
@@ -401,6 +403,9 @@ tsuba::to_json(json& j, const tsuba::RDGPartHeader& header) {
       {kPartPropertyFilesKey, header.part_prop_info_list_},
       {kPartProperyMetaKey, header.metadata_},
   };
+  if (!header.graph_profile_.empty()) {
+    j[kGraphProfileKey] = header.graph_profile_;
+  }
 }
 
 void
@@ -410,6 +415,10 @@ tsuba::from_json(const json& j, tsuba::RDGPartHeader& header) {
   j.at(kEdgePropertyKey).get_to(header.edge_prop_info_list_);
   j.at(kPartPropertyFilesKey).get_to(header.part_prop_info_list_);
   j.at(kPartProperyMetaKey).get_to(header.metadata_);
+  // Optional; absent from headers written before graph profiles existed
+  if (auto it = j.find(kGraphProfileKey); it != j.end()) {
+    it->get_to(header.graph_profile_);
+  }
 }
 
 void
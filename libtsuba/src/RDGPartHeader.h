@@ -2,6 +2,7 @@
 #define KATANA_LIBTSUBA_RDGPARTHEADER_H_
 
 #include <cassert>
+#include <string>
 #include <vector>
 
 #include <arrow/api.h>
@@ -31,7 +32,10 @@ public:
       const std::vector<std::string>* node_props,
       const std::vector<std::string>* edge_props);
 
-  katana::Result<void> Write(RDGHandle handle, WriteGroup* writes) const;
+  /// Write this header as the partition file of \param host_id in the next
+  /// version of the RDG at \param handle
+  katana::Result<void> Write(
+      RDGHandle handle, WriteGroup* writes, uint32_t host_id) const;
 
   void UnbindFromStorage();
 
@@ -104,6 +108,11 @@ public:
   const PartitionMetadata& metadata() const { return metadata_; }
   void set_metadata(const PartitionMetadata& metadata) { metadata_ = metadata; }
 
+  const std::string& graph_profile() const { return graph_profile_; }
+  void set_graph_profile(std::string graph_profile) {
+    graph_profile_ = std::move(graph_profile);
+  }
+
   friend void to_json(nlohmann::json& j, const RDGPartHeader& header);
   friend void from_json(const nlohmann::json& j, RDGPartHeader& header);
 
@@ -120,6 +129,10 @@ private:
   /// Metadata filled in by CuSP, or from storage (meta partition file)
   PartitionMetadata metadata_;
 
+  /// Summary of the topology computed by analytics, opaque to tsuba; empty if
+  /// none has been computed since the topology last changed
+  std::string graph_profile_;
+
   std::string topology_path_;
 };
 
@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Env.h"
+#include "katana/Logging.h"
+#include "katana/Uri.h"
+#include "tsuba/Errors.h"
+#include "tsuba/FileStorage.h"
+#include "tsuba/FileView.h"
+#include "tsuba/file.h"
+#include "tsuba/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr const char* kScheme = "cachetest://";
+
+/// A stand-in for a remote object store that serves files out of a local
+/// directory and counts how many bytes it is asked for
+class DirectoryStorage : public tsuba::FileStorage {
+  std::string root_;
+
+  std::string Path(const std::string& uri) const {
+    return root_ + "/" + uri.substr(uri_scheme().size());
+  }
+
+public:
+  std::atomic<uint64_t> bytes_fetched{0};
+
+  explicit DirectoryStorage(std::string root)
+      : FileStorage(kScheme), root_(std::move(root)) {}
+
+  katana::Result<void> Init() override { return katana::ResultSuccess(); }
+  katana::Result<void> Fini() override { return katana::ResultSuccess(); }
+
+  katana::Result<void> Stat(
+      const std::string& uri, tsuba::StatBuf* s_buf) override {
+    boost::system::error_code err;
+    s_buf->size = fs::file_size(Path(uri), err);
+    if (err) {
+      return err;
+    }
+    // Objects in this store are immutable
+    s_buf->version = "1";
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    std::ifstream ifile(Path(uri), std::ios_base::binary);
+    ifile.seekg(start);
+    ifile.read(reinterpret_cast<char*>(result_buf), size); /* NOLINT */
+    if (!ifile) {
+      return tsuba::ErrorCode::LocalStorageError;
+    }
+    bytes_fetched += size;
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> PutMultiSync(
+      const std::string&, const uint8_t*, uint64_t) override {
+    return tsuba::ErrorCode::NotImplemented;
+  }
+
+  katana::Result<void> RemoteCopy(
+      const std::string&, const std::string&, uint64_t, uint64_t) override {
+    return tsuba::ErrorCode::NotImplemented;
+  }
+
+  std::future<katana::Result<void>> PutAsync(
+      const std::string&, const uint8_t*, uint64_t) override {
+    return std::async([]() -> katana::Result<void> {
+      return tsuba::ErrorCode::NotImplemented;
+    });
+  }
+
+  std::future<katana::Result<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override {
+    return std::async(
+        [=]() { return GetMultiSync(uri, start, size, result_buf); });
+  }
+
+  std::future<katana::Result<void>> ListAsync(
+      const std::string&, std::vector<std::string>*,
+      std::vector<uint64_t>*) override {
+    return std::async([]() -> katana::Result<void> {
+      return tsuba::ErrorCode::NotImplemented;
+    });
+  }
+
+  katana::Result<void> Delete(
+      const std::string&, const std::unordered_set<std::string>&) override {
+    return tsuba::ErrorCode::NotImplemented;
+  }
+};
+
+void
+CheckContents(const std::string& uri, const std::vector<uint8_t>& expected) {
+  tsuba::FileView fv;
+  auto bind_res = fv.Bind(uri, true);
+  KATANA_LOG_ASSERT(bind_res);
+  KATANA_LOG_ASSERT(fv.size() == expected.size());
+  KATANA_LOG_ASSERT(
+      std::equal(expected.begin(), expected.end(), fv.ptr<uint8_t>()));
+}
+
+uint64_t
+CachedBytes(const std::string& cache_dir) {
+  uint64_t cached = 0;
+  for (fs::recursive_directory_iterator it(cache_dir), end; it != end; ++it) {
+    if (fs::is_regular_file(it->status())) {
+      cached += fs::file_size(it->path());
+    }
+  }
+  return cached;
+}
+
+void
+TestReadThrough(const std::string& backing_dir) {
+  // Not a multiple of the block size so that the last block is partial
+  std::vector<uint8_t> data((UINT64_C(7) << 19) + 123);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(i * 31 + i / 4096);
+  }
+  {
+    std::ofstream ofile(backing_dir + "/object", std::ios_base::binary);
+    ofile.write(
+        reinterpret_cast<const char*>(data.data()), data.size()); /* NOLINT */
+    KATANA_LOG_ASSERT(ofile.good());
+  }
+  std::string uri = std::string(kScheme) + "object";
+
+  DirectoryStorage first_storage(backing_dir);
+  tsuba::RegisterFileStorage(&first_storage);
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  CheckContents(uri, data);
+  KATANA_LOG_ASSERT(first_storage.bytes_fetched == data.size());
+
+  // A second load in the same process is served from the cache
+  CheckContents(uri, data);
+  KATANA_LOG_ASSERT(first_storage.bytes_fetched == data.size());
+
+  KATANA_LOG_ASSERT(tsuba::Fini());
+
+  // And so is a load from a new instance that has to recover the cache from
+  // the directory
+  DirectoryStorage second_storage(backing_dir);
+  tsuba::RegisterFileStorage(&second_storage);
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  CheckContents(uri, data);
+  KATANA_LOG_ASSERT(second_storage.bytes_fetched == 0);
+
+  KATANA_LOG_ASSERT(tsuba::Fini());
+}
+
+void
+TestEviction(const std::string& backing_dir, const std::string& cache_dir) {
+  // Room for exactly two blocks
+  KATANA_LOG_ASSERT(katana::SetEnv("KATANA_TSUBA_CACHE_SIZE_MB", "2", true));
+
+  std::vector<uint8_t> data(UINT64_C(3) << 20, 7);
+  {
+    std::ofstream ofile(backing_dir + "/big", std::ios_base::binary);
+    ofile.write(
+        reinterpret_cast<const char*>(data.data()), data.size()); /* NOLINT */
+    KATANA_LOG_ASSERT(ofile.good());
+  }
+  std::string uri = std::string(kScheme) + "big";
+
+  DirectoryStorage storage(backing_dir);
+  tsuba::RegisterFileStorage(&storage);
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  CheckContents(uri, data);
+
+  KATANA_LOG_ASSERT(CachedBytes(cache_dir) <= (UINT64_C(2) << 20));
+
+  KATANA_LOG_ASSERT(tsuba::Fini());
+  KATANA_LOG_ASSERT(katana::UnsetEnv("KATANA_TSUBA_CACHE_SIZE_MB"));
+}
+
+void
+TestLocalVersion(const std::string& backing_dir, const std::string& cache_dir) {
+  KATANA_LOG_ASSERT(katana::SetEnv("KATANA_TSUBA_CACHE_LOCAL", "1", true));
+  KATANA_LOG_ASSERT(tsuba::Init());
+
+  std::string path = backing_dir + "/local";
+  std::vector<uint8_t> data((UINT64_C(3) << 19) + 5, 1);
+  KATANA_LOG_ASSERT(tsuba::FileStore(path, data.data(), data.size()));
+  CheckContents(path, data);
+  KATANA_LOG_ASSERT(CachedBytes(cache_dir) == data.size());
+
+  // Replacing the file gives it a new version, so the stale blocks of the old
+  // contents are not served
+  std::fill(data.begin(), data.end(), 2);
+  std::string tmp_path = path + ".new";
+  KATANA_LOG_ASSERT(tsuba::FileStore(tmp_path, data.data(), data.size()));
+  fs::rename(tmp_path, path);
+  CheckContents(path, data);
+  KATANA_LOG_ASSERT(CachedBytes(cache_dir) == 2 * data.size());
+
+  KATANA_LOG_ASSERT(tsuba::Fini());
+  KATANA_LOG_ASSERT(katana::UnsetEnv("KATANA_TSUBA_CACHE_LOCAL"));
+}
+
+}  // namespace
+
+int
+main() {
+  auto backing_res = katana::Uri::MakeRand("/tmp/block-cache-backing");
+  KATANA_LOG_ASSERT(backing_res);
+  auto cache_res = katana::Uri::MakeRand("/tmp/block-cache");
+  KATANA_LOG_ASSERT(cache_res);
+
+  std::string backing_dir = backing_res.value().path();
+  std::string cache_dir = cache_res.value().path();
+  fs::create_directories(backing_dir);
+
+  KATANA_LOG_ASSERT(katana::SetEnv("KATANA_TSUBA_CACHE_DIR", cache_dir, true));
+
+  TestReadThrough(backing_dir);
+
+  fs::remove_all(cache_dir);
+  TestEviction(backing_dir, cache_dir);
+
+  fs::remove_all(cache_dir);
+  TestLocalVersion(backing_dir, cache_dir);
+
+  fs::remove_all(backing_dir);
+  fs::remove_all(cache_dir);
+
+  return 0;
+}
@@ -97,8 +97,10 @@ main(int argc, char** argv) {
 
   katana::reportPageAlloc("MeminfoPre");
 
-  if (auto r = Bfs(pfg.get(), startNode, "level", BfsPlan::FromAlgorithm(algo));
-      !r) {
+  BfsPlan plan = algo == BfsPlan::kSynchronous
+                     ? BfsPlan::Synchronous(symmetricGraph)
+                     : BfsPlan::FromAlgorithm(algo);
+  if (auto r = Bfs(pfg.get(), startNode, "level", plan); !r) {
     KATANA_LOG_FATAL("Failed to run bfs {}", r.error());
   }
 
@@ -63,6 +63,12 @@ static cll::opt<SsspPlan::Algorithm> algo(
         clEnumValN(SsspPlan::kDijkstra, "Dijkstra", "Dijkstra's algorithm"),
         clEnumValN(SsspPlan::kTopo, "Topo", "Topological"),
         clEnumValN(SsspPlan::kTopoTile, "TopoTile", "Topological tiled"),
+        clEnumValN(
+            SsspPlan::kMultiQueue, "MultiQueue",
+            "Relaxed priority scheduling with a MultiQueue"),
+        clEnumValN(
+            SsspPlan::kOrdered, "Ordered",
+            "Dijkstra's algorithm run in parallel by the ordered executor"),
         clEnumValN(
             SsspPlan::kAutomatic, "Automatic",
             "Automatic: choose among the algorithms automatically")),
@@ -93,6 +99,10 @@ AlgorithmName(SsspPlan::Algorithm algorithm) {
     return "Topo";
   case SsspPlan::kTopoTile:
     return "TopoTile";
+  case SsspPlan::kMultiQueue:
+    return "MultiQueue";
+  case SsspPlan::kOrdered:
+    return "Ordered";
   case SsspPlan::kAutomatic:
     return "Automatic";
   default:
@@ -177,6 +187,12 @@ main(int argc, char** argv) {
   case SsspPlan::kTopoTile:
     plan = SsspPlan::TopoTile();
     break;
+  case SsspPlan::kMultiQueue:
+    plan = SsspPlan::MultiQueue();
+    break;
+  case SsspPlan::kOrdered:
+    plan = SsspPlan::Ordered();
+    break;
   case SsspPlan::kAutomatic:
     plan = SsspPlan();
     break;
@@ -1,13 +1,28 @@
-from katana.analytics._pagerank import pagerank, pagerank_assert_valid, PagerankPlan, PagerankStatistics
+from katana.analytics._pagerank import (
+    pagerank,
+    pagerank_assert_valid,
+    PagerankPlan,
+    PagerankStatistics,
+    personalized_pagerank,
+    personalized_pagerank_top_k,
+    PersonalizedPagerankPlan,
+)
 from katana.analytics._betweenness_centrality import (
     betweenness_centrality,
     BetweennessCentralityPlan,
     BetweennessCentralityStatistics,
 )
+from katana.analytics._closeness_centrality import (
+    closeness_centrality,
+    ClosenessCentralityPlan,
+    ClosenessCentralityStatistics,
+)
 from katana.analytics._wrappers import bfs, bfs_assert_valid, BfsPlan, BfsStatistics
 from katana.analytics._wrappers import sssp, sssp_assert_valid, SsspPlan, SsspStatistics
 from katana.analytics._wrappers import jaccard, jaccard_assert_valid, JaccardPlan, JaccardStatistics
 from katana.analytics._wrappers import sort_all_edges_by_dest, find_edge_sorted_by_dest, sort_nodes_by_degree
+from katana.analytics._wrappers import reorder_nodes, restore_node_order, ReorderPlan
+from katana.analytics._wrappers import GraphProfile
 from katana.analytics._triangle_count import triangle_count, TriangleCountPlan
 from katana.analytics._independent_set import (
     independent_set,
@@ -15,3 +30,53 @@ from katana.analytics._independent_set import (
     IndependentSetPlan,
     IndependentSetStatistics,
 )
+from katana.analytics._connected_components import (
+    connected_components,
+    connected_components_assert_valid,
+    ConnectedComponentsPlan,
+    ConnectedComponentsStatistics,
+)
+from katana.analytics._core_decomposition import (
+    core_decomposition,
+    core_decomposition_assert_valid,
+    CoreDecompositionPlan,
+    CoreDecompositionStatistics,
+)
+from katana.analytics._k_core import k_core, k_core_assert_valid, KCorePlan, KCoreStatistics
+from katana.analytics._k_truss import k_truss, k_truss_assert_valid, KTrussPlan, KTrussStatistics
+from katana.analytics._strongly_connected_components import (
+    strongly_connected_components,
+    strongly_connected_components_assert_valid,
+    StronglyConnectedComponentsPlan,
+    StronglyConnectedComponentsStatistics,
+)
+from katana.analytics._graph_coloring import (
+    graph_coloring,
+    graph_coloring_assert_valid,
+    GraphColoringPlan,
+    GraphColoringStatistics,
+)
+from katana.analytics._label_propagation import (
+    label_propagation,
+    label_propagation_assert_valid,
+    LabelPropagationPlan,
+    LabelPropagationStatistics,
+)
+from katana.analytics._minimum_spanning_forest import (
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
+)
+from katana.analytics._hypergraph_partition import (
+    hypergraph_partition,
+    hypergraph_partition_assert_valid,
+    HypergraphPartitionPlan,
+    HypergraphPartitionStatistics,
+)
+from katana.analytics._matrix_completion import (
+    matrix_completion,
+    matrix_completion_assert_valid,
+    MatrixCompletionPlan,
+    MatrixCompletionStatistics,
+)
@@ -19,8 +19,11 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         enum Algorithm:
             kOuter "katana::analytics::BetweennessCentralityPlan::kOuter"
             kLevel "katana::analytics::BetweennessCentralityPlan::kLevel"
+            kAdaptiveSampling "katana::analytics::BetweennessCentralityPlan::kAdaptiveSampling"
 
         _BetweennessCentralityPlan.Algorithm algorithm() const
+        double epsilon() const
+        double delta() const
 
         BetweennessCentralityPlan()
 
@@ -29,6 +32,8 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         @staticmethod
         _BetweennessCentralityPlan Outer()
         @staticmethod
+        _BetweennessCentralityPlan AdaptiveSampling(double epsilon, double delta)
+        @staticmethod
         _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
 
     BetweennessCentralitySources kBetweennessCentralityAllNodes;
@@ -64,6 +69,7 @@ cdef extern from * nogil:
 class _BetweennessCentralityPlanAlgorithm(Enum):
     Outer = _BetweennessCentralityPlan.Algorithm.kOuter
     Level = _BetweennessCentralityPlan.Algorithm.kLevel
+    AdaptiveSampling = _BetweennessCentralityPlan.Algorithm.kAdaptiveSampling
 
 
 cdef class BetweennessCentralityPlan(Plan):
@@ -85,6 +91,14 @@ cdef class BetweennessCentralityPlan(Plan):
     def algorithm(self) -> _BetweennessCentralityPlanAlgorithm:
         return _BetweennessCentralityPlanAlgorithm(self.underlying_.algorithm())
 
+    @property
+    def epsilon(self) -> float:
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> float:
+        return self.underlying_.delta()
+
     @staticmethod
     def outer():
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Outer())
@@ -93,6 +107,10 @@ cdef class BetweennessCentralityPlan(Plan):
     def level():
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Level())
 
+    @staticmethod
+    def adaptive_sampling(double epsilon = 0.01, double delta = 0.1):
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.AdaptiveSampling(epsilon, delta))
+
 
 def betweenness_centrality(PropertyGraph pg, str output_property_name, sources = None,
              BetweennessCentralityPlan plan = BetweennessCentralityPlan()):
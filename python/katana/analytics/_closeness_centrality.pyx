@@ -0,0 +1,140 @@
+from libcpp.string cimport string
+
+from katana.cpp.libstd.boost cimport handle_result_void, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/closeness_centrality/closeness_centrality.h" namespace "katana::analytics" nogil:
+    cppclass _ClosenessCentralityPlan "katana::analytics::ClosenessCentralityPlan" (_Plan):
+        enum Algorithm:
+            kExact "katana::analytics::ClosenessCentralityPlan::kExact"
+            kAdaptiveSampling "katana::analytics::ClosenessCentralityPlan::kAdaptiveSampling"
+
+        enum Measure:
+            kHarmonic "katana::analytics::ClosenessCentralityPlan::kHarmonic"
+            kCloseness "katana::analytics::ClosenessCentralityPlan::kCloseness"
+
+        _ClosenessCentralityPlan.Algorithm algorithm() const
+        _ClosenessCentralityPlan.Measure measure() const
+        double epsilon() const
+        double delta() const
+
+        ClosenessCentralityPlan()
+
+        @staticmethod
+        _ClosenessCentralityPlan Exact(_ClosenessCentralityPlan.Measure measure)
+        @staticmethod
+        _ClosenessCentralityPlan AdaptiveSampling(_ClosenessCentralityPlan.Measure measure, double epsilon, double delta)
+
+    std_result[void] ClosenessCentrality(PropertyFileGraph* pfg, string output_property_name, _ClosenessCentralityPlan plan)
+
+    cppclass _ClosenessCentralityStatistics "katana::analytics::ClosenessCentralityStatistics":
+        double max_centrality
+        double min_centrality
+        double average_centrality
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_ClosenessCentralityStatistics] Compute(PropertyFileGraph* pfg, string output_property_name)
+
+
+class _ClosenessCentralityPlanAlgorithm(Enum):
+    Exact = _ClosenessCentralityPlan.Algorithm.kExact
+    AdaptiveSampling = _ClosenessCentralityPlan.Algorithm.kAdaptiveSampling
+
+
+class _ClosenessCentralityPlanMeasure(Enum):
+    Harmonic = _ClosenessCentralityPlan.Measure.kHarmonic
+    Closeness = _ClosenessCentralityPlan.Measure.kCloseness
+
+
+cdef class ClosenessCentralityPlan(Plan):
+    cdef:
+        _ClosenessCentralityPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _ClosenessCentralityPlanAlgorithm
+    Measure = _ClosenessCentralityPlanMeasure
+
+    @staticmethod
+    cdef ClosenessCentralityPlan make(_ClosenessCentralityPlan u):
+        f = <ClosenessCentralityPlan>ClosenessCentralityPlan.__new__(ClosenessCentralityPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _ClosenessCentralityPlanAlgorithm:
+        return _ClosenessCentralityPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def measure(self) -> _ClosenessCentralityPlanMeasure:
+        return _ClosenessCentralityPlanMeasure(self.underlying_.measure())
+
+    @property
+    def epsilon(self) -> float:
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> float:
+        return self.underlying_.delta()
+
+    @staticmethod
+    def exact(measure = _ClosenessCentralityPlanMeasure.Harmonic):
+        return ClosenessCentralityPlan.make(_ClosenessCentralityPlan.Exact(measure.value))
+
+    @staticmethod
+    def adaptive_sampling(measure = _ClosenessCentralityPlanMeasure.Harmonic, double epsilon = 0.01,
+                          double delta = 0.1):
+        return ClosenessCentralityPlan.make(_ClosenessCentralityPlan.AdaptiveSampling(measure.value, epsilon, delta))
+
+
+def closeness_centrality(PropertyGraph pg, str output_property_name,
+                         ClosenessCentralityPlan plan = ClosenessCentralityPlan()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(ClosenessCentrality(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
+
+
+cdef _ClosenessCentralityStatistics handle_result_ClosenessCentralityStatistics(
+        std_result[_ClosenessCentralityStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class ClosenessCentralityStatistics:
+    cdef _ClosenessCentralityStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_ClosenessCentralityStatistics(_ClosenessCentralityStatistics.Compute(
+                pg.underlying.get(), output_property_name_cstr))
+
+    @property
+    def max_centrality(self) -> float:
+        return self.underlying.max_centrality
+
+    @property
+    def min_centrality(self) -> float:
+        return self.underlying.min_centrality
+
+    @property
+    def average_centrality(self) -> float:
+        return self.underlying.average_centrality
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
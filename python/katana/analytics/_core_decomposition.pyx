@@ -0,0 +1,135 @@
+from libcpp.string cimport string
+from libc.stdint cimport uint32_t, uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/core_decomposition/core_decomposition.h" namespace "katana::analytics" nogil:
+    cppclass _CoreDecompositionPlan "katana::analytics::CoreDecompositionPlan" (_Plan):
+        enum Algorithm:
+            kBucketed "katana::analytics::CoreDecompositionPlan::kBucketed"
+            kSerial "katana::analytics::CoreDecompositionPlan::kSerial"
+
+        _CoreDecompositionPlan.Algorithm algorithm() const
+        uint32_t num_open_buckets() const
+
+        CoreDecompositionPlan()
+
+        @staticmethod
+        _CoreDecompositionPlan Bucketed(uint32_t num_open_buckets)
+        @staticmethod
+        _CoreDecompositionPlan Serial()
+
+    std_result[void] CoreDecomposition(PropertyFileGraph* pfg, string output_property_name,
+                                       _CoreDecompositionPlan plan)
+
+    std_result[void] CoreDecompositionAssertValid(PropertyFileGraph* pfg, string output_property_name)
+
+    cppclass _CoreDecompositionStatistics "katana::analytics::CoreDecompositionStatistics":
+        uint32_t degeneracy
+        uint64_t num_nodes_in_max_core
+        uint64_t num_distinct_cores
+        double average_core_number
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_CoreDecompositionStatistics] Compute(PropertyFileGraph* pfg, string output_property_name)
+
+
+class _CoreDecompositionPlanAlgorithm(Enum):
+    Bucketed = _CoreDecompositionPlan.Algorithm.kBucketed
+    Serial = _CoreDecompositionPlan.Algorithm.kSerial
+
+
+cdef class CoreDecompositionPlan(Plan):
+    cdef:
+        _CoreDecompositionPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _CoreDecompositionPlanAlgorithm
+
+    @staticmethod
+    cdef CoreDecompositionPlan make(_CoreDecompositionPlan u):
+        f = <CoreDecompositionPlan>CoreDecompositionPlan.__new__(CoreDecompositionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _CoreDecompositionPlanAlgorithm:
+        return _CoreDecompositionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def num_open_buckets(self) -> int:
+        return self.underlying_.num_open_buckets()
+
+    @staticmethod
+    def bucketed(uint32_t num_open_buckets = 128):
+        return CoreDecompositionPlan.make(_CoreDecompositionPlan.Bucketed(num_open_buckets))
+
+    @staticmethod
+    def serial():
+        return CoreDecompositionPlan.make(_CoreDecompositionPlan.Serial())
+
+
+def core_decomposition(PropertyGraph pg, str output_property_name,
+                       CoreDecompositionPlan plan = CoreDecompositionPlan()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(CoreDecomposition(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
+
+
+def core_decomposition_assert_valid(PropertyGraph pg, str output_property_name):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_assert(CoreDecompositionAssertValid(pg.underlying.get(), output_property_name_cstr))
+
+
+cdef _CoreDecompositionStatistics handle_result_CoreDecompositionStatistics(
+        std_result[_CoreDecompositionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class CoreDecompositionStatistics:
+    cdef _CoreDecompositionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_CoreDecompositionStatistics(_CoreDecompositionStatistics.Compute(
+                pg.underlying.get(), output_property_name_cstr))
+
+    @property
+    def degeneracy(self) -> int:
+        return self.underlying.degeneracy
+
+    @property
+    def num_nodes_in_max_core(self) -> int:
+        return self.underlying.num_nodes_in_max_core
+
+    @property
+    def num_distinct_cores(self) -> int:
+        return self.underlying.num_distinct_cores
+
+    @property
+    def average_core_number(self) -> float:
+        return self.underlying.average_core_number
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,155 @@
+from libcpp cimport bool
+from libcpp.string cimport string
+from libc.stdint cimport uint32_t, uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/graph_coloring/graph_coloring.h" namespace "katana::analytics" nogil:
+    cppclass _GraphColoringPlan "katana::analytics::GraphColoringPlan" (_Plan):
+        enum Algorithm:
+            kSpeculative "katana::analytics::GraphColoringPlan::kSpeculative"
+            kJonesPlassmann "katana::analytics::GraphColoringPlan::kJonesPlassmann"
+            kLargestDegreeFirst "katana::analytics::GraphColoringPlan::kLargestDegreeFirst"
+            kSmallestLast "katana::analytics::GraphColoringPlan::kSmallestLast"
+
+        _GraphColoringPlan.Algorithm algorithm() const
+        uint32_t distance() const
+        bool balance() const
+
+        GraphColoringPlan()
+
+        @staticmethod
+        _GraphColoringPlan Speculative(uint32_t distance, bool balance)
+        @staticmethod
+        _GraphColoringPlan JonesPlassmann(uint32_t distance, bool balance)
+        @staticmethod
+        _GraphColoringPlan LargestDegreeFirst(uint32_t distance, bool balance)
+        @staticmethod
+        _GraphColoringPlan SmallestLast(uint32_t distance, bool balance)
+
+    std_result[void] GraphColoring(PropertyFileGraph* pfg, string output_property_name, _GraphColoringPlan plan)
+
+    std_result[void] GraphColoringAssertValid(PropertyFileGraph* pfg, string output_property_name, uint32_t distance)
+
+    cppclass _GraphColoringStatistics "katana::analytics::GraphColoringStatistics":
+        uint32_t num_colors
+        uint64_t largest_color_class_size
+        uint64_t smallest_color_class_size
+        double average_color_class_size
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_GraphColoringStatistics] Compute(PropertyFileGraph* pfg, string output_property_name)
+
+
+class _GraphColoringPlanAlgorithm(Enum):
+    Speculative = _GraphColoringPlan.Algorithm.kSpeculative
+    JonesPlassmann = _GraphColoringPlan.Algorithm.kJonesPlassmann
+    LargestDegreeFirst = _GraphColoringPlan.Algorithm.kLargestDegreeFirst
+    SmallestLast = _GraphColoringPlan.Algorithm.kSmallestLast
+
+
+cdef class GraphColoringPlan(Plan):
+    cdef:
+        _GraphColoringPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _GraphColoringPlanAlgorithm
+
+    @staticmethod
+    cdef GraphColoringPlan make(_GraphColoringPlan u):
+        f = <GraphColoringPlan>GraphColoringPlan.__new__(GraphColoringPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _GraphColoringPlanAlgorithm:
+        return _GraphColoringPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def distance(self) -> int:
+        return self.underlying_.distance()
+
+    @property
+    def balance(self) -> bool:
+        return self.underlying_.balance()
+
+    @staticmethod
+    def speculative(uint32_t distance = 1, bool balance = False):
+        return GraphColoringPlan.make(_GraphColoringPlan.Speculative(distance, balance))
+
+    @staticmethod
+    def jones_plassmann(uint32_t distance = 1, bool balance = False):
+        return GraphColoringPlan.make(_GraphColoringPlan.JonesPlassmann(distance, balance))
+
+    @staticmethod
+    def largest_degree_first(uint32_t distance = 1, bool balance = False):
+        return GraphColoringPlan.make(_GraphColoringPlan.LargestDegreeFirst(distance, balance))
+
+    @staticmethod
+    def smallest_last(uint32_t distance = 1, bool balance = False):
+        return GraphColoringPlan.make(_GraphColoringPlan.SmallestLast(distance, balance))
+
+
+def graph_coloring(PropertyGraph pg, str output_property_name, GraphColoringPlan plan = GraphColoringPlan()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(GraphColoring(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
+
+
+def graph_coloring_assert_valid(PropertyGraph pg, str output_property_name, uint32_t distance = 1):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_assert(GraphColoringAssertValid(pg.underlying.get(), output_property_name_cstr, distance))
+
+
+cdef _GraphColoringStatistics handle_result_GraphColoringStatistics(
+        std_result[_GraphColoringStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class GraphColoringStatistics:
+    cdef _GraphColoringStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_GraphColoringStatistics(_GraphColoringStatistics.Compute(
+                pg.underlying.get(), output_property_name_cstr))
+
+    @property
+    def num_colors(self) -> int:
+        return self.underlying.num_colors
+
+    @property
+    def largest_color_class_size(self) -> int:
+        return self.underlying.largest_color_class_size
+
+    @property
+    def smallest_color_class_size(self) -> int:
+        return self.underlying.smallest_color_class_size
+
+    @property
+    def average_color_class_size(self) -> float:
+        return self.underlying.average_color_class_size
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
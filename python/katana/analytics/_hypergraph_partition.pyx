@@ -0,0 +1,178 @@
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+from libc.stdint cimport uint32_t, uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/hypergraph_partition/hypergraph_partition.h" namespace "katana::analytics" nogil:
+    cppclass _HypergraphPartitionPlan "katana::analytics::HypergraphPartitionPlan" (_Plan):
+        enum Algorithm:
+            kBiPart "katana::analytics::HypergraphPartitionPlan::kBiPart"
+
+        enum MatchingPolicy:
+            kHigherDegree "katana::analytics::HypergraphPartitionPlan::kHigherDegree"
+            kLowerDegree "katana::analytics::HypergraphPartitionPlan::kLowerDegree"
+            kHigherWeight "katana::analytics::HypergraphPartitionPlan::kHigherWeight"
+            kLowerWeight "katana::analytics::HypergraphPartitionPlan::kLowerWeight"
+            kRandom "katana::analytics::HypergraphPartitionPlan::kRandom"
+
+        _HypergraphPartitionPlan.Algorithm algorithm() const
+        _HypergraphPartitionPlan.MatchingPolicy matching_policy() const
+        uint32_t max_coarsening_levels() const
+        uint32_t refinement_iterations() const
+        double imbalance_tolerance() const
+
+        HypergraphPartitionPlan()
+
+        @staticmethod
+        _HypergraphPartitionPlan BiPart(_HypergraphPartitionPlan.MatchingPolicy matching_policy,
+                                        uint32_t max_coarsening_levels, uint32_t refinement_iterations,
+                                        double imbalance_tolerance)
+
+    uint32_t kHyperedgePartition
+
+    std_result[void] HypergraphPartition(PropertyFileGraph* pfg, string hyperedge_property_name,
+                                         uint32_t num_partitions, string output_property_name,
+                                         _HypergraphPartitionPlan plan)
+
+    std_result[void] HypergraphPartitionAssertValid(PropertyFileGraph* pfg, string hyperedge_property_name,
+                                                    uint32_t num_partitions, string output_property_name)
+
+    cppclass _HypergraphPartitionStatistics "katana::analytics::HypergraphPartitionStatistics":
+        uint64_t num_cut_hyperedges
+        vector[uint64_t] part_sizes
+
+        double Imbalance()
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_HypergraphPartitionStatistics] Compute(PropertyFileGraph* pfg, string hyperedge_property_name,
+                                                           string output_property_name)
+
+
+class _HypergraphPartitionPlanAlgorithm(Enum):
+    BiPart = _HypergraphPartitionPlan.Algorithm.kBiPart
+
+
+class _HypergraphPartitionPlanMatchingPolicy(Enum):
+    HigherDegree = _HypergraphPartitionPlan.MatchingPolicy.kHigherDegree
+    LowerDegree = _HypergraphPartitionPlan.MatchingPolicy.kLowerDegree
+    HigherWeight = _HypergraphPartitionPlan.MatchingPolicy.kHigherWeight
+    LowerWeight = _HypergraphPartitionPlan.MatchingPolicy.kLowerWeight
+    Random = _HypergraphPartitionPlan.MatchingPolicy.kRandom
+
+
+HYPEREDGE_PARTITION = kHyperedgePartition
+
+
+cdef class HypergraphPartitionPlan(Plan):
+    cdef:
+        _HypergraphPartitionPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _HypergraphPartitionPlanAlgorithm
+    MatchingPolicy = _HypergraphPartitionPlanMatchingPolicy
+
+    @staticmethod
+    cdef HypergraphPartitionPlan make(_HypergraphPartitionPlan u):
+        f = <HypergraphPartitionPlan>HypergraphPartitionPlan.__new__(HypergraphPartitionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _HypergraphPartitionPlanAlgorithm:
+        return _HypergraphPartitionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def matching_policy(self) -> _HypergraphPartitionPlanMatchingPolicy:
+        return _HypergraphPartitionPlanMatchingPolicy(self.underlying_.matching_policy())
+
+    @property
+    def max_coarsening_levels(self) -> int:
+        return self.underlying_.max_coarsening_levels()
+
+    @property
+    def refinement_iterations(self) -> int:
+        return self.underlying_.refinement_iterations()
+
+    @property
+    def imbalance_tolerance(self) -> float:
+        return self.underlying_.imbalance_tolerance()
+
+    @staticmethod
+    def bipart(matching_policy = _HypergraphPartitionPlanMatchingPolicy.HigherDegree,
+               uint32_t max_coarsening_levels = 25, uint32_t refinement_iterations = 2,
+               double imbalance_tolerance = 0.05):
+        return HypergraphPartitionPlan.make(_HypergraphPartitionPlan.BiPart(
+            matching_policy.value, max_coarsening_levels, refinement_iterations, imbalance_tolerance))
+
+
+def hypergraph_partition(PropertyGraph pg, str hyperedge_property_name, uint32_t num_partitions,
+                         str output_property_name, HypergraphPartitionPlan plan = HypergraphPartitionPlan()):
+    hyperedge_property_name_bytes = bytes(hyperedge_property_name, "utf-8")
+    hyperedge_property_name_cstr = <string>hyperedge_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(HypergraphPartition(pg.underlying.get(), hyperedge_property_name_cstr, num_partitions,
+                                               output_property_name_cstr, plan.underlying_))
+
+
+def hypergraph_partition_assert_valid(PropertyGraph pg, str hyperedge_property_name, uint32_t num_partitions,
+                                      str output_property_name):
+    hyperedge_property_name_bytes = bytes(hyperedge_property_name, "utf-8")
+    hyperedge_property_name_cstr = <string>hyperedge_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_assert(HypergraphPartitionAssertValid(pg.underlying.get(), hyperedge_property_name_cstr,
+                                                            num_partitions, output_property_name_cstr))
+
+
+cdef _HypergraphPartitionStatistics handle_result_HypergraphPartitionStatistics(
+        std_result[_HypergraphPartitionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class HypergraphPartitionStatistics:
+    cdef _HypergraphPartitionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str hyperedge_property_name, str output_property_name):
+        hyperedge_property_name_bytes = bytes(hyperedge_property_name, "utf-8")
+        hyperedge_property_name_cstr = <string> hyperedge_property_name_bytes
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_HypergraphPartitionStatistics(
+                _HypergraphPartitionStatistics.Compute(pg.underlying.get(), hyperedge_property_name_cstr,
+                                                       output_property_name_cstr))
+
+    @property
+    def num_cut_hyperedges(self) -> int:
+        return self.underlying.num_cut_hyperedges
+
+    @property
+    def part_sizes(self) -> list:
+        return list(self.underlying.part_sizes)
+
+    @property
+    def imbalance(self) -> float:
+        return self.underlying.Imbalance()
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
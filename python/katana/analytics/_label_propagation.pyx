@@ -0,0 +1,158 @@
+from libcpp.string cimport string
+from libc.stdint cimport uint32_t, uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/label_propagation/label_propagation.h" namespace "katana::analytics" nogil:
+    cppclass _LabelPropagationPlan "katana::analytics::LabelPropagationPlan" (_Plan):
+        enum Algorithm:
+            kSynchronous "katana::analytics::LabelPropagationPlan::kSynchronous"
+            kAsynchronous "katana::analytics::LabelPropagationPlan::kAsynchronous"
+
+        _LabelPropagationPlan.Algorithm algorithm() const
+        uint32_t max_iterations() const
+
+        LabelPropagationPlan()
+
+        @staticmethod
+        _LabelPropagationPlan Synchronous(uint32_t max_iterations)
+        @staticmethod
+        _LabelPropagationPlan Asynchronous(uint32_t max_iterations)
+
+    std_result[void] LabelPropagation(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                      string seed_property_name, string output_property_name,
+                                      _LabelPropagationPlan plan)
+
+    std_result[void] LabelPropagationAssertValid(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                                 string seed_property_name, string output_property_name)
+
+    cppclass _LabelPropagationStatistics "katana::analytics::LabelPropagationStatistics":
+        uint64_t total_communities
+        uint64_t total_non_trivial_communities
+        uint64_t largest_community_size
+        double ratio_largest_community
+        uint64_t num_unlabeled_nodes
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_LabelPropagationStatistics] Compute(PropertyFileGraph* pfg, string output_property_name)
+
+
+class _LabelPropagationPlanAlgorithm(Enum):
+    Synchronous = _LabelPropagationPlan.Algorithm.kSynchronous
+    Asynchronous = _LabelPropagationPlan.Algorithm.kAsynchronous
+
+
+cdef class LabelPropagationPlan(Plan):
+    cdef:
+        _LabelPropagationPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _LabelPropagationPlanAlgorithm
+
+    @staticmethod
+    cdef LabelPropagationPlan make(_LabelPropagationPlan u):
+        f = <LabelPropagationPlan>LabelPropagationPlan.__new__(LabelPropagationPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _LabelPropagationPlanAlgorithm:
+        return _LabelPropagationPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def max_iterations(self) -> int:
+        return self.underlying_.max_iterations()
+
+    @staticmethod
+    def synchronous(uint32_t max_iterations = 100):
+        return LabelPropagationPlan.make(_LabelPropagationPlan.Synchronous(max_iterations))
+
+    @staticmethod
+    def asynchronous(uint32_t max_iterations = 100):
+        return LabelPropagationPlan.make(_LabelPropagationPlan.Asynchronous(max_iterations))
+
+
+cdef string _optional_name(name):
+    return bytes(name or "", "utf-8")
+
+
+def label_propagation(PropertyGraph pg, str output_property_name,
+                      LabelPropagationPlan plan = LabelPropagationPlan(),
+                      str edge_weight_property_name = None, str seed_property_name = None):
+    """
+    Detect communities by label propagation. Edges have weight 1 unless edge_weight_property_name is given. If
+    seed_property_name is given, its non-null values are fixed labels that spread to the other nodes.
+    """
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    cdef string output_property_name_cstr = <string>output_property_name_bytes
+    cdef string edge_weight_property_name_cstr = _optional_name(edge_weight_property_name)
+    cdef string seed_property_name_cstr = _optional_name(seed_property_name)
+    with nogil:
+        handle_result_void(LabelPropagation(pg.underlying.get(), edge_weight_property_name_cstr,
+                                            seed_property_name_cstr, output_property_name_cstr, plan.underlying_))
+
+
+def label_propagation_assert_valid(PropertyGraph pg, str output_property_name,
+                                   str edge_weight_property_name = None, str seed_property_name = None):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    cdef string output_property_name_cstr = <string>output_property_name_bytes
+    cdef string edge_weight_property_name_cstr = _optional_name(edge_weight_property_name)
+    cdef string seed_property_name_cstr = _optional_name(seed_property_name)
+    with nogil:
+        handle_result_assert(LabelPropagationAssertValid(pg.underlying.get(), edge_weight_property_name_cstr,
+                                                         seed_property_name_cstr, output_property_name_cstr))
+
+
+cdef _LabelPropagationStatistics handle_result_LabelPropagationStatistics(
+        std_result[_LabelPropagationStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class LabelPropagationStatistics:
+    cdef _LabelPropagationStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_LabelPropagationStatistics(_LabelPropagationStatistics.Compute(
+                pg.underlying.get(), output_property_name_cstr))
+
+    @property
+    def total_communities(self) -> int:
+        return self.underlying.total_communities
+
+    @property
+    def total_non_trivial_communities(self) -> int:
+        return self.underlying.total_non_trivial_communities
+
+    @property
+    def largest_community_size(self) -> int:
+        return self.underlying.largest_community_size
+
+    @property
+    def ratio_largest_community(self) -> float:
+        return self.underlying.ratio_largest_community
+
+    @property
+    def num_unlabeled_nodes(self) -> int:
+        return self.underlying.num_unlabeled_nodes
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,223 @@
+from libcpp.string cimport string
+from libc.stdint cimport uint32_t, uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/matrix_completion/matrix_completion.h" namespace "katana::analytics" nogil:
+    cppclass _MatrixCompletionPlan "katana::analytics::MatrixCompletionPlan" (_Plan):
+        enum Algorithm:
+            kSGDBlockedEdges "katana::analytics::MatrixCompletionPlan::kSGDBlockedEdges"
+            kSGDByItems "katana::analytics::MatrixCompletionPlan::kSGDByItems"
+            kALS "katana::analytics::MatrixCompletionPlan::kALS"
+
+        enum StepFunction:
+            kBold "katana::analytics::MatrixCompletionPlan::kBold"
+            kPurdue "katana::analytics::MatrixCompletionPlan::kPurdue"
+            kIntel "katana::analytics::MatrixCompletionPlan::kIntel"
+            kBottou "katana::analytics::MatrixCompletionPlan::kBottou"
+            kInverse "katana::analytics::MatrixCompletionPlan::kInverse"
+
+        _MatrixCompletionPlan.Algorithm algorithm() const
+        uint32_t latent_vector_size() const
+        double lambda_ "lambda"() const
+        double learning_rate() const
+        double decay_rate() const
+        _MatrixCompletionPlan.StepFunction step_function() const
+        double tolerance() const
+        uint32_t max_rounds() const
+        uint32_t items_per_block() const
+        uint32_t users_per_block() const
+
+        MatrixCompletionPlan()
+
+        @staticmethod
+        _MatrixCompletionPlan SGDBlockedEdges(uint32_t latent_vector_size, double lambda_, double learning_rate,
+                                              _MatrixCompletionPlan.StepFunction step_function, double decay_rate,
+                                              uint32_t items_per_block, uint32_t users_per_block, double tolerance,
+                                              uint32_t max_rounds)
+
+        @staticmethod
+        _MatrixCompletionPlan SGDByItems(uint32_t latent_vector_size, double lambda_, double learning_rate,
+                                         _MatrixCompletionPlan.StepFunction step_function, double decay_rate,
+                                         double tolerance, uint32_t max_rounds)
+
+        @staticmethod
+        _MatrixCompletionPlan ALS(uint32_t latent_vector_size, double lambda_, double tolerance, uint32_t max_rounds)
+
+    std_result[void] MatrixCompletion(PropertyFileGraph* pfg, string rating_property_name, string item_property_name,
+                                      string user_property_name, _MatrixCompletionPlan plan)
+
+    std_result[void] MatrixCompletionAssertValid(PropertyFileGraph* pfg, string rating_property_name,
+                                                 string item_property_name, string user_property_name)
+
+    cppclass _MatrixCompletionStatistics "katana::analytics::MatrixCompletionStatistics":
+        uint64_t num_ratings
+        double root_mean_square_error
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_MatrixCompletionStatistics] Compute(PropertyFileGraph* pfg, string rating_property_name,
+                                                        string item_property_name, string user_property_name)
+
+
+class _MatrixCompletionPlanAlgorithm(Enum):
+    SGDBlockedEdges = _MatrixCompletionPlan.Algorithm.kSGDBlockedEdges
+    SGDByItems = _MatrixCompletionPlan.Algorithm.kSGDByItems
+    ALS = _MatrixCompletionPlan.Algorithm.kALS
+
+
+class _MatrixCompletionPlanStepFunction(Enum):
+    Bold = _MatrixCompletionPlan.StepFunction.kBold
+    Purdue = _MatrixCompletionPlan.StepFunction.kPurdue
+    Intel = _MatrixCompletionPlan.StepFunction.kIntel
+    Bottou = _MatrixCompletionPlan.StepFunction.kBottou
+    Inverse = _MatrixCompletionPlan.StepFunction.kInverse
+
+
+cdef class MatrixCompletionPlan(Plan):
+    cdef:
+        _MatrixCompletionPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MatrixCompletionPlanAlgorithm
+    StepFunction = _MatrixCompletionPlanStepFunction
+
+    @staticmethod
+    cdef MatrixCompletionPlan make(_MatrixCompletionPlan u):
+        f = <MatrixCompletionPlan>MatrixCompletionPlan.__new__(MatrixCompletionPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MatrixCompletionPlanAlgorithm:
+        return _MatrixCompletionPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def latent_vector_size(self) -> int:
+        return self.underlying_.latent_vector_size()
+
+    @property
+    def lambda_(self) -> float:
+        return self.underlying_.lambda_()
+
+    @property
+    def learning_rate(self) -> float:
+        return self.underlying_.learning_rate()
+
+    @property
+    def decay_rate(self) -> float:
+        return self.underlying_.decay_rate()
+
+    @property
+    def step_function(self) -> _MatrixCompletionPlanStepFunction:
+        return _MatrixCompletionPlanStepFunction(self.underlying_.step_function())
+
+    @property
+    def tolerance(self) -> float:
+        return self.underlying_.tolerance()
+
+    @property
+    def max_rounds(self) -> int:
+        return self.underlying_.max_rounds()
+
+    @property
+    def items_per_block(self) -> int:
+        return self.underlying_.items_per_block()
+
+    @property
+    def users_per_block(self) -> int:
+        return self.underlying_.users_per_block()
+
+    @staticmethod
+    def sgd_blocked_edges(uint32_t latent_vector_size = 20, double lambda_ = 0.05, double learning_rate = 0.012,
+                          step_function = _MatrixCompletionPlanStepFunction.Bold, double decay_rate = 0.015,
+                          uint32_t items_per_block = 350, uint32_t users_per_block = 2048, double tolerance = 0.01,
+                          uint32_t max_rounds = 100):
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.SGDBlockedEdges(
+            latent_vector_size, lambda_, learning_rate, step_function.value, decay_rate, items_per_block,
+            users_per_block, tolerance, max_rounds))
+
+    @staticmethod
+    def sgd_by_items(uint32_t latent_vector_size = 20, double lambda_ = 0.05, double learning_rate = 0.012,
+                     step_function = _MatrixCompletionPlanStepFunction.Bold, double decay_rate = 0.015,
+                     double tolerance = 0.01, uint32_t max_rounds = 100):
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.SGDByItems(
+            latent_vector_size, lambda_, learning_rate, step_function.value, decay_rate, tolerance, max_rounds))
+
+    @staticmethod
+    def als(uint32_t latent_vector_size = 20, double lambda_ = 0.05, double tolerance = 0.01,
+            uint32_t max_rounds = 100):
+        return MatrixCompletionPlan.make(_MatrixCompletionPlan.ALS(latent_vector_size, lambda_, tolerance, max_rounds))
+
+
+def matrix_completion(PropertyGraph pg, str rating_property_name, str item_property_name, str user_property_name,
+                      MatrixCompletionPlan plan = MatrixCompletionPlan()):
+    rating_property_name_bytes = bytes(rating_property_name, "utf-8")
+    rating_property_name_cstr = <string>rating_property_name_bytes
+    item_property_name_bytes = bytes(item_property_name, "utf-8")
+    item_property_name_cstr = <string>item_property_name_bytes
+    user_property_name_bytes = bytes(user_property_name, "utf-8")
+    user_property_name_cstr = <string>user_property_name_bytes
+    with nogil:
+        handle_result_void(MatrixCompletion(pg.underlying.get(), rating_property_name_cstr, item_property_name_cstr,
+                                            user_property_name_cstr, plan.underlying_))
+
+
+def matrix_completion_assert_valid(PropertyGraph pg, str rating_property_name, str item_property_name,
+                                   str user_property_name):
+    rating_property_name_bytes = bytes(rating_property_name, "utf-8")
+    rating_property_name_cstr = <string>rating_property_name_bytes
+    item_property_name_bytes = bytes(item_property_name, "utf-8")
+    item_property_name_cstr = <string>item_property_name_bytes
+    user_property_name_bytes = bytes(user_property_name, "utf-8")
+    user_property_name_cstr = <string>user_property_name_bytes
+    with nogil:
+        handle_result_assert(MatrixCompletionAssertValid(pg.underlying.get(), rating_property_name_cstr,
+                                                         item_property_name_cstr, user_property_name_cstr))
+
+
+cdef _MatrixCompletionStatistics handle_result_MatrixCompletionStatistics(
+        std_result[_MatrixCompletionStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MatrixCompletionStatistics:
+    cdef _MatrixCompletionStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str rating_property_name, str item_property_name, str user_property_name):
+        rating_property_name_bytes = bytes(rating_property_name, "utf-8")
+        rating_property_name_cstr = <string> rating_property_name_bytes
+        item_property_name_bytes = bytes(item_property_name, "utf-8")
+        item_property_name_cstr = <string> item_property_name_bytes
+        user_property_name_bytes = bytes(user_property_name, "utf-8")
+        user_property_name_cstr = <string> user_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_MatrixCompletionStatistics(
+                _MatrixCompletionStatistics.Compute(pg.underlying.get(), rating_property_name_cstr,
+                                                    item_property_name_cstr, user_property_name_cstr))
+
+    @property
+    def num_ratings(self) -> int:
+        return self.underlying.num_ratings
+
+    @property
+    def root_mean_square_error(self) -> float:
+        return self.underlying.root_mean_square_error
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -0,0 +1,141 @@
+from libcpp.string cimport string
+from libc.stdint cimport uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/minimum_spanning_forest/minimum_spanning_forest.h" namespace "katana::analytics" nogil:
+    cppclass _MinimumSpanningForestPlan "katana::analytics::MinimumSpanningForestPlan" (_Plan):
+        enum Algorithm:
+            kBoruvka "katana::analytics::MinimumSpanningForestPlan::kBoruvka"
+            kFilterKruskal "katana::analytics::MinimumSpanningForestPlan::kFilterKruskal"
+
+        _MinimumSpanningForestPlan.Algorithm algorithm() const
+        uint64_t kruskal_threshold() const
+
+        MinimumSpanningForestPlan()
+
+        @staticmethod
+        _MinimumSpanningForestPlan Boruvka(uint64_t kruskal_threshold)
+        @staticmethod
+        _MinimumSpanningForestPlan FilterKruskal()
+
+    std_result[void] MinimumSpanningForest(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                           string output_property_name, _MinimumSpanningForestPlan plan)
+
+    std_result[void] MinimumSpanningForestAssertValid(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                                      string output_property_name)
+
+    cppclass _MinimumSpanningForestStatistics "katana::analytics::MinimumSpanningForestStatistics":
+        uint64_t num_forest_edges
+        uint64_t num_trees
+        double total_weight
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_MinimumSpanningForestStatistics] Compute(PropertyFileGraph* pfg, string edge_weight_property_name,
+                                                             string output_property_name)
+
+
+class _MinimumSpanningForestPlanAlgorithm(Enum):
+    Boruvka = _MinimumSpanningForestPlan.Algorithm.kBoruvka
+    FilterKruskal = _MinimumSpanningForestPlan.Algorithm.kFilterKruskal
+
+
+cdef class MinimumSpanningForestPlan(Plan):
+    cdef:
+        _MinimumSpanningForestPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _MinimumSpanningForestPlanAlgorithm
+
+    @staticmethod
+    cdef MinimumSpanningForestPlan make(_MinimumSpanningForestPlan u):
+        f = <MinimumSpanningForestPlan>MinimumSpanningForestPlan.__new__(MinimumSpanningForestPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _MinimumSpanningForestPlanAlgorithm:
+        return _MinimumSpanningForestPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def kruskal_threshold(self) -> int:
+        return self.underlying_.kruskal_threshold()
+
+    @staticmethod
+    def boruvka(uint64_t kruskal_threshold = 100000):
+        return MinimumSpanningForestPlan.make(_MinimumSpanningForestPlan.Boruvka(kruskal_threshold))
+
+    @staticmethod
+    def filter_kruskal():
+        return MinimumSpanningForestPlan.make(_MinimumSpanningForestPlan.FilterKruskal())
+
+
+def minimum_spanning_forest(PropertyGraph pg, str edge_weight_property_name, str output_property_name,
+                            MinimumSpanningForestPlan plan = MinimumSpanningForestPlan()):
+    edge_weight_property_name_bytes = bytes(edge_weight_property_name, "utf-8")
+    edge_weight_property_name_cstr = <string>edge_weight_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(MinimumSpanningForest(pg.underlying.get(), edge_weight_property_name_cstr,
+                                                 output_property_name_cstr, plan.underlying_))
+
+
+def minimum_spanning_forest_assert_valid(PropertyGraph pg, str edge_weight_property_name, str output_property_name):
+    edge_weight_property_name_bytes = bytes(edge_weight_property_name, "utf-8")
+    edge_weight_property_name_cstr = <string>edge_weight_property_name_bytes
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_assert(MinimumSpanningForestAssertValid(pg.underlying.get(), edge_weight_property_name_cstr,
+                                                              output_property_name_cstr))
+
+
+cdef _MinimumSpanningForestStatistics handle_result_MinimumSpanningForestStatistics(
+        std_result[_MinimumSpanningForestStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class MinimumSpanningForestStatistics:
+    cdef _MinimumSpanningForestStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str edge_weight_property_name, str output_property_name):
+        edge_weight_property_name_bytes = bytes(edge_weight_property_name, "utf-8")
+        edge_weight_property_name_cstr = <string> edge_weight_property_name_bytes
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_MinimumSpanningForestStatistics(
+                _MinimumSpanningForestStatistics.Compute(pg.underlying.get(), edge_weight_property_name_cstr,
+                                                         output_property_name_cstr))
+
+    @property
+    def num_forest_edges(self) -> int:
+        return self.underlying.num_forest_edges
+
+    @property
+    def num_trees(self) -> int:
+        return self.underlying.num_trees
+
+    @property
+    def total_weight(self) -> float:
+        return self.underlying.total_weight
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
@@ -1,4 +1,7 @@
 from libcpp.string cimport string
+from libcpp.vector cimport vector
+from libcpp.utility cimport pair
+from libc.stdint cimport uint32_t
 
 from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
 from katana.cpp.libstd.iostream cimport ostringstream, ostream
@@ -35,9 +38,34 @@ cdef extern from "katana/analytics/pagerank/pagerank.h" namespace "katana::analy
         _PagerankPlan PushAsynchronous(float tolerance, float alpha)
         @staticmethod
         _PagerankPlan PushSynchronous(float tolerance, unsigned int max_iterations, float alpha)
+        @staticmethod
+        _PagerankPlan Automatic(PropertyFileGraph* pfg, float tolerance, unsigned int max_iterations, float alpha)
 
     std_result[void] Pagerank(PropertyFileGraph* pfg, string output_property_name, _PagerankPlan plan)
 
+    cppclass _PersonalizedPagerankPlan "katana::analytics::PersonalizedPagerankPlan" (_Plan):
+        enum Algorithm:
+            kLocalPush "katana::analytics::PersonalizedPagerankPlan::kLocalPush"
+            kBatchedPush "katana::analytics::PersonalizedPagerankPlan::kBatchedPush"
+
+        _PersonalizedPagerankPlan.Algorithm algorithm() const
+        float tolerance() const
+        float alpha() const
+        uint32_t batch_size() const
+
+        PersonalizedPagerankPlan()
+
+        @staticmethod
+        _PersonalizedPagerankPlan LocalPush(float tolerance, float alpha)
+        @staticmethod
+        _PersonalizedPagerankPlan BatchedPush(float tolerance, float alpha, uint32_t batch_size)
+
+    std_result[void] PersonalizedPagerank(PropertyFileGraph* pfg, vector[vector[uint32_t]] seed_sets,
+                                          vector[string] output_property_names, _PersonalizedPagerankPlan plan)
+
+    std_result[vector[vector[pair[uint32_t, float]]]] PersonalizedPagerankTopK(
+        PropertyFileGraph* pfg, vector[vector[uint32_t]] seed_sets, uint32_t top_k, _PersonalizedPagerankPlan plan)
+
     std_result[void] PagerankAssertValid(PropertyFileGraph* pfg, string output_property_name)
 
     cppclass _PagerankStatistics "katana::analytics::PagerankStatistics":
@@ -109,6 +137,17 @@ cdef class PagerankPlan(Plan):
     def push_synchronous(float tolerance, unsigned int max_iterations, float alpha):
         return PagerankPlan.make(_PagerankPlan.PushSynchronous(tolerance, max_iterations, alpha))
 
+    @staticmethod
+    def automatic(PropertyGraph pg, float tolerance = 1.0e-3, unsigned int max_iterations = 1000,
+                  float alpha = 0.85):
+        """
+        Choose an algorithm from the `GraphProfile` of the graph.
+        """
+        cdef _PagerankPlan plan
+        with nogil:
+            plan = _PagerankPlan.Automatic(pg.underlying.get(), tolerance, max_iterations, alpha)
+        return PagerankPlan.make(plan)
+
 
 def pagerank(PropertyGraph pg, str output_property_name,
              PagerankPlan plan = PagerankPlan()):
@@ -118,6 +157,81 @@ def pagerank(PropertyGraph pg, str output_property_name,
         handle_result_void(Pagerank(pg.underlying.get(), output_property_name_cstr, plan.underlying_))
 
 
+class _PersonalizedPagerankPlanAlgorithm(Enum):
+    LocalPush = _PersonalizedPagerankPlan.Algorithm.kLocalPush
+    BatchedPush = _PersonalizedPagerankPlan.Algorithm.kBatchedPush
+
+
+cdef class PersonalizedPagerankPlan(Plan):
+    cdef:
+        _PersonalizedPagerankPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _PersonalizedPagerankPlanAlgorithm
+
+    @staticmethod
+    cdef PersonalizedPagerankPlan make(_PersonalizedPagerankPlan u):
+        f = <PersonalizedPagerankPlan>PersonalizedPagerankPlan.__new__(PersonalizedPagerankPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _PersonalizedPagerankPlanAlgorithm:
+        return _PersonalizedPagerankPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def tolerance(self) -> float:
+        return self.underlying_.tolerance()
+
+    @property
+    def alpha(self) -> float:
+        return self.underlying_.alpha()
+
+    @property
+    def batch_size(self) -> int:
+        return self.underlying_.batch_size()
+
+    @staticmethod
+    def local_push(float tolerance = 1.0e-6, float alpha = 0.85):
+        return PersonalizedPagerankPlan.make(_PersonalizedPagerankPlan.LocalPush(tolerance, alpha))
+
+    @staticmethod
+    def batched_push(float tolerance = 1.0e-6, float alpha = 0.85, uint32_t batch_size = 16):
+        return PersonalizedPagerankPlan.make(_PersonalizedPagerankPlan.BatchedPush(tolerance, alpha, batch_size))
+
+
+def personalized_pagerank(PropertyGraph pg, seed_sets, output_property_names,
+                          PersonalizedPagerankPlan plan = PersonalizedPagerankPlan()):
+    cdef vector[vector[uint32_t]] c_seed_sets = [list(s) for s in seed_sets]
+    cdef vector[string] c_output_property_names = [bytes(n, "utf-8") for n in output_property_names]
+    with nogil:
+        handle_result_void(PersonalizedPagerank(pg.underlying.get(), c_seed_sets, c_output_property_names,
+                                                plan.underlying_))
+
+
+cdef vector[vector[pair[uint32_t, float]]] handle_result_PersonalizedPagerankTopK(
+        std_result[vector[vector[pair[uint32_t, float]]]] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+def personalized_pagerank_top_k(PropertyGraph pg, seed_sets, uint32_t top_k,
+                                PersonalizedPagerankPlan plan = PersonalizedPagerankPlan.local_push()):
+    """
+    Return, for each seed set, a list of (node, rank) pairs of its top_k highest ranked nodes, highest first.
+    """
+    cdef vector[vector[uint32_t]] c_seed_sets = [list(s) for s in seed_sets]
+    cdef vector[vector[pair[uint32_t, float]]] top
+    with nogil:
+        top = handle_result_PersonalizedPagerankTopK(PersonalizedPagerankTopK(pg.underlying.get(), c_seed_sets,
+                                                                              top_k, plan.underlying_))
+    return top
+
+
 def pagerank_assert_valid(PropertyGraph pg, str output_property_name):
     output_property_name_bytes = bytes(output_property_name, "utf-8")
     output_property_name_cstr = <string>output_property_name_bytes
@@ -0,0 +1,145 @@
+from libcpp.string cimport string
+from libc.stdint cimport uint32_t, uint64_t
+
+from katana.cpp.libstd.boost cimport handle_result_void, handle_result_assert, raise_error_code, std_result
+from katana.cpp.libstd.iostream cimport ostringstream, ostream
+from katana.cpp.libgalois.graphs.Graph cimport PropertyFileGraph
+from katana.analytics.plan cimport Plan, _Plan
+from katana.property_graph cimport PropertyGraph
+
+from enum import Enum
+
+
+cdef extern from "katana/analytics/strongly_connected_components/strongly_connected_components.h" namespace "katana::analytics" nogil:
+    cppclass _StronglyConnectedComponentsPlan "katana::analytics::StronglyConnectedComponentsPlan" (_Plan):
+        enum Algorithm:
+            kSerial "katana::analytics::StronglyConnectedComponentsPlan::kSerial"
+            kForwardBackward "katana::analytics::StronglyConnectedComponentsPlan::kForwardBackward"
+            kMultistep "katana::analytics::StronglyConnectedComponentsPlan::kMultistep"
+
+        _StronglyConnectedComponentsPlan.Algorithm algorithm() const
+        uint32_t serial_threshold() const
+
+        StronglyConnectedComponentsPlan()
+
+        @staticmethod
+        _StronglyConnectedComponentsPlan Serial()
+        @staticmethod
+        _StronglyConnectedComponentsPlan ForwardBackward()
+        @staticmethod
+        _StronglyConnectedComponentsPlan Multistep(uint32_t serial_threshold)
+
+    std_result[void] StronglyConnectedComponents(PropertyFileGraph* pfg, string output_property_name,
+                                                 _StronglyConnectedComponentsPlan plan)
+
+    std_result[void] StronglyConnectedComponentsAssertValid(PropertyFileGraph* pfg, string output_property_name)
+
+    cppclass _StronglyConnectedComponentsStatistics "katana::analytics::StronglyConnectedComponentsStatistics":
+        uint64_t total_components
+        uint64_t total_non_trivial_components
+        uint64_t largest_component_size
+        double ratio_largest_component
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_StronglyConnectedComponentsStatistics] Compute(PropertyFileGraph* pfg,
+                                                                   string output_property_name)
+
+
+class _StronglyConnectedComponentsPlanAlgorithm(Enum):
+    Serial = _StronglyConnectedComponentsPlan.Algorithm.kSerial
+    ForwardBackward = _StronglyConnectedComponentsPlan.Algorithm.kForwardBackward
+    Multistep = _StronglyConnectedComponentsPlan.Algorithm.kMultistep
+
+
+cdef class StronglyConnectedComponentsPlan(Plan):
+    cdef:
+        _StronglyConnectedComponentsPlan underlying_
+
+    cdef _Plan* underlying(self) except NULL:
+        return &self.underlying_
+
+    Algorithm = _StronglyConnectedComponentsPlanAlgorithm
+
+    @staticmethod
+    cdef StronglyConnectedComponentsPlan make(_StronglyConnectedComponentsPlan u):
+        f = <StronglyConnectedComponentsPlan>StronglyConnectedComponentsPlan.__new__(StronglyConnectedComponentsPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _StronglyConnectedComponentsPlanAlgorithm:
+        return _StronglyConnectedComponentsPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def serial_threshold(self) -> int:
+        return self.underlying_.serial_threshold()
+
+    @staticmethod
+    def serial():
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Serial())
+
+    @staticmethod
+    def forward_backward():
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.ForwardBackward())
+
+    @staticmethod
+    def multistep(uint32_t serial_threshold = 100000):
+        return StronglyConnectedComponentsPlan.make(_StronglyConnectedComponentsPlan.Multistep(serial_threshold))
+
+
+def strongly_connected_components(PropertyGraph pg, str output_property_name,
+                                  StronglyConnectedComponentsPlan plan = StronglyConnectedComponentsPlan()):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_void(StronglyConnectedComponents(pg.underlying.get(), output_property_name_cstr,
+                                                       plan.underlying_))
+
+
+def strongly_connected_components_assert_valid(PropertyGraph pg, str output_property_name):
+    output_property_name_bytes = bytes(output_property_name, "utf-8")
+    output_property_name_cstr = <string>output_property_name_bytes
+    with nogil:
+        handle_result_assert(StronglyConnectedComponentsAssertValid(pg.underlying.get(), output_property_name_cstr))
+
+
+cdef _StronglyConnectedComponentsStatistics handle_result_StronglyConnectedComponentsStatistics(
+        std_result[_StronglyConnectedComponentsStatistics] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
+cdef class StronglyConnectedComponentsStatistics:
+    cdef _StronglyConnectedComponentsStatistics underlying
+
+    def __init__(self, PropertyGraph pg, str output_property_name):
+        output_property_name_bytes = bytes(output_property_name, "utf-8")
+        output_property_name_cstr = <string> output_property_name_bytes
+        with nogil:
+            self.underlying = handle_result_StronglyConnectedComponentsStatistics(
+                _StronglyConnectedComponentsStatistics.Compute(pg.underlying.get(), output_property_name_cstr))
+
+    @property
+    def total_components(self) -> int:
+        return self.underlying.total_components
+
+    @property
+    def total_non_trivial_components(self) -> int:
+        return self.underlying.total_non_trivial_components
+
+    @property
+    def largest_component_size(self) -> int:
+        return self.underlying.largest_component_size
+
+    @property
+    def ratio_largest_component(self) -> float:
+        return self.underlying.ratio_largest_component
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
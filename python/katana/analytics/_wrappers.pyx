@@ -1,9 +1,11 @@
 from libc.stddef cimport ptrdiff_t
 from libc.stdint cimport uint64_t, uint32_t
+from libcpp cimport bool
 from libcpp.string cimport string
 from libcpp.memory cimport shared_ptr, static_pointer_cast
 
-from pyarrow.lib cimport CArray, CUInt64Array, pyarrow_wrap_array
+from pyarrow.lib cimport CArray, CChunkedArray, CUInt64Array, pyarrow_wrap_array, pyarrow_unwrap_array, \
+    pyarrow_wrap_chunked_array, pyarrow_unwrap_chunked_array
 
 from katana.cpp.libstd.boost cimport std_result, handle_result_void, handle_result_assert, raise_error_code
 from katana.cpp.libstd.iostream cimport ostream, ostringstream
@@ -13,6 +15,8 @@ from katana.analytics.plan cimport _Plan, Plan
 
 from enum import Enum
 
+import pyarrow
+
 cdef inline default_value(v, d):
     if v is None:
         return d
@@ -26,6 +30,14 @@ cdef shared_ptr[CUInt64Array] handle_result_shared_cuint64array(std_result[share
     return res.value()
 
 
+cdef shared_ptr[CChunkedArray] handle_result_shared_cchunkedarray(std_result[shared_ptr[CChunkedArray]] res) \
+        nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+
 # "Algorithms" from PropertyFileGraph
 
 cdef extern from "katana/PropertyFileGraph.h" namespace "katana" nogil:
@@ -55,6 +67,198 @@ def sort_nodes_by_degree(PropertyGraph pg):
         handle_result_void(SortNodesByDegree(pg.underlying.get()))
 
 
+# Node reordering
+
+cdef extern from "katana/ReorderNodes.h" namespace "katana" nogil:
+    cppclass _ReorderPlan "katana::ReorderPlan":
+        enum Algorithm:
+            kDegreeGrouping "katana::ReorderPlan::kDegreeGrouping"
+            kBreadthFirst "katana::ReorderPlan::kBreadthFirst"
+            kReverseCuthillMcKee "katana::ReorderPlan::kReverseCuthillMcKee"
+            kGorder "katana::ReorderPlan::kGorder"
+            kCommunity "katana::ReorderPlan::kCommunity"
+
+        _ReorderPlan.Algorithm algorithm() const
+        uint32_t window() const
+
+        ReorderPlan()
+
+        @staticmethod
+        _ReorderPlan DegreeGrouping()
+        @staticmethod
+        _ReorderPlan BreadthFirst()
+        @staticmethod
+        _ReorderPlan ReverseCuthillMcKee()
+        @staticmethod
+        _ReorderPlan Gorder(uint32_t window)
+        @staticmethod
+        _ReorderPlan Community()
+
+    std_result[shared_ptr[CUInt64Array]] ReorderNodes(PropertyFileGraph* pfg, _ReorderPlan plan)
+
+    std_result[shared_ptr[CChunkedArray]] RestoreNodeOrder(shared_ptr[CChunkedArray] property,
+                                                           shared_ptr[CUInt64Array] new_to_old)
+
+
+class _ReorderPlanAlgorithm(Enum):
+    DegreeGrouping = _ReorderPlan.Algorithm.kDegreeGrouping
+    BreadthFirst = _ReorderPlan.Algorithm.kBreadthFirst
+    ReverseCuthillMcKee = _ReorderPlan.Algorithm.kReverseCuthillMcKee
+    Gorder = _ReorderPlan.Algorithm.kGorder
+    Community = _ReorderPlan.Algorithm.kCommunity
+
+
+cdef class ReorderPlan:
+    """
+    The order `reorder_nodes` gives nodes. See the static methods for the orders.
+    """
+    cdef:
+        _ReorderPlan underlying_
+
+    Algorithm = _ReorderPlanAlgorithm
+
+    @staticmethod
+    cdef ReorderPlan make(_ReorderPlan u):
+        f = <ReorderPlan>ReorderPlan.__new__(ReorderPlan)
+        f.underlying_ = u
+        return f
+
+    @property
+    def algorithm(self) -> _ReorderPlanAlgorithm:
+        return _ReorderPlanAlgorithm(self.underlying_.algorithm())
+
+    @property
+    def window(self) -> int:
+        return self.underlying_.window()
+
+    @staticmethod
+    def degree_grouping():
+        """
+        Group nodes by degree, highest degrees first, keeping their relative order within a group.
+        """
+        return ReorderPlan.make(_ReorderPlan.DegreeGrouping())
+
+    @staticmethod
+    def breadth_first():
+        """
+        The order of a breadth-first search from the highest degree node of each component.
+        """
+        return ReorderPlan.make(_ReorderPlan.BreadthFirst())
+
+    @staticmethod
+    def reverse_cuthill_mckee():
+        """
+        Reverse Cuthill-McKee, which minimizes bandwidth. The graph should be symmetric.
+        """
+        return ReorderPlan.make(_ReorderPlan.ReverseCuthillMcKee())
+
+    @staticmethod
+    def gorder(uint32_t window = 5):
+        """
+        Place next the node with the most shared in-neighbors and edges with the last `window` placed nodes.
+        """
+        return ReorderPlan.make(_ReorderPlan.Gorder(window))
+
+    @staticmethod
+    def community():
+        """
+        Rabbit order: the depth-first order of a hierarchy of communities that increase modularity.
+        """
+        return ReorderPlan.make(_ReorderPlan.Community())
+
+
+def reorder_nodes(PropertyGraph pg, ReorderPlan plan = ReorderPlan()):
+    """
+    Renumber the nodes of the graph, permuting its topology and every property, to improve cache locality.
+
+    :return: An array mapping each new node ID to the node's ID before reordering. Pass it to `restore_node_order` to
+        put node properties computed on the reordered graph in the original order.
+    """
+    with nogil:
+        res = handle_result_shared_cuint64array(ReorderNodes(pg.underlying.get(), plan.underlying_))
+    return pyarrow_wrap_array(static_pointer_cast[CArray, CUInt64Array](res))
+
+
+def restore_node_order(property, new_to_old):
+    """
+    Return `property`, a node property of a graph reordered by `reorder_nodes`, in the order of the nodes before
+    reordering. `new_to_old` is the array `reorder_nodes` returned.
+    """
+    if isinstance(property, pyarrow.Array):
+        property = pyarrow.chunked_array([property])
+    if new_to_old.type != pyarrow.uint64():
+        raise TypeError("new_to_old must be an array of uint64")
+    cdef shared_ptr[CChunkedArray] c_property = pyarrow_unwrap_chunked_array(property)
+    cdef shared_ptr[CUInt64Array] c_new_to_old = static_pointer_cast[CUInt64Array, CArray](
+        pyarrow_unwrap_array(new_to_old))
+    with nogil:
+        res = handle_result_shared_cchunkedarray(RestoreNodeOrder(c_property, c_new_to_old))
+    return pyarrow_wrap_chunked_array(res)
+
+
+# Graph profiles
+
+cdef extern from "katana/analytics/GraphProfile.h" namespace "katana::analytics" nogil:
+    cppclass _GraphProfile "katana::analytics::GraphProfile":
+        uint64_t num_nodes
+        uint64_t num_edges
+        double average_degree
+        double degree_skew
+        uint32_t estimated_diameter
+        bool edges_sorted
+
+        void Print(ostream os)
+
+        @staticmethod
+        std_result[_GraphProfile] Get(PropertyFileGraph* pfg)
+
+cdef _GraphProfile handle_result_GraphProfile(std_result[_GraphProfile] res) nogil except *:
+    if not res.has_value():
+        with gil:
+            raise_error_code(res.error())
+    return res.value()
+
+cdef class GraphProfile:
+    """
+    A summary of the topology of a graph from which the `automatic` plans of analytics choose an algorithm. The
+    profile is computed once and stored with the graph until its topology changes.
+    """
+    cdef _GraphProfile underlying
+
+    def __init__(self, PropertyGraph pg):
+        with nogil:
+            self.underlying = handle_result_GraphProfile(_GraphProfile.Get(pg.underlying.get()))
+
+    @property
+    def num_nodes(self) -> int:
+        return self.underlying.num_nodes
+
+    @property
+    def num_edges(self) -> int:
+        return self.underlying.num_edges
+
+    @property
+    def average_degree(self) -> float:
+        return self.underlying.average_degree
+
+    @property
+    def degree_skew(self) -> float:
+        return self.underlying.degree_skew
+
+    @property
+    def estimated_diameter(self) -> int:
+        return self.underlying.estimated_diameter
+
+    @property
+    def edges_sorted(self) -> bool:
+        return self.underlying.edges_sorted
+
+    def __str__(self) -> str:
+        cdef ostringstream ss
+        self.underlying.Print(ss)
+        return str(ss.str(), "ascii")
+
+
 # BFS
 
 cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
@@ -67,6 +271,7 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
 
         _BfsPlan.Algorithm algorithm() const
         ptrdiff_t edge_tile_size() const
+        bool symmetric() const
 
         @staticmethod
         _BfsPlan AsynchronousTile()
@@ -83,10 +288,15 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
 
         @staticmethod
         _BfsPlan Synchronous()
+        @staticmethod
+        _BfsPlan Synchronous_1 "Synchronous"(bool symmetric)
 
         @staticmethod
         _BfsPlan FromAlgorithm(_BfsPlan.Algorithm algo)
 
+        @staticmethod
+        _BfsPlan Automatic(PropertyFileGraph* pfg)
+
     std_result[void] Bfs(PropertyFileGraph * pfg,
                          size_t start_node,
                          string output_property_name,
@@ -139,6 +349,10 @@ cdef class BfsPlan(Plan):
     def edge_tile_size(self) -> int:
         return self.underlying_.edge_tile_size()
 
+    @property
+    def symmetric(self) -> bool:
+        return self.underlying_.symmetric()
+
     @staticmethod
     def asynchronous_tile(edge_tile_size=None):
 
@@ -157,13 +371,23 @@ cdef class BfsPlan(Plan):
         return BfsPlan.make(_BfsPlan.SynchronousTile())
 
     @staticmethod
-    def synchronous():
-        return BfsPlan.make(_BfsPlan.Synchronous())
+    def synchronous(symmetric=False):
+        return BfsPlan.make(_BfsPlan.Synchronous_1(symmetric))
 
     @staticmethod
     def from_algorithm(algorithm):
         return BfsPlan.make(_BfsPlan.FromAlgorithm(int(algorithm)))
 
+    @staticmethod
+    def automatic(PropertyGraph pg):
+        """
+        Choose an algorithm from the `GraphProfile` of the graph.
+        """
+        cdef _BfsPlan plan
+        with nogil:
+            plan = _BfsPlan.Automatic(pg.underlying.get())
+        return BfsPlan.make(plan)
+
 
 def bfs(PropertyGraph pg, size_t start_node, str output_property_name, BfsPlan plan = BfsPlan()):
     output_property_name_bytes = bytes(output_property_name, "utf-8")
@@ -232,6 +456,8 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
             kDijkstra "katana::analytics::SsspPlan::kDijkstra"
             kTopo "katana::analytics::SsspPlan::kTopo"
             kTopoTile "katana::analytics::SsspPlan::kTopoTile"
+            kMultiQueue "katana::analytics::SsspPlan::kMultiQueue"
+            kOrdered "katana::analytics::SsspPlan::kOrdered"
             kAutomatic "katana::analytics::SsspPlan::kAutomatic"
 
         _SsspPlan()
@@ -279,6 +505,12 @@ cdef extern from "katana/Analytics.h" namespace "katana::analytics" nogil:
         @staticmethod
         _SsspPlan TopoTile_1 "TopoTile"(ptrdiff_t edge_tile_size)
 
+        @staticmethod
+        _SsspPlan MultiQueue()
+
+        @staticmethod
+        _SsspPlan Ordered()
+
 
     std_result[void] Sssp(PropertyFileGraph* pfg, size_t start_node,
         string edge_weight_property_name, string output_property_name,
@@ -312,6 +544,8 @@ class _SsspAlgorithm(Enum):
     Dijkstra = _SsspPlan.Algorithm.kDijkstra
     Topo = _SsspPlan.Algorithm.kTopo
     TopoTile = _SsspPlan.Algorithm.kTopoTile
+    MultiQueue = _SsspPlan.Algorithm.kMultiQueue
+    Ordered = _SsspPlan.Algorithm.kOrdered
     Automatic = _SsspPlan.Algorithm.kAutomatic
 
 
@@ -342,7 +576,7 @@ cdef class SsspPlan(Plan):
 
     @property
     def algorithm(self) -> _SsspAlgorithm:
-        return _BfsAlgorithm(self.underlying_.algorithm())
+        return _SsspAlgorithm(self.underlying_.algorithm())
 
     @property
     def delta(self) -> int:
@@ -371,12 +605,6 @@ cdef class SsspPlan(Plan):
             return SsspPlan.make(_SsspPlan.DeltaStepBarrier())
         return SsspPlan.make(_SsspPlan.DeltaStepBarrier_1(delta))
 
-    @staticmethod
-    def delta_step_barrier(delta=None):
-        if delta is None:
-            return SsspPlan.make(_SsspPlan.DeltaStepBarrier())
-        return SsspPlan.make(_SsspPlan.DeltaStepBarrier_1(delta))
-
     @staticmethod
     def serial_delta_tile(delta=None, edge_tile_size=None):
         default = _SsspPlan.SerialDeltaTile()
@@ -410,6 +638,18 @@ cdef class SsspPlan(Plan):
     def topo():
         return SsspPlan.make(_SsspPlan.Topo())
 
+    @staticmethod
+    def multi_queue():
+        return SsspPlan.make(_SsspPlan.MultiQueue())
+
+    @staticmethod
+    def ordered():
+        return SsspPlan.make(_SsspPlan.Ordered())
+
+    @staticmethod
+    def automatic():
+        return SsspPlan.make(_SsspPlan())
+
 
 def sssp(PropertyGraph pg, size_t start_node, str edge_weight_property_name, str output_property_name,
          SsspPlan plan = SsspPlan()):
@@ -487,6 +727,9 @@ cdef extern from "katana/analytics/jaccard/jaccard.h" namespace "katana::analyti
         @staticmethod
         _JaccardPlan Unsorted()
 
+        @staticmethod
+        _JaccardPlan Automatic(PropertyFileGraph* pfg)
+
     std_result[void] Jaccard(PropertyFileGraph* pfg, size_t compare_node,
         string output_property_name, _JaccardPlan plan)
 
@@ -537,6 +780,16 @@ cdef class JaccardPlan(Plan):
     def unsorted():
         return JaccardPlan.make(_JaccardPlan.Unsorted())
 
+    @staticmethod
+    def automatic(PropertyGraph pg):
+        """
+        Choose an algorithm from the `GraphProfile` of the graph.
+        """
+        cdef _JaccardPlan plan
+        with nogil:
+            plan = _JaccardPlan.Automatic(pg.underlying.get())
+        return JaccardPlan.make(plan)
+
 
 def jaccard(PropertyGraph pg, size_t compare_node, str output_property_name,
             JaccardPlan plan = JaccardPlan()):
@@ -587,5 +840,3 @@ cdef class JaccardStatistics:
         self.underlying.Print(ss)
         return str(ss.str(), "ascii")
 
-
-# TODO(amp): Wrap ConnectedComponents
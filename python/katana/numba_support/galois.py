@@ -1,6 +1,7 @@
 import ctypes
 from typing import Dict
 
+import numba
 from numba import types
 from numba.extending import overload_method, overload
 
@@ -28,15 +29,52 @@ def overload_PropertyGraph_nodes(self):
     return impl
 
 
+@overload_method(katana.property_graph.PropertyGraph_numba_wrapper.Type, "out_indices")
+def overload_PropertyGraph_out_indices(self):
+    def impl(self):
+        return numba.carray(self.out_indices_data(), (self.num_nodes(),), numba.uint64)
+
+    return impl
+
+
+@overload_method(katana.property_graph.PropertyGraph_numba_wrapper.Type, "out_dests")
+def overload_PropertyGraph_out_dests(self):
+    def impl(self):
+        return numba.carray(self.out_dests_data(), (self.num_edges(),), numba.uint32)
+
+    return impl
+
+
+@overload_method(katana.property_graph.PropertyGraph_numba_wrapper.Type, "edge_index")
+def overload_PropertyGraph_edge_index(self, n):
+    if isinstance(n, types.Integer):
+
+        def impl(self, n):
+            return self.out_indices()[n]
+
+        return impl
+
+
+@overload_method(katana.property_graph.PropertyGraph_numba_wrapper.Type, "get_edge_dst")
+def overload_PropertyGraph_get_edge_dst(self, e):
+    if isinstance(e, types.Integer):
+
+        def impl(self, e):
+            return numba.uint64(self.out_dests()[e])
+
+        return impl
+
+
 @overload_method(katana.property_graph.PropertyGraph_numba_wrapper.Type, "edges")
 def overload_PropertyGraph_edges(self, n):
     if isinstance(n, types.Integer) and not n.signed:
 
         def impl(self, n):
+            indices = self.out_indices()
             if n == 0:
                 prev = 0
             else:
-                prev = self.edge_index(n - 1)
-            return range(prev, self.edge_index(n))
+                prev = indices[n - 1]
+            return range(prev, indices[n])
 
         return impl
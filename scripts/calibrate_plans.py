@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+"""
+Calibrate the thresholds with which automatic plans (e.g., BfsPlan.automatic) choose algorithms on this machine.
+
+Each input graph is profiled and BFS and connected components are timed on it with each of the algorithms that
+automatic plans choose between. Each threshold is then set to the value that minimizes the total time of the
+algorithms automatic plans would choose over all of the inputs. The thresholds are written as JSON; set
+KATANA_PLAN_CALIBRATION to the path of the output to use them.
+
+Only BFS and connected components are timed; the thresholds of the other automatic plans are shared with them rather
+than fit separately. PageRank and k-truss treat power-law graphs with the skew_threshold fit on BFS, connected
+components uses the edge_tile_size fit on BFS, and min_skewed_average_degree keeps its default. JaccardPlan.automatic
+only checks whether edges are sorted and has no thresholds.
+
+Inputs should resemble the graphs that will be analyzed and include both low- and high-diameter and both skewed
+and uniform graphs, or the thresholds they cannot distinguish keep their defaults.
+
+    calibrate_plans.py -o plans.json rmat22 road-USA twitter40
+"""
+
+import argparse
+import json
+import math
+import os
+import time
+
+from katana.galois import setActiveThreads
+from katana.analytics import (
+    bfs,
+    BfsPlan,
+    connected_components,
+    ConnectedComponentsPlan,
+    GraphProfile,
+)
+from katana.property_graph import PropertyGraph
+
+# The defaults of katana::analytics::PlanCalibration
+DEFAULTS = {
+    "skew_threshold": 1.3,
+    "min_skewed_average_degree": 10,
+    "high_diameter": 64,
+    "edge_tile_size": 512,
+    "afforest_min_average_degree": 2,
+}
+
+EDGE_TILE_SIZES = [128, 256, 512, 1024, 2048]
+
+
+def time_run(graph, runs, run):
+    """Return the least time of runs calls of run(graph, output_property_name)."""
+    best = math.inf
+    for i in range(runs):
+        name = "__calibrate_{}".format(i)
+        start = time.perf_counter()
+        run(graph, name)
+        best = min(best, time.perf_counter() - start)
+        graph.remove_node_property(name)
+    return best
+
+
+def fit_threshold(samples, default):
+    """
+    Each sample is (feature, time below the threshold, time at or above it). Return the threshold that minimizes the
+    total time, preferring default among equally good thresholds.
+    """
+
+    def total(threshold):
+        return sum(high if feature >= threshold else low for feature, low, high in samples)
+
+    candidates = [default] + sorted(feature for feature, _, _ in samples) + [math.inf]
+    return min(candidates, key=total)
+
+
+def measure(path, runs):
+    graph = PropertyGraph(path)
+    profile = GraphProfile(graph)
+    print("{}:\n{}".format(path, profile))
+
+    def bfs_run(plan):
+        return lambda g, name: bfs(g, 0, name, plan)
+
+    def cc_run(plan):
+        return lambda g, name: connected_components(g, name, plan)
+
+    m = {"profile": profile}
+    m["bfs_synchronous"] = time_run(graph, runs, bfs_run(BfsPlan.synchronous()))
+    m["bfs_asynchronous"] = time_run(graph, runs, bfs_run(BfsPlan.asynchronous()))
+    m["bfs_synchronous_tile"] = {
+        size: time_run(graph, runs, bfs_run(BfsPlan.synchronous_tile(size))) for size in EDGE_TILE_SIZES
+    }
+    m["cc_asynchronous"] = time_run(graph, runs, cc_run(ConnectedComponentsPlan.asynchronous()))
+    m["cc_afforest"] = time_run(graph, runs, cc_run(ConnectedComponentsPlan.afforest()))
+    return m
+
+
+def calibrate(measurements):
+    calibration = dict(DEFAULTS)
+
+    def skew(profile):
+        if profile.average_degree < calibration["min_skewed_average_degree"]:
+            return 0
+        return profile.degree_skew
+
+    # High-diameter graphs: asynchronous BFS instead of synchronous
+    calibration["high_diameter"] = fit_threshold(
+        [(m["profile"].estimated_diameter, m["bfs_synchronous"], m["bfs_asynchronous"]) for m in measurements],
+        DEFAULTS["high_diameter"],
+    )
+
+    # Edge tile size: the best total over all inputs
+    calibration["edge_tile_size"] = min(
+        EDGE_TILE_SIZES, key=lambda size: sum(m["bfs_synchronous_tile"][size] for m in measurements)
+    )
+
+    # Power-law graphs: tiled BFS instead of untiled. PageRank and k-truss reuse this threshold.
+    calibration["skew_threshold"] = fit_threshold(
+        [
+            (skew(m["profile"]), m["bfs_synchronous"], m["bfs_synchronous_tile"][calibration["edge_tile_size"]])
+            for m in measurements
+        ],
+        DEFAULTS["skew_threshold"],
+    )
+
+    # Sparse graphs: asynchronous connected components instead of Afforest
+    calibration["afforest_min_average_degree"] = fit_threshold(
+        [(m["profile"].average_degree, m["cc_asynchronous"], m["cc_afforest"]) for m in measurements],
+        DEFAULTS["afforest_min_average_degree"],
+    )
+
+    # A threshold above every input means never; JSON has no infinity
+    for key, value in calibration.items():
+        if value == math.inf:
+            calibration[key] = 2 ** 32 - 1
+    return calibration
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", help="paths of property graphs to time the analytics on")
+    parser.add_argument("-o", "--output", default="plan_calibration.json", help="path of the calibration to write")
+    parser.add_argument("-t", "--threads", type=int, default=os.cpu_count(), help="number of threads (default: all)")
+    parser.add_argument("-r", "--runs", type=int, default=3, help="runs of each algorithm; the fastest is used")
+    args = parser.parse_args()
+
+    setActiveThreads(args.threads)
+
+    measurements = [measure(path, args.runs) for path in args.inputs]
+    calibration = calibrate(measurements)
+
+    with open(args.output, "w") as f:
+        json.dump(calibration, f, indent=2)
+        f.write("\n")
+    print("wrote {}:\n{}".format(args.output, json.dumps(calibration, indent=2)))
+
+
+if __name__ == "__main__":
+    main()
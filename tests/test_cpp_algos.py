@@ -1,6 +1,8 @@
+import pytest
 from pytest import raises, approx
 
 from pyarrow import Schema, table
+import pyarrow as pa
 
 import numpy as np
 
@@ -11,26 +13,79 @@ from katana.analytics import (
     BfsStatistics,
     sssp,
     sssp_assert_valid,
+    SsspPlan,
     SsspStatistics,
     jaccard,
     JaccardPlan,
     sort_all_edges_by_dest,
     find_edge_sorted_by_dest,
     sort_nodes_by_degree,
+    reorder_nodes,
+    restore_node_order,
+    ReorderPlan,
     jaccard_assert_valid,
     JaccardStatistics,
     pagerank,
     pagerank_assert_valid,
     PagerankStatistics,
+    personalized_pagerank,
+    personalized_pagerank_top_k,
+    PersonalizedPagerankPlan,
     betweenness_centrality,
     BetweennessCentralityStatistics,
     BetweennessCentralityPlan,
+    closeness_centrality,
+    ClosenessCentralityPlan,
+    ClosenessCentralityStatistics,
     triangle_count,
     TriangleCountPlan,
     independent_set,
     IndependentSetStatistics,
     IndependentSetPlan,
     independent_set_assert_valid,
+    connected_components,
+    connected_components_assert_valid,
+    ConnectedComponentsPlan,
+    ConnectedComponentsStatistics,
+    core_decomposition,
+    core_decomposition_assert_valid,
+    CoreDecompositionPlan,
+    CoreDecompositionStatistics,
+    k_core,
+    k_core_assert_valid,
+    KCorePlan,
+    KCoreStatistics,
+    k_truss,
+    k_truss_assert_valid,
+    KTrussPlan,
+    KTrussStatistics,
+    strongly_connected_components,
+    strongly_connected_components_assert_valid,
+    StronglyConnectedComponentsPlan,
+    StronglyConnectedComponentsStatistics,
+    graph_coloring,
+    graph_coloring_assert_valid,
+    GraphColoringPlan,
+    GraphColoringStatistics,
+    label_propagation,
+    label_propagation_assert_valid,
+    LabelPropagationPlan,
+    LabelPropagationStatistics,
+    minimum_spanning_forest,
+    minimum_spanning_forest_assert_valid,
+    MinimumSpanningForestPlan,
+    MinimumSpanningForestStatistics,
+    hypergraph_partition,
+    hypergraph_partition_assert_valid,
+    HypergraphPartitionPlan,
+    HypergraphPartitionStatistics,
+    matrix_completion,
+    matrix_completion_assert_valid,
+    MatrixCompletionPlan,
+    MatrixCompletionStatistics,
+    GraphProfile,
+    BfsPlan,
+    PagerankPlan,
 )
 from katana.example_utils import get_input
 from katana.lonestar.analytics.bfs import verify_bfs
@@ -86,6 +141,28 @@ def test_sort_nodes_by_degree(property_graph: PropertyGraph):
         last_node_n_edges = v
 
 
+def test_reorder_nodes(property_graph: PropertyGraph):
+    num_nodes = property_graph.num_nodes()
+    original_degrees = [len(property_graph.edges(n)) for n in range(num_nodes)]
+    bfs(property_graph, 0, "OriginalDistance")
+    original_distances = property_graph.get_node_property("OriginalDistance").to_pylist()
+
+    new_to_old = reorder_nodes(property_graph, ReorderPlan.community())
+    assert sorted(new_to_old.to_pylist()) == list(range(num_nodes))
+    for n in range(num_nodes):
+        assert len(property_graph.edges(n)) == original_degrees[new_to_old[n].as_py()]
+
+    # Node properties are permuted with the nodes
+    restored = restore_node_order(property_graph.get_node_property("OriginalDistance"), new_to_old)
+    assert restored.to_pylist() == original_distances
+
+    # Results computed on the reordered graph map back to the original nodes
+    new_source = new_to_old.to_pylist().index(0)
+    bfs(property_graph, new_source, "NewDistance")
+    restored = restore_node_order(property_graph.get_node_property("NewDistance"), new_to_old)
+    assert restored.to_pylist() == original_distances
+
+
 def test_bfs(property_graph: PropertyGraph):
     property_name = "NewProp"
     start_node = 0
@@ -110,6 +187,20 @@ def test_bfs(property_graph: PropertyGraph):
     verify_bfs(property_graph, start_node, new_property_id)
 
 
+def test_bfs_synchronous_symmetric():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    plan = BfsPlan.synchronous(symmetric=True)
+    assert plan.symmetric
+    assert not BfsPlan.synchronous().symmetric
+
+    # Pulling along in-edges finds the same levels as pushing along out-edges
+    bfs(property_graph, 0, "pull", plan)
+    bfs(property_graph, 0, "push", BfsPlan.synchronous())
+    assert np.array_equal(
+        property_graph.get_node_property_numpy("pull"), property_graph.get_node_property_numpy("push")
+    )
+
+
 def test_sssp(property_graph: PropertyGraph):
     property_name = "NewProp"
     weight_name = "workFrom"
@@ -133,6 +224,68 @@ def test_sssp(property_graph: PropertyGraph):
     # Verify with numba implementation of verifier
     verify_sssp(property_graph, start_node, new_property_id)
 
+    assert SsspPlan.dijkstra().algorithm == SsspPlan.Algorithm.Dijkstra
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(SsspPlan.delta_tile(), id="delta_tile"),
+        pytest.param(SsspPlan.delta_step(), id="delta_step"),
+        pytest.param(SsspPlan.dijkstra(), id="dijkstra"),
+        pytest.param(SsspPlan.topo_tile(), id="topo_tile"),
+        pytest.param(SsspPlan.multi_queue(), id="multi_queue"),
+        pytest.param(SsspPlan.ordered(), id="ordered"),
+        pytest.param(SsspPlan.automatic(), id="automatic"),
+    ],
+)
+def test_sssp_plans(property_graph: PropertyGraph, plan):
+    start_node = 0
+    weight_name = "workFrom"
+
+    sssp(property_graph, start_node, weight_name, "NewProp", plan)
+    sssp_assert_valid(property_graph, start_node, weight_name, "NewProp")
+
+
+def test_minimum_spanning_forest():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    weights = np.random.default_rng(0).integers(0, 100, property_graph.num_edges(), dtype=np.uint32)
+    property_graph.add_edge_property(table({"weight": weights, "float_weight": weights.astype(np.float64) / 2}))
+
+    minimum_spanning_forest(property_graph, "weight", "output")
+
+    stats = MinimumSpanningForestStatistics(property_graph, "weight", "output")
+
+    minimum_spanning_forest_assert_valid(property_graph, "weight", "output")
+
+    assert stats.num_forest_edges + stats.num_trees == property_graph.num_nodes()
+
+    minimum_spanning_forest(property_graph, "float_weight", "float_output")
+    minimum_spanning_forest_assert_valid(property_graph, "float_weight", "float_output")
+    float_stats = MinimumSpanningForestStatistics(property_graph, "float_weight", "float_output")
+    assert float_stats.total_weight == approx(stats.total_weight / 2)
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(MinimumSpanningForestPlan.boruvka(0), id="boruvka"),
+        pytest.param(MinimumSpanningForestPlan.filter_kruskal(), id="filter_kruskal"),
+    ],
+)
+def test_minimum_spanning_forest_plans(plan):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    weights = np.random.default_rng(0).integers(0, 100, property_graph.num_edges(), dtype=np.uint32)
+    property_graph.add_edge_property(table({"weight": weights}))
+
+    minimum_spanning_forest(property_graph, "weight", "output")
+    minimum_spanning_forest(property_graph, "weight", "output_plan", plan)
+
+    minimum_spanning_forest_assert_valid(property_graph, "weight", "output_plan")
+
+    stats = MinimumSpanningForestStatistics(property_graph, "weight", "output")
+    assert MinimumSpanningForestStatistics(property_graph, "weight", "output_plan").total_weight == stats.total_weight
+
 
 def test_jaccard(property_graph: PropertyGraph):
     property_name = "NewProp"
@@ -194,6 +347,26 @@ def test_pagerank(property_graph: PropertyGraph):
     assert stats.average_rank == approx(0.5205338001251221, abs=0.001)
 
 
+def test_personalized_pagerank(property_graph: PropertyGraph):
+    seed_sets = [[0], [1, 2], [3]]
+    names = ["ppr0", "ppr1", "ppr2"]
+
+    personalized_pagerank(property_graph, seed_sets, names, PersonalizedPagerankPlan.batched_push(batch_size=2))
+    batched = [property_graph.get_node_property_numpy(name) for name in names]
+
+    top = personalized_pagerank_top_k(property_graph, seed_sets, 5, PersonalizedPagerankPlan.local_push())
+    assert len(top) == len(seed_sets)
+    for ranks, nodes in zip(batched, top):
+        assert 0 < len(nodes) <= 5
+        assert np.sum(ranks) <= 1 + 1e-3
+        assert [rank for _, rank in nodes] == sorted([rank for _, rank in nodes], reverse=True)
+        for node, rank in nodes:
+            assert rank == approx(ranks[node], abs=1e-3)
+
+    with raises(Exception):
+        personalized_pagerank(property_graph, [[]], ["empty"])
+
+
 def test_betweenness_centrality_outer(property_graph: PropertyGraph):
     property_name = "NewProp"
 
@@ -228,6 +401,44 @@ def test_betweenness_centrality_level(property_graph: PropertyGraph):
     assert stats.average_centrality == approx(1.3645)
 
 
+def test_betweenness_centrality_adaptive_sampling(property_graph: PropertyGraph):
+    property_name = "NewProp"
+    plan = BetweennessCentralityPlan.adaptive_sampling(0.05, 0.1)
+    assert plan.algorithm == BetweennessCentralityPlan.Algorithm.AdaptiveSampling
+    assert plan.epsilon == approx(0.05)
+
+    betweenness_centrality(property_graph, property_name, plan=plan)
+    sampled = property_graph.get_node_property_numpy(property_name)
+
+    betweenness_centrality(property_graph, "exact", plan=BetweennessCentralityPlan.level())
+    exact = property_graph.get_node_property_numpy("exact")
+
+    # Both are scaled to the number of ordered pairs. Samples are seeded by
+    # their index, so the estimate is the same on every run.
+    num_pairs = property_graph.num_nodes() * (property_graph.num_nodes() - 1)
+    assert np.max(np.abs(sampled - exact)) <= plan.epsilon * num_pairs
+
+
+def test_closeness_centrality():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    closeness_centrality(property_graph, "harmonic")
+    exact = property_graph.get_node_property_numpy("harmonic")
+
+    stats = ClosenessCentralityStatistics(property_graph, "harmonic")
+    assert 0 <= stats.min_centrality <= stats.average_centrality <= stats.max_centrality <= 1
+
+    closeness_centrality(property_graph, "sampled", ClosenessCentralityPlan.adaptive_sampling(epsilon=0.05))
+    sampled = property_graph.get_node_property_numpy("sampled")
+    assert np.max(np.abs(sampled - exact)) <= 0.05
+
+    closeness_centrality(
+        property_graph, "closeness", ClosenessCentralityPlan.exact(ClosenessCentralityPlan.Measure.Closeness)
+    )
+    closeness_stats = ClosenessCentralityStatistics(property_graph, "closeness")
+    assert 0 <= closeness_stats.min_centrality <= closeness_stats.max_centrality <= 1
+
+
 def test_triangle_count():
     property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
     original_first_edge_list = [property_graph.get_edge_dst(e) for e in property_graph.edges(0)]
@@ -271,4 +482,335 @@ def test_independent_set():
     independent_set_assert_valid(property_graph, "output2")
 
 
+def test_graph_coloring():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    graph_coloring(property_graph, "output")
+
+    stats = GraphColoringStatistics(property_graph, "output")
+
+    graph_coloring_assert_valid(property_graph, "output")
+
+    assert stats.num_colors > 1
+
+    graph_coloring(property_graph, "balanced", GraphColoringPlan.speculative(balance=True))
+    graph_coloring_assert_valid(property_graph, "balanced")
+    balanced_stats = GraphColoringStatistics(property_graph, "balanced")
+    assert balanced_stats.largest_color_class_size >= balanced_stats.average_color_class_size
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(GraphColoringPlan.jones_plassmann(), id="jones_plassmann"),
+        pytest.param(GraphColoringPlan.largest_degree_first(), id="largest_degree_first"),
+        pytest.param(GraphColoringPlan.smallest_last(), id="smallest_last"),
+        pytest.param(GraphColoringPlan.speculative(2), id="speculative_distance_2"),
+    ],
+)
+def test_graph_coloring_plans(plan):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    graph_coloring(property_graph, "output", plan)
+
+    graph_coloring_assert_valid(property_graph, "output", plan.distance)
+
+
+def test_connected_components():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    connected_components(property_graph, "output")
+
+    stats = ConnectedComponentsStatistics(property_graph, "output")
+
+    connected_components_assert_valid(property_graph, "output")
+
+    assert stats.total_components > 0
+    assert stats.largest_component_size <= property_graph.num_nodes()
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(ConnectedComponentsPlan.serial(), id="serial"),
+        pytest.param(ConnectedComponentsPlan.label_prop(), id="label_prop"),
+        pytest.param(ConnectedComponentsPlan.asynchronous(), id="asynchronous"),
+        pytest.param(ConnectedComponentsPlan.edge_tiled_afforest(), id="edge_tiled_afforest"),
+    ],
+)
+def test_connected_components_plans(plan):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    connected_components(property_graph, "output")
+    connected_components(property_graph, "output_plan", plan)
+
+    connected_components_assert_valid(property_graph, "output_plan")
+
+    stats = ConnectedComponentsStatistics(property_graph, "output")
+    assert ConnectedComponentsStatistics(property_graph, "output_plan").total_components == stats.total_components
+
+
+def test_strongly_connected_components(property_graph: PropertyGraph):
+    strongly_connected_components(property_graph, "output")
+
+    stats = StronglyConnectedComponentsStatistics(property_graph, "output")
+
+    strongly_connected_components_assert_valid(property_graph, "output")
+
+    assert stats.total_components > 0
+    assert stats.largest_component_size <= property_graph.num_nodes()
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(StronglyConnectedComponentsPlan.serial(), id="serial"),
+        pytest.param(StronglyConnectedComponentsPlan.forward_backward(), id="forward_backward"),
+        pytest.param(StronglyConnectedComponentsPlan.multistep(0), id="multistep"),
+    ],
+)
+def test_strongly_connected_components_plans(property_graph: PropertyGraph, plan):
+    strongly_connected_components(property_graph, "output")
+    strongly_connected_components(property_graph, "output_plan", plan)
+
+    strongly_connected_components_assert_valid(property_graph, "output_plan")
+
+    stats = StronglyConnectedComponentsStatistics(property_graph, "output")
+    plan_stats = StronglyConnectedComponentsStatistics(property_graph, "output_plan")
+    assert plan_stats.total_components == stats.total_components
+    assert plan_stats.largest_component_size == stats.largest_component_size
+
+
+def test_label_propagation(threads_1):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    # On one thread, every label change of asynchronous propagation increases
+    # the weight of the edges whose endpoints agree, so with integer weights it
+    # converges within one iteration per edge and the fixed point can be
+    # checked
+    converging_plan = LabelPropagationPlan.asynchronous(property_graph.num_edges() + 1)
+
+    label_propagation(property_graph, "output", plan=converging_plan)
+
+    stats = LabelPropagationStatistics(property_graph, "output")
+
+    label_propagation_assert_valid(property_graph, "output")
+
+    assert stats.total_communities > 0
+    assert stats.num_unlabeled_nodes == 0
+
+    label_propagation(property_graph, "output_sync", LabelPropagationPlan.synchronous(10))
+    assert LabelPropagationStatistics(property_graph, "output_sync").total_communities > 0
+
+    property_graph.add_edge_property(table({"weight": np.ones(property_graph.num_edges(), dtype=np.uint32)}))
+    label_propagation(property_graph, "output_weighted", edge_weight_property_name="weight", plan=converging_plan)
+    label_propagation_assert_valid(property_graph, "output_weighted", edge_weight_property_name="weight")
+
+    seeds = [None] * property_graph.num_nodes()
+    seeds[0] = 7
+    seeds[1] = 9
+    property_graph.add_node_property(table({"seeds": pa.array(seeds, type=pa.uint64())}))
+    label_propagation(property_graph, "output_seeded", seed_property_name="seeds", plan=converging_plan)
+    label_propagation_assert_valid(property_graph, "output_seeded", seed_property_name="seeds")
+    seeded = property_graph.get_node_property_numpy("output_seeded")
+    assert seeded[0] == 7
+    assert seeded[1] == 9
+
+
+def test_label_propagation_default_plan():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    num_nodes = property_graph.num_nodes()
+
+    # With several threads, asynchronous updates can race and oscillate, so the
+    # default plan is not guaranteed to reach a fixed point within its
+    # iteration cap; check only properties that hold after any number of
+    # iterations
+    label_propagation(property_graph, "output")
+
+    labels = property_graph.get_node_property_numpy("output")
+    assert (labels < num_nodes).all()
+
+    stats = LabelPropagationStatistics(property_graph, "output")
+    assert stats.num_unlabeled_nodes == 0
+    assert 0 < stats.total_communities < num_nodes
+    assert stats.total_non_trivial_communities <= stats.total_communities
+    assert stats.largest_community_size > 1
+    assert stats.ratio_largest_community == approx(stats.largest_community_size / num_nodes)
+
+
+def test_k_core():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    k_core(property_graph, 10, "output")
+
+    stats = KCoreStatistics(property_graph, 10, "output")
+
+    k_core_assert_valid(property_graph, 10, "output")
+
+    assert stats.k_core_number == 10
+
+    k_core(property_graph, 10, "output2", KCorePlan.asynchronous())
+
+    k_core_assert_valid(property_graph, 10, "output2")
+
+    assert KCoreStatistics(property_graph, 10, "output2").number_of_nodes_in_kcore == stats.number_of_nodes_in_kcore
+
+
+def test_core_decomposition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    core_decomposition(property_graph, "output")
+
+    stats = CoreDecompositionStatistics(property_graph, "output")
+
+    core_decomposition_assert_valid(property_graph, "output")
+
+    assert stats.degeneracy > 0
+    assert stats.num_nodes_in_max_core > 0
+
+    # The k-core is the set of nodes with core number at least k
+    k_core(property_graph, 10, "in_core")
+    in_core = property_graph.get_node_property_numpy("in_core")
+    core_numbers = property_graph.get_node_property_numpy("output")
+    assert ((core_numbers >= 10) == (in_core == 1)).all()
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(CoreDecompositionPlan.bucketed(4), id="bucketed"),
+        pytest.param(CoreDecompositionPlan.serial(), id="serial"),
+    ],
+)
+def test_core_decomposition_plans(plan):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    core_decomposition(property_graph, "output")
+    core_decomposition(property_graph, "output_plan", plan)
+
+    core_decomposition_assert_valid(property_graph, "output_plan")
+
+    stats = CoreDecompositionStatistics(property_graph, "output")
+    assert CoreDecompositionStatistics(property_graph, "output_plan").degeneracy == stats.degeneracy
+
+
+def test_k_truss():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    k_truss(property_graph, 10, "output")
+
+    stats = KTrussStatistics(property_graph, 10, "output")
+
+    k_truss_assert_valid(property_graph, 10, "output")
+
+    assert stats.k_truss_number == 10
+
+    k_truss(property_graph, 10, "output2", KTrussPlan.bsp_core_then_truss())
+
+    k_truss_assert_valid(property_graph, 10, "output2")
+
+    assert KTrussStatistics(property_graph, 10, "output2").number_of_edges_left == stats.number_of_edges_left
+
+
+def test_hypergraph_partition():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    is_hyperedge = (np.arange(property_graph.num_nodes()) % 4 == 0).astype(np.uint8)
+    property_graph.add_node_property(table({"is_hyperedge": is_hyperedge}))
+
+    hypergraph_partition(property_graph, "is_hyperedge", 4, "part")
+    hypergraph_partition_assert_valid(property_graph, "is_hyperedge", 4, "part")
+
+    parts = property_graph.get_node_property_numpy("part")
+    assert np.all(parts[is_hyperedge == 1] == np.iinfo(np.uint32).max)
+
+    stats = HypergraphPartitionStatistics(property_graph, "is_hyperedge", "part")
+    assert len(stats.part_sizes) == 4
+    assert sum(stats.part_sizes) == property_graph.num_nodes() - np.sum(is_hyperedge)
+    assert stats.imbalance < 1.25
+
+    plan = HypergraphPartitionPlan.bipart(HypergraphPartitionPlan.MatchingPolicy.Random, refinement_iterations=4)
+    hypergraph_partition(property_graph, "is_hyperedge", 3, "part_random", plan)
+    hypergraph_partition_assert_valid(property_graph, "is_hyperedge", 3, "part_random")
+    with raises(AssertionError):
+        hypergraph_partition_assert_valid(property_graph, "is_hyperedge", 2, "part_random")
+
+    with raises(Exception):
+        hypergraph_partition(property_graph, "is_hyperedge", 0, "part_none")
+
+
+def test_matrix_completion():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    rng = np.random.default_rng(0)
+    ratings = rng.integers(1, 6, property_graph.num_edges()).astype(np.float32)
+    property_graph.add_edge_property(table({"rating": ratings}))
+
+    initial_plan = MatrixCompletionPlan.sgd_blocked_edges(max_rounds=0)
+    matrix_completion(property_graph, "rating", "item_initial", "user_initial", initial_plan)
+    initial_stats = MatrixCompletionStatistics(property_graph, "rating", "item_initial", "user_initial")
+    assert initial_stats.num_ratings == property_graph.num_edges()
+
+    matrix_completion(property_graph, "rating", "item", "user")
+    matrix_completion_assert_valid(property_graph, "rating", "item", "user")
+    stats = MatrixCompletionStatistics(property_graph, "rating", "item", "user")
+    assert stats.root_mean_square_error < initial_stats.root_mean_square_error
+
+    with raises(Exception):
+        matrix_completion(property_graph, "rating", "item_none", "user_none", MatrixCompletionPlan.als(0))
+
+
+@pytest.mark.parametrize(
+    "plan",
+    [
+        pytest.param(
+            MatrixCompletionPlan.sgd_by_items(
+                latent_vector_size=8, step_function=MatrixCompletionPlan.StepFunction.Purdue
+            ),
+            id="sgd_by_items",
+        ),
+        pytest.param(MatrixCompletionPlan.als(latent_vector_size=8, max_rounds=5), id="als"),
+    ],
+)
+def test_matrix_completion_plans(plan):
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+    rng = np.random.default_rng(0)
+    ratings = rng.integers(1, 6, property_graph.num_edges()).astype(np.float32)
+    property_graph.add_edge_property(table({"rating": ratings}))
+
+    initial_plan = MatrixCompletionPlan.sgd_blocked_edges(max_rounds=0)
+    matrix_completion(property_graph, "rating", "item_initial", "user_initial", initial_plan)
+    initial_stats = MatrixCompletionStatistics(property_graph, "rating", "item_initial", "user_initial")
+
+    matrix_completion(property_graph, "rating", "item", "user", plan)
+    matrix_completion_assert_valid(property_graph, "rating", "item", "user")
+    stats = MatrixCompletionStatistics(property_graph, "rating", "item", "user")
+    assert stats.root_mean_square_error < initial_stats.root_mean_square_error
+
+
+def test_automatic_plans():
+    property_graph = PropertyGraph(get_input("propertygraphs/rmat15_cleaned_symmetric"))
+
+    profile = GraphProfile(property_graph)
+    assert profile.num_nodes == property_graph.num_nodes()
+    assert profile.num_edges == property_graph.num_edges()
+    assert profile.average_degree == approx(property_graph.num_edges() / property_graph.num_nodes())
+    assert profile.degree_skew > 1.3
+    assert profile.estimated_diameter > 0
+    assert "Estimated diameter" in str(profile)
+
+    sort_all_edges_by_dest(property_graph)
+    assert GraphProfile(property_graph).edges_sorted
+    assert JaccardPlan.automatic(property_graph).edge_sorting == JaccardPlan.EdgeSorting.Sorted
+
+    bfs(property_graph, 0, "bfs", BfsPlan.automatic(property_graph))
+    bfs_assert_valid(property_graph, "bfs")
+
+    connected_components(property_graph, "cc", ConnectedComponentsPlan.automatic(property_graph))
+    connected_components_assert_valid(property_graph, "cc")
+
+    k_truss(property_graph, 5, "k_truss", KTrussPlan.automatic(property_graph))
+    k_truss_assert_valid(property_graph, 5, "k_truss")
+
+    pagerank(property_graph, "pagerank", PagerankPlan.automatic(property_graph))
+    pagerank_assert_valid(property_graph, "pagerank")
+
+
 # TODO: Add more tests.
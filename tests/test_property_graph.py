@@ -8,6 +8,7 @@ import pytest
 from katana.loops import do_all_operator, do_all
 from katana.property_graph import PropertyGraph
 from katana import TsubaError
+from katana.example_utils import get_input
 
 
 def test_load(property_graph):
@@ -167,3 +168,64 @@ def test_simple_algorithm(property_graph):
     assert oprop[0].as_py() == 91
     assert oprop[4].as_py() == 239
     assert oprop[-1].as_py() == 0
+
+
+def test_out_indices_out_dests(property_graph):
+    g = property_graph
+    indices = g.out_indices()
+    dests = g.out_dests()
+    assert indices.dtype == np.uint64
+    assert dests.dtype == np.uint32
+    assert len(indices) == g.num_nodes()
+    assert len(dests) == g.num_edges()
+    assert not indices.flags.writeable
+    assert not dests.flags.writeable
+    for n in range(10):
+        assert list(g.edges(n)) == list(range(indices[n - 1] if n > 0 else 0, indices[n]))
+    for e in range(0, g.num_edges(), 97):
+        assert dests[e] == g.get_edge_dst(e)
+
+
+def test_out_dests_keeps_graph_alive():
+    g = PropertyGraph(get_input("propertygraphs/ldbc_003"))
+    expected = [g.get_edge_dst(e) for e in range(10)]
+    dests = g.out_dests()
+    del g
+    assert list(dests[:10]) == expected
+
+
+def test_get_node_property_numpy(property_graph):
+    t = pyarrow.table(dict(new_prop=range(property_graph.num_nodes())))
+    property_graph.add_node_property(t)
+    array = property_graph.get_node_property_numpy("new_prop")
+    assert isinstance(array, np.ndarray)
+    assert not array.flags.writeable
+    assert np.array_equal(array, np.arange(property_graph.num_nodes()))
+
+
+def test_get_edge_property_numpy_exception(property_graph):
+    with pytest.raises(pyarrow.ArrowInvalid):
+        # Should raise because booleans are bit packed so they cannot be viewed without a copy
+        property_graph.get_edge_property_numpy("IS_SUBCLASS_OF")
+
+
+def test_csr_algorithm(property_graph):
+    @do_all_operator()
+    def func_operator(g, out, nid):
+        dests = g.out_dests()
+        t = 0
+        for eid in g.edges(nid):
+            t += dests[eid]
+        out[nid] = t
+
+    g = property_graph
+    out = np.empty((g.num_nodes(),), dtype=np.uint64)
+
+    do_all(g, func_operator(g, out), "operator")
+
+    indices = g.out_indices()
+    dests = g.out_dests()
+    expected = np.array(
+        [dests[(indices[n - 1] if n > 0 else 0) : indices[n]].sum() for n in range(g.num_nodes())], dtype=np.uint64
+    )
+    assert np.array_equal(out, expected)
@@ -0,0 +1,88 @@
+/// graph-partition splits a property graph into partitions that can be loaded
+/// by the hosts of a distributed computation and writes them as one
+/// partitioned RDG.
+
+#include <sstream>
+
+#include <llvm/Support/CommandLine.h>
+
+#include "katana/Logging.h"
+#include "katana/PartitionGraph.h"
+#include "katana/PropertyFileGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+#include "katana/Timer.h"
+
+namespace cll = llvm::cl;
+
+namespace {
+
+cll::opt<std::string> input_rdg(
+    cll::Positional, cll::desc("<input rdg>"), cll::Required);
+cll::opt<std::string> output_rdg(
+    cll::Positional, cll::desc("<output rdg>"), cll::Required);
+cll::opt<uint32_t> num_partitions(
+    "num-partitions", cll::desc("Number of partitions (default value 2)"),
+    cll::init(2));
+cll::opt<katana::PartitionPolicy> policy(
+    "policy", cll::desc("Partitioning policy:"),
+    cll::values(
+        clEnumValN(
+            katana::PartitionPolicy::kOutgoingEdgeCut, "oec",
+            "Outgoing edge-cut: edges go with their sources (default)"),
+        clEnumValN(
+            katana::PartitionPolicy::kIncomingEdgeCut, "iec",
+            "Incoming edge-cut: edges go with their destinations"),
+        clEnumValN(
+            katana::PartitionPolicy::kCartesianVertexCut, "cvc",
+            "Cartesian vertex-cut: edges go to a 2D grid of partitions")),
+    cll::init(katana::PartitionPolicy::kOutgoingEdgeCut));
+cll::opt<unsigned> num_threads(
+    "t", cll::desc("Number of threads (default value 1)"), cll::init(1));
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  katana::SharedMemSys sys;
+  llvm::cl::ParseCommandLineOptions(argc, argv);
+
+  std::ostringstream command_line;
+  for (int i = 0; i < argc; ++i) {
+    command_line << (i > 0 ? " " : "") << argv[i];
+  }
+
+  katana::setActiveThreads(num_threads);
+
+  katana::StatTimer total_timer("TimerTotal");
+  total_timer.start();
+
+  auto pfg_res = katana::PropertyFileGraph::Make(input_rdg);
+  if (!pfg_res) {
+    KATANA_LOG_FATAL("failed to load {}: {}", input_rdg, pfg_res.error());
+  }
+  std::unique_ptr<katana::PropertyFileGraph> pfg = std::move(pfg_res.value());
+
+  auto parts_res = katana::PartitionGraph(pfg.get(), num_partitions, policy);
+  if (!parts_res) {
+    KATANA_LOG_FATAL(
+        "failed to partition {}: {}", input_rdg, parts_res.error());
+  }
+
+  for (uint32_t i = 0; i < parts_res.value().size(); ++i) {
+    const auto& part = parts_res.value()[i];
+    KATANA_LOG_VERBOSE(
+        "partition {}: {} nodes ({} owned), {} edges", i, part->num_nodes(),
+        part->partition_metadata().num_owned_, part->num_edges());
+  }
+
+  if (auto res = katana::PropertyFileGraph::WritePartitions(
+          parts_res.value(), output_rdg, command_line.str());
+      !res) {
+    KATANA_LOG_FATAL("failed to write {}: {}", output_rdg, res.error());
+  }
+
+  total_timer.stop();
+
+  return 0;
+}